@@ -7,13 +7,7 @@
 #include <ArduinoOTA.h>
 #include <LittleFS.h>  // For balance history storage
 #include <DNSServer.h> // For captive portal
-#include <time.h>      // For NTP time sync
 #include <WiFiUdp.h>   // For NTP
-#include <NTPClient.h> // For NTP time synchronization
-
-#define DBG_WIFI 1
-#define DBG_WEB 1
-#define DBG_BMS 0
 
 // En el repo la lógica usa "Serial2"; aquí lo aliasamos a UART0
 #define Serial2 Serial
@@ -21,56 +15,91 @@
 #include "PylontechMonitoring.h" // define WIFI_SSID, WIFI_PASS, WIFI_HOSTNAME (+ opcional STATIC_IP e IPs)
 #include "batteryStack.h"
 #include "commandParser.h"
+#include "bmsAcquisition.h"
 #include "webInterface.h"
+#include "liveSocket.h"
+#ifndef DISABLE_MQTT
+#include "mqttClient.h"
+#include "haDiscovery.h"
+#endif
+#ifndef DISABLE_MODBUS
+#include "modbusServer.h"
+#endif
+#ifdef INFLUX_URL
+#include "influxClient.h"
+#endif
+#ifdef UDP_SNAPSHOT_GROUP
+#include "udpBroadcaster.h"
+#endif
 #include "buildinfo.h"
+#include "timeService.h"
 #include "wifiConfig.h"
 
-// Forward declaration for BMS command function
-String _bmsSendCmd(const String &cmd, uint32_t timeout_ms);
-
 WebServer server(80);
+WebSocketsServer liveSocket(WEBSOCKET_PORT);
 batteryStack stack;
 bool wifiConnected = false;
 
-// NTP Configuration
-WiFiUDP ntpUDP;
-NTPClient timeClient(ntpUDP, "pool.ntp.org", 2 * 3600, 60000); // UTC+2 (Madrid, España CEST - horario de verano), update every minute
-unsigned long lastNtpSync = 0;
-const unsigned long NTP_SYNC_INTERVAL = 3600000; // Sync every hour
+#ifndef DISABLE_MQTT
+asyncMqttTransport mqttLink;
+mqttPublisher mqtt;
+telemetryOutbox outbox; // telemetry kept while the broker is unreachable
+#endif
+
+#ifndef DISABLE_MODBUS
+modbusTcpServer modbus(MODBUS_TCP_PORT);
+#endif
+
+#ifdef INFLUX_URL
+httpInfluxTransport influxLink;
+influxExporter influx; // line-protocol batches pushed to INFLUX_URL
+#endif
+
+#ifdef UDP_SNAPSHOT_GROUP
+udpSnapshotBroadcaster udpSnapshots(UDP_SNAPSHOT_GROUP, UDP_SNAPSHOT_PORT);
+#endif
+
+// Time: monotonic clock + non-blocking NTP (timeService.h)
+const long NTP_UTC_OFFSET = 2 * 3600; // UTC+2 (Madrid, España CEST - horario de verano)
+timeService timeSvc(NTP_UTC_OFFSET);
 
 static void dumpNet()
 {
-  Serial.print("IP: ");
-  Serial.println(WiFi.localIP());
-  Serial.print("GW: ");
-  Serial.println(WiFi.gatewayIP());
-  Serial.print("Mask: ");
-  Serial.println(WiFi.subnetMask());
-  Serial.print("DNS: ");
-  Serial.println(WiFi.dnsIP());
-  Serial.print("RSSI: ");
-  Serial.println(WiFi.RSSI());
+  LOG_I(NET, "IP %s GW %s mask %s DNS %s RSSI %d", WiFi.localIP().toString().c_str(),
+        WiFi.gatewayIP().toString().c_str(), WiFi.subnetMask().toString().c_str(),
+        WiFi.dnsIP().toString().c_str(), WiFi.RSSI());
 }
 
-static void connectWiFi()
+// ---------- Arranque WiFi sin bloqueo ----------
+// La conexión avanza desde loop(): configuración guardada, después las
+// credenciales de PylontechMonitoring.h y, si ambas fallan, el portal cautivo.
+// Antes, si hay caché de la última conexión, un intento corto sin escaneo. Si el portal se cierra sin conexión, la secuencia vuelve a empezar.
+// Mientras tanto la adquisición y el histórico ya funcionan.
+enum wifiBringUpState
 {
-  Serial.println("\n[WiFi] Attempting to connect...");
+  WIFI_TRY_FAST,
+  WIFI_TRY_SAVED,
+  WIFI_TRY_FALLBACK,
+  WIFI_PORTAL,
+  WIFI_ONLINE
+};
 
-  // First try to load saved configuration
-  if (wifiConfig.loadConfig())
-  {
-    Serial.println("[WiFi] Using saved configuration");
-    if (wifiConfig.connectToWiFi())
-    {
-      wifiConnected = true;
-      WiFi.hostname(WIFI_HOSTNAME);
-      dumpNet();
-      return;
-    }
-  }
+const unsigned long WIFI_FAST_TIMEOUT_MS = 8000; // asociación sin escaneo + DHCP
+const unsigned long WIFI_SAVED_TIMEOUT_MS = 30000;
+const unsigned long WIFI_FALLBACK_TIMEOUT_MS = 25000;
 
-  // If no saved config or connection failed, try hardcoded values as fallback
-  Serial.println("[WiFi] Trying hardcoded configuration as fallback...");
+static wifiBringUpState wifiState = WIFI_TRY_SAVED;
+static unsigned long wifiStateSince = 0;
+
+static void setWifiState(wifiBringUpState state)
+{
+  wifiState = state;
+  wifiStateSince = millis();
+}
+
+static void startFallbackWiFi()
+{
+  LOG_I(WIFI, "Trying hardcoded configuration as fallback");
   WiFi.mode(WIFI_STA);
   WiFi.hostname(WIFI_HOSTNAME);
 
@@ -79,278 +108,269 @@ static void connectWiFi()
 #endif
 
   WiFi.begin(WIFI_SSID, WIFI_PASS);
-  uint32_t t0 = millis();
-  while (WiFi.status() != WL_CONNECTED && millis() - t0 < 25000)
-  {
-    delay(400);
-    Serial.print(".");
-  }
-  Serial.println();
+  setWifiState(WIFI_TRY_FALLBACK);
+}
 
-  if (WiFi.status() == WL_CONNECTED)
+// Camino normal: configuración guardada o, si no hay, la de respaldo
+static void beginFullWiFi()
+{
+  if (wifiConfig.beginConnect())
   {
-    Serial.println("[WiFi] ✅ Connected with hardcoded config");
-    wifiConnected = true;
-    dumpNet();
+    LOG_I(WIFI, "Using saved configuration");
+    setWifiState(WIFI_TRY_SAVED);
   }
   else
   {
-    Serial.println("[WiFi] ❌ All connection attempts failed");
-    Serial.println("[WiFi] Starting configuration portal...");
-    wifiConfig.startConfigPortal();
+    startFallbackWiFi();
   }
 }
 
-static void setupOTA()
+static void beginWiFi()
 {
-  ArduinoOTA.setHostname(WIFI_HOSTNAME);
-  ArduinoOTA.setPassword("ota123"); // cambia esta clave
-  ArduinoOTA.begin();
-  Serial.println("[OTA] Listo (8266)");
+  LOG_I(WIFI, "Attempting to connect");
+  WiFi.mode(WIFI_STA);
+  WiFi.hostname(WIFI_HOSTNAME);
+
+  bool saved = wifiConfig.loadConfig();
+#ifdef STATIC_IP
+  // La ruta rápida hacia la red de respaldo usa su IP fija
+  if (!saved)
+    WiFi.config(ip, gateway, subnet, dns);
+#else
+  (void)saved;
+#endif
+  if (wifiConfig.beginFastConnect(WIFI_SSID, WIFI_PASS))
+    setWifiState(WIFI_TRY_FAST);
+  else
+    beginFullWiFi();
 }
 
-// Function to update battery data array from BMS commands
-void updateBatteryData()
+static void startNetworkServices();
+
+static void wifiUp(unsigned long now, const char *how)
 {
-  Serial.println("[BATTERY UPDATE] Starting battery data update...");
-  
-  // Clear all battery data first
-  for (int i = 0; i < MAX_PYLON_BATTERIES_SUPPORTED; i++)
-  {
-    stack.batts[i].isPresent = false;
-    stack.batts[i].soc = 0;
-    stack.batts[i].voltage = 0;
-    stack.batts[i].current = 0;
-    stack.batts[i].tempr = 0;
-    stack.batts[i].cellVoltHigh = 0;
-    stack.batts[i].cellVoltLow = 0;
-  }
+  LOG_I(WIFI, "Connected with %s config (%lu ms after boot)", how, now);
+  health.wifiConnectMs = now;
+  health.wifiFastPath = wifiConfig.usingFastPath();
+  wifiConfig.rememberLink();
+  setWifiState(WIFI_ONLINE);
+  startNetworkServices();
+}
 
-  // Use the exact same parsing logic as the working /battery-data endpoint
-  String raw = _bmsSendCmd("bat", 4000);
-  Serial.print("[BATTERY UPDATE] Raw response length: ");
-  Serial.println(raw.length());
-  
-  if (raw.length() < 10) {
-    Serial.println("[BATTERY UPDATE] Response too short, aborting");
-    return;
-  }
+// Avanza la máquina de estados; llamar en cada vuelta de loop()
+static void wifiLoop(unsigned long now)
+{
+  static const char *const names[] = {"cached fast-path", "saved", "hardcoded"};
 
-  // Parse exactly like the working endpoint
-  int cellCount = 0;
-  long sumMv = 0, sumMa = 0, sumMc = 0, sumSoc = 0;
-  long maxCellV = 0, minCellV = 999999;
-
-  int pos = 0;
-  while (pos < (int)raw.length()) {
-    int nl = raw.indexOf('\n', pos);
-    if (nl < 0) nl = raw.length();
-    
-    String line = raw.substring(pos, nl);
-    line.trim();
-    pos = nl + 1;
-
-    if (line.length() == 0 || !isDigit(line[0])) continue;
-
-    Serial.print("[BATTERY UPDATE] Processing: ");
-    Serial.println(line);
-
-    // Parse: cell_id voltage current temp soc%
-    const char* s = line.c_str();
-    long values[4];
-    int valueCount = 0;
-    
-    // Extract 4 numeric values
-    while (*s && valueCount < 4) {
-      while (*s && !isDigit(*s) && *s != '-') s++;
-      if (!*s) break;
-      
-      char* endPtr;
-      values[valueCount++] = strtol(s, &endPtr, 10);
-      s = endPtr;
+  switch (wifiState)
+  {
+  case WIFI_TRY_FAST:
+  case WIFI_TRY_SAVED:
+  case WIFI_TRY_FALLBACK:
+    if (WiFi.status() == WL_CONNECTED)
+    {
+      wifiUp(now, names[wifiState]);
     }
+    else if (wifiState == WIFI_TRY_FAST && now - wifiStateSince > WIFI_FAST_TIMEOUT_MS)
+    {
+      // AP cambiado de canal o de BSSID: escaneo completo
+      wifiConfig.forgetFastPath();
+      beginFullWiFi();
+    }
+    else if (wifiState == WIFI_TRY_SAVED && now - wifiStateSince > WIFI_SAVED_TIMEOUT_MS)
+    {
+      LOG_W(WIFI, "Saved configuration failed");
+      startFallbackWiFi();
+    }
+    else if (wifiState == WIFI_TRY_FALLBACK && now - wifiStateSince > WIFI_FALLBACK_TIMEOUT_MS)
+    {
+      LOG_W(WIFI, "All connection attempts failed, starting configuration portal");
+      wifiConfig.startConfigPortal();
+      setWifiState(WIFI_PORTAL);
+    }
+    break;
 
-    if (valueCount >= 4) {
-      long cellVoltage = values[1];  // mV
-      long cellCurrent = values[2];  // mA  
-      long cellTemp = values[3];     // mC
-
-      // Extract SOC percentage
-      int percentPos = line.indexOf('%');
-      int socValue = 0;
-      if (percentPos > 0) {
-        String socStr = "";
-        for (int i = percentPos - 1; i >= 0 && isDigit(line[i]); i--) {
-          socStr = line[i] + socStr;
-        }
-        socValue = socStr.toInt();
-      }
-
-      cellCount++;
-      sumMv += cellVoltage;
-      sumMa += cellCurrent;
-      sumMc += cellTemp;
-      sumSoc += socValue;
-
-      if (cellVoltage > maxCellV) maxCellV = cellVoltage;
-      if (cellVoltage < minCellV) minCellV = cellVoltage;
-
-      Serial.printf("[BATTERY UPDATE] Cell %d: V=%ldmV, I=%ldmA, T=%ldmC, SOC=%d%%\n", 
-                    cellCount, cellVoltage, cellCurrent, cellTemp, socValue);
+  case WIFI_PORTAL:
+    wifiConfig.handleConfigPortal();
+    // La estación sigue intentándolo en modo AP+STA: si entra, el portal
+    // deja libre el puerto 80 para la web normal
+    if (WiFi.status() == WL_CONNECTED)
+    {
+      LOG_I(WIFI, "Reconnected");
+      wifiConfig.stop();
+      WiFi.mode(WIFI_STA);
+      wifiUp(now, "hardcoded");
     }
-  }
+    else if (!wifiConfig.isInAPMode())
+    {
+      // Portal cerrado por tiempo: otra vuelta de la secuencia, sin reiniciar
+      LOG_I(WIFI, "Portal closed, retrying the configured networks");
+      beginFullWiFi();
+    }
+    break;
 
-  // Populate battery data if we found cells
-  if (cellCount > 0) {
-    stack.batts[0].isPresent = true;
-    stack.batts[0].soc = sumSoc / cellCount;
-    stack.batts[0].voltage = sumMv / 1000.0;  // Convert mV to V
-    stack.batts[0].current = sumMa / 1000.0;  // Convert mA to A
-    stack.batts[0].tempr = sumMc / 1000.0;    // Convert mC to C
-    stack.batts[0].cellVoltHigh = maxCellV;
-    stack.batts[0].cellVoltLow = minCellV;
-
-    Serial.printf("[BATTERY UPDATE] SUCCESS! Battery 1 populated:\n");
-    Serial.printf("  - SOC: %d%%\n", stack.batts[0].soc);
-    Serial.printf("  - Voltage: %.3fV\n", stack.batts[0].voltage);
-    Serial.printf("  - Current: %.3fA\n", stack.batts[0].current);
-    Serial.printf("  - Temperature: %.1f°C\n", stack.batts[0].tempr);
-    Serial.printf("  - Balance: %ldmV\n", maxCellV - minCellV);
-    Serial.printf("  - Cells: %d\n", cellCount);
-  } else {
-    Serial.println("[BATTERY UPDATE] ERROR: No valid cells found in response");
+  case WIFI_ONLINE:
+    break;
   }
 }
 
-// Function to get current Unix timestamp (real time, not millis)
+static void setupOTA()
+{
+  ArduinoOTA.setHostname(WIFI_HOSTNAME);
+  ArduinoOTA.setPassword("ota123"); // cambia esta clave
+  ArduinoOTA.begin();
+  LOG_I(OTA, "Listo (8266)");
+}
+
+// Current local Unix timestamp. Before the first NTP sync there is no real
+// time: this returns seconds since boot, and callers that store it must tag
+// it (timeSvc.isSynced()) so it can be fixed up later.
 unsigned long getCurrentTimestamp()
 {
-  if (wifiConnected && timeClient.isTimeSet())
-  {
-    return timeClient.getEpochTime();
-  }
-  // Fallback to millis() if NTP not available (should not be used for production)
-  return millis() / 1000; // Convert millis to seconds for compatibility
+  return timeSvc.isSynced() ? timeSvc.localTime() : timeSvc.uptimeSeconds();
 }
 
-// Function to initialize and sync NTP
-void setupNTP()
+// The periodic BMS poll, one telemetry job per console command (bmsScheduler.h).
+// It fills the stack snapshot that the web endpoints, WebSocket and history serve from.
+static queuedAcquisition acquisition;
+
+// Runs once the last command of an acquisition has been parsed and committed
+static void acquisitionDone(int present, unsigned long ms)
 {
-  if (wifiConnected)
-  {
-    Serial.println("[NTP] Initializing time synchronization...");
-    timeClient.begin();
-    timeClient.update();
+  health.acquisitionDone(ms, present > 0);
+  liveSocketBroadcastTelemetry();
+#ifndef DISABLE_MQTT
+  mqtt.queueIfOffline(timeSvc.isSynced() ? timeSvc.utc() : timeSvc.uptimeSeconds(), timeSvc.isSynced(), millis());
+#endif
+#ifdef INFLUX_URL
+  influx.sample(timeSvc.utc(), timeSvc.isSynced(), millis());
+#endif
+}
 
-    if (timeClient.isTimeSet())
-    {
-      Serial.print("[NTP] Time synchronized: ");
-      Serial.println(timeClient.getFormattedTime());
-      lastNtpSync = millis();
-    }
-    else
-    {
-      Serial.println("[NTP] Failed to synchronize time");
-    }
-  }
+// Starts an acquisition now (/force-update) unless one is running; it completes
+// from loop() and ends in acquisitionDone()
+bool updateBatteryData()
+{
+  LOG_D(BATTERY, "Starting battery data update");
+  return acquisition.start(stack);
+}
+
+// Servicios que necesitan red; se arrancan una sola vez, al conectar
+static void startNetworkServices()
+{
+  wifiConnected = true;
+  dumpNet();
+  setupOTA();
+  setupWebInterface(server, &stack); // Web estilo original del repo
+  // Marca la primera petición para medir el tiempo hasta la primera respuesta
+  // y anota la ruta para las estadísticas por ruta de /perf y /heap
+  server.addHook([](const String &, const String &url, WiFiClient *, ESP8266WebServer::ContentTypeFunction)
+                 {
+    if (health.firstHttpMs == 0)
+      health.httpRequestSeen = true;
+    httpRoutes.current = httpRoutes.lookup(url.c_str());
+    health.heap.requestBegin();
+    return ESP8266WebServer::CLIENT_REQUEST_CAN_CONTINUE; });
+  server.begin();
+  setupLiveSocket(liveSocket, &stack);
+#ifndef DISABLE_MODBUS
+  modbus.begin(stack);
+#endif
+#ifdef UDP_SNAPSHOT_GROUP
+  udpSnapshots.begin(stack);
+#endif
+  LOG_I(HTTP, "HTTP server listo");
 }
 
 void setup()
 {
-  Serial.begin(115200);
+  bmsPort.begin(BMS_UART_BAUD);
   // Si prefieres D7/D8:
   // Serial.swap();
-
-  connectWiFi();
-
-  // Only setup OTA if WiFi is connected
-  if (wifiConnected)
-  {
-    setupOTA();
-    setupNTP(); // Initialize NTP time synchronization
-  }
+#ifdef LOG_MIRROR
+  // Serial es el BMS: el log solo sale por la UART de LOG_MIRROR
+  LOG_MIRROR.begin(115200);
+  logBuffer.mirror = [](const char *line)
+  { LOG_MIRROR.println(line); };
+#endif
 
   // Initialize battery stack and load history
   stack.init();
-  Serial.println("[HISTORY] Stack initialized");
-  Serial.print("[HISTORY] Current millis(): ");
-  Serial.println(millis());
-
+  acquisition.onDone = acquisitionDone;
+  LOG_D(HISTORY, "Stack initialized");
+
+#ifndef DISABLE_MQTT
+  // The publisher connects on its own from loop() once WiFi is up
+  mqttLink.begin();
+  mqtt.begin(mqttLink, stack);
+  outbox.begin();
+  mqtt.attachOutbox(outbox);
+  mqtt.attachHeap(health.heap);
+  setupHaDiscovery(mqtt);
+#endif
+#ifdef INFLUX_URL
+  influxLink.begin();
+  influx.begin(influxLink, stack, WIFI_HOSTNAME);
+#endif
   if (stack.loadBalanceHistory())
   {
-    Serial.println("[HISTORY] Balance history loaded from flash");
-    Serial.print("[HISTORY] Loaded entries: ");
-    Serial.println(stack.history.entryCount);
-    Serial.print("[HISTORY] Last save time from flash: ");
-    Serial.println(stack.history.lastSaveTime);
+    LOG_I(HISTORY, "Balance history loaded from flash: %u entries, last save %lu",
+          stack.history.entryCount, (unsigned long)stack.history.lastSaveTime);
   }
   else
   {
-    Serial.println("[HISTORY] No existing history found - starting fresh");
-  }
-
-  // Force reset lastSaveTime to ensure first record happens quickly
-  stack.history.lastSaveTime = 0;
-  Serial.println("[HISTORY] Reset lastSaveTime to 0 for quick first record");
-
-  // For testing: Force immediate recording by setting lastSaveTime to an old value
-  unsigned long currentTime = millis();
-  if (currentTime > 60000) // If we've been running for more than 1 minute
-  {
-    stack.history.lastSaveTime = currentTime - 61000; // Set to 61 seconds ago
-    Serial.println("[HISTORY] Forced lastSaveTime to 61 seconds ago for immediate recording");
+    LOG_I(HISTORY, "No existing history found - starting fresh");
   }
 
-  // Test shouldRecordHistory function
-  unsigned long testTime = millis();
-  Serial.print("[HISTORY] Testing shouldRecordHistory() at ");
-  Serial.print(testTime);
-  Serial.print(": ");
-  Serial.println(stack.shouldRecordHistory(testTime) ? "YES" : "NO");
-
-  // Setup web interface only if WiFi is connected
-  if (wifiConnected)
-  {
-    setupWebInterface(server, &stack); // Web estilo original del repo
-    server.begin();
-    Serial.println("HTTP server listo");
-  }
+  // WiFi comes up from loop(); acquisition does not wait for it
+  beginWiFi();
 }
 
 void loop()
 {
-  // Handle configuration portal if in AP mode
-  if (wifiConfig.isInAPMode())
+  health.loopBegin(micros());
+  PERF_SCOPE(PERF_LOOP);
+
+  // WiFi bring-up, fallback and configuration portal
   {
-    wifiConfig.handleConfigPortal();
-    // Don't return here - we can still do basic tasks like recording history
+    PERF_SCOPE(PERF_WIFI);
+    wifiLoop(millis());
   }
 
-  // Periodic NTP synchronization (every hour)
-  if (wifiConnected && (millis() - lastNtpSync > NTP_SYNC_INTERVAL))
+  // Monotonic clock and NTP exchanges (never waits for the reply)
   {
-    timeClient.update();
-    if (timeClient.isTimeSet())
-    {
-      Serial.print("[NTP] Time resynchronized: ");
-      Serial.println(timeClient.getFormattedTime());
-      lastNtpSync = millis();
-    }
+    PERF_SCOPE(PERF_NTP);
+    timeSvc.loop(millis(), wifiConnected);
+  }
+  if (timeSvc.takeFirstSync())
+  {
+    // History recorded before the clock was known carried uptime stamps
+    int fixed = stack.history.fixUnsynced(timeSvc.bootEpoch());
+    LOG_I(HISTORY, "Clock known, %d early entries re-stamped", fixed);
+#ifndef DISABLE_MQTT
+    // Same for telemetry queued offline, which is stamped in UTC
+    fixed = outbox.fixUnsynced(timeSvc.bootUtc());
+    if (fixed)
+      LOG_I(OUTBOX, "%d offline records re-stamped", fixed);
+#endif
   }
 
-  // Update battery data periodically (every 30 seconds)
+  // Update battery data periodically, starting right after boot. The commands
+  // wait in the console queue behind interactive ones, one at a time
   static unsigned long lastBatteryUpdate = 0;
   unsigned long currentTime = millis();
-  if (currentTime - lastBatteryUpdate > 30000) // 30 seconds
+  if ((stack.generation == 0 || currentTime - lastBatteryUpdate > ACQUISITION_INTERVAL_MS) && acquisition.start(stack))
   {
-    updateBatteryData();
+    LOG_D(BATTERY, "Starting battery data update");
     lastBatteryUpdate = currentTime;
   }
+  bmsQueue.poll(millis());
 
-  // Check if we should record balance history (every 15 minutes)
-  if (stack.shouldRecordHistory(getCurrentTimestamp()))
+  // Check if we should record balance history (every 15 minutes of uptime)
+  uint32_t uptime = timeSvc.uptimeSeconds();
+  if (stack.shouldRecordHistory(uptime))
   {
-    Serial.println("[HISTORY] Recording balance history...");
+    LOG_D(HISTORY, "Recording balance history");
 
     // Check if we have real battery data
     bool hasRealData = false;
@@ -365,77 +385,107 @@ void loop()
 
     if (hasRealData)
     {
-      // Record actual battery data with real timestamp
-      stack.recordBalanceHistory(getCurrentTimestamp());
-      Serial.println("[HISTORY] Real battery data recorded");
+      // Record actual battery data; uptime-stamped and tagged until NTP answers
+      stack.recordBalanceHistory(getCurrentTimestamp(), timeSvc.isSynced());
+      LOG_D(HISTORY, "Real battery data recorded");
     }
     else
     {
       // No batteries detected - skip recording
-      Serial.println("[HISTORY] No batteries detected, skipping recording until real batteries are connected");
+      LOG_I(HISTORY, "No batteries detected, skipping recording until real batteries are connected");
     }
 
-    stack.updateLastSaveTime(getCurrentTimestamp());
+    stack.updateLastSaveTime(getCurrentTimestamp(), uptime);
 
     // Save to persistent storage every 2 records (2 minutes with 1min interval for testing)
     static uint8_t saveCounter = 0;
     saveCounter++;
     if (saveCounter >= 2)
     {
+      PERF_SCOPE(PERF_FLASH);
       if (stack.saveBalanceHistory())
       {
-        Serial.println("[HISTORY] Balance history saved to flash");
+        LOG_D(HISTORY, "Balance history saved to flash");
       }
       else
       {
-        Serial.println("[HISTORY] Failed to save balance history");
+        LOG_E(HISTORY, "Failed to save balance history");
       }
       saveCounter = 0;
     }
 
-    Serial.print("[HISTORY] Total entries: ");
-    Serial.println(stack.history.entryCount);
-    Serial.print("[HISTORY] Current time: ");
-    Serial.print(currentTime);
-    Serial.print(", Last save time: ");
-    Serial.println(stack.history.lastSaveTime);
+    LOG_D(HISTORY, "Total entries: %u, current time: %lu%s, last save time: %lu",
+          stack.history.entryCount, getCurrentTimestamp(), timeSvc.isSynced() ? "" : " (uptime)",
+          (unsigned long)stack.history.lastSaveTime);
   }
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
   else
   {
     // Debug: Show why we're not recording
     static unsigned long lastDebugTime = 0;
     if (currentTime - lastDebugTime > 10000) // Debug every 10 seconds
     {
-      Serial.print("[HISTORY DEBUG] Current time: ");
-      Serial.print(currentTime);
-      Serial.print(", Last save: ");
-      Serial.print(stack.history.lastSaveTime);
-      Serial.print(", Should record: ");
-      Serial.println(stack.shouldRecordHistory(currentTime) ? "YES" : "NO");
+      LOG_D(HISTORY, "Uptime: %lu, last record at uptime: %lu, should record: %s", (unsigned long)uptime,
+            (unsigned long)stack.history.lastRecordUptime, stack.shouldRecordHistory(uptime) ? "YES" : "NO");
       lastDebugTime = currentTime;
     }
   }
+#endif
 
   // Normal operation when WiFi is connected
   if (wifiConnected)
   {
-    server.handleClient();
-    ArduinoOTA.handle();
-  }
-  else
-  {
-    // Check if WiFi reconnected
-    if (WiFi.status() == WL_CONNECTED)
     {
-      wifiConnected = true;
-      Serial.println("[WiFi] ✅ Reconnected!");
-      dumpNet();
-
-      // Setup services now that WiFi is available
-      setupOTA();
-      setupWebInterface(server, &stack);
-      server.begin();
-      Serial.println("HTTP server listo");
+      PERF_SCOPE(PERF_HTTP);
+      server.handleClient();
+    }
+    if (httpRoutes.current >= 0)
+    {
+      health.heap.requestEnd(httpRoutes.current, millis());
+      httpRoutes.current = -1;
+    }
+    if (health.httpRequestSeen && health.firstHttpMs == 0)
+    {
+      health.firstHttpMs = millis();
+      LOG_I(BOOT, "First HTTP response %lu ms after boot (WiFi up at %lu ms%s)",
+            (unsigned long)health.firstHttpMs, (unsigned long)health.wifiConnectMs,
+            health.wifiFastPath ? ", fast path" : "");
+    }
+    {
+      PERF_SCOPE(PERF_WEBSOCKET);
+      liveSocketLoop();
+    }
+#ifndef DISABLE_MODBUS
+    {
+      PERF_SCOPE(PERF_MODBUS);
+      modbus.loop();
+    }
+#endif
+#ifndef DISABLE_MQTT
+    {
+      PERF_SCOPE(PERF_MQTT);
+      mqtt.loop(millis());
+    }
+#endif
+#ifdef INFLUX_URL
+    {
+      PERF_SCOPE(PERF_INFLUX);
+      influx.loop(millis());
+    }
+#endif
+#ifdef UDP_SNAPSHOT_GROUP
+    {
+      PERF_SCOPE(PERF_UDP);
+      udpSnapshots.loop();
+    }
+#endif
+    {
+      PERF_SCOPE(PERF_OTA);
+      ArduinoOTA.handle();
     }
   }
+
+  bmsPort.poll();
+  health.heap.loop(millis());
+  health.loopEnd(micros());
 }
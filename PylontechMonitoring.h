@@ -24,6 +24,35 @@ const char *www_password = "admin";
 #define MQTT_TOPIC_ROOT "pylontech/sensor/"
 #define MQTT_PUSH_FREQ_SEC 10
 
+// Exportador InfluxDB (influxExporter.h): descomente para activarlo. La URL
+// es la de escritura completa, con precision=s
+// #define INFLUX_URL "http://192.168.1.10:8086/api/v2/write?org=home&bucket=pylontech&precision=s"
+// #define INFLUX_TOKEN "token"
+
+// Snapshot CBOR por multicast en cada adquisición (udpSnapshot.h): descomente para activarlo
+// #define UDP_SNAPSHOT_GROUP IPAddress(239, 255, 42, 1)
+// #define UDP_SNAPSHOT_PORT 42424
+
+// #define DISABLE_MODBUS
+#define MODBUS_TCP_PORT 502 // registros del snapshot para PLC/inversores (modbusMap.h)
+
+#define WEBSOCKET_PORT 81 // telemetría en vivo y consola BMS interactiva
+
+// #define DISABLE_PERF // quita el perfil de latencia de loop() y /perf (perfProfiler.h)
+
+// Log en RAM (logger.h), leído por /log y el WebSocket. Serial es el BMS, así
+// que no se escribe ahí; LOG_MIRROR copia cada línea a otra UART
+// #define LOG_LEVEL 4        // 1 errores, 2 avisos, 3 info (por defecto), 4 depuración
+// #define LOG_MIRROR Serial1 // ESP8266: GPIO2 (D4), solo TX
+
+// Anillo de recepción de la consola del BMS (bmsUart.h), 2048 bytes por
+// defecto; /metrics da la ocupación máxima y los desbordes
+// #define BMS_UART_RX_BUFFER 4096
+// #define BMS_UART_RX_PIN 16 // ESP32: pines de Serial2
+// #define BMS_UART_TX_PIN 17
+
+#define ACQUISITION_INTERVAL_MS 30000 // lectura periódica del BMS (pwr + bat N + pwrsys)
+
 #define GMT 7200
 #define MAX_PYLON_BATTERIES 6
 
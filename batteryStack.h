@@ -5,26 +5,64 @@
 #ifndef BATTERYSTACK_H
 #define BATTERYSTACK_H
 
+#include "logger.h"
+
 // Maximum history entries (72 hours * 4 entries per hour = 288)
 #define MAX_BALANCE_HISTORY_ENTRIES 288
 
+// Cells reported by "bat N" (15 on US2000/US3000, 16 on some models)
+#define MAX_CELLS_PER_BATTERY 16
+
+// Longer gaps between acquisitions are not integrated into the energy counters
+#define ENERGY_MAX_GAP_MS 60000
+
+// History entry flags
+#define HISTORY_UNSYNCED 0x01  // timestamp is seconds since boot, not Unix time
+#define HISTORY_TIME_LOST 0x02 // unsynced entry from an earlier boot: cannot be fixed up
+
+// History file: versioned header + entries (v1 files had no header)
+#define HISTORY_FILE_MAGIC 0x48424C50UL // "PLBH"
+#define HISTORY_FILE_VERSION 2
+
+// The history file lives on LittleFS: on the ESP8266, and on the host build
+// (tools/hostArduino.h maps it onto plain files)
+#if defined(ESP8266) || defined(PYLONTECH_HOST)
+#define HISTORY_ON_LITTLEFS 1
+#endif
+
 // Structure to store balance history entry
 struct balanceHistoryEntry
 {
-  unsigned long timestamp; // Unix timestamp
+  unsigned long timestamp; // Unix timestamp (local), or uptime seconds if HISTORY_UNSYNCED
   uint8_t batteryId;       // Battery ID (1-16)
+  uint8_t flags;           // HISTORY_* (was padding in v1 files)
   int16_t balanceMv;       // Balance difference in mV
   uint8_t socPercent;      // State of charge in %
   bool isValid;            // Entry validity flag
 };
 
+struct balanceHistoryFileHeader
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t entrySize;
+  uint16_t capacity;
+  uint16_t currentIndex;
+  uint16_t entryCount;
+  uint16_t reserved;
+  uint32_t lastSaveTime;
+};
+
 // Structure to manage daily balance history
 struct balanceHistory
 {
   balanceHistoryEntry entries[MAX_BALANCE_HISTORY_ENTRIES];
-  uint8_t currentIndex;       // Current write position (circular buffer)
-  uint8_t entryCount;         // Total valid entries
-  unsigned long lastSaveTime; // Last save timestamp
+  uint16_t currentIndex;      // Current write position (circular buffer)
+  uint16_t entryCount;        // Total valid entries
+  unsigned long lastSaveTime; // Timestamp of the last record
+  uint32_t generation;        // Bumped on every change (not persisted), used as ETag
+  bool recordedThisBoot;      // Not persisted: the record interval runs on uptime
+  uint32_t lastRecordUptime;  // Uptime seconds of the last record
 
   // Initialize the history buffer
   void init()
@@ -32,6 +70,9 @@ struct balanceHistory
     currentIndex = 0;
     entryCount = 0;
     lastSaveTime = 0;
+    recordedThisBoot = false;
+    lastRecordUptime = 0;
+    generation++;
     for (int i = 0; i < MAX_BALANCE_HISTORY_ENTRIES; i++)
     {
       entries[i].isValid = false;
@@ -45,10 +86,11 @@ struct balanceHistory
   }
 
   // Add new entry to history
-  void addEntry(uint8_t batteryId, int16_t balanceMv, uint8_t socPercent, unsigned long timestamp)
+  void addEntry(uint8_t batteryId, int16_t balanceMv, uint8_t socPercent, unsigned long timestamp, uint8_t flags = 0)
   {
     entries[currentIndex].timestamp = timestamp;
     entries[currentIndex].batteryId = batteryId;
+    entries[currentIndex].flags = flags;
     entries[currentIndex].balanceMv = balanceMv;
     entries[currentIndex].socPercent = socPercent;
     entries[currentIndex].isValid = true;
@@ -58,15 +100,16 @@ struct balanceHistory
     {
       entryCount++;
     }
+    generation++;
   }
 
   // Get entry by index (0 = oldest, entryCount-1 = newest)
-  balanceHistoryEntry *getEntry(uint8_t index)
+  balanceHistoryEntry *getEntry(uint16_t index)
   {
     if (index >= entryCount)
       return nullptr;
 
-    uint8_t actualIndex;
+    uint16_t actualIndex;
     if (entryCount < MAX_BALANCE_HISTORY_ENTRIES)
     {
       actualIndex = index;
@@ -78,6 +121,68 @@ struct balanceHistory
 
     return entries[actualIndex].isValid ? &entries[actualIndex] : nullptr;
   }
+
+  const balanceHistoryEntry *getEntry(uint16_t index) const
+  {
+    return const_cast<balanceHistory *>(this)->getEntry(index);
+  }
+
+  // Once the clock is known, turn this boot's uptime stamps into real time
+  // (bootEpoch = local Unix time at boot). Returns the entries fixed.
+  int fixUnsynced(unsigned long bootEpoch)
+  {
+    int fixed = 0;
+    for (int i = 0; i < MAX_BALANCE_HISTORY_ENTRIES; i++)
+    {
+      balanceHistoryEntry &e = entries[i];
+      if (!e.isValid || (e.flags & (HISTORY_UNSYNCED | HISTORY_TIME_LOST)) != HISTORY_UNSYNCED)
+        continue;
+      e.timestamp += bootEpoch;
+      e.flags &= ~HISTORY_UNSYNCED;
+      fixed++;
+    }
+    if (lastSaveTime < 1000000000UL)
+      lastSaveTime += bootEpoch;
+    if (fixed)
+      generation++;
+    return fixed;
+  }
+
+  // Unsynced entries loaded from flash belong to an earlier boot
+  void markLoadedUnsynced()
+  {
+    for (int i = 0; i < MAX_BALANCE_HISTORY_ENTRIES; i++)
+      if (entries[i].isValid && (entries[i].flags & HISTORY_UNSYNCED))
+        entries[i].flags |= HISTORY_TIME_LOST;
+  }
+
+  // v1 files stored uint8_t index/count, which wrapped past 255 entries:
+  // rebuild both from the valid slots, the newest one marks the write position
+  void rebuildIndex()
+  {
+    entryCount = 0;
+    currentIndex = 0;
+    unsigned long newest = 0;
+    int newestAt = -1;
+    for (int i = 0; i < MAX_BALANCE_HISTORY_ENTRIES; i++)
+    {
+      if (!entries[i].isValid)
+        continue;
+      entryCount++;
+      if (newestAt < 0 || entries[i].timestamp >= newest)
+      {
+        newest = entries[i].timestamp;
+        newestAt = i;
+      }
+    }
+    if (entryCount < MAX_BALANCE_HISTORY_ENTRIES)
+    {
+      // Not yet wrapped: entries fill 0..entryCount-1 in order
+      currentIndex = entryCount;
+      return;
+    }
+    currentIndex = (newestAt + 1) % MAX_BALANCE_HISTORY_ENTRIES;
+  }
 };
 
 // This struct represents a single Pylontech battery.
@@ -99,6 +204,13 @@ struct pylonBattery
   char time[20];
   char b_v_st[9];
   char b_t_st[9];
+  uint8_t cellCount;                         // Cells parsed from "bat N"
+  uint8_t cellVoltHighId;                    // BMS index of the highest cell
+  uint8_t cellVoltLowId;                     // BMS index of the lowest cell
+  uint16_t cellVolt[MAX_CELLS_PER_BATTERY]; // Per-cell voltage (mV)
+
+  // Cell imbalance (mV), 0 when no cell data
+  long imbalanceMv() const { return cellCount > 0 ? cellVoltHigh - cellVoltLow : 0; }
 
   bool isCharging() const { return strcmp(baseState, "Charge") == 0; }
   bool isDischarging() const { return strcmp(baseState, "Dischg") == 0; }
@@ -132,6 +244,21 @@ struct batteryStack
   long avgVoltage;   // Average voltage across batteries in mV
   char baseState[9]; // e.g., "Charge", "Dischg", "Idle", "Alarm!", etc.
 
+  // Acquisition snapshot: every successful BMS poll bumps the generation,
+  // so consumers can tell whether anything changed since they last looked.
+  uint32_t generation;       // 0 = no data acquired yet
+  unsigned long acquiredAt;  // millis() of the last acquisition
+  int cellCount;             // Cells across all present batteries
+  long cellVoltHigh;         // Highest cell in the stack (mV)
+  long cellVoltLow;          // Lowest cell in the stack (mV)
+  uint8_t cellVoltHighBatt;  // Battery (1-based) holding the highest cell
+  uint8_t cellVoltLowBatt;   // Battery (1-based) holding the lowest cell
+
+  // Energy through the stack since boot (trapezoidal, from voltage x current)
+  uint64_t energyChargedUj;    // microjoules (mW x ms)
+  uint64_t energyDischargedUj;
+  long lastPowerMw;
+
   // Array de batería: reservado hasta el máximo soportado (16).
   pylonBattery batts[MAX_PYLON_BATTERIES_SUPPORTED];
 
@@ -141,12 +268,109 @@ struct batteryStack
   // Initialize the battery stack including history
   void init()
   {
+    generation = 0;
+    acquiredAt = 0;
+    energyChargedUj = 0;
+    energyDischargedUj = 0;
+    lastPowerMw = 0;
     history.init();
   }
 
+  // Forget all per-battery data before a new acquisition
+  void clearBatteries()
+  {
+    for (int i = 0; i < MAX_PYLON_BATTERIES_SUPPORTED; i++)
+    {
+      batts[i].isPresent = false;
+      batts[i].soc = 0;
+      batts[i].voltage = 0;
+      batts[i].current = 0;
+      batts[i].tempr = 0;
+      batts[i].cellVoltHigh = 0;
+      batts[i].cellVoltLow = 0;
+      batts[i].cellCount = 0;
+    }
+  }
+
+  // Recompute stack-wide values from the batteries and publish the snapshot.
+  // systemCurrentMa ("pwrsys") is used when known, else the module currents are summed.
+  void commitAcquisition(bool hasSystemCurrent, long systemCurrentMa, unsigned long now)
+  {
+    batteryCount = 0;
+    cellCount = 0;
+    cellVoltHigh = 0;
+    cellVoltLow = 0;
+    cellVoltHighBatt = 0;
+    cellVoltLowBatt = 0;
+    long sumSoc = 0, sumMv = 0, sumMa = 0, sumMc = 0;
+    bool charging = false, discharging = false;
+
+    for (int i = 0; i < MAX_PYLON_BATTERIES_SUPPORTED; i++)
+    {
+      const pylonBattery &b = batts[i];
+      if (!b.isPresent)
+        continue;
+      batteryCount++;
+      sumSoc += b.soc;
+      sumMv += b.voltage;
+      sumMa += b.current;
+      sumMc += b.tempr;
+      charging |= b.isCharging();
+      discharging |= b.isDischarging();
+
+      if (b.cellCount == 0)
+        continue;
+      cellCount += b.cellCount;
+      if (cellVoltHighBatt == 0 || b.cellVoltHigh > cellVoltHigh)
+      {
+        cellVoltHigh = b.cellVoltHigh;
+        cellVoltHighBatt = i + 1;
+      }
+      if (cellVoltLowBatt == 0 || b.cellVoltLow < cellVoltLow)
+      {
+        cellVoltLow = b.cellVoltLow;
+        cellVoltLowBatt = i + 1;
+      }
+    }
+
+    if (batteryCount > 0)
+    {
+      soc = sumSoc / batteryCount;
+      avgVoltage = sumMv / batteryCount;
+      temp = sumMc / batteryCount;
+    }
+    else
+    {
+      soc = 0;
+      avgVoltage = 0;
+      temp = 0;
+    }
+    currentDC = hasSystemCurrent ? systemCurrentMa : sumMa;
+    strncpy(baseState, charging ? "Charge" : discharging ? "Dischg" : batteryCount ? "Idle" : "Absent", sizeof(baseState));
+
+    long powerMw = (long)((long long)avgVoltage * currentDC / 1000);
+    if (generation > 0 && now - acquiredAt <= ENERGY_MAX_GAP_MS)
+    {
+      long long avgMw = ((long long)lastPowerMw + powerMw) / 2;
+      uint64_t uj = (uint64_t)(avgMw < 0 ? -avgMw : avgMw) * (now - acquiredAt);
+      if (avgMw > 0)
+        energyChargedUj += uj;
+      else
+        energyDischargedUj += uj;
+    }
+    lastPowerMw = powerMw;
+
+    acquiredAt = now;
+    generation++;
+  }
+
+  // Stack-wide cell imbalance (mV), 0 when no cell data
+  long imbalanceMv() const { return cellCount > 0 ? cellVoltHigh - cellVoltLow : 0; }
+
   // Record balance data for all batteries
-  void recordBalanceHistory(unsigned long currentTime)
+  void recordBalanceHistory(unsigned long currentTime, bool synced = true)
   {
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
     // Count how many batteries are actually present
     int presentCount = 0;
     for (int i = 0; i < MAX_PYLON_BATTERIES_SUPPORTED; i++)
@@ -156,10 +380,8 @@ struct batteryStack
         presentCount++;
       }
     }
-
-    Serial.print("[HISTORY DEBUG] Found ");
-    Serial.print(presentCount);
-    Serial.println(" batteries marked as present");
+    LOG_D(HISTORY, "Found %d batteries marked as present", presentCount);
+#endif
 
     // Only record from batteries that are actually present and have valid data
     for (int i = 0; i < MAX_PYLON_BATTERIES_SUPPORTED; i++)
@@ -169,52 +391,46 @@ struct batteryStack
         int16_t balanceMv = (int16_t)(batts[i].cellVoltHigh - batts[i].cellVoltLow);
         uint8_t socPercent = (uint8_t)batts[i].soc;
 
-        Serial.print("[HISTORY DEBUG] Recording battery ");
-        Serial.print(i + 1);
-        Serial.print(": Balance=");
-        Serial.print(balanceMv);
-        Serial.print("mV, SOC=");
-        Serial.print(socPercent);
-        Serial.println("%");
+        LOG_D(HISTORY, "Recording battery %d: Balance=%dmV, SOC=%u%%", i + 1, balanceMv, socPercent);
 
-        history.addEntry(i + 1, balanceMv, socPercent, currentTime);
+        history.addEntry(i + 1, balanceMv, socPercent, currentTime, synced ? 0 : HISTORY_UNSYNCED);
       }
       else if (batts[i].isPresent)
       {
-        Serial.print("[HISTORY DEBUG] Battery ");
-        Serial.print(i + 1);
-        Serial.print(" marked present but has invalid voltage data: High=");
-        Serial.print(batts[i].cellVoltHigh);
-        Serial.print(", Low=");
-        Serial.println(batts[i].cellVoltLow);
+        LOG_W(HISTORY, "Battery %d marked present but has invalid voltage data: High=%ld, Low=%ld",
+              i + 1, (long)batts[i].cellVoltHigh, (long)batts[i].cellVoltLow);
       }
     }
   }
 
-  // Check if it's time to record (every 15 minutes)
-  bool shouldRecordHistory(unsigned long currentTime)
+  // Check if it's time to record (every 15 minutes). Runs on uptime, so a
+  // clock that is not set yet (or steps on sync) never delays or repeats a record.
+  bool shouldRecordHistory(uint32_t uptimeSeconds) const
   {
-    const unsigned long RECORD_INTERVAL = 15 * 60; // 15 minutes in seconds (for Unix timestamp)
+    const uint32_t RECORD_INTERVAL = 15 * 60; // 15 minutes in seconds
 
-    // Force first record if lastSaveTime is 0 or seems invalid (Unix timestamp should be > 1000000000)
-    if (history.lastSaveTime == 0 || history.lastSaveTime < 1000000000)
+    // First record of every boot as soon as the first acquisition is in;
+    // before that no battery is present and the record would be skipped
+    if (!history.recordedThisBoot)
     {
-      return true;
+      return generation > 0;
     }
 
-    return (currentTime - history.lastSaveTime) >= RECORD_INTERVAL;
+    return (uptimeSeconds - history.lastRecordUptime) >= RECORD_INTERVAL;
   }
 
   // Update last save time
-  void updateLastSaveTime(unsigned long currentTime)
+  void updateLastSaveTime(unsigned long timestamp, uint32_t uptimeSeconds)
   {
-    history.lastSaveTime = currentTime;
+    history.lastSaveTime = timestamp;
+    history.lastRecordUptime = uptimeSeconds;
+    history.recordedThisBoot = true;
   }
 
   // Save balance history to LittleFS
   bool saveBalanceHistory()
   {
-#ifdef ESP8266
+#ifdef HISTORY_ON_LITTLEFS
     if (!LittleFS.begin())
     {
       return false;
@@ -227,9 +443,10 @@ struct batteryStack
     }
 
     // Write header with metadata
-    file.write((uint8_t *)&history.currentIndex, sizeof(history.currentIndex));
-    file.write((uint8_t *)&history.entryCount, sizeof(history.entryCount));
-    file.write((uint8_t *)&history.lastSaveTime, sizeof(history.lastSaveTime));
+    balanceHistoryFileHeader header = {HISTORY_FILE_MAGIC, HISTORY_FILE_VERSION, sizeof(balanceHistoryEntry),
+                                       MAX_BALANCE_HISTORY_ENTRIES, history.currentIndex, history.entryCount, 0,
+                                       (uint32_t)history.lastSaveTime};
+    file.write((uint8_t *)&header, sizeof(header));
 
     // Write all entries
     for (int i = 0; i < MAX_BALANCE_HISTORY_ENTRIES; i++)
@@ -247,7 +464,7 @@ struct batteryStack
   // Load balance history from LittleFS
   bool loadBalanceHistory()
   {
-#ifdef ESP8266
+#ifdef HISTORY_ON_LITTLEFS
     if (!LittleFS.begin())
     {
       return false;
@@ -266,18 +483,58 @@ struct batteryStack
       return false;
     }
 
-    // Read header with metadata
-    file.read((uint8_t *)&history.currentIndex, sizeof(history.currentIndex));
-    file.read((uint8_t *)&history.entryCount, sizeof(history.entryCount));
-    file.read((uint8_t *)&history.lastSaveTime, sizeof(history.lastSaveTime));
+    // v2 files start with a header; v1 files with uint8_t index and count
+    balanceHistoryFileHeader header;
+    bool v2 = file.read((uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+              header.magic == HISTORY_FILE_MAGIC;
+    if (v2 && (header.version != HISTORY_FILE_VERSION || header.entrySize != sizeof(balanceHistoryEntry) ||
+               header.capacity != MAX_BALANCE_HISTORY_ENTRIES))
+    {
+      file.close();
+      history.init();
+      return false;
+    }
+    if (!v2)
+    {
+      const size_t v1Header = 2 + sizeof(uint32_t); // currentIndex, entryCount, lastSaveTime
+      uint32_t lastSave = 0;
+      file.seek(2);
+      file.read((uint8_t *)&lastSave, sizeof(lastSave));
+      history.lastSaveTime = lastSave;
+      file.seek(v1Header);
+    }
 
     // Read all entries
+    size_t bytes = 0;
     for (int i = 0; i < MAX_BALANCE_HISTORY_ENTRIES; i++)
     {
-      file.read((uint8_t *)&history.entries[i], sizeof(balanceHistoryEntry));
+      bytes += file.read((uint8_t *)&history.entries[i], sizeof(balanceHistoryEntry));
     }
-
     file.close();
+
+    if (bytes != sizeof(history.entries))
+    {
+      history.init();
+      return false;
+    }
+
+    if (v2)
+    {
+      history.currentIndex = header.currentIndex % MAX_BALANCE_HISTORY_ENTRIES;
+      history.entryCount = header.entryCount > MAX_BALANCE_HISTORY_ENTRIES ? MAX_BALANCE_HISTORY_ENTRIES : header.entryCount;
+      history.lastSaveTime = header.lastSaveTime;
+    }
+    else
+    {
+      // The flags byte was uninitialised padding; v1 stamped millis()/1000
+      // whenever NTP was missing, those entries have no usable time
+      for (int i = 0; i < MAX_BALANCE_HISTORY_ENTRIES; i++)
+        history.entries[i].flags = history.entries[i].timestamp < 1000000000UL ? HISTORY_UNSYNCED : 0;
+      history.rebuildIndex();
+    }
+    history.markLoadedUnsynced();
+    history.recordedThisBoot = false;
+    history.generation++;
     return true;
 #else
     history.init();
@@ -288,7 +545,7 @@ struct batteryStack
   // Clear balance history from memory and delete from flash
   bool clearBalanceHistory()
   {
-#ifdef ESP8266
+#ifdef HISTORY_ON_LITTLEFS
     if (!LittleFS.begin())
     {
       return false;
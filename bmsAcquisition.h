@@ -0,0 +1,168 @@
+#ifndef BMSACQUISITION_H
+#define BMSACQUISITION_H
+
+#include <stdio.h>
+#include <string.h>
+
+#include "batteryStack.h"
+#include "bmsParser.h"
+#include "logger.h"
+#include "perfProfiler.h"
+
+// ================== Adquisición del BMS ==================
+//
+// La secuencia de cada lectura (pwr, bat N por módulo presente, pwrsys) y el
+// commit del snapshot, escrita contra bmsConsole en lugar del UART: en el
+// firmware la consola es la cola de bmsScheduler.h sobre bmsPort; en el host
+// (tools/hostBmsConsole.h) transcripciones con el formato del BMS o un
+// adaptador USB-serie abierto con termios.
+
+struct bmsConsole
+{
+  // Envía 'cmd' y devuelve la salida hasta el prompt (o lo que llegara
+  // antes del timeout). El puntero vale hasta la siguiente llamada.
+  virtual const char *command(const char *cmd, uint32_t timeoutMs) = 0;
+};
+
+// La secuencia paso a paso, para quien no espera cada respuesta (el
+// planificador de la consola, bmsScheduler.h): next() da el comando siguiente
+// y su timeout, feed() recibe su salida y, cuando next() devuelve nullptr,
+// finish() hace el commit del snapshot.
+struct stackAcquisition
+{
+  enum Step : uint8_t
+  {
+    IDLE,
+    PWR,
+    BAT_SINGLE, // sin respuesta a 'pwr': 'bat' a secas como módulo 1
+    BAT,        // 'bat N' de cada módulo presente
+    PWRSYS,
+    COMMIT,
+  };
+
+  batteryStack *stack = nullptr;
+  Step step = IDLE;
+  int present = 0;
+  int module = -1; // índice del 'bat N' en curso
+  bool hasSystemCurrent = false;
+  long systemCurrent = 0;
+  char cmd[16];
+
+  bool active() const { return step != IDLE; }
+
+  void begin(batteryStack &st)
+  {
+    stack = &st;
+    stack->clearBatteries();
+    step = PWR;
+    present = 0;
+    module = -1;
+    hasSystemCurrent = false;
+    systemCurrent = 0;
+  }
+
+  // Comando siguiente; nullptr cuando solo falta finish()
+  const char *next(uint32_t &timeoutMs)
+  {
+    switch (step)
+    {
+    case PWR:
+      timeoutMs = 4000;
+      return "pwr";
+    case BAT_SINGLE:
+      timeoutMs = 4000;
+      return "bat";
+    case BAT:
+      timeoutMs = 3000;
+      snprintf(cmd, sizeof(cmd), "bat %d", module + 1);
+      return cmd;
+    case PWRSYS:
+      timeoutMs = 3000;
+      return "pwrsys";
+    default:
+      return nullptr;
+    }
+  }
+
+  // Salida del comando que dio next()
+  void feed(const char *raw)
+  {
+    switch (step)
+    {
+    case PWR:
+      // Module presence and per-module values
+      present = parsePwrOutput(raw, *stack);
+      LOG_D(BATTERY, "pwr: %u bytes, %d modules present", (unsigned)strlen(raw), present);
+      step = present == 0 ? BAT_SINGLE : BAT;
+      if (step == BAT)
+        nextModule();
+      break;
+    case BAT_SINGLE:
+      // Single-module systems may not answer "pwr": fall back to plain "bat" as battery 1
+      if (strlen(raw) < 10)
+        LOG_W(BATTERY, "Response too short, no batteries");
+      else
+        parseBatOutput(raw, stack->batts[0]);
+      step = PWRSYS;
+      break;
+    case BAT:
+    {
+      // Cell voltages for every present module
+      int cells = parseBatOutput(raw, stack->batts[module]);
+      LOG_D(BATTERY, "Battery %d: %d cells, balance %ldmV", module + 1, cells, stack->batts[module].imbalanceMv());
+      nextModule();
+      break;
+    }
+    case PWRSYS:
+      // System current as reported by the BMS
+      hasSystemCurrent = parsePwrsysCurrent(raw, systemCurrent);
+      step = COMMIT;
+      break;
+    default:
+      break;
+    }
+  }
+
+  // Commit del snapshot. Devuelve los módulos presentes.
+  int finish(unsigned long now)
+  {
+    batteryStack &st = *stack;
+    st.commitAcquisition(hasSystemCurrent, systemCurrent, now);
+    step = IDLE;
+
+    if (st.batteryCount > 0)
+    {
+      LOG_D(BATTERY, "Snapshot %u: %d batteries, SOC %d%%, %.3fV, %.3fA, %.1f°C, balance %ldmV, %d cells",
+            (unsigned)st.generation, st.batteryCount, st.soc, st.avgVoltage / 1000.0,
+            st.currentDC / 1000.0, st.temp / 1000.0, st.imbalanceMv(), st.cellCount);
+    }
+    else
+    {
+      LOG_W(BATTERY, "No batteries found in response");
+    }
+    return st.batteryCount;
+  }
+
+private:
+  void nextModule()
+  {
+    while (++module < MAX_PYLON_BATTERIES_SUPPORTED && !stack->batts[module].isPresent)
+      ;
+    if (module >= MAX_PYLON_BATTERIES_SUPPORTED)
+      step = PWRSYS;
+  }
+};
+
+// Una adquisición completa sobre 'stack', esperando cada respuesta.
+// Devuelve los módulos presentes.
+inline int acquireStack(bmsConsole &console, batteryStack &stack)
+{
+  stackAcquisition acq;
+  acq.begin(stack);
+  uint32_t timeoutMs = 0;
+  while (const char *cmd = acq.next(timeoutMs))
+    acq.feed(console.command(cmd, timeoutMs));
+  return acq.finish(millis());
+}
+
+#endif // BMSACQUISITION_H
@@ -0,0 +1,229 @@
+#ifndef BMSPARSER_H
+#define BMSPARSER_H
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "batteryStack.h"
+#include "perfProfiler.h"
+
+// ================== Parsers de la consola de texto (pwr / bat / pwrsys) ==================
+//
+// Sin Arduino: solo texto en C y batteryStack, así que compilan igual en el
+// host (CMakeLists.txt) que en el firmware.
+
+#define BMS_MAX_LINE 192
+
+// Recorre la salida del BMS línea a línea sin crear Strings intermedios.
+// fn(line) recibe cada línea no vacía, recortada y terminada en '\0'.
+template <typename F>
+static void forEachBmsLine(const char *raw, F fn)
+{
+  char line[BMS_MAX_LINE];
+  while (*raw)
+  {
+    const char *nl = strchr(raw, '\n');
+    const char *end = nl ? nl : raw + strlen(raw);
+    const char *a = raw;
+    const char *b = end;
+    while (a < b && (*a == ' ' || *a == '\t' || *a == '\r'))
+      a++;
+    while (b > a && (b[-1] == ' ' || b[-1] == '\t' || b[-1] == '\r'))
+      b--;
+    size_t len = b - a;
+    if (len >= sizeof(line))
+      len = sizeof(line) - 1;
+    if (len > 0)
+    {
+      memcpy(line, a, len);
+      line[len] = '\0';
+      fn(line);
+    }
+    raw = nl ? nl + 1 : end;
+  }
+}
+
+// Extrae hasta n enteros en orden (tolerante a espacios). Devuelve cuántos encontró.
+static int scanInts(const char *s, long *vals, int n)
+{
+  int found = 0;
+  while (*s && found < n)
+  {
+    while (*s && !((*s == '-') || (*s >= '0' && *s <= '9')))
+      s++; // salta no-num
+    if (!*s)
+      break;
+    char *end;
+    vals[found++] = strtol(s, &end, 10);
+    if (end == s)
+      end++; // '-' suelto
+    s = end;
+  }
+  return found;
+}
+
+// SOC: número justo antes del primer '%' (0 si no hay)
+static int parseSocPercent(const char *line)
+{
+  const char *pcent = strchr(line, '%');
+  if (!pcent)
+    return 0;
+  const char *p = pcent;
+  while (p > line && isdigit((unsigned char)p[-1]))
+    p--;
+  return atoi(p);
+}
+
+// Separa una línea en tokens por espacios (modifica la línea). Devuelve cuántos.
+static int splitTokens(char *line, char **tokens, int maxTokens)
+{
+  int n = 0;
+  char *p = line;
+  while (*p && n < maxTokens)
+  {
+    while (*p == ' ' || *p == '\t')
+      *p++ = '\0';
+    if (!*p)
+      break;
+    tokens[n++] = p;
+    while (*p && *p != ' ' && *p != '\t')
+      p++;
+  }
+  return n;
+}
+
+static void copyState(char *dst, size_t size, const char *src)
+{
+  strncpy(dst, src, size - 1);
+  dst[size - 1] = '\0';
+}
+
+// "pwr": una fila por módulo
+// Power Volt Curr Tempr Tlow Thigh Vlow Vhigh Base.St Volt.St Curr.St Temp.St Coulomb Time(2) B.V.St B.T.St
+// Marca presentes los módulos con datos y devuelve cuántos hay.
+static int parsePwrOutput(const char *raw, batteryStack &stack)
+{
+  PERF_SCOPE(PERF_PARSE);
+  int present = 0;
+  forEachBmsLine(raw, [&](char *line)
+                 {
+    if (!isdigit((unsigned char)line[0]))
+      return;
+
+    char *tok[17];
+    int n = splitTokens(line, tok, 17);
+    if (n < 9)
+      return;
+
+    int id = atoi(tok[0]);
+    if (id < 1 || id > MAX_PYLON_BATTERIES_SUPPORTED)
+      return;
+    if (strcmp(tok[8], "Absent") == 0 || strcmp(tok[1], "-") == 0)
+      return;
+
+    pylonBattery &bat = stack.batts[id - 1];
+    bat.isPresent = true;
+    bat.voltage = atol(tok[1]);
+    bat.current = atol(tok[2]);
+    bat.tempr = atol(tok[3]);
+    bat.cellTempLow = atol(tok[4]);
+    bat.cellTempHigh = atol(tok[5]);
+    bat.cellVoltLow = atol(tok[6]);
+    bat.cellVoltHigh = atol(tok[7]);
+    copyState(bat.baseState, sizeof(bat.baseState), tok[8]);
+    copyState(bat.voltageState, sizeof(bat.voltageState), n > 9 ? tok[9] : "");
+    copyState(bat.currentState, sizeof(bat.currentState), n > 10 ? tok[10] : "");
+    copyState(bat.tempState, sizeof(bat.tempState), n > 11 ? tok[11] : "");
+    bat.soc = n > 12 ? parseSocPercent(tok[12]) : 0;
+    if (n > 14)
+      snprintf(bat.time, sizeof(bat.time), "%s %s", tok[13], tok[14]);
+    else
+      bat.time[0] = '\0';
+    copyState(bat.b_v_st, sizeof(bat.b_v_st), n > 15 ? tok[15] : "");
+    copyState(bat.b_t_st, sizeof(bat.b_t_st), n > 16 ? tok[16] : "");
+    present++; });
+  return present;
+}
+
+// "bat [N]": una fila por celda -> índice, mV, mA, mC, estados, SOC%
+// Rellena las celdas de bat y devuelve cuántas encontró.
+static int parseBatOutput(const char *raw, pylonBattery &bat)
+{
+  PERF_SCOPE(PERF_PARSE);
+  int cells = 0;
+  long sumMa = 0, sumMc = 0, sumSoc = 0;
+  long maxMc = 0, minMc = 0;
+  forEachBmsLine(raw, [&](char *line)
+                 {
+    if (!isdigit((unsigned char)line[0]))
+      return;
+    long v[4];
+    if (scanInts(line, v, 4) < 4)
+      return;
+    if (cells >= MAX_CELLS_PER_BATTERY)
+      return;
+
+    long mv = v[1];
+    bat.cellVolt[cells] = (uint16_t)mv;
+    if (cells == 0 || mv > bat.cellVoltHigh)
+    {
+      bat.cellVoltHigh = mv;
+      bat.cellVoltHighId = (uint8_t)v[0];
+    }
+    if (cells == 0 || mv < bat.cellVoltLow)
+    {
+      bat.cellVoltLow = mv;
+      bat.cellVoltLowId = (uint8_t)v[0];
+    }
+    if (cells == 0 || v[3] > maxMc)
+      maxMc = v[3];
+    if (cells == 0 || v[3] < minMc)
+      minMc = v[3];
+    sumMa += v[2];
+    sumMc += v[3];
+    sumSoc += parseSocPercent(line);
+    cells++; });
+
+  bat.cellCount = cells;
+  if (cells > 0)
+  {
+    bat.cellTempHigh = maxMc;
+    bat.cellTempLow = minMc;
+    // Sin fila en "pwr" (sistemas de un solo módulo) se derivan de las celdas
+    if (!bat.isPresent)
+    {
+      long sumMv = 0;
+      for (int i = 0; i < cells; i++)
+        sumMv += bat.cellVolt[i];
+      bat.isPresent = true;
+      bat.voltage = sumMv;
+      bat.current = sumMa / cells;
+      bat.soc = sumSoc / cells;
+      strncpy(bat.baseState, "Idle", sizeof(bat.baseState));
+      bat.tempr = sumMc / cells;
+    }
+  }
+  return cells;
+}
+
+// "pwrsys": corriente total del sistema ("System Curr : -3060 mA")
+static bool parsePwrsysCurrent(const char *raw, long &mA)
+{
+  PERF_SCOPE(PERF_PARSE);
+  const char *p = strstr(raw, "System Curr");
+  if (!p)
+    return false;
+  const char *colon = strchr(p, ':');
+  if (!colon)
+    return false;
+  char *end;
+  double v = strtod(colon + 1, &end);
+  if (end == colon + 1)
+    return false;
+  mA = (long)v;
+  return true;
+}
+
+#endif // BMSPARSER_H
@@ -0,0 +1,557 @@
+#ifndef BMSSCHEDULER_H
+#define BMSSCHEDULER_H
+
+#include <Arduino.h>
+#include <functional>
+
+#include "batteryStack.h"
+#include "bmsAcquisition.h"
+#include "bmsUart.h"
+#include "firmwareHealth.h"
+#include "logger.h"
+#include "perfProfiler.h"
+
+// ================== Consola del BMS: una sola línea, varios productores ==================
+//
+// La consola solo atiende un comando cada vez y la quieren la adquisición
+// periódica, /force-update, /cmd y la consola por WebSocket. Todos pasan por
+// bmsQueue, que ejecuta los comandos de uno en uno con bmsSession (sin
+// bloquear loop()) desde colas por clase:
+//   - interactive: consola por WebSocket y /cmd, alguien espera la respuesta;
+//   - telemetry:   la adquisición, un comando por paso (stackAcquisition), así
+//                  un comando interactivo espera como mucho el que esté en
+//                  curso y no la adquisición entera;
+//   - background:  lo que puede esperar o perderse.
+// Se despacha por clase, salvo que el primero de una cola haya pasado su plazo
+// (BMS_*_DEADLINE_MS): entonces va antes el que más se haya pasado, y así ni
+// la consola interactiva deja sin datos a la telemetría ni al revés. Los de
+// background que vencen en cola se descartan. Cada cola admite
+// BMS_QUEUE_DEPTH trabajos; con la cola llena submit() rechaza el comando.
+//
+// Nadie espera a un trabajo dentro de un handler: el resultado llega por sus
+// callbacks, que solo se llaman desde poll() en loop(). /cmd guarda la salida
+// para /console y la consola por WebSocket la envía línea a línea.
+
+#ifndef BMS_QUEUE_DEPTH
+#define BMS_QUEUE_DEPTH 4 // trabajos en espera por clase
+#endif
+#ifndef BMS_INTERACTIVE_DEADLINE_MS
+#define BMS_INTERACTIVE_DEADLINE_MS 1000
+#endif
+#ifndef BMS_TELEMETRY_DEADLINE_MS
+#define BMS_TELEMETRY_DEADLINE_MS 2000
+#endif
+#ifndef BMS_BACKGROUND_DEADLINE_MS
+#define BMS_BACKGROUND_DEADLINE_MS 30000
+#endif
+#define BMS_CMD_MAX 32
+
+static inline bool _isBmsPrompt(const String &s)
+{
+  return s.endsWith("pylon>") || s.endsWith("pylon_debug>");
+}
+
+// Cambia a true si tu firmware exige CRLF
+#define USE_CRLF false
+
+static void _bmsWriteCmd(const String &cmd)
+{
+#if USE_CRLF
+  bmsPort.print(cmd);
+  bmsPort.print("\r\n");
+#else
+  bmsPort.print(cmd);
+  bmsPort.print("\r");
+#endif
+}
+
+// ================== Sesión de consola no bloqueante ==================
+// Ejecuta un comando sin bloquear loop() y entrega la salida línea a línea
+// a medida que el BMS la produce. Solo la usa bmsQueue.
+struct bmsConsoleSession
+{
+  typedef std::function<void(const char *line)> LineHandler;
+  typedef std::function<void(bool ok)> DoneHandler;
+
+  enum Phase : uint8_t
+  {
+    IDLE,
+    WAKING,  // enviado "\r", esperando prompt
+    RUNNING, // comando enviado, leyendo salida
+  };
+
+  static const uint32_t WAKE_TIMEOUT_MS = 700;
+
+  Phase phase = IDLE;
+  String cmd;
+  String line;
+  unsigned long t0 = 0;
+  uint32_t timeout_ms = 0;
+  LineHandler onLine;
+  DoneHandler onDone;
+
+  bool busy() const { return phase != IDLE; }
+
+  bool begin(const String &command, uint32_t timeout, LineHandler lineCb, DoneHandler doneCb)
+  {
+    if (busy())
+      return false;
+    cmd = command;
+    timeout_ms = timeout;
+    onLine = lineCb;
+    onDone = doneCb;
+    line = "";
+    line.reserve(160);
+
+    // “Despierta” y limpia, sin esperar aquí al prompt
+    bmsPort.discardInput();
+    bmsPort.print("\r");
+    phase = WAKING;
+    t0 = millis();
+    return true;
+  }
+
+  // Avanza la sesión con lo que haya en el UART; nunca espera
+  void poll()
+  {
+    if (phase == IDLE)
+      return;
+
+    while (bmsPort.available())
+    {
+      char c = (char)bmsPort.read();
+      if (phase == WAKING)
+      {
+        line += c;
+        if (_isBmsPrompt(line))
+          startCommand();
+        continue;
+      }
+
+      if (c == '\r')
+        continue;
+      if (c == '\n')
+      {
+        emitLine();
+        continue;
+      }
+      line += c;
+      if (_isBmsPrompt(line))
+      {
+        finish(true);
+        return;
+      }
+    }
+
+    if (phase == WAKING && millis() - t0 >= WAKE_TIMEOUT_MS)
+      startCommand(); // sin prompt: se envía igualmente
+    else if (phase == RUNNING && millis() - t0 >= timeout_ms)
+      finish(false);
+  }
+
+private:
+  void startCommand()
+  {
+    bmsPort.discardInput();
+    _bmsWriteCmd(cmd);
+    line = "";
+    phase = RUNNING;
+    t0 = millis();
+  }
+
+  void emitLine()
+  {
+    if (onLine)
+      onLine(line.c_str());
+    line = "";
+  }
+
+  void finish(bool ok)
+  {
+    if (line.length() && onLine)
+      onLine(line.c_str()); // el propio prompt
+    line = "";
+    phase = IDLE;
+    DoneHandler done = onDone;
+    onLine = nullptr;
+    onDone = nullptr;
+    if (done)
+      done(ok);
+  }
+};
+
+static bmsConsoleSession bmsSession;
+
+// Cuenta el comando; si el anillo de RX se desbordó mientras llegaba su
+// respuesta, esta viene incompleta
+static void _bmsCommandDone(const char *cmd, bool gotPrompt, size_t bytes, uint32_t overrunsBefore)
+{
+  bmsPort.checkErrors();
+  bool overrun = health.uartOverruns != overrunsBefore;
+  if (overrun)
+    LOG_W(BMS, "RX overrun during '%s' (%u bytes read)", cmd, (unsigned)bytes);
+  health.bmsCommandDone(gotPrompt, bytes, overrun);
+}
+
+// ================== Cola de la consola ==================
+enum bmsPriority : uint8_t
+{
+  BMS_INTERACTIVE,
+  BMS_TELEMETRY,
+  BMS_BACKGROUND,
+  BMS_PRIORITY_COUNT
+};
+
+static const char *const _bmsPriorityNames[BMS_PRIORITY_COUNT] = {"interactive", "telemetry", "background"};
+static const uint32_t _bmsDeadlineMs[BMS_PRIORITY_COUNT] = {BMS_INTERACTIVE_DEADLINE_MS, BMS_TELEMETRY_DEADLINE_MS,
+                                                            BMS_BACKGROUND_DEADLINE_MS};
+static const bool _bmsDropLate[BMS_PRIORITY_COUNT] = {false, false, true};
+
+// Por qué submit() devolvió 0
+enum bmsReject : uint8_t
+{
+  BMS_ACCEPTED,
+  BMS_QUEUE_FULL,
+  BMS_CMD_TOO_LONG // BMS_CMD_MAX - 1 caracteres como mucho
+};
+
+struct bmsJob
+{
+  uint32_t id;
+  char cmd[BMS_CMD_MAX];
+  uint32_t timeoutMs;
+  unsigned long queuedAt;
+  bmsConsoleSession::LineHandler onLine;
+  bmsConsoleSession::DoneHandler onDone;
+};
+
+struct bmsQueueStats
+{
+  uint32_t submitted = 0;
+  uint32_t rejected = 0;  // cola llena
+  uint32_t expired = 0;   // vencidos en cola (background)
+  uint32_t late = 0;      // despachados después de su plazo
+  uint32_t completed = 0;
+  uint32_t timeouts = 0;  // sin prompt
+  uint64_t waitMsTotal = 0;
+  uint32_t waitMsMax = 0;
+  uint32_t runMsMax = 0;
+};
+
+struct bmsScheduler
+{
+  // Un anillo por clase
+  bmsJob jobs[BMS_PRIORITY_COUNT][BMS_QUEUE_DEPTH];
+  uint8_t head[BMS_PRIORITY_COUNT] = {};
+  uint8_t count[BMS_PRIORITY_COUNT] = {};
+  bmsQueueStats stats[BMS_PRIORITY_COUNT];
+  unsigned long statsResetAt = 0;
+  uint32_t nextId = 1;
+  bmsReject lastReject = BMS_ACCEPTED;
+
+  // Comando en curso
+  int8_t running = -1; // clase, -1 ninguno
+  bmsJob current;
+  unsigned long startedAt = 0;
+  size_t bytes = 0;
+  uint32_t overrunsBefore = 0;
+
+  // Encola 'cmd'; devuelve su id, o 0 si se rechaza (el motivo queda en
+  // lastReject). onDone se llama siempre que se acepta, desde poll(): false si
+  // no llegó el prompt o si venció en cola.
+  uint32_t submit(bmsPriority prio, const char *cmd, uint32_t timeoutMs, bmsConsoleSession::LineHandler onLine,
+                  bmsConsoleSession::DoneHandler onDone)
+  {
+    if (strlen(cmd) >= BMS_CMD_MAX)
+    {
+      lastReject = BMS_CMD_TOO_LONG;
+      LOG_W(BMS, "Command rejected: longer than %d characters", BMS_CMD_MAX - 1);
+      return 0;
+    }
+    if (count[prio] >= BMS_QUEUE_DEPTH)
+    {
+      lastReject = BMS_QUEUE_FULL;
+      stats[prio].rejected++;
+      LOG_W(BMS, "Queue %s full, '%s' rejected", _bmsPriorityNames[prio], cmd);
+      return 0;
+    }
+    lastReject = BMS_ACCEPTED;
+    bmsJob &j = jobs[prio][(head[prio] + count[prio]) % BMS_QUEUE_DEPTH];
+    if (nextId == 0)
+      nextId = 1; // el 0 es "rechazado"
+    j.id = nextId++;
+    strcpy(j.cmd, cmd);
+    j.timeoutMs = timeoutMs;
+    j.queuedAt = millis();
+    j.onLine = onLine;
+    j.onDone = onDone;
+    count[prio]++;
+    stats[prio].submitted++;
+    return j.id;
+  }
+
+  uint8_t queued() const
+  {
+    uint8_t n = 0;
+    for (uint8_t p = 0; p < BMS_PRIORITY_COUNT; p++)
+      n += count[p];
+    return n;
+  }
+
+  bool idle() const { return running < 0 && queued() == 0; }
+
+  // En cola o en curso
+  bool pending(uint32_t id) const
+  {
+    if (running >= 0 && current.id == id)
+      return true;
+    for (uint8_t p = 0; p < BMS_PRIORITY_COUNT; p++)
+      for (uint8_t i = 0; i < count[p]; i++)
+        if (jobs[p][(head[p] + i) % BMS_QUEUE_DEPTH].id == id)
+          return true;
+    return false;
+  }
+
+  // Llamar en cada vuelta de loop(): avanza el comando en curso y, con la
+  // consola libre, despacha el siguiente
+  void poll(unsigned long now)
+  {
+    PERF_SCOPE(PERF_BMS_SERIAL);
+    if (running >= 0)
+    {
+      bmsSession.poll();
+      if (running >= 0)
+        return;
+      now = millis(); // onDone puede haber encolado el siguiente después de 'now'
+    }
+    expire(now);
+    int8_t p = pick(now);
+    if (p >= 0)
+      dispatch((bmsPriority)p, now);
+  }
+
+  void resetStats(unsigned long now)
+  {
+    for (uint8_t p = 0; p < BMS_PRIORITY_COUNT; p++)
+      stats[p] = bmsQueueStats();
+    statsResetAt = now;
+  }
+
+private:
+  bmsJob pop(uint8_t p)
+  {
+    bmsJob j = std::move(jobs[p][head[p]]);
+    jobs[p][head[p]].onLine = nullptr;
+    jobs[p][head[p]].onDone = nullptr;
+    head[p] = (head[p] + 1) % BMS_QUEUE_DEPTH;
+    count[p]--;
+    return j;
+  }
+
+  // Los de clases que se pueden perder, si ya vencieron en cola
+  void expire(unsigned long now)
+  {
+    for (uint8_t p = 0; p < BMS_PRIORITY_COUNT; p++)
+    {
+      while (_bmsDropLate[p] && count[p] && now - jobs[p][head[p]].queuedAt > _bmsDeadlineMs[p])
+      {
+        bmsJob j = pop(p);
+        stats[p].expired++;
+        LOG_W(BMS, "'%s' expired after %lu ms in queue", j.cmd, now - j.queuedAt);
+        if (j.onDone)
+          j.onDone(false);
+      }
+    }
+  }
+
+  // El que más se haya pasado de su plazo; si ninguno, el primero de la clase más prioritaria
+  int8_t pick(unsigned long now) const
+  {
+    int8_t best = -1;
+    long bestLate = -1;
+    for (uint8_t p = 0; p < BMS_PRIORITY_COUNT; p++)
+    {
+      if (!count[p])
+        continue;
+      long late = (long)(now - jobs[p][head[p]].queuedAt) - (long)_bmsDeadlineMs[p];
+      if (late >= 0 && late > bestLate)
+      {
+        best = p;
+        bestLate = late;
+      }
+    }
+    if (best >= 0)
+      return best;
+    for (uint8_t p = 0; p < BMS_PRIORITY_COUNT; p++)
+      if (count[p])
+        return p;
+    return -1;
+  }
+
+  void dispatch(bmsPriority p, unsigned long now)
+  {
+    current = pop(p);
+    bmsQueueStats &s = stats[p];
+    uint32_t waited = now - current.queuedAt;
+    s.waitMsTotal += waited;
+    if (waited > s.waitMsMax)
+      s.waitMsMax = waited;
+    if (waited > _bmsDeadlineMs[p])
+      s.late++;
+
+    bmsPort.checkErrors();
+    overrunsBefore = health.uartOverruns;
+    bytes = 0;
+    startedAt = now;
+    running = p;
+    bmsSession.begin(current.cmd, current.timeoutMs, [this](const char *line)
+                     {
+      bytes += strlen(line) + 1;
+      if (current.onLine)
+        current.onLine(line); }, [this](bool ok)
+                     { finished(ok); });
+  }
+
+  void finished(bool ok)
+  {
+    bmsQueueStats &s = stats[running];
+    s.completed++;
+    if (!ok)
+      s.timeouts++;
+    uint32_t ran = millis() - startedAt;
+    if (ran > s.runMsMax)
+      s.runMsMax = ran;
+    _bmsCommandDone(current.cmd, ok, bytes, overrunsBefore);
+
+    // La consola queda libre antes del callback: puede encolar el siguiente paso
+    running = -1;
+    bmsConsoleSession::DoneHandler done = std::move(current.onDone);
+    current.onDone = nullptr;
+    current.onLine = nullptr;
+    if (done)
+      done(ok);
+  }
+};
+
+static bmsScheduler bmsQueue;
+
+// ================== Adquisición por la cola ==================
+// La lectura periódica como trabajos de telemetría, un comando cada vez:
+// cada salida se parsea al llegar su prompt y entonces se encola el comando
+// siguiente. onDone recibe los módulos presentes y la duración total.
+struct queuedAcquisition
+{
+  typedef std::function<void(int present, unsigned long ms)> DoneHandler;
+
+  stackAcquisition steps;
+  String out;
+  unsigned long startedAt = 0;
+  DoneHandler onDone;
+
+  bool active() const { return steps.active(); }
+
+  // Empieza una adquisición; false si ya hay una en curso
+  bool start(batteryStack &st)
+  {
+    if (active())
+      return false;
+    startedAt = millis();
+    out.reserve(BMS_UART_RX_BUFFER);
+    steps.begin(st);
+    submitNext();
+    return true;
+  }
+
+private:
+  void submitNext()
+  {
+    uint32_t timeoutMs = 0;
+    const char *cmd = steps.next(timeoutMs);
+    if (cmd)
+    {
+      out = "";
+      if (bmsQueue.submit(BMS_TELEMETRY, cmd, timeoutMs, [this](const char *line)
+                          {
+        out += line;
+        out += '\n'; }, [this](bool)
+                          { stepDone(); }))
+        return;
+      // Sin sitio en la cola: se cierra con lo leído hasta aquí
+    }
+    int present;
+    {
+      PERF_SCOPE(PERF_ACQUISITION);
+      present = steps.finish(millis());
+    }
+    if (onDone)
+      onDone(present, millis() - startedAt);
+  }
+
+  void stepDone()
+  {
+    {
+      PERF_SCOPE(PERF_ACQUISITION);
+      steps.feed(out.c_str());
+    }
+    submitNext();
+  }
+};
+
+// ---------- /bms-queue ----------
+template <typename Sink>
+void _bmsJsonCmd(textWriter<Sink> &out, const char *cmd)
+{
+  out.print("\"");
+  for (const char *c = cmd; *c; c++)
+  {
+    if (*c == '"' || *c == '\\')
+      out.printf("\\%c", *c);
+    else if ((uint8_t)*c < 0x20)
+      out.printf("\\u%04x", (uint8_t)*c);
+    else
+      out.printf("%c", *c);
+  }
+  out.print("\"");
+}
+
+template <typename Sink>
+void writeBmsQueueJson(Sink &sink, const bmsScheduler &q, unsigned long now)
+{
+  textWriter<Sink> out(sink);
+  out.printf("{\"windowMs\":%lu,\"depth\":%u,\"running\":", now - q.statsResetAt, (unsigned)BMS_QUEUE_DEPTH);
+  if (q.running >= 0)
+  {
+    out.print("{\"cmd\":");
+    _bmsJsonCmd(out, q.current.cmd);
+    out.printf(",\"class\":\"%s\",\"ms\":%lu}", _bmsPriorityNames[q.running], now - q.startedAt);
+  }
+  else
+  {
+    out.print("null");
+  }
+  out.print(",\"classes\":[");
+  for (uint8_t p = 0; p < BMS_PRIORITY_COUNT; p++)
+  {
+    const bmsQueueStats &s = q.stats[p];
+    uint32_t dispatched = s.completed + (q.running == p ? 1 : 0);
+    out.printf("%s{\"name\":\"%s\",\"deadlineMs\":%lu,\"queued\":%u,\"submitted\":%lu,\"rejected\":%lu,"
+               "\"expired\":%lu,\"late\":%lu,",
+               p ? "," : "", _bmsPriorityNames[p], (unsigned long)_bmsDeadlineMs[p], q.count[p],
+               (unsigned long)s.submitted, (unsigned long)s.rejected, (unsigned long)s.expired, (unsigned long)s.late);
+    out.printf("\"completed\":%lu,\"timeouts\":%lu,\"waitMsMean\":%lu,\"waitMsMax\":%lu,\"runMsMax\":%lu,\"jobs\":[",
+               (unsigned long)s.completed, (unsigned long)s.timeouts,
+               dispatched ? (unsigned long)(s.waitMsTotal / dispatched) : 0UL, (unsigned long)s.waitMsMax,
+               (unsigned long)s.runMsMax);
+    for (uint8_t i = 0; i < q.count[p]; i++)
+    {
+      const bmsJob &j = q.jobs[p][(q.head[p] + i) % BMS_QUEUE_DEPTH];
+      out.printf("%s{\"id\":%lu,\"cmd\":", i ? "," : "", (unsigned long)j.id);
+      _bmsJsonCmd(out, j.cmd);
+      out.printf(",\"waitMs\":%lu}", now - j.queuedAt);
+    }
+    out.print("]}");
+  }
+  out.print("]}");
+}
+
+#endif // BMSSCHEDULER_H
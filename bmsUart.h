@@ -0,0 +1,132 @@
+#ifndef BMSUART_H
+#define BMSUART_H
+
+#include <Arduino.h>
+
+#include "firmwareHealth.h"
+#include "logger.h"
+
+// ================== UART de la consola del BMS ==================
+//
+// El core ya recibe por interrupción: la ISR de la UART vacía la FIFO
+// hardware (128 bytes) en un anillo en RAM y loop() lee de ese anillo a su
+// ritmo. Por defecto el anillo es de 256 bytes, menos que un 'pwr' o un
+// 'bat N' completos, así que una vuelta de loop() lenta (flash, TLS, un
+// scrape grande) perdía el final de la respuesta. Aquí se agranda a
+// BMS_UART_RX_BUFFER antes de abrir el puerto y se lleva la cuenta de lo que
+// pasa por él:
+//   - overruns: veces que el anillo se llenó y la ISR tiró bytes (ESP8266:
+//     hasOverrun(); ESP32: UART_BUFFER_FULL_ERROR / UART_FIFO_OVF_ERROR);
+//   - rxPeak: la mayor ocupación vista, para dimensionar el anillo;
+//   - rxErrors: bytes con error de trama o paridad.
+//
+// Todo el acceso a la consola pasa por bmsPort. En el ESP32 el BMS va en
+// Serial2 con pines propios (BMS_UART_RX_PIN / BMS_UART_TX_PIN); en el
+// ESP8266 Serial2 es Serial (UART0).
+
+#ifndef BMS_UART_BAUD
+#define BMS_UART_BAUD 115200
+#endif
+#ifndef BMS_UART_RX_BUFFER
+#define BMS_UART_RX_BUFFER 2048
+#endif
+#if defined(ESP32)
+#ifndef BMS_UART_RX_PIN
+#define BMS_UART_RX_PIN 16
+#endif
+#ifndef BMS_UART_TX_PIN
+#define BMS_UART_TX_PIN 17
+#endif
+#endif
+
+#if defined(ESP32)
+// El callback de errores corre en la tarea de eventos de la UART
+static volatile uint32_t _bmsUartOverflows = 0;
+static volatile uint32_t _bmsUartRxErrors = 0;
+#endif
+
+struct bmsUart
+{
+  HardwareSerial &port;
+  uint32_t seenOverflows = 0;
+  uint32_t seenRxErrors = 0;
+
+  explicit bmsUart(HardwareSerial &p) : port(p) {}
+
+  void begin(unsigned long baud = BMS_UART_BAUD)
+  {
+    // Antes de begin(): el ESP32 solo redimensiona con el puerto cerrado
+    health.uartRxBuffer = port.setRxBufferSize(BMS_UART_RX_BUFFER);
+#if defined(ESP32)
+    port.begin(baud, SERIAL_8N1, BMS_UART_RX_PIN, BMS_UART_TX_PIN);
+    port.onReceiveError([](hardwareSerial_error_t e)
+                        {
+      if (e == UART_BUFFER_FULL_ERROR || e == UART_FIFO_OVF_ERROR)
+        _bmsUartOverflows++;
+      else
+        _bmsUartRxErrors++; });
+#else
+    port.begin(baud);
+#endif
+    LOG_I(BMS, "UART %lu baud, RX buffer %lu bytes", baud, (unsigned long)health.uartRxBuffer);
+  }
+
+  // Recoge los errores que haya anotado el driver desde la última llamada
+  void checkErrors()
+  {
+#if defined(ESP32)
+    uint32_t overflows = _bmsUartOverflows;
+    bool overrun = overflows != seenOverflows;
+    seenOverflows = overflows;
+    uint32_t errors = _bmsUartRxErrors;
+    health.uartRxErrors += errors - seenRxErrors;
+    seenRxErrors = errors;
+#else
+    bool overrun = port.hasOverrun(); // se borra al leerlo
+    if (port.hasRxError())
+      health.uartRxErrors++;
+#endif
+    if (overrun)
+    {
+      health.uartOverruns++;
+      health.uartLastOverrunMs = millis();
+    }
+  }
+
+  int available()
+  {
+    int n = port.available();
+    if ((uint32_t)n > health.uartRxPeak)
+      health.uartRxPeak = n;
+    return n;
+  }
+
+  int read()
+  {
+    int c = port.read();
+    if (c >= 0)
+      health.uartRxBytes++;
+    return c;
+  }
+
+  // Tira lo pendiente (eco, restos de un comando anterior)
+  void discardInput()
+  {
+    while (available())
+      read();
+  }
+
+  size_t print(const char *s) { return port.print(s); }
+  size_t print(const String &s) { return port.print(s); }
+
+  // Llamar en cada vuelta de loop(): detecta los desbordes aunque nadie lea
+  void poll()
+  {
+    available();
+    checkErrors();
+  }
+};
+
+static bmsUart bmsPort(Serial2);
+
+#endif // BMSUART_H
@@ -2,11 +2,16 @@
 #define COMMANDPARSER_H
 
 #include "batteryStack.h"
+#include "bmsParser.h"
+#include "bmsUart.h"
+
+// Los parsers de texto están en bmsParser.h (sin Arduino); aquí queda lo
+// que habla directamente con el UART.
 
 // Reduced timeout from 1000ms to 300ms
 void requestBatteryData(batteryStack &battStack) {
-  Serial2.print("^P003FDC\r");
-  Serial.println(">> Enviado: ^P003FDC");
+  bmsPort.print("^P003FDC\r");
+  LOG_D(BMS, ">> Enviado: ^P003FDC");
 
   unsigned long start = millis();
   String response = "";
@@ -16,9 +21,9 @@ void requestBatteryData(batteryStack &battStack) {
   bool responseComplete = false;
   
   while (millis() - start < timeout && !responseComplete) {
-    if (Serial2.available()) {
-      while (Serial2.available()) {
-        char c = Serial2.read();
+    if (bmsPort.available()) {
+      while (bmsPort.available()) {
+        char c = bmsPort.read();
         response += c;
         
         // Check if we have a complete response
@@ -33,8 +38,7 @@ void requestBatteryData(batteryStack &battStack) {
   }
 
   if (response.startsWith("^D")) {
-    Serial.println("<< Respuesta recibida:");
-    Serial.println(response);
+    LOG_D(BMS, "<< Respuesta recibida: %s", response.c_str());
 
     if (response.length() > 70) {
       int ix = 0;
@@ -50,12 +54,10 @@ void requestBatteryData(batteryStack &battStack) {
       battStack.currentDC  = bat.current;
       battStack.soc        = bat.soc;
 
-      Serial.print("SOC: "); Serial.println(battStack.soc);
-      Serial.print("Voltaje: "); Serial.println(battStack.avgVoltage);
-      Serial.print("Corriente: "); Serial.println(battStack.currentDC);
+      LOG_D(BMS, "SOC: %d, Voltaje: %ld, Corriente: %ld", battStack.soc, (long)battStack.avgVoltage, (long)battStack.currentDC);
     }
   } else {
-    Serial.println("⚠ No se recibió respuesta válida del BMS.");
+    LOG_W(BMS, "No se recibió respuesta válida del BMS");
   }
 }
 
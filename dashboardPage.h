@@ -0,0 +1,467 @@
+// Generado por tools/embed_dashboard.py a partir de web/index.html - NO EDITAR
+#ifndef DASHBOARDPAGE_H
+#define DASHBOARDPAGE_H
+
+// 24307 bytes sin comprimir, 7272 bytes gzip
+#define DASHBOARD_ETAG "\"b4d6d59ea0167a93\""
+#define DASHBOARD_HTML_GZ_LEN 7272
+
+static const uint8_t DASHBOARD_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x3c, 0xdb, 0x6e, 0xe3, 0x48,
+  0x76, 0xef, 0xfe, 0x8a, 0x6a, 0xcf, 0xf6, 0x50, 0x84, 0x28, 0xea, 0x62, 0x4b, 0xed, 0x16, 0x2d,
+  0x75, 0xba, 0x6d, 0xcf, 0x8e, 0x83, 0xbe, 0xa1, 0xed, 0xf1, 0x64, 0xd1, 0xdd, 0xbb, 0xa0, 0xc8,
+  0x92, 0xc5, 0x69, 0x8a, 0xe4, 0x90, 0x94, 0x2f, 0xe3, 0x16, 0x90, 0x87, 0x60, 0x91, 0x64, 0x11,
+  0x24, 0x99, 0x49, 0xb0, 0x41, 0x5e, 0x06, 0x13, 0x04, 0xc8, 0xd3, 0x02, 0x01, 0xe6, 0x25, 0x4f,
+  0x09, 0xb0, 0xfd, 0x27, 0xf3, 0x03, 0xd9, 0x4f, 0xc8, 0x39, 0x75, 0x21, 0x8b, 0x14, 0x29, 0xdb,
+  0xdd, 0x1d, 0x24, 0x08, 0xb2, 0x83, 0x6d, 0x4b, 0x64, 0xd5, 0x39, 0xa7, 0xce, 0xfd, 0x9c, 0xaa,
+  0xd2, 0xee, 0x9d, 0xfd, 0x67, 0x7b, 0xc7, 0xbf, 0x78, 0x7e, 0x40, 0x66, 0xe9, 0xdc, 0x1f, 0xef,
+  0xe2, 0xbf, 0xc4, 0xb7, 0x83, 0xd3, 0x91, 0x46, 0x13, 0x0d, 0xbe, 0x53, 0xdb, 0x1d, 0xef, 0xce,
+  0x69, 0x6a, 0x13, 0x67, 0x66, 0xc7, 0x09, 0x4d, 0x47, 0xda, 0x22, 0x9d, 0xb6, 0x76, 0x34, 0xf1,
+  0x34, 0xb0, 0xe7, 0x74, 0xa4, 0x9d, 0x79, 0xf4, 0x3c, 0x0a, 0xe3, 0x54, 0x23, 0x4e, 0x18, 0xa4,
+  0x34, 0x80, 0x51, 0xe7, 0x9e, 0x9b, 0xce, 0x46, 0x2e, 0x3d, 0xf3, 0x1c, 0xda, 0x62, 0x5f, 0x0c,
+  0xe2, 0x05, 0x5e, 0xea, 0xd9, 0x7e, 0x2b, 0x71, 0x6c, 0x9f, 0x8e, 0xba, 0x00, 0x23, 0xf5, 0x52,
+  0x9f, 0x8e, 0x9f, 0x5f, 0xfa, 0x38, 0xcd, 0x99, 0x91, 0x27, 0x21, 0x0c, 0x09, 0x63, 0x2f, 0x38,
+  0x25, 0xbb, 0x6d, 0xfe, 0x72, 0x37, 0x49, 0x2f, 0xe1, 0xcf, 0x24, 0x74, 0x2f, 0xaf, 0xe6, 0x76,
+  0x7c, 0xea, 0x05, 0xc3, 0x8e, 0x35, 0x85, 0xf1, 0xad, 0xa9, 0x3d, 0xf7, 0xfc, 0xcb, 0xe1, 0x21,
+  0x4c, 0x8d, 0x8d, 0xe4, 0x32, 0x49, 0xe9, 0xbc, 0xb5, 0xf0, 0x8c, 0x96, 0x1d, 0x45, 0x3e, 0x6d,
+  0xf1, 0x07, 0xc6, 0x11, 0x3d, 0x0d, 0x29, 0xf9, 0xe2, 0xd0, 0x78, 0x11, 0x4e, 0xc2, 0x34, 0x34,
+  0xbe, 0x98, 0x2c, 0x82, 0x74, 0x61, 0x7c, 0x4e, 0xfd, 0x33, 0x9a, 0x7a, 0x8e, 0x6d, 0x3c, 0x8c,
+  0x81, 0x24, 0x23, 0xb1, 0x83, 0xa4, 0x95, 0xd0, 0xd8, 0x9b, 0x5a, 0x13, 0xdb, 0x79, 0x73, 0x1a,
+  0x87, 0x8b, 0xc0, 0x1d, 0x7e, 0x32, 0xed, 0x4f, 0xef, 0x4d, 0x27, 0x96, 0x13, 0xfa, 0x61, 0x3c,
+  0xfc, 0xa4, 0x33, 0xed, 0xde, 0xeb, 0xd9, 0xcb, 0xc0, 0x3e, 0xbb, 0x52, 0x07, 0x75, 0xa8, 0xdd,
+  0xa7, 0xf7, 0xe5, 0xa0, 0xe9, 0x74, 0x6a, 0x45, 0xb6, 0xeb, 0xc2, 0x1a, 0x86, 0xdd, 0xed, 0xe8,
+  0x82, 0x74, 0x07, 0xd1, 0x85, 0xe5, 0x7a, 0x49, 0xe4, 0xdb, 0x97, 0xc3, 0xa9, 0x4f, 0x2f, 0xac,
+  0xaf, 0x16, 0x49, 0xea, 0x4d, 0x2f, 0x5b, 0x82, 0x59, 0xc3, 0x24, 0xb2, 0x81, 0x49, 0x13, 0x9a,
+  0x9e, 0x53, 0x1a, 0x58, 0xb6, 0xef, 0x9d, 0x06, 0x2d, 0x0f, 0x88, 0x4f, 0x86, 0x0e, 0xc5, 0xc5,
+  0x21, 0x46, 0x62, 0x4e, 0x62, 0x3b, 0x70, 0xaf, 0xd8, 0xca, 0xcf, 0xa9, 0x77, 0x3a, 0x4b, 0x87,
+  0x3b, 0x9d, 0x8e, 0xe5, 0xd3, 0x14, 0x46, 0xb4, 0x10, 0x04, 0x62, 0x34, 0x7b, 0xd1, 0xc5, 0x72,
+  0x6e, 0x7b, 0x01, 0xf0, 0xea, 0x82, 0xf3, 0x7d, 0xd8, 0xed, 0xf4, 0x80, 0x0e, 0x4b, 0x30, 0xaf,
+  0xbb, 0x03, 0x34, 0xd9, 0x8b, 0x34, 0xcc, 0xa8, 0xec, 0x30, 0x12, 0x97, 0xe6, 0x69, 0xec, 0xb9,
+  0x57, 0x92, 0x50, 0xfc, 0x62, 0x9d, 0xda, 0xd1, 0x90, 0x91, 0x8f, 0xdf, 0x5a, 0x40, 0x11, 0xbc,
+  0x4a, 0x29, 0xd0, 0xed, 0x2f, 0xe6, 0x41, 0x32, 0x8c, 0x69, 0x44, 0xed, 0xb4, 0x81, 0xc0, 0x5a,
+  0x53, 0x2f, 0x35, 0xe6, 0x5e, 0x00, 0x58, 0x1b, 0xbd, 0x41, 0x27, 0xba, 0x30, 0xba, 0xd3, 0x58,
+  0xd7, 0x97, 0xa6, 0x63, 0xc7, 0x6e, 0x81, 0x5b, 0xc8, 0x9f, 0x49, 0x18, 0xbb, 0x34, 0x1e, 0x76,
+  0x81, 0x92, 0x24, 0xf4, 0x3d, 0x97, 0x7c, 0x42, 0x7b, 0x74, 0x67, 0xda, 0x11, 0x2f, 0x5a, 0xb1,
+  0xed, 0x7a, 0x8b, 0x84, 0xb1, 0x0f, 0x1e, 0x5d, 0xb4, 0x92, 0x99, 0xed, 0x86, 0xe7, 0x40, 0xe8,
+  0x00, 0xf9, 0x89, 0x0b, 0x88, 0x4f, 0x27, 0x76, 0xa3, 0x67, 0x0c, 0x8c, 0xde, 0x96, 0x61, 0x76,
+  0x06, 0x7a, 0xce, 0x72, 0xb6, 0x14, 0xa6, 0x3a, 0x9c, 0x57, 0x89, 0xf7, 0x0d, 0x1d, 0x76, 0xfb,
+  0x00, 0x49, 0x65, 0xdd, 0x3d, 0x60, 0x9d, 0x10, 0xd8, 0xd6, 0xd6, 0x76, 0xb7, 0xdf, 0x97, 0xec,
+  0xe9, 0x90, 0x0e, 0xd9, 0x41, 0x10, 0x13, 0xef, 0x54, 0x01, 0xd0, 0xdb, 0x29, 0x01, 0x40, 0xde,
+  0x8b, 0x29, 0x48, 0x54, 0x87, 0x20, 0xe3, 0xcd, 0xf9, 0x22, 0xa5, 0xee, 0x95, 0x00, 0x3c, 0xd8,
+  0xbe, 0xb7, 0xbd, 0x33, 0xb1, 0x14, 0x2a, 0xb6, 0x70, 0x4c, 0x12, 0x3a, 0xe7, 0xb1, 0x1d, 0x5d,
+  0xcd, 0x38, 0x20, 0xc6, 0x5f, 0x95, 0x41, 0xd5, 0xac, 0x00, 0x96, 0x5a, 0xe1, 0x19, 0x8d, 0xa7,
+  0x3e, 0x30, 0x62, 0xe6, 0xb9, 0x2e, 0x0d, 0x18, 0xa8, 0x89, 0x1d, 0x67, 0x90, 0x3a, 0x9d, 0xbb,
+  0x16, 0x17, 0x79, 0x47, 0x85, 0xe8, 0x7b, 0x01, 0xb5, 0xe3, 0xd6, 0x29, 0x82, 0x02, 0x7d, 0x6a,
+  0xdc, 0xef, 0xb8, 0xf4, 0xd4, 0xf8, 0xa4, 0xd7, 0x73, 0xfa, 0x7d, 0x6a, 0x7c, 0xd2, 0xed, 0x4c,
+  0xee, 0xef, 0x74, 0x75, 0x2b, 0x05, 0xfd, 0x4a, 0xc0, 0x40, 0xc3, 0x60, 0xc8, 0x80, 0x10, 0x73,
+  0x90, 0x10, 0x6a, 0x27, 0x14, 0xd8, 0x49, 0x63, 0x90, 0xad, 0xed, 0x17, 0xd5, 0x7e, 0xd2, 0xed,
+  0xf5, 0x32, 0x2e, 0x56, 0x53, 0x0d, 0x4c, 0xc9, 0x25, 0xd3, 0x93, 0x2c, 0x14, 0x86, 0xbb, 0xf0,
+  0x5a, 0xf3, 0x30, 0x08, 0x99, 0xf6, 0x1b, 0x7b, 0x61, 0x00, 0xaa, 0x60, 0x27, 0x06, 0xb8, 0x00,
+  0xdb, 0x09, 0x8d, 0xec, 0x8d, 0x75, 0x3e, 0x03, 0x5b, 0x60, 0x0a, 0x4e, 0x87, 0x51, 0x4c, 0x2d,
+  0xa0, 0xa4, 0x25, 0x57, 0xdc, 0x2b, 0xb0, 0x85, 0x69, 0xb5, 0xfc, 0xd6, 0xba, 0xe0, 0xdf, 0x55,
+  0x3b, 0xe8, 0xdc, 0xcd, 0xd7, 0x42, 0x4c, 0x74, 0x6e, 0x34, 0xce, 0xa4, 0xd5, 0xb1, 0xfb, 0x53,
+  0xbb, 0x20, 0xe3, 0x49, 0xe8, 0xbb, 0x72, 0x45, 0xe0, 0x3c, 0xd2, 0x70, 0xae, 0xaa, 0x6c, 0x97,
+  0xf6, 0xee, 0x6f, 0x4d, 0xe4, 0xf2, 0xe4, 0x80, 0xdc, 0xd2, 0xe4, 0x13, 0xd4, 0x9c, 0xd2, 0x1a,
+  0x54, 0x2a, 0x5c, 0x3b, 0xb5, 0x5b, 0x71, 0x78, 0x7e, 0xb5, 0x66, 0xcc, 0x59, 0xe8, 0xa7, 0xf6,
+  0x29, 0x95, 0xa4, 0x72, 0x89, 0xa9, 0x03, 0x9c, 0x45, 0x1c, 0x83, 0x68, 0xe5, 0x80, 0x69, 0xff,
+  0x3e, 0xed, 0x4c, 0xd4, 0x01, 0x68, 0xbb, 0x34, 0xb6, 0xd3, 0x45, 0x9c, 0x41, 0xa1, 0xd3, 0x6d,
+  0xf8, 0x9f, 0x3a, 0x08, 0xd4, 0x49, 0xbe, 0xdc, 0x99, 0xf4, 0x9d, 0xe9, 0xa0, 0xf0, 0x32, 0x45,
+  0xd3, 0x0f, 0xc2, 0x78, 0x0e, 0x7a, 0x50, 0x4b, 0x08, 0x1f, 0xe5, 0xb9, 0x7e, 0x86, 0x66, 0x30,
+  0xb9, 0xd7, 0xdb, 0xe9, 0xac, 0x8e, 0xb1, 0x27, 0x89, 0x42, 0x31, 0x1f, 0x65, 0x85, 0xe8, 0xc6,
+  0xd2, 0xcb, 0x61, 0xc7, 0x2c, 0xe0, 0x0e, 0x16, 0xf3, 0x49, 0x2e, 0xa9, 0xce, 0x60, 0x32, 0x70,
+  0x8b, 0x84, 0xd3, 0xc8, 0x86, 0xc5, 0x85, 0xd9, 0x90, 0xed, 0x7b, 0xfd, 0xfe, 0xe0, 0xfe, 0x12,
+  0x45, 0xec, 0xa7, 0xb3, 0x1a, 0xaa, 0xc5, 0xcb, 0x73, 0x3b, 0x0e, 0x40, 0x80, 0x65, 0xde, 0x89,
+  0xb7, 0x4e, 0xec, 0x61, 0x98, 0xf0, 0x4b, 0x5c, 0xfb, 0x84, 0xbf, 0xde, 0x03, 0xef, 0x66, 0x0a,
+  0xe8, 0x42, 0x51, 0x7c, 0x3a, 0x4d, 0x51, 0x0b, 0x32, 0x35, 0xe1, 0xd8, 0xd4, 0x09, 0x12, 0x63,
+  0xcd, 0x0c, 0x41, 0x81, 0x3a, 0x23, 0xa3, 0xa2, 0x66, 0x8a, 0x94, 0xa5, 0x17, 0x4c, 0xc3, 0x96,
+  0x07, 0x71, 0x25, 0xf3, 0xe3, 0x5e, 0x80, 0xe6, 0xdf, 0x9a, 0xf8, 0xa1, 0xf3, 0x46, 0x2a, 0x26,
+  0x9b, 0x8d, 0x1e, 0x11, 0xd4, 0x26, 0x81, 0x45, 0xcd, 0xa8, 0x1f, 0x59, 0x45, 0x41, 0x28, 0x4e,
+  0x0b, 0x35, 0x3a, 0x0a, 0x85, 0x67, 0x88, 0x29, 0x44, 0x00, 0xef, 0x8c, 0x5a, 0x8b, 0x04, 0xa3,
+  0x0e, 0xf5, 0xa9, 0x93, 0x0e, 0x83, 0x30, 0xa0, 0x0a, 0xee, 0xe1, 0x0c, 0x6d, 0x50, 0x32, 0x6c,
+  0x6b, 0xb2, 0xd3, 0x63, 0x9a, 0x14, 0x82, 0x12, 0x7b, 0x51, 0x46, 0x18, 0x4e, 0xca, 0xe1, 0x82,
+  0x36, 0x40, 0x50, 0x49, 0xa9, 0x95, 0x86, 0xd1, 0xb0, 0x87, 0xb4, 0x71, 0x22, 0xc1, 0xa3, 0x31,
+  0xbf, 0x34, 0x05, 0x1e, 0x0f, 0xd9, 0x27, 0x8c, 0x40, 0x7f, 0xd2, 0x68, 0xc1, 0x1b, 0xbd, 0xe0,
+  0x36, 0xbb, 0x53, 0x30, 0xc7, 0x7b, 0x99, 0x3b, 0xea, 0xd3, 0x7b, 0x34, 0x33, 0x4e, 0xb4, 0x41,
+  0xc2, 0xfc, 0x4f, 0xd1, 0x3f, 0x0d, 0xa4, 0x47, 0xe2, 0x2b, 0xed, 0x95, 0x2c, 0x35, 0x08, 0xd1,
+  0x51, 0x5b, 0xdf, 0xb4, 0xbc, 0xc0, 0xa5, 0x17, 0xe8, 0x3f, 0x3a, 0xc5, 0x70, 0x84, 0x12, 0x18,
+  0xc8, 0x68, 0xd4, 0x31, 0xd8, 0x7f, 0xe6, 0x96, 0xae, 0xf8, 0x1c, 0xe0, 0xe5, 0x0a, 0x50, 0xd4,
+  0x16, 0x2b, 0xa5, 0x17, 0x69, 0x8b, 0x85, 0xfa, 0x21, 0xae, 0xd4, 0x62, 0x52, 0x92, 0x6e, 0xcd,
+  0xdc, 0x02, 0xce, 0x78, 0x18, 0xfa, 0x5b, 0xf4, 0x0c, 0xac, 0x24, 0x11, 0x2c, 0x16, 0x3c, 0x1c,
+  0x0e, 0x27, 0x14, 0x18, 0x82, 0x26, 0xc6, 0x13, 0x08, 0x4d, 0xab, 0xe1, 0x64, 0xeb, 0xa6, 0x9c,
+  0x94, 0x61, 0x43, 0x50, 0x90, 0x39, 0x72, 0xa9, 0x2a, 0x42, 0xd1, 0xd8, 0x3c, 0xb0, 0x35, 0x40,
+  0x9a, 0xb1, 0x92, 0x4d, 0x58, 0x3b, 0x44, 0x38, 0xc2, 0xbe, 0x62, 0x14, 0x4c, 0x58, 0x2b, 0x3a,
+  0x43, 0x56, 0xb4, 0x84, 0xe9, 0xed, 0xf2, 0x8f, 0xe6, 0xd4, 0xf5, 0x6c, 0xd2, 0xc8, 0xf9, 0x4a,
+  0xee, 0x0d, 0x40, 0xa6, 0xfa, 0x55, 0x1e, 0x9a, 0x14, 0x39, 0x76, 0x95, 0xa8, 0x83, 0xde, 0xb7,
+  0xc8, 0xdb, 0x1e, 0xcf, 0x8f, 0xf2, 0xec, 0x67, 0x47, 0x49, 0x8e, 0x7a, 0x22, 0x39, 0x12, 0x89,
+  0x8b, 0x1a, 0xbb, 0x96, 0x26, 0x7a, 0x69, 0x4c, 0x89, 0x76, 0xb2, 0x6c, 0xa9, 0x3a, 0x2f, 0x82,
+  0xd4, 0x67, 0x39, 0x59, 0xc0, 0x9a, 0x03, 0xf3, 0xeb, 0x85, 0xe7, 0xbc, 0x69, 0x39, 0xf3, 0x1c,
+  0x14, 0xea, 0xcc, 0x4e, 0x51, 0xef, 0xba, 0x0a, 0x01, 0x00, 0xda, 0x0b, 0xa2, 0x45, 0xfa, 0x32,
+  0xbd, 0x8c, 0xe8, 0x08, 0xb5, 0xe4, 0xf5, 0x15, 0x46, 0x3c, 0x11, 0xc2, 0xfa, 0x9d, 0xe2, 0xda,
+  0x08, 0x4b, 0x0c, 0x8a, 0xd6, 0x9a, 0xdb, 0x9a, 0xa2, 0x87, 0x6c, 0x22, 0x93, 0x66, 0x8b, 0x7d,
+  0xcc, 0x75, 0x81, 0x19, 0x62, 0x91, 0x1a, 0x41, 0xfd, 0xd5, 0x8a, 0xf9, 0x94, 0x72, 0x19, 0xce,
+  0x92, 0x42, 0x6e, 0xcb, 0x52, 0x46, 0x36, 0x14, 0xbe, 0xb5, 0xd0, 0x7e, 0x86, 0xcc, 0x88, 0x2a,
+  0xb2, 0xda, 0x95, 0x75, 0xe2, 0x94, 0x61, 0xd7, 0xca, 0x97, 0xdb, 0xeb, 0xa9, 0xcb, 0xc5, 0xa5,
+  0xaa, 0x56, 0xac, 0x06, 0x63, 0x67, 0xe2, 0xf6, 0x69, 0xb7, 0x2a, 0x69, 0x2a, 0xf1, 0xa6, 0xb4,
+  0x32, 0x0e, 0x73, 0x3b, 0x87, 0xd9, 0xa9, 0x85, 0xa1, 0x66, 0x8e, 0xdc, 0x6f, 0x0a, 0x1b, 0xb5,
+  0xd6, 0x16, 0x03, 0x52, 0x13, 0x12, 0x0a, 0x6a, 0xee, 0xda, 0xf1, 0x65, 0x31, 0x1b, 0xee, 0x42,
+  0x89, 0x71, 0xbf, 0x54, 0x60, 0x88, 0x19, 0x2e, 0xd4, 0x61, 0xe0, 0x47, 0x0b, 0xb9, 0x21, 0xf3,
+  0xf3, 0x15, 0xd0, 0xf9, 0x58, 0xe1, 0x79, 0xd5, 0x19, 0xae, 0xd3, 0x1b, 0xf4, 0x06, 0xf5, 0xea,
+  0x38, 0x90, 0x3c, 0x15, 0x0a, 0xd8, 0x2b, 0x65, 0xa3, 0xdb, 0xd3, 0xed, 0x01, 0xed, 0xab, 0xc5,
+  0x4d, 0x51, 0x07, 0x0a, 0xbc, 0x19, 0x74, 0x3a, 0x2b, 0x98, 0x2a, 0x68, 0x1a, 0x6c, 0x0d, 0x06,
+  0xd3, 0xae, 0x1c, 0x39, 0x0f, 0xdd, 0x05, 0xa4, 0x0b, 0x2b, 0xba, 0x26, 0x08, 0xda, 0x5e, 0xf1,
+  0xda, 0x3b, 0x2b, 0x8a, 0x58, 0x47, 0x04, 0x07, 0x6d, 0xda, 0x0e, 0x86, 0xac, 0x02, 0x09, 0x3c,
+  0x2a, 0x57, 0x30, 0x52, 0x4c, 0x01, 0x97, 0xb2, 0x3a, 0x49, 0xe4, 0xb8, 0xc5, 0xf4, 0x5e, 0xe8,
+  0x42, 0x10, 0xa2, 0x3b, 0x87, 0xbc, 0x93, 0xba, 0x12, 0xd4, 0x22, 0xf5, 0x7c, 0x48, 0x66, 0x5a,
+  0x93, 0x34, 0xa8, 0x5d, 0x5d, 0x99, 0xdd, 0x2b, 0x74, 0xd5, 0xe9, 0x65, 0x45, 0xe8, 0x2a, 0x31,
+  0xa1, 0xa4, 0xa5, 0x15, 0x54, 0x55, 0x88, 0xa6, 0xd3, 0xbf, 0x3f, 0x80, 0xc4, 0x69, 0x75, 0x6c,
+  0xbd, 0x36, 0xd6, 0x0f, 0xae, 0x57, 0x47, 0xc1, 0x66, 0x91, 0x40, 0x40, 0xde, 0x56, 0x4c, 0x99,
+  0x59, 0x4d, 0xa4, 0x56, 0x74, 0xd6, 0xfb, 0x56, 0x90, 0xbc, 0x2a, 0xe3, 0xc8, 0x94, 0xa2, 0x50,
+  0xb1, 0xe5, 0x12, 0x66, 0x64, 0x64, 0xa1, 0x30, 0x5c, 0xda, 0x26, 0xc4, 0x8f, 0x37, 0x59, 0xf2,
+  0xc9, 0xed, 0x9b, 0x85, 0x6f, 0x17, 0x4c, 0x1a, 0xd2, 0x4e, 0x8c, 0xba, 0xb9, 0x13, 0xcd, 0x41,
+  0x2f, 0xcd, 0x69, 0x18, 0xa6, 0xb2, 0x69, 0xd1, 0xc3, 0xd0, 0x92, 0x29, 0xcf, 0xfd, 0x6d, 0x1b,
+  0x12, 0xa3, 0x92, 0x04, 0x97, 0xbb, 0x6d, 0xde, 0xec, 0xd8, 0x6d, 0xf3, 0xc6, 0x0b, 0x36, 0x3d,
+  0xc6, 0xbb, 0x50, 0xfd, 0x8f, 0x77, 0x5d, 0xef, 0x8c, 0x38, 0x50, 0x1f, 0x25, 0x23, 0x8d, 0x35,
+  0x02, 0xb4, 0xca, 0xae, 0xc9, 0x6e, 0x1b, 0xc6, 0xb1, 0xc1, 0xe3, 0x5d, 0x5b, 0x8e, 0x47, 0xf2,
+  0x35, 0x32, 0x8b, 0xe9, 0x74, 0xa4, 0xb5, 0x27, 0x36, 0xf6, 0x0b, 0x2e, 0x5b, 0x58, 0x76, 0x68,
+  0xe3, 0xc2, 0xd7, 0xdd, 0xb6, 0x3d, 0x16, 0x00, 0xda, 0x0c, 0x27, 0xc6, 0xc9, 0x02, 0xe6, 0x92,
+  0xd4, 0xb4, 0xaa, 0x97, 0x8c, 0xcb, 0xda, 0xf8, 0x08, 0xc7, 0x38, 0xc0, 0x1a, 0x3b, 0x26, 0x8f,
+  0x20, 0x38, 0xc6, 0xef, 0x7e, 0x67, 0x0f, 0x73, 0xf2, 0x88, 0xe7, 0xca, 0x19, 0x8f, 0x98, 0xfa,
+  0x60, 0xb7, 0x89, 0x2b, 0x52, 0x11, 0x1e, 0xe1, 0x76, 0xa8, 0x91, 0x30, 0x70, 0x7c, 0x70, 0x29,
+  0x23, 0x8d, 0x63, 0x7f, 0xc2, 0xde, 0x36, 0x36, 0x79, 0x9b, 0x67, 0x53, 0x07, 0x8c, 0x1e, 0x7e,
+  0x82, 0x55, 0x70, 0x30, 0xd5, 0xe0, 0xea, 0xe0, 0x74, 0x01, 0x00, 0x90, 0x49, 0xba, 0xeb, 0xa7,
+  0x13, 0xe9, 0x17, 0xea, 0xe0, 0xf4, 0x04, 0x9c, 0xde, 0x07, 0xc2, 0xd9, 0x12, 0x70, 0xb6, 0x3e,
+  0x10, 0xce, 0xb6, 0x80, 0xb3, 0x9d, 0xc3, 0x11, 0x12, 0xce, 0x24, 0x21, 0x00, 0x62, 0x2a, 0x53,
+  0x14, 0x28, 0x66, 0x40, 0x1a, 0x61, 0x1a, 0xc9, 0x5f, 0x8b, 0x04, 0x67, 0xd8, 0x6d, 0xb7, 0xba,
+  0x6a, 0x02, 0xcb, 0xe3, 0x79, 0xd1, 0x46, 0x77, 0xa6, 0xf6, 0xd4, 0x29, 0xc2, 0xe3, 0x9a, 0xa1,
+  0x48, 0xfe, 0x98, 0xab, 0xca, 0x3e, 0x54, 0x6e, 0x09, 0x71, 0xa9, 0x4f, 0x84, 0x08, 0xc9, 0xcf,
+  0x69, 0x00, 0xc5, 0xaa, 0x5f, 0x47, 0x2a, 0x23, 0xac, 0x02, 0xf4, 0xf8, 0x00, 0x4a, 0x4b, 0x37,
+  0x04, 0x50, 0x04, 0x86, 0x9c, 0xda, 0xab, 0x33, 0x27, 0xde, 0x29, 0x4c, 0x84, 0xf4, 0x34, 0x60,
+  0x64, 0x40, 0xc1, 0x7b, 0xa6, 0x8d, 0x5b, 0x2d, 0xb0, 0x3b, 0x78, 0x34, 0xbe, 0xbb, 0x3a, 0x41,
+  0x34, 0x6b, 0xb4, 0x5c, 0x69, 0x79, 0xcf, 0x45, 0x53, 0x06, 0xe0, 0xd7, 0x5a, 0xb6, 0xb2, 0x8e,
+  0x50, 0xc6, 0x45, 0xe1, 0x6c, 0x30, 0x35, 0x87, 0x48, 0xa0, 0x8d, 0x1f, 0x3a, 0xe9, 0x02, 0x78,
+  0xf8, 0x0d, 0x52, 0xed, 0xd8, 0xae, 0x4d, 0xb6, 0x48, 0x72, 0xeb, 0x55, 0x9f, 0x60, 0x77, 0xe0,
+  0x2b, 0x7a, 0xed, 0x6a, 0xb1, 0x8b, 0xa0, 0xac, 0x96, 0x9c, 0xd4, 0x52, 0x2b, 0x47, 0xef, 0xd3,
+  0xc4, 0xc9, 0x0c, 0x8b, 0xa4, 0x61, 0xfa, 0x1e, 0x32, 0xd9, 0x0b, 0xe3, 0x18, 0xdb, 0x4e, 0xd7,
+  0xd3, 0x87, 0x4d, 0x0c, 0x95, 0xbe, 0x87, 0x6b, 0xe9, 0xc3, 0xd1, 0x1f, 0x83, 0xbe, 0xe7, 0x21,
+  0x94, 0x50, 0x0e, 0x54, 0x17, 0xfb, 0x7b, 0xd7, 0x52, 0x18, 0x41, 0x41, 0xa8, 0x52, 0xf8, 0x65,
+  0x1d, 0x85, 0xe3, 0x13, 0xf2, 0xee, 0xb7, 0xe4, 0xf0, 0xd6, 0xc4, 0x1c, 0x67, 0x6d, 0x9a, 0xeb,
+  0x95, 0x17, 0xcb, 0x0e, 0x95, 0x98, 0xdf, 0xff, 0xeb, 0xde, 0x5a, 0x86, 0xe1, 0x78, 0xce, 0xb0,
+  0xe7, 0x71, 0x88, 0x05, 0x55, 0x48, 0x12, 0xe9, 0x32, 0xd7, 0x90, 0xc9, 0xe6, 0xe6, 0xad, 0x88,
+  0x4a, 0xb2, 0x8f, 0x6c, 0x7f, 0xe1, 0x92, 0x3d, 0xea, 0xbb, 0x76, 0xc2, 0x09, 0x14, 0xef, 0xb3,
+  0xfa, 0x4e, 0x05, 0x73, 0x08, 0x0f, 0xb5, 0xf1, 0x4f, 0xdf, 0xfd, 0x43, 0x01, 0x12, 0x2f, 0x59,
+  0xd4, 0x71, 0xc7, 0xe2, 0xd1, 0x78, 0x0f, 0x8d, 0x39, 0x00, 0x13, 0x41, 0x70, 0x50, 0x3d, 0x3b,
+  0xde, 0xbb, 0x1f, 0x03, 0xd3, 0x34, 0x25, 0xdd, 0x6c, 0xfd, 0xd7, 0xf2, 0x6b, 0x62, 0xfb, 0x76,
+  0xe0, 0xd0, 0xa3, 0x14, 0xd8, 0x9b, 0x28, 0x8c, 0x5b, 0xcb, 0x34, 0x31, 0x69, 0x9f, 0xa6, 0xb6,
+  0xe7, 0xc3, 0xac, 0x87, 0x01, 0x33, 0x57, 0x20, 0x26, 0xc7, 0x8f, 0x33, 0x85, 0x7d, 0x2b, 0xf1,
+  0xbc, 0x93, 0x27, 0x12, 0xa2, 0xa7, 0x52, 0x34, 0xfe, 0x72, 0x55, 0xaa, 0x8d, 0x9f, 0xb2, 0xce,
+  0xc0, 0x90, 0xfc, 0xf4, 0x17, 0xff, 0xbc, 0xdd, 0x99, 0x9f, 0x90, 0xb7, 0xe4, 0xa1, 0x0b, 0xf9,
+  0x13, 0x57, 0xcf, 0x21, 0xd9, 0xee, 0xb4, 0x06, 0xfc, 0xf1, 0x1e, 0x04, 0xd3, 0x14, 0xb8, 0x3a,
+  0x24, 0x63, 0x7c, 0x52, 0x10, 0x5f, 0x8d, 0x10, 0x57, 0xfd, 0x4f, 0x97, 0x39, 0xa0, 0x0a, 0x61,
+  0x7e, 0x0e, 0x4a, 0xf1, 0xee, 0xc7, 0x18, 0xe0, 0xa3, 0x23, 0x7d, 0xc4, 0x19, 0x40, 0xf6, 0x3d,
+  0x3b, 0xf6, 0xc2, 0x52, 0x10, 0xca, 0x6a, 0x9a, 0x0c, 0xc1, 0xd4, 0x0f, 0xed, 0x74, 0xc8, 0x7a,
+  0x02, 0xd6, 0x9a, 0x8a, 0x17, 0x92, 0x1d, 0x25, 0x62, 0xa5, 0xe1, 0xe9, 0xa9, 0x4f, 0x11, 0x6f,
+  0x18, 0x5f, 0x36, 0x20, 0x62, 0x3d, 0x09, 0x13, 0xa8, 0x4f, 0xe3, 0xf6, 0x33, 0x67, 0x01, 0xae,
+  0x2d, 0x2e, 0xc7, 0x2e, 0xe9, 0x8a, 0x67, 0x7c, 0xc6, 0x11, 0x84, 0x3b, 0x0f, 0x55, 0x4c, 0xd0,
+  0xa0, 0x76, 0x98, 0x8a, 0x2b, 0x84, 0x6a, 0xb5, 0xcc, 0x0a, 0x99, 0xf7, 0x75, 0xca, 0x9b, 0x34,
+  0xab, 0x05, 0x2b, 0xaf, 0x6d, 0x3b, 0x8c, 0x6d, 0x3c, 0xc8, 0x0a, 0x15, 0x61, 0x29, 0xd4, 0x67,
+  0x9e, 0x0f, 0x7f, 0x32, 0xf0, 0x4a, 0x7d, 0x05, 0xc3, 0xc3, 0x08, 0x29, 0x24, 0x67, 0x60, 0x27,
+  0xf0, 0x0e, 0xea, 0x04, 0x30, 0xf5, 0x10, 0x8c, 0x85, 0x00, 0x5d, 0x64, 0x22, 0xd2, 0x23, 0xf0,
+  0xfc, 0x7c, 0x1c, 0xaa, 0x34, 0x83, 0x9f, 0x05, 0xfd, 0x8c, 0x55, 0x90, 0xc4, 0xc5, 0x34, 0x99,
+  0x29, 0xbc, 0xca, 0x42, 0x48, 0x5c, 0x97, 0x2a, 0x28, 0x52, 0xca, 0xe0, 0xd0, 0x0b, 0xdc, 0xaf,
+  0x53, 0xc0, 0x1c, 0xb0, 0x07, 0x90, 0xac, 0xed, 0x1d, 0x9d, 0xd4, 0x01, 0xe2, 0x59, 0xbd, 0x02,
+  0xc5, 0xf1, 0xa9, 0x1d, 0x2b, 0x40, 0x4e, 0xc0, 0x34, 0x01, 0x04, 0x7f, 0xe2, 0xa1, 0x33, 0x5e,
+  0x15, 0x5c, 0xc6, 0xfe, 0x0b, 0xa9, 0xfc, 0x5b, 0x1d, 0xb5, 0x8b, 0xdf, 0xba, 0x64, 0x7d, 0x7b,
+  0xdc, 0x1c, 0xb4, 0x27, 0x98, 0xe1, 0xe4, 0x82, 0x3e, 0xc6, 0x07, 0x19, 0x87, 0xf3, 0xa6, 0xbe,
+  0x4c, 0xfa, 0xc1, 0xdc, 0x7c, 0x3b, 0x4a, 0xe8, 0x50, 0x7e, 0x28, 0xab, 0x1c, 0xc0, 0xc4, 0xc4,
+  0x5a, 0x42, 0x58, 0x4d, 0x58, 0xf2, 0x36, 0x5a, 0x02, 0x06, 0xf6, 0xe6, 0x92, 0x35, 0xd1, 0x3a,
+  0x38, 0x2f, 0xc6, 0xb9, 0x65, 0xe1, 0xee, 0x54, 0xf6, 0x22, 0x78, 0x25, 0x02, 0x86, 0x14, 0xa2,
+  0x17, 0x4f, 0x67, 0xb7, 0x9f, 0x29, 0x13, 0xe6, 0xf7, 0x9d, 0xcd, 0x4d, 0xb6, 0x31, 0x3f, 0xd1,
+  0xdf, 0x0f, 0xc2, 0xd1, 0xb3, 0x3d, 0xd2, 0xb8, 0xfb, 0x9e, 0x93, 0x79, 0x12, 0xc6, 0xe7, 0xb6,
+  0x91, 0x6f, 0xed, 0x94, 0x57, 0x33, 0x29, 0x96, 0x33, 0xaa, 0x3c, 0x1f, 0xc1, 0x77, 0xc9, 0x5b,
+  0x97, 0x80, 0xd0, 0xd0, 0x1f, 0x8f, 0xb4, 0x7e, 0x26, 0xe2, 0xd5, 0x1c, 0x53, 0x92, 0xd0, 0x5b,
+  0x71, 0xaf, 0x4a, 0x98, 0x98, 0x65, 0x1e, 0x8c, 0x39, 0xe9, 0xd4, 0xcd, 0x08, 0xe1, 0x05, 0x55,
+  0x9b, 0x69, 0x56, 0xa5, 0x52, 0xe6, 0xee, 0xb1, 0xb3, 0xda, 0xa3, 0x2b, 0xe1, 0x7b, 0x41, 0x4f,
+  0x01, 0x51, 0x0c, 0xb9, 0x2b, 0x4b, 0xdd, 0xba, 0x7d, 0x32, 0xf7, 0x82, 0x05, 0xe6, 0xb2, 0x3f,
+  0xfd, 0xe9, 0x3f, 0x91, 0x27, 0xef, 0x7e, 0xb8, 0xf0, 0xe6, 0x21, 0xb9, 0x3f, 0x20, 0x40, 0x3a,
+  0xd4, 0xa3, 0x60, 0xe9, 0x8d, 0xde, 0x36, 0x99, 0x81, 0x56, 0x24, 0xfa, 0x47, 0xf6, 0xd9, 0xc7,
+  0x72, 0x2b, 0xe4, 0xd1, 0x93, 0x23, 0xa2, 0xe4, 0xb7, 0x4e, 0x0c, 0x96, 0xd0, 0x9a, 0x79, 0x41,
+  0xaa, 0x55, 0x84, 0xa8, 0x95, 0x35, 0x59, 0x45, 0xd7, 0xf9, 0xd3, 0xaf, 0xff, 0x86, 0x40, 0xc6,
+  0x80, 0xce, 0x05, 0xc9, 0xf6, 0xbe, 0x81, 0xa9, 0xb6, 0x3f, 0x47, 0x49, 0x90, 0x9f, 0x7e, 0xfd,
+  0x6d, 0x6d, 0xfc, 0x5c, 0xef, 0x66, 0x57, 0x0a, 0xbd, 0xac, 0x55, 0xa4, 0x78, 0x16, 0xf6, 0x6c,
+  0x6f, 0xee, 0x36, 0x36, 0xa3, 0xf3, 0x18, 0xab, 0x3b, 0xf8, 0x53, 0xe7, 0x96, 0xae, 0x9d, 0x0f,
+  0x35, 0xa2, 0x00, 0x01, 0x9f, 0x6e, 0x00, 0x45, 0x78, 0xf5, 0xbd, 0x4a, 0x88, 0x60, 0x9b, 0xe8,
+  0xea, 0xe0, 0xfd, 0xfb, 0xd1, 0x83, 0x9b, 0x2d, 0x48, 0x0d, 0xfe, 0xad, 0xf2, 0x8f, 0x0a, 0x0f,
+  0xc7, 0xbb, 0xac, 0x45, 0xca, 0xd3, 0x5d, 0x04, 0xc7, 0x7a, 0xa5, 0xcc, 0x2a, 0x34, 0x02, 0x72,
+  0x72, 0xe8, 0x2c, 0xf4, 0xc1, 0x0a, 0x47, 0xda, 0xc1, 0x57, 0x43, 0x82, 0x00, 0x0d, 0x0c, 0x26,
+  0x06, 0xe1, 0x2b, 0x65, 0x7f, 0xb5, 0xd5, 0x18, 0x92, 0xd0, 0xc0, 0x45, 0x52, 0xd0, 0xeb, 0x07,
+  0x67, 0xde, 0xed, 0x02, 0x07, 0x73, 0xf9, 0x7c, 0xb3, 0x96, 0x22, 0x84, 0xc7, 0xde, 0x3c, 0xf2,
+  0xea, 0x43, 0xb4, 0xc3, 0x47, 0x66, 0xe5, 0x92, 0x6c, 0xd7, 0x6b, 0x1f, 0x4f, 0xf7, 0xbf, 0xc0,
+  0xbe, 0x93, 0x6b, 0xbb, 0x34, 0x21, 0x97, 0xa0, 0xae, 0x93, 0xc5, 0x69, 0xf2, 0xdf, 0x99, 0xa6,
+  0x30, 0x74, 0xa9, 0x47, 0x93, 0x5b, 0x24, 0x2a, 0x0b, 0x39, 0xe7, 0x06, 0xa9, 0x4a, 0xb5, 0xdd,
+  0xf4, 0xd9, 0xe2, 0x67, 0xdb, 0xc5, 0xd7, 0xf2, 0xb4, 0x02, 0x59, 0xd9, 0xb0, 0x93, 0x2d, 0xac,
+  0x7b, 0xdb, 0xdd, 0x7e, 0x57, 0x1b, 0xff, 0xe1, 0xfb, 0xbf, 0xfb, 0x17, 0x92, 0x35, 0x48, 0x66,
+  0xdb, 0x05, 0x54, 0x85, 0xb4, 0xa7, 0xd4, 0xb6, 0x17, 0xdb, 0x1d, 0x56, 0x25, 0x39, 0x45, 0x2e,
+  0x2b, 0xfd, 0x3f, 0x85, 0x69, 0x61, 0x44, 0x03, 0xce, 0xb2, 0xcb, 0xc6, 0x66, 0x1b, 0x72, 0x17,
+  0x60, 0x53, 0x8a, 0xfa, 0x0f, 0x24, 0xfd, 0x19, 0x79, 0x41, 0xbd, 0xc0, 0x63, 0x39, 0xc3, 0xc1,
+  0xd1, 0xf3, 0x3a, 0x35, 0xbc, 0x09, 0xe0, 0xd4, 0x9b, 0xd3, 0x16, 0x96, 0x07, 0x1c, 0xf4, 0xdf,
+  0x7f, 0x4b, 0xb0, 0xca, 0x20, 0xc7, 0x1e, 0x14, 0x3d, 0xe1, 0x87, 0x00, 0x86, 0xac, 0x24, 0x01,
+  0x89, 0xb5, 0x9c, 0x19, 0x75, 0xde, 0x70, 0xe0, 0xdf, 0xfd, 0x86, 0x9c, 0xe0, 0x53, 0x28, 0x42,
+  0xca, 0x02, 0xff, 0x10, 0x01, 0xfd, 0x95, 0x54, 0xde, 0xff, 0x41, 0xf9, 0xb8, 0x48, 0x41, 0x8b,
+  0x67, 0xb4, 0xa0, 0xae, 0x42, 0x4e, 0xbf, 0xe1, 0x94, 0x65, 0x7d, 0xbc, 0xe4, 0x43, 0x18, 0xca,
+  0x51, 0x88, 0x0c, 0x40, 0x30, 0xf4, 0x2f, 0x05, 0x82, 0x8a, 0xc4, 0xf1, 0xf6, 0x08, 0xd4, 0x96,
+  0xa6, 0x80, 0xff, 0xe7, 0x84, 0xf7, 0x98, 0x20, 0x3a, 0x7e, 0x34, 0x89, 0xfd, 0xf4, 0x8f, 0x3f,
+  0x90, 0x87, 0xac, 0xc3, 0x49, 0xdf, 0x4b, 0x64, 0x37, 0x94, 0x0f, 0x14, 0xbc, 0x0e, 0x7d, 0x81,
+  0x8d, 0x66, 0xe6, 0xb0, 0xff, 0xf0, 0xfd, 0xb7, 0xff, 0x4e, 0x7e, 0x1e, 0xdb, 0x13, 0x30, 0x99,
+  0x87, 0x33, 0x96, 0x60, 0x5e, 0xcb, 0x29, 0xb2, 0x9a, 0xb7, 0x87, 0xc1, 0xd4, 0x8b, 0xe7, 0x7b,
+  0xa5, 0xf4, 0xfd, 0x0f, 0xdf, 0xff, 0xf6, 0x6f, 0xff, 0xf3, 0xdf, 0xfe, 0x9a, 0xd4, 0xa7, 0xf1,
+  0xef, 0x23, 0x0d, 0x96, 0x8c, 0x96, 0x04, 0xce, 0x2c, 0x88, 0xfc, 0xf1, 0xd1, 0xb3, 0xa7, 0xf5,
+  0xc5, 0x42, 0x95, 0x0b, 0xbd, 0x7c, 0x41, 0x13, 0xf0, 0xb4, 0x95, 0xf1, 0xa1, 0x5f, 0xda, 0x2a,
+  0xac, 0xe8, 0x47, 0xde, 0x74, 0xdb, 0x60, 0x47, 0x29, 0x06, 0x85, 0x6b, 0x8e, 0x62, 0xaa, 0xd2,
+  0xb1, 0xc7, 0x77, 0xde, 0xb5, 0xb2, 0xf2, 0xac, 0x3b, 0x4e, 0x00, 0x20, 0x5a, 0xa2, 0x99, 0xd8,
+  0x86, 0xcf, 0xe3, 0xf5, 0x39, 0x20, 0xee, 0x1d, 0x68, 0xe3, 0xfd, 0x83, 0x13, 0xf2, 0xe8, 0x17,
+  0x10, 0xdc, 0xd3, 0x34, 0x4a, 0x86, 0xed, 0xf6, 0xa9, 0x97, 0xce, 0x16, 0x13, 0xd3, 0x09, 0xe7,
+  0xed, 0x59, 0x0b, 0xab, 0xa5, 0x19, 0xc4, 0xb0, 0x76, 0x24, 0xb7, 0x02, 0xf0, 0x40, 0x55, 0x71,
+  0x2b, 0x00, 0x52, 0x40, 0x2f, 0x4a, 0xc7, 0x1b, 0x3e, 0x4d, 0x89, 0x38, 0x25, 0xc4, 0x5b, 0xc3,
+  0x10, 0x16, 0x59, 0xeb, 0x5c, 0xb3, 0x36, 0xa6, 0x8b, 0x80, 0x85, 0x25, 0x32, 0x9d, 0xa7, 0x8d,
+  0xc0, 0x70, 0xa9, 0xa3, 0x5f, 0x79, 0xd3, 0x86, 0x97, 0x3c, 0xb5, 0x9f, 0x36, 0x02, 0x5d, 0x8f,
+  0x69, 0xba, 0x88, 0x03, 0xad, 0xd5, 0xd2, 0x2c, 0xfe, 0x91, 0x3c, 0x65, 0x07, 0x72, 0xe0, 0x9d,
+  0x99, 0x86, 0x9f, 0x79, 0x17, 0xd4, 0x6d, 0xe0, 0xa4, 0x65, 0x0e, 0xa9, 0xd0, 0x84, 0xe6, 0xdd,
+  0x5e, 0xfd, 0x6a, 0xa3, 0x48, 0x00, 0x7f, 0x6c, 0x6d, 0xb8, 0xa1, 0xb3, 0xc0, 0xa4, 0xd2, 0xfc,
+  0x7a, 0x41, 0xb1, 0x9a, 0xe7, 0x9b, 0x0b, 0x0f, 0x7d, 0xbf, 0xa1, 0x89, 0xad, 0x1b, 0x4d, 0x37,
+  0xc1, 0x0e, 0x0e, 0x6c, 0x67, 0xd6, 0x98, 0x8c, 0xc6, 0xb0, 0x7c, 0x64, 0xd1, 0x63, 0x50, 0x1c,
+  0x33, 0xa6, 0x73, 0x28, 0x1c, 0x1b, 0x9a, 0xe8, 0x82, 0xeb, 0xba, 0xb5, 0xc1, 0x4e, 0x4c, 0x98,
+  0x10, 0x66, 0x4e, 0x69, 0xaa, 0x8c, 0x04, 0xcd, 0xc8, 0x87, 0x59, 0x1b, 0x8b, 0x08, 0xfc, 0x03,
+  0x05, 0x8f, 0xc6, 0xb7, 0x1f, 0x1a, 0xf0, 0x08, 0x96, 0xcc, 0xd1, 0x8d, 0x46, 0x19, 0x73, 0x80,
+  0xe8, 0x8c, 0x3c, 0x80, 0x77, 0xe0, 0x53, 0xfc, 0xf8, 0xe8, 0xf2, 0x10, 0x80, 0xa9, 0x4d, 0x6c,
+  0x60, 0x04, 0x64, 0x65, 0x7b, 0xf2, 0xf4, 0x6b, 0x6d, 0x4b, 0x5b, 0xb3, 0xea, 0xe1, 0x65, 0x1d,
+  0xd7, 0x12, 0xb0, 0x42, 0x7f, 0x73, 0x1d, 0x80, 0xac, 0x25, 0xfa, 0xbe, 0x00, 0xb2, 0x16, 0x61,
+  0x09, 0x40, 0xb9, 0x61, 0x08, 0x30, 0x96, 0xd4, 0x4f, 0xe8, 0x87, 0x31, 0x27, 0x8b, 0x27, 0x44,
+  0x6b, 0xae, 0xe8, 0xc2, 0x4d, 0x99, 0x93, 0xc1, 0xf0, 0x02, 0xd0, 0x77, 0xcf, 0x5d, 0xbc, 0x1f,
+  0x8b, 0x6e, 0x09, 0xa6, 0x8e, 0x51, 0xd5, 0x60, 0x96, 0xa8, 0x5a, 0x49, 0x60, 0x47, 0x7a, 0x64,
+  0x43, 0x29, 0xd6, 0xc0, 0xe3, 0xd2, 0xcf, 0xf8, 0x13, 0x43, 0xd8, 0x86, 0x6e, 0x21, 0x3f, 0x49,
+  0xb4, 0x00, 0xad, 0xd7, 0x71, 0x46, 0x66, 0x49, 0xc2, 0x81, 0xc2, 0xf8, 0xf9, 0x99, 0xe1, 0x50,
+  0xdf, 0x4f, 0x40, 0x27, 0x01, 0xde, 0x1d, 0xfe, 0x99, 0x1b, 0xe4, 0x4b, 0xed, 0x69, 0xfb, 0xa1,
+  0x66, 0x80, 0xa4, 0xd1, 0xdb, 0x03, 0x7b, 0xb5, 0xd7, 0x5c, 0x9f, 0xcf, 0x76, 0x47, 0xdb, 0x9d,
+  0x7c, 0x10, 0xeb, 0x30, 0xc2, 0x38, 0xd9, 0x22, 0x78, 0xf7, 0x63, 0x94, 0x62, 0x91, 0xda, 0x00,
+  0x09, 0x9c, 0x35, 0xb5, 0xf9, 0x89, 0xae, 0x4c, 0x1c, 0xe4, 0x13, 0x95, 0x46, 0x24, 0xcc, 0x86,
+  0x95, 0x53, 0x28, 0x68, 0x7c, 0x6f, 0x12, 0x83, 0x4e, 0xc0, 0x0a, 0x40, 0xb3, 0xdd, 0x32, 0x10,
+  0x39, 0x55, 0x36, 0x2b, 0x57, 0xe6, 0xd9, 0x7e, 0x5a, 0x9e, 0xa3, 0x2c, 0x5b, 0xf2, 0xc8, 0xc8,
+  0x9d, 0x07, 0x94, 0x12, 0x29, 0xb9, 0x18, 0xad, 0xd8, 0xe8, 0x83, 0x04, 0x8f, 0x14, 0x3a, 0x6f,
+  0x86, 0x89, 0x70, 0x17, 0x89, 0x39, 0x05, 0xfe, 0x37, 0xe6, 0xa3, 0xf1, 0xdc, 0x04, 0x9f, 0x2d,
+  0x66, 0x70, 0x0b, 0xbf, 0x73, 0x21, 0x16, 0x75, 0x95, 0x84, 0xce, 0xb0, 0x63, 0x88, 0xa3, 0x95,
+  0xf0, 0x49, 0x38, 0x27, 0xf8, 0x14, 0x85, 0xe7, 0xb8, 0xe3, 0x6e, 0x28, 0x87, 0x26, 0x87, 0x9d,
+  0xa5, 0x25, 0x28, 0x98, 0x8c, 0x72, 0x91, 0x5c, 0x98, 0xde, 0x5c, 0x7c, 0x7b, 0x72, 0x66, 0x5c,
+  0x98, 0x28, 0x93, 0x3d, 0x88, 0x38, 0xa9, 0x2e, 0x19, 0xc0, 0xd0, 0x5c, 0xe0, 0xd1, 0xca, 0x0c,
+  0xd5, 0x85, 0x3c, 0xcf, 0x99, 0xa1, 0xbc, 0x90, 0x07, 0x38, 0x05, 0xea, 0x0b, 0x93, 0xfd, 0x2d,
+  0x10, 0x70, 0xa1, 0x9e, 0xe1, 0x34, 0x36, 0x0a, 0xdd, 0xec, 0xe1, 0xe4, 0x65, 0xe7, 0xb5, 0x21,
+  0x09, 0xa1, 0x49, 0x82, 0x68, 0x26, 0x2f, 0xbb, 0xaf, 0x0d, 0x85, 0xbc, 0x61, 0x91, 0xd8, 0x8c,
+  0xd4, 0xa1, 0x42, 0xb6, 0xb1, 0x31, 0xb7, 0x2f, 0xf6, 0xe0, 0xdb, 0x49, 0x46, 0xab, 0x78, 0xf0,
+  0x20, 0xfb, 0x64, 0xe6, 0x2c, 0x83, 0x52, 0xae, 0x34, 0x98, 0x3f, 0x78, 0x90, 0x7d, 0x52, 0x06,
+  0x4b, 0xd0, 0x87, 0x6e, 0x25, 0x54, 0xa4, 0x21, 0x07, 0xc9, 0x07, 0xad, 0x40, 0xe3, 0x83, 0x96,
+  0x05, 0x4d, 0xe1, 0x36, 0xe5, 0xae, 0xf3, 0xd4, 0x6c, 0x9f, 0xaf, 0x68, 0xaa, 0x2e, 0x8a, 0xc4,
+  0x5a, 0x3b, 0x05, 0xf7, 0xf5, 0x74, 0x93, 0x05, 0x78, 0x53, 0x5c, 0x67, 0xc0, 0x49, 0x4d, 0xed,
+  0xee, 0x75, 0x5e, 0xbc, 0x84, 0x0b, 0xc3, 0xaa, 0x9b, 0x09, 0x7d, 0x4b, 0xbf, 0xc6, 0x3f, 0x55,
+  0xce, 0x96, 0x0a, 0xb2, 0x76, 0x36, 0xdb, 0x9f, 0xaa, 0x9a, 0xcd, 0xd5, 0xa9, 0xab, 0x5f, 0xe3,
+  0xd2, 0x2a, 0xe7, 0xaa, 0x6a, 0xd7, 0xe5, 0x46, 0xe4, 0x9a, 0x05, 0xf5, 0xfb, 0xf4, 0xd3, 0xd2,
+  0x83, 0x3b, 0x60, 0x9c, 0xe8, 0x90, 0x32, 0xab, 0x4d, 0xd8, 0xe3, 0x03, 0x7f, 0x54, 0x8b, 0xbe,
+  0xb8, 0x3b, 0xa3, 0x4b, 0x63, 0x73, 0xf9, 0xc6, 0xcb, 0x0d, 0x66, 0xca, 0x2d, 0x9a, 0x6c, 0x2a,
+  0x36, 0x12, 0xd6, 0xcd, 0x53, 0xf6, 0xb4, 0xb2, 0x39, 0x62, 0x17, 0xea, 0xfa, 0x69, 0x72, 0x6f,
+  0x0a, 0x66, 0xca, 0xb5, 0x95, 0xd4, 0xab, 0xb0, 0x20, 0xe0, 0xbb, 0x5c, 0x48, 0xf5, 0x30, 0x61,
+  0xb4, 0x40, 0x07, 0xa3, 0x9a, 0xe7, 0x2d, 0x4f, 0xd9, 0xe5, 0x1a, 0xd6, 0x10, 0x51, 0xd0, 0x28,
+  0xaf, 0xb4, 0x2a, 0x69, 0xa0, 0x67, 0x14, 0x8e, 0x5e, 0xbf, 0x52, 0xc1, 0xe5, 0x69, 0x50, 0x20,
+  0x5e, 0x5b, 0x45, 0xa0, 0xf9, 0x80, 0xc2, 0xb9, 0x69, 0x18, 0xb7, 0xdc, 0x60, 0xe1, 0xa9, 0x1a,
+  0x99, 0x1a, 0x1c, 0xea, 0x30, 0x8a, 0x23, 0xcf, 0xd7, 0xa3, 0xcc, 0x07, 0xae, 0xc5, 0x99, 0x45,
+  0x95, 0x3a, 0x84, 0xf2, 0xc4, 0xf4, 0xf5, 0x18, 0x95, 0x91, 0x4b, 0x96, 0x26, 0x0b, 0x25, 0x38,
+  0x06, 0x39, 0x8d, 0xb2, 0x48, 0x09, 0xe9, 0x8a, 0xd6, 0x74, 0x73, 0x4f, 0xd9, 0xd4, 0x88, 0xc3,
+  0xf6, 0x3b, 0x87, 0xaf, 0x02, 0x10, 0x83, 0x32, 0xa7, 0x39, 0xd2, 0xb0, 0xff, 0x2b, 0x76, 0xe5,
+  0xc9, 0x9c, 0xf7, 0x81, 0x87, 0x30, 0x9d, 0xdb, 0x53, 0xd1, 0xc3, 0x82, 0x41, 0x37, 0xb5, 0x13,
+  0x29, 0xc8, 0xcc, 0x45, 0xea, 0x45, 0x80, 0xa4, 0xc1, 0x90, 0x31, 0x12, 0xb2, 0x31, 0x4d, 0x4d,
+  0x5f, 0xc1, 0xfc, 0x2a, 0x28, 0xe2, 0xfe, 0x5d, 0x50, 0xc4, 0x5d, 0x70, 0xd8, 0x25, 0xdc, 0xd2,
+  0xf3, 0xae, 0xc3, 0x2d, 0xc7, 0xd4, 0xe3, 0xde, 0xf7, 0xa6, 0x34, 0x16, 0x5b, 0x96, 0x12, 0xad,
+  0x1a, 0x77, 0xba, 0x3a, 0x86, 0x7b, 0x89, 0x54, 0x79, 0xc3, 0x32, 0x95, 0x2a, 0x88, 0x7c, 0x43,
+  0x61, 0x48, 0x0e, 0x2e, 0x80, 0x10, 0xd6, 0x7c, 0x16, 0x73, 0x00, 0x48, 0xae, 0x22, 0x05, 0x48,
+  0x83, 0xf5, 0x90, 0x5e, 0xd0, 0x33, 0x2f, 0x81, 0x0a, 0x37, 0x8a, 0xc1, 0x0e, 0x43, 0x09, 0x66,
+  0xfd, 0x0c, 0x48, 0x5c, 0x60, 0x5d, 0xc4, 0x66, 0x8a, 0xfe, 0xee, 0xc7, 0x00, 0x52, 0x3c, 0x76,
+  0x2a, 0x39, 0xb5, 0x73, 0x46, 0x80, 0x8e, 0x79, 0x01, 0xe4, 0xf9, 0x9f, 0x1f, 0x3f, 0x79, 0x3c,
+  0x52, 0xc0, 0x41, 0x99, 0xc2, 0xda, 0xb5, 0x8d, 0xf6, 0xab, 0xa0, 0x7d, 0x6a, 0x68, 0xbb, 0x93,
+  0x78, 0xac, 0xb1, 0x34, 0xef, 0x9a, 0x2c, 0xba, 0xe4, 0x15, 0x8b, 0xc9, 0x26, 0x7a, 0x58, 0x6b,
+  0xe3, 0xc6, 0x7e, 0xb1, 0x5c, 0x13, 0x88, 0x4c, 0x11, 0x35, 0x3b, 0xe7, 0xe7, 0x8d, 0xbc, 0x65,
+  0x85, 0x77, 0xba, 0xa9, 0xbb, 0x54, 0xf8, 0x03, 0x4e, 0x8a, 0xcc, 0xec, 0xcb, 0xc2, 0xa6, 0xbe,
+  0x42, 0x0c, 0xc1, 0x02, 0x1c, 0xaa, 0x59, 0xdc, 0x03, 0xc4, 0xdb, 0x1d, 0x04, 0x5b, 0x87, 0x90,
+  0x16, 0xc2, 0xbf, 0x26, 0xcb, 0xa9, 0xb9, 0xb1, 0x62, 0x12, 0x3d, 0x0a, 0x20, 0x6d, 0xb6, 0x36,
+  0xec, 0xe4, 0x32, 0x70, 0x48, 0x9e, 0x17, 0xb0, 0x5c, 0xfa, 0x6a, 0x23, 0x8d, 0x2f, 0x65, 0x18,
+  0x8a, 0x47, 0xf6, 0xb9, 0xed, 0xa5, 0x64, 0x4a, 0x53, 0x28, 0x25, 0xb5, 0x36, 0x4e, 0x4e, 0x66,
+  0x50, 0x67, 0x1b, 0xe0, 0x45, 0x9c, 0x19, 0x1d, 0x82, 0x67, 0x6c, 0xb1, 0x4f, 0xda, 0x52, 0xa4,
+  0x8b, 0xb1, 0x19, 0xbe, 0x11, 0x19, 0xa3, 0xc5, 0x70, 0x71, 0x08, 0xb1, 0xf9, 0x55, 0xc2, 0xab,
+  0xc6, 0xd5, 0x94, 0xbe, 0x50, 0xe5, 0xea, 0x59, 0xad, 0xf9, 0x44, 0x3d, 0xed, 0xf6, 0x19, 0x54,
+  0x54, 0x6c, 0x74, 0x96, 0xb2, 0xce, 0xed, 0x48, 0x66, 0xac, 0x38, 0x67, 0xe9, 0xd8, 0x48, 0x23,
+  0x24, 0xbe, 0x4b, 0x35, 0xd9, 0xa9, 0x03, 0x25, 0xa0, 0xa8, 0x49, 0xd0, 0x4d, 0xaa, 0xe9, 0xc6,
+  0x24, 0x0d, 0x0c, 0xcf, 0xbd, 0xd0, 0x47, 0x63, 0x56, 0x54, 0xc0, 0x47, 0xf0, 0xae, 0x32, 0xef,
+  0x97, 0x51, 0x91, 0x4f, 0x83, 0x9a, 0x7f, 0x04, 0xef, 0x95, 0x3a, 0x39, 0x01, 0x69, 0x3a, 0xfe,
+  0xc2, 0xa5, 0x49, 0x23, 0x1b, 0xa2, 0x03, 0x09, 0x78, 0x02, 0x74, 0xb5, 0x44, 0xcf, 0x8e, 0xaa,
+  0xc1, 0xea, 0xd8, 0x19, 0x51, 0x30, 0x41, 0x10, 0xae, 0x3b, 0x9a, 0xda, 0x60, 0x04, 0x59, 0x45,
+  0x59, 0x9c, 0xcc, 0x1c, 0x75, 0xed, 0xcc, 0x34, 0x5e, 0x50, 0xa6, 0x0a, 0xcc, 0x96, 0x50, 0x1d,
+  0xce, 0x13, 0xa6, 0x0c, 0xc6, 0x79, 0xc2, 0xdd, 0xb7, 0x06, 0x9f, 0x9e, 0x87, 0x71, 0x3a, 0x82,
+  0xfc, 0x7e, 0xee, 0x1e, 0xba, 0xa3, 0x8e, 0xd2, 0xee, 0x38, 0x4f, 0xc0, 0x1c, 0x02, 0xe0, 0x4f,
+  0x43, 0x94, 0x54, 0x7c, 0x6c, 0xb6, 0x7a, 0xd4, 0x1c, 0x04, 0x48, 0xcf, 0xc9, 0x97, 0x74, 0x72,
+  0x14, 0x3a, 0x6f, 0x68, 0x0a, 0xa1, 0x0c, 0xfb, 0x30, 0x5a, 0xd3, 0x0f, 0x1d, 0x76, 0xf4, 0xd3,
+  0x9c, 0x85, 0x49, 0x8a, 0xd7, 0x60, 0x9b, 0xda, 0x50, 0x6b, 0x72, 0x08, 0x4d, 0xad, 0x8d, 0xd1,
+  0x24, 0x13, 0xa1, 0xa0, 0x4a, 0x74, 0x4f, 0x20, 0xcc, 0x9c, 0x27, 0x66, 0x08, 0xee, 0x83, 0xc5,
+  0xfc, 0x11, 0x3d, 0x43, 0xee, 0x23, 0xf5, 0x73, 0x0b, 0x51, 0xce, 0x47, 0xd8, 0x18, 0x33, 0x23,
+  0xbc, 0x6f, 0xdb, 0xa0, 0x67, 0xec, 0x86, 0x98, 0x0a, 0x2d, 0x83, 0x82, 0x82, 0x30, 0xd9, 0x9e,
+  0xd0, 0x08, 0x77, 0x56, 0xd0, 0xec, 0x60, 0xbe, 0xa6, 0xcb, 0x2a, 0x52, 0x3a, 0xc7, 0x7c, 0x10,
+  0x9e, 0x39, 0xd1, 0x90, 0x1e, 0xee, 0xe4, 0xe6, 0x0c, 0x76, 0x53, 0xc3, 0x10, 0x06, 0x2a, 0x0b,
+  0x75, 0x9c, 0xdc, 0xd9, 0xe1, 0x23, 0xd4, 0x20, 0x9c, 0x03, 0x99, 0x2c, 0x92, 0x4b, 0x05, 0x88,
+  0xf6, 0x92, 0x6f, 0xf2, 0xd8, 0x04, 0x34, 0x2f, 0xb2, 0x5d, 0xdb, 0x20, 0x31, 0xf5, 0x98, 0x9b,
+  0xb1, 0x5f, 0xdf, 0x0e, 0x32, 0x8d, 0xe3, 0x30, 0x2e, 0x80, 0x86, 0xf2, 0xd0, 0x9c, 0x27, 0xa7,
+  0x4d, 0x6d, 0x2d, 0x24, 0x28, 0x08, 0x18, 0x47, 0x1d, 0x3f, 0x4c, 0xe8, 0xa8, 0x81, 0xda, 0x2c,
+  0x59, 0x9e, 0xd0, 0xf4, 0xd8, 0x9b, 0xd3, 0x70, 0x91, 0x36, 0x32, 0x71, 0x1b, 0xfd, 0x4e, 0xa7,
+  0x03, 0xf3, 0x0a, 0x65, 0x44, 0x11, 0x76, 0xaa, 0x5f, 0x71, 0xdd, 0xa7, 0x6b, 0x52, 0x41, 0xb9,
+  0xb9, 0x85, 0xc5, 0xbb, 0xe2, 0xd8, 0x98, 0x3b, 0x4b, 0xe5, 0x96, 0xec, 0xb3, 0x45, 0x1a, 0x01,
+  0xf2, 0x94, 0x0d, 0xe2, 0x1b, 0xb2, 0xc7, 0x61, 0x34, 0xca, 0xbe, 0x7c, 0xce, 0x0e, 0x41, 0xc0,
+  0x22, 0x4a, 0xee, 0x2b, 0xdb, 0xa5, 0x93, 0xce, 0xcb, 0x59, 0x43, 0xc8, 0x1c, 0xbd, 0x32, 0x3b,
+  0x5d, 0xf2, 0xf6, 0x2d, 0x64, 0x85, 0x84, 0xf5, 0x07, 0x32, 0x3d, 0x86, 0x6f, 0xe7, 0x90, 0xa4,
+  0x03, 0x8b, 0x62, 0x6a, 0xbb, 0x97, 0x18, 0x4d, 0x90, 0xdd, 0x5d, 0xc9, 0x68, 0x4c, 0x24, 0x8b,
+  0xcb, 0xd7, 0x60, 0x4d, 0x30, 0x1c, 0x69, 0x68, 0x38, 0x7a, 0xae, 0xb7, 0xa8, 0x9e, 0xd5, 0xae,
+  0x14, 0x48, 0x78, 0xf0, 0xf5, 0x48, 0x6b, 0x42, 0x74, 0x0c, 0x5d, 0xfa, 0xc5, 0x8b, 0xc3, 0xbd,
+  0x70, 0x0e, 0xee, 0x1b, 0xef, 0x9b, 0x3a, 0xe0, 0xcf, 0x88, 0x48, 0xe7, 0x57, 0xdc, 0x67, 0xe6,
+  0x63, 0xaf, 0x4a, 0x14, 0xbc, 0xc4, 0x7c, 0x83, 0x29, 0x04, 0x08, 0x5f, 0x53, 0x68, 0xe0, 0x76,
+  0x0c, 0x01, 0xdf, 0xb5, 0x88, 0x22, 0x5d, 0x3f, 0xb4, 0x5d, 0x31, 0xd9, 0xe8, 0xf5, 0x3b, 0xaa,
+  0xc1, 0x14, 0x3c, 0x68, 0x71, 0x03, 0x53, 0xe1, 0xc0, 0xf5, 0x62, 0x2e, 0x46, 0x50, 0xcd, 0x52,
+  0xa0, 0x56, 0xcb, 0x1c, 0xd5, 0x93, 0x7b, 0x16, 0xf6, 0x51, 0x34, 0x4f, 0x31, 0x6d, 0x47, 0x6b,
+  0x47, 0x63, 0x4c, 0xd8, 0xd5, 0x17, 0x33, 0x89, 0x7c, 0x0f, 0x5c, 0x0b, 0xe8, 0xb8, 0xce, 0xdf,
+  0x71, 0x78, 0x29, 0xf8, 0x38, 0x39, 0xda, 0x0b, 0xf6, 0xc1, 0x56, 0xc5, 0x06, 0xa2, 0xf4, 0x99,
+  0x30, 0xac, 0xc1, 0x5e, 0x82, 0x5f, 0xf3, 0x76, 0x19, 0x40, 0x13, 0x52, 0xa4, 0xd3, 0x74, 0x66,
+  0x79, 0xcd, 0xa6, 0x7e, 0x95, 0xe1, 0x19, 0xb1, 0x77, 0x2f, 0x3d, 0xde, 0xdd, 0xc1, 0x2f, 0xb9,
+  0xef, 0xc6, 0xae, 0x15, 0xee, 0x98, 0x68, 0x3a, 0xf9, 0xf4, 0x53, 0x52, 0x7a, 0x77, 0xc2, 0xca,
+  0xd9, 0x8a, 0x17, 0x7b, 0xac, 0x52, 0xc5, 0xe5, 0x15, 0x08, 0xe3, 0x2e, 0x39, 0x23, 0x1f, 0x6c,
+  0x58, 0x69, 0x6a, 0x6f, 0xf2, 0x2b, 0xb7, 0x9b, 0x63, 0x70, 0x9f, 0x00, 0xad, 0xa9, 0xf1, 0x26,
+  0xb5, 0x6c, 0x27, 0x92, 0x55, 0xd2, 0x9e, 0x63, 0xe1, 0xfa, 0xbf, 0x82, 0xb0, 0x02, 0x34, 0x44,
+  0xdb, 0xfe, 0xe5, 0x2b, 0xb7, 0x0d, 0x2a, 0x91, 0xa4, 0x8c, 0x68, 0x5d, 0x70, 0x9b, 0x6d, 0x13,
+  0x51, 0xf7, 0xb1, 0x64, 0x3a, 0x06, 0xd1, 0xfc, 0x89, 0xf2, 0x39, 0x4f, 0x0a, 0x7f, 0xd9, 0x78,
+  0xe5, 0x36, 0xf5, 0x36, 0xe4, 0x85, 0xca, 0xd9, 0xc9, 0x4d, 0x7e, 0xe9, 0x75, 0x73, 0xfc, 0xb3,
+  0xae, 0x38, 0x68, 0xc1, 0xcb, 0xd4, 0x6b, 0x60, 0x35, 0x5e, 0x25, 0x3a, 0x80, 0xbb, 0xda, 0x5e,
+  0xea, 0xf8, 0x11, 0xb3, 0x4d, 0x00, 0xa0, 0xc2, 0x15, 0x7d, 0x08, 0x00, 0xdc, 0x13, 0x80, 0x7f,
+  0xb6, 0x75, 0x73, 0xd0, 0xad, 0x07, 0x48, 0xab, 0x00, 0x2d, 0xd5, 0xbf, 0x31, 0x47, 0x53, 0x33,
+  0xa2, 0xae, 0x11, 0xf5, 0x8c, 0x68, 0xcb, 0x08, 0xa7, 0x53, 0xb0, 0x4c, 0xae, 0xfa, 0x2a, 0x28,
+  0x76, 0x8f, 0x12, 0xd2, 0x24, 0xad, 0x9a, 0x20, 0x4d, 0x1f, 0xb7, 0xba, 0xc8, 0x5a, 0x3e, 0x7f,
+  0x7c, 0xab, 0xa9, 0x1c, 0x5b, 0xd4, 0x13, 0xfa, 0x3f, 0x1a, 0xf5, 0x75, 0x22, 0x0c, 0x2e, 0xea,
+  0x36, 0x8b, 0xd3, 0x94, 0x96, 0x06, 0x8a, 0x3c, 0xea, 0xa1, 0xc0, 0x39, 0x8f, 0x9b, 0xd1, 0x96,
+  0xc5, 0x01, 0x41, 0x3c, 0xea, 0x68, 0x6f, 0xdf, 0x02, 0x44, 0xb6, 0x67, 0x9d, 0x7c, 0xe9, 0xa5,
+  0xe0, 0xe8, 0x5a, 0x80, 0xa9, 0x16, 0xae, 0xc8, 0xfc, 0x2a, 0x61, 0x2e, 0x45, 0x43, 0x90, 0x30,
+  0x5e, 0x59, 0x2c, 0x67, 0xb9, 0x01, 0xcb, 0xdd, 0xe6, 0x5d, 0x26, 0xc4, 0x02, 0x9e, 0x24, 0x74,
+  0x6e, 0xab, 0x17, 0xaf, 0x26, 0xbc, 0x27, 0xf0, 0x6a, 0xb2, 0x0a, 0x4d, 0xb9, 0xd9, 0xbd, 0x29,
+  0x4e, 0xa1, 0xde, 0x0e, 0xf4, 0xa1, 0xeb, 0xd3, 0x5a, 0xc0, 0x78, 0x19, 0x7c, 0x73, 0x8c, 0x43,
+  0x6e, 0x07, 0xf4, 0x21, 0xbb, 0x20, 0x5e, 0x0b, 0x96, 0xdf, 0x1f, 0xdf, 0x1c, 0xf3, 0x61, 0x0a,
+  0xe8, 0x3a, 0x13, 0x97, 0x17, 0xed, 0x51, 0x3a, 0x0a, 0xca, 0xb2, 0xad, 0x5f, 0x65, 0x0e, 0x32,
+  0x8d, 0xbd, 0x39, 0xe4, 0x12, 0xe0, 0x81, 0xf5, 0x3a, 0xe7, 0x5b, 0x40, 0x54, 0xe1, 0x3c, 0x72,
+  0xa9, 0x67, 0x83, 0xf1, 0x69, 0x29, 0xd4, 0x2b, 0xa1, 0x4b, 0x16, 0x2c, 0x35, 0x41, 0x56, 0x44,
+  0x22, 0xb5, 0x5c, 0xc1, 0xdd, 0x53, 0x56, 0xae, 0xd4, 0x86, 0x58, 0xfe, 0x7c, 0xea, 0xc5, 0x49,
+  0x3a, 0x12, 0x29, 0xae, 0x45, 0x44, 0x5a, 0xec, 0x9a, 0xe2, 0xc1, 0xc6, 0x0d, 0xc2, 0xdf, 0x35,
+  0x29, 0x8e, 0x6b, 0x86, 0xec, 0x03, 0x8f, 0xea, 0x0c, 0x9f, 0xae, 0xa4, 0xd8, 0xb2, 0xe2, 0x77,
+  0x21, 0xf5, 0x60, 0x31, 0xfc, 0xd3, 0x4f, 0xef, 0xb8, 0xa6, 0x0b, 0x39, 0x82, 0xbe, 0x2e, 0x8c,
+  0xd7, 0x55, 0x42, 0xd9, 0x89, 0x2a, 0x80, 0xb5, 0xae, 0xf7, 0xab, 0xe4, 0x46, 0x88, 0xd6, 0xca,
+  0x13, 0x2b, 0xab, 0x0a, 0x1c, 0x3b, 0xde, 0x95, 0xa5, 0x5c, 0x73, 0x97, 0x8c, 0x4a, 0xdb, 0xa6,
+  0xf9, 0xbe, 0x03, 0x79, 0x40, 0xf0, 0x98, 0x98, 0x46, 0x86, 0xec, 0x2f, 0x01, 0xb5, 0x52, 0x47,
+  0x5a, 0x1f, 0x4c, 0xd3, 0xca, 0x1e, 0xa5, 0xa4, 0x0b, 0x8a, 0xa0, 0x75, 0xfd, 0x50, 0x76, 0x72,
+  0x4d, 0xd4, 0x4a, 0x4a, 0xca, 0xf2, 0x21, 0x4b, 0x51, 0x13, 0x28, 0x3c, 0x09, 0xf3, 0x24, 0x9c,
+  0x78, 0x5c, 0x5b, 0x39, 0x45, 0x5e, 0xc2, 0x9f, 0x00, 0x8e, 0x73, 0x70, 0xd5, 0xe1, 0x39, 0x57,
+  0x96, 0x2f, 0xd9, 0x0f, 0x89, 0xec, 0x8e, 0xf0, 0xba, 0xb6, 0x54, 0x44, 0x3c, 0x8d, 0x08, 0xc3,
+  0xea, 0x3b, 0xef, 0xca, 0xa1, 0x45, 0xae, 0x34, 0x19, 0x70, 0x08, 0x0d, 0xf8, 0x58, 0x67, 0xff,
+  0x8a, 0xce, 0xbc, 0xd8, 0xa7, 0x07, 0x88, 0x1a, 0xff, 0xad, 0x03, 0x66, 0x77, 0xa2, 0x04, 0x2a,
+  0x9a, 0x96, 0xb5, 0xca, 0x51, 0xab, 0xb8, 0x1c, 0x96, 0x51, 0xb2, 0x1f, 0x14, 0x02, 0xe1, 0x34,
+  0x10, 0x88, 0xb1, 0xc5, 0x6a, 0x85, 0x0d, 0xb1, 0x2a, 0xa8, 0x47, 0x0f, 0x70, 0x7f, 0x19, 0x8b,
+  0x53, 0xdc, 0xd1, 0x6d, 0x68, 0x31, 0xc5, 0xdd, 0x7e, 0xcd, 0x50, 0x01, 0xe9, 0xd7, 0xca, 0x7e,
+  0x15, 0xce, 0x1b, 0x7a, 0x09, 0x08, 0x02, 0xcd, 0xa0, 0x50, 0xbd, 0xc0, 0xa2, 0xa9, 0x09, 0x4f,
+  0x50, 0x44, 0x07, 0x48, 0x8e, 0xa6, 0xe7, 0x2a, 0xb2, 0x14, 0x39, 0xa2, 0x68, 0x30, 0x9d, 0x78,
+  0x09, 0x6b, 0x92, 0x8c, 0x88, 0xf0, 0x4b, 0xd7, 0xf4, 0x62, 0xd8, 0xf5, 0x8b, 0x2a, 0x0a, 0xd8,
+  0xf9, 0x0d, 0x58, 0x48, 0x16, 0xd5, 0x71, 0xd7, 0x8d, 0x9a, 0x51, 0xcc, 0x76, 0xd4, 0xf7, 0xe9,
+  0xd4, 0x5e, 0xf8, 0x69, 0xa3, 0xdc, 0x2b, 0x5f, 0x27, 0xca, 0x95, 0x5e, 0xf9, 0x0a, 0xc9, 0x77,
+  0x8a, 0x4f, 0xb2, 0x11, 0x2b, 0xc2, 0x2d, 0xcd, 0x44, 0x7d, 0xc5, 0x9f, 0x06, 0x60, 0x1a, 0xcb,
+  0x8e, 0x68, 0x30, 0x4d, 0x29, 0x8e, 0xd2, 0xd5, 0xfa, 0xa0, 0xa1, 0x93, 0xd1, 0x98, 0x5c, 0xd5,
+  0x30, 0x8d, 0xd4, 0xe1, 0x15, 0xc0, 0x97, 0x06, 0x11, 0x8a, 0x80, 0xdc, 0xcf, 0x6c, 0xa1, 0x74,
+  0x73, 0x21, 0xdb, 0xee, 0x10, 0x59, 0xe2, 0x3a, 0xd6, 0x14, 0xef, 0x2e, 0x70, 0x45, 0x17, 0xf3,
+  0xca, 0x44, 0x8c, 0x24, 0x19, 0x80, 0xa0, 0x66, 0x88, 0x64, 0x87, 0x25, 0xb7, 0x9a, 0xd1, 0x56,
+  0xd6, 0xb9, 0x08, 0xe5, 0xca, 0x82, 0xf0, 0x44, 0x1c, 0x0f, 0xde, 0x4d, 0x40, 0x77, 0xca, 0x01,
+  0xcb, 0x95, 0x5d, 0x61, 0xf0, 0x1c, 0xb2, 0x66, 0x9b, 0x29, 0x28, 0x47, 0x3e, 0x44, 0x21, 0x98,
+  0x08, 0x37, 0xa8, 0x1c, 0x5e, 0xdd, 0x60, 0x11, 0x5d, 0xcb, 0x37, 0x18, 0x58, 0x94, 0xe4, 0xaf,
+  0x6a, 0xd7, 0x26, 0x04, 0xbc, 0x5c, 0x0d, 0x9d, 0x65, 0x68, 0xc5, 0x76, 0x1f, 0xcc, 0x2d, 0x06,
+  0xd0, 0xd2, 0x69, 0x24, 0x50, 0x76, 0x11, 0x49, 0x49, 0x4d, 0xe7, 0x8f, 0x14, 0x3b, 0x61, 0xb8,
+  0xb2, 0x0c, 0x68, 0x1e, 0x61, 0x4b, 0xdc, 0xe2, 0x0d, 0x9b, 0x1a, 0xee, 0x88, 0x97, 0x79, 0x54,
+  0x13, 0xf1, 0x95, 0xd7, 0xba, 0x0d, 0xed, 0x00, 0xff, 0x30, 0xbf, 0x85, 0xbf, 0x82, 0x26, 0x08,
+  0x1d, 0x02, 0xa5, 0x94, 0x75, 0x3a, 0x72, 0xdd, 0xab, 0x42, 0x2a, 0x57, 0xce, 0x8f, 0xda, 0x5f,
+  0xaf, 0x7e, 0xec, 0x04, 0xbe, 0x92, 0x22, 0x20, 0x85, 0xeb, 0xa6, 0x55, 0x2a, 0x0e, 0x18, 0x2d,
+  0xa2, 0xcb, 0xd3, 0x03, 0x14, 0x19, 0xd7, 0xc4, 0x3b, 0x48, 0x15, 0x6b, 0x32, 0x91, 0xb7, 0x6f,
+  0x49, 0xf6, 0x45, 0xe4, 0xe8, 0x4c, 0xe3, 0x3a, 0x28, 0xb3, 0xd5, 0xf9, 0xe5, 0x5b, 0x01, 0x9b,
+  0xfd, 0x4d, 0x71, 0xd6, 0x6a, 0xf3, 0x36, 0xb7, 0x02, 0x30, 0x9f, 0x65, 0x5d, 0x66, 0xd1, 0xeb,
+  0xce, 0x7a, 0xca, 0x49, 0x7e, 0x2f, 0x40, 0x93, 0x7b, 0xf5, 0xa8, 0x61, 0x2a, 0x27, 0xa8, 0xbb,
+  0xcf, 0xe5, 0x2d, 0x19, 0x23, 0x0d, 0x04, 0xdc, 0x4f, 0xbe, 0xb0, 0xa1, 0xb2, 0xae, 0xa9, 0x90,
+  0x31, 0xba, 0x1a, 0xdc, 0xb5, 0x62, 0xdc, 0x3a, 0x84, 0xaf, 0x12, 0x06, 0x3a, 0x0f, 0x05, 0xb6,
+  0x99, 0x80, 0xcf, 0xa5, 0x8d, 0xd6, 0xf6, 0x8e, 0x6e, 0xa2, 0x9b, 0xc5, 0x8e, 0x5f, 0xde, 0x9d,
+  0xc5, 0x7b, 0x03, 0x97, 0xcc, 0x6b, 0xe5, 0xea, 0x87, 0x2e, 0x0b, 0x1b, 0x92, 0x30, 0x9b, 0xf2,
+  0x01, 0x26, 0x9e, 0x7d, 0x85, 0x9c, 0x78, 0x1e, 0xe5, 0xae, 0x19, 0x9e, 0xa0, 0x18, 0x61, 0x8c,
+  0x99, 0x86, 0x8f, 0x43, 0xfc, 0xbd, 0x3d, 0xf4, 0x83, 0x47, 0x29, 0x9e, 0x0c, 0x6b, 0x68, 0x34,
+  0x69, 0x1d, 0x1c, 0xa1, 0xf2, 0xcf, 0xc2, 0x45, 0x0c, 0xba, 0xdf, 0x6b, 0xb9, 0xde, 0xa9, 0x97,
+  0xc2, 0x13, 0x76, 0x83, 0x81, 0x2a, 0x8f, 0x96, 0x19, 0x50, 0xbe, 0x8d, 0x06, 0x60, 0x39, 0xd6,
+  0x6c, 0xb7, 0x05, 0xc3, 0xfb, 0x76, 0x07, 0x3d, 0xb2, 0xd8, 0x75, 0x04, 0x8e, 0x54, 0x0c, 0x19,
+  0xb0, 0x21, 0xea, 0x5e, 0x21, 0xba, 0xee, 0x6c, 0x1f, 0xaf, 0x88, 0x65, 0x0f, 0x53, 0xf6, 0x75,
+  0xa8, 0x8a, 0x1b, 0x94, 0xeb, 0x30, 0x96, 0xf6, 0x15, 0x11, 0x69, 0x79, 0xe3, 0x6f, 0x55, 0x81,
+  0x9b, 0x42, 0x03, 0x35, 0xd2, 0xdc, 0xd0, 0x50, 0x0d, 0x85, 0xea, 0x29, 0xb7, 0xba, 0x6a, 0xcf,
+  0x12, 0x6e, 0xe2, 0x2c, 0x2e, 0x82, 0x26, 0x40, 0x41, 0x35, 0x7b, 0x7f, 0x30, 0x72, 0x59, 0x52,
+  0x91, 0x3e, 0x1e, 0x44, 0xc9, 0xa8, 0x8f, 0x05, 0x11, 0x6a, 0xd2, 0xe7, 0x34, 0x46, 0x83, 0x44,
+  0x90, 0x77, 0xdf, 0x1f, 0xa6, 0xac, 0xd7, 0x10, 0xb4, 0xaa, 0x0d, 0x00, 0x95, 0xe3, 0x13, 0x8a,
+  0x58, 0x24, 0x5c, 0x18, 0xf2, 0xb2, 0x98, 0x41, 0xaf, 0x71, 0xc1, 0x79, 0xac, 0x66, 0x37, 0xf9,
+  0x6e, 0xee, 0xf4, 0xb2, 0xf3, 0x05, 0x3c, 0x43, 0x3e, 0xe1, 0xb1, 0x53, 0xc0, 0x91, 0x1e, 0x51,
+  0xe4, 0xe9, 0xf2, 0x20, 0x35, 0xbc, 0x7f, 0x69, 0x9a, 0x26, 0x1a, 0xee, 0x11, 0x4d, 0x1b, 0xb9,
+  0xc3, 0xc0, 0x5d, 0x9f, 0xb2, 0xb7, 0xd0, 0xf5, 0xd7, 0xc0, 0xcd, 0x18, 0x52, 0x16, 0xdb, 0x98,
+  0xb0, 0xac, 0xc5, 0x6e, 0x4d, 0xf0, 0xa0, 0x01, 0xc7, 0x50, 0x74, 0x93, 0x85, 0x9b, 0x85, 0x9b,
+  0xe0, 0x9c, 0x36, 0xd7, 0xde, 0x2c, 0x04, 0x16, 0x65, 0x44, 0x65, 0x7e, 0xc6, 0x73, 0xb9, 0x93,
+  0x59, 0x41, 0xd0, 0x5c, 0xc5, 0x80, 0x02, 0xf0, 0x5c, 0x2e, 0x8c, 0xfc, 0xfc, 0x5e, 0xf6, 0x50,
+  0x45, 0xb4, 0xcc, 0x69, 0x16, 0x09, 0x46, 0x81, 0x67, 0xd9, 0xcb, 0x30, 0x70, 0x66, 0x78, 0x42,
+  0x19, 0xde, 0xf3, 0x24, 0xad, 0x2a, 0x45, 0xc8, 0x44, 0x5a, 0xba, 0xb9, 0x78, 0xb5, 0x51, 0x17,
+  0xdb, 0x75, 0x33, 0x9d, 0xd1, 0xa0, 0x11, 0x33, 0x88, 0x22, 0x54, 0x8b, 0x67, 0x3c, 0x8c, 0xe3,
+  0x92, 0x59, 0xc7, 0x2e, 0x39, 0x43, 0x56, 0x1e, 0x4b, 0x37, 0x6a, 0x08, 0x6d, 0x21, 0x87, 0xfb,
+  0x86, 0x7a, 0x97, 0xce, 0x10, 0xd7, 0xe2, 0x0c, 0xbe, 0x1d, 0xcb, 0xf6, 0xfd, 0x15, 0xd7, 0xff,
+  0xa1, 0x4e, 0xfb, 0xa3, 0xf8, 0xd7, 0x2f, 0x15, 0x37, 0xb7, 0x97, 0xfb, 0x37, 0x5c, 0x62, 0x33,
+  0x0b, 0x08, 0x87, 0x47, 0xcf, 0x44, 0x24, 0xd0, 0x51, 0x66, 0x46, 0x8d, 0xa3, 0x31, 0x6a, 0xdc,
+  0x85, 0x51, 0x67, 0xf4, 0x46, 0xd1, 0x3a, 0x19, 0x83, 0xf2, 0xf8, 0x01, 0x09, 0xea, 0x44, 0xf0,
+  0xe1, 0x11, 0x7c, 0x6c, 0xbc, 0x04, 0xa2, 0x5e, 0x43, 0x0c, 0xc2, 0xcd, 0x1f, 0xa0, 0x16, 0xa3,
+  0x7a, 0x1b, 0x1e, 0x29, 0x11, 0x67, 0x11, 0xfb, 0x30, 0xe1, 0x8b, 0x17, 0x8f, 0x4d, 0x27, 0xa6,
+  0x40, 0xfa, 0xb3, 0xc9, 0x57, 0xa0, 0x2f, 0xf0, 0xbd, 0x81, 0xb0, 0xb2, 0x61, 0xb6, 0x6a, 0xbc,
+  0x7c, 0xa4, 0xb0, 0xdf, 0x86, 0x66, 0xa3, 0xbd, 0xda, 0x26, 0xfe, 0xf8, 0x09, 0x8c, 0x02, 0x80,
+  0xf8, 0x0d, 0xeb, 0x2c, 0x4c, 0xb0, 0x58, 0xda, 0xcc, 0x57, 0xf6, 0x2b, 0xa1, 0x35, 0xbf, 0xc2,
+  0x25, 0x64, 0xa2, 0xd2, 0x8b, 0xcc, 0x92, 0x6d, 0xfa, 0x63, 0x4d, 0x7f, 0xd9, 0x79, 0x8d, 0x4b,
+  0x34, 0x91, 0x60, 0x04, 0xc9, 0x6a, 0x27, 0xd4, 0x54, 0xa4, 0x16, 0x22, 0x79, 0xf8, 0x46, 0xa1,
+  0x16, 0xd0, 0xea, 0x2b, 0xae, 0xa9, 0x78, 0x77, 0x56, 0xb4, 0x4a, 0xd9, 0xb1, 0xfc, 0x86, 0xf6,
+  0xfb, 0xff, 0x38, 0x48, 0xd2, 0x77, 0x3f, 0x24, 0xe0, 0x54, 0x4e, 0x17, 0x31, 0xbb, 0x87, 0xfd,
+  0xf5, 0x02, 0xff, 0x8f, 0x47, 0x10, 0x12, 0x30, 0x45, 0x76, 0x3e, 0x3f, 0x0d, 0xdd, 0x90, 0x50,
+  0x5f, 0xe4, 0x88, 0x9e, 0xed, 0x3f, 0x78, 0x15, 0xbc, 0x0a, 0xf0, 0xc4, 0x02, 0xb1, 0x1d, 0xbe,
+  0x9d, 0xfe, 0xf4, 0x19, 0x61, 0xa7, 0x4a, 0xa9, 0x8b, 0x27, 0x58, 0x92, 0x99, 0xed, 0xd0, 0xd8,
+  0x94, 0xbd, 0xd2, 0x0c, 0xdd, 0xde, 0xb3, 0xa7, 0x9f, 0x1d, 0xbe, 0x78, 0xf2, 0x70, 0xef, 0xf0,
+  0xdd, 0x77, 0x4f, 0xc9, 0x67, 0x87, 0x4f, 0x1f, 0x3e, 0x1e, 0x82, 0x9f, 0x02, 0xd8, 0x1e, 0xf6,
+  0x77, 0xe2, 0x77, 0x3f, 0x04, 0xe4, 0xf8, 0xd9, 0xfe, 0xb3, 0x23, 0x48, 0x4b, 0x13, 0x91, 0x49,
+  0xe5, 0x77, 0x2c, 0x13, 0x12, 0x51, 0xd0, 0x4b, 0xdc, 0xea, 0x61, 0x4c, 0xa7, 0x1c, 0x41, 0xd6,
+  0xb3, 0xc2, 0x75, 0xaa, 0x09, 0xf7, 0x9c, 0xa6, 0xb3, 0xd0, 0x05, 0x89, 0x3f, 0x7f, 0x76, 0x74,
+  0x0c, 0xd2, 0xde, 0x10, 0x76, 0x4a, 0x31, 0x35, 0x03, 0x6a, 0x99, 0xe9, 0x00, 0x79, 0xf2, 0x01,
+  0xdb, 0x1c, 0xda, 0x80, 0x0c, 0x06, 0x3c, 0xa2, 0x96, 0xdd, 0x16, 0xe0, 0x4c, 0xc0, 0x9f, 0xcd,
+  0x08, 0xc1, 0xa5, 0x38, 0x60, 0x49, 0x88, 0x5a, 0x63, 0xe7, 0x2e, 0x57, 0xbc, 0x07, 0x2f, 0x2f,
+  0x04, 0x08, 0x9e, 0x60, 0x4b, 0x08, 0x71, 0x81, 0x83, 0xfc, 0x50, 0x06, 0xd2, 0x24, 0xd2, 0x73,
+  0x36, 0x96, 0x51, 0x54, 0x98, 0x8d, 0xbf, 0x30, 0x02, 0x35, 0xc9, 0x05, 0x32, 0x79, 0xc8, 0xdc,
+  0x1f, 0x1b, 0x99, 0x49, 0xb9, 0x90, 0xa8, 0xaf, 0xdc, 0x1b, 0xbb, 0x45, 0x99, 0xb8, 0x72, 0x73,
+  0x8c, 0xf9, 0xd4, 0xea, 0x32, 0xe9, 0xba, 0xea, 0xb1, 0xb2, 0x68, 0x56, 0xe8, 0x54, 0x2f, 0x6e,
+  0xd0, 0xc0, 0x65, 0xbf, 0x1b, 0x95, 0xd1, 0x1a, 0xb3, 0x8b, 0x17, 0xfb, 0xde, 0xd9, 0xf5, 0xd4,
+  0xca, 0x4b, 0x1a, 0x79, 0xa4, 0xe4, 0xfd, 0xa7, 0xe7, 0x31, 0xbd, 0xc1, 0x64, 0x79, 0xb3, 0x82,
+  0x49, 0x52, 0xe0, 0xac, 0xaf, 0x76, 0x73, 0xd0, 0xa5, 0x4e, 0x97, 0x26, 0x6f, 0x03, 0x43, 0xd8,
+  0xc5, 0x2b, 0x0e, 0x4c, 0x1b, 0xb3, 0x55, 0x55, 0xe8, 0x5c, 0xa6, 0x6e, 0x08, 0x07, 0x22, 0xc5,
+  0x46, 0x39, 0x54, 0xa0, 0x5b, 0x97, 0xdc, 0xc0, 0x68, 0x22, 0x6a, 0x03, 0x65, 0xaf, 0x5e, 0x94,
+  0x76, 0xb5, 0x34, 0xb1, 0xa1, 0x09, 0x73, 0x26, 0xde, 0xf4, 0xb2, 0x21, 0x81, 0x18, 0x84, 0x1d,
+  0x59, 0x20, 0x3d, 0x54, 0x1d, 0x22, 0xeb, 0x42, 0x8e, 0xab, 0x1a, 0x10, 0x22, 0xaa, 0x55, 0xd4,
+  0x7a, 0x96, 0x30, 0xdd, 0x55, 0xd4, 0x75, 0xc5, 0x27, 0x15, 0x2e, 0x1b, 0xe5, 0x26, 0x1c, 0xb3,
+  0x27, 0x90, 0x6c, 0x9f, 0xdf, 0xd0, 0x7e, 0xaf, 0xe5, 0xa5, 0x30, 0x26, 0x76, 0x91, 0x89, 0x7b,
+  0x2a, 0x40, 0xfd, 0x8d, 0xed, 0xda, 0x9c, 0x3a, 0xc1, 0xc8, 0x0a, 0x4b, 0xbe, 0xce, 0x32, 0xab,
+  0x8c, 0x31, 0x77, 0xb9, 0x55, 0xd7, 0x9e, 0xfe, 0xdf, 0xf3, 0xfe, 0x5f, 0xf3, 0xbc, 0xbb, 0x6d,
+  0x71, 0xe9, 0x69, 0xb7, 0xcd, 0x7f, 0xc1, 0xac, 0x2d, 0xae, 0xfd, 0xb3, 0xdf, 0xb8, 0xff, 0x2f,
+  0x5c, 0xa3, 0xfd, 0x1f, 0xf3, 0x5e, 0x00, 0x00,
+};
+
+#endif // DASHBOARDPAGE_H
@@ -0,0 +1,85 @@
+#ifndef FIRMWAREHEALTH_H
+#define FIRMWAREHEALTH_H
+
+#include <stdint.h>
+
+#include "heapMonitor.h"
+
+// ================== Salud del firmware ==================
+// Contadores baratos que alimentan /metrics: duración de cada adquisición,
+// errores de la consola serie del BMS y de su UART (bmsUart.h), tiempo de cada vuelta de loop() y
+// heap (heapMonitor.h). Se actualizan con unas pocas sumas; nada se formatea hasta el scrape.
+
+struct firmwareHealth
+{
+  // Adquisición (updateBatteryData)
+  uint32_t acquisitions = 0;
+  uint32_t acquisitionFailures = 0; // sin módulos en la respuesta
+  uint64_t acquisitionMsTotal = 0;
+  uint32_t acquisitionMsLast = 0;
+
+  // Consola serie del BMS (bmsScheduler.h)
+  uint32_t bmsCommands = 0;
+  uint32_t bmsTimeouts = 0; // sin prompt dentro del timeout
+  uint32_t bmsEmpty = 0;    // ni un byte de respuesta
+  uint32_t bmsOverrunCommands = 0; // respuestas a las que les faltan bytes
+
+  // UART del BMS (bmsUart.h)
+  uint32_t uartRxBuffer = 0; // tamaño real del anillo de recepción
+  uint32_t uartRxPeak = 0;   // mayor ocupación vista
+  uint32_t uartRxBytes = 0;
+  uint32_t uartRxErrors = 0; // trama o paridad
+  uint32_t uartOverruns = 0; // veces que el anillo se llenó
+  unsigned long uartLastOverrunMs = 0;
+
+  // loop()
+  uint32_t loops = 0;
+  uint64_t loopUsTotal = 0;
+  uint32_t loopUsMax = 0; // desde el arranque (el scrape no lo toca)
+  unsigned long loopStartedAt = 0;
+
+  // Arranque: ms desde el boot hasta tener WiFi y hasta la primera respuesta HTTP
+  uint32_t wifiConnectMs = 0;
+  uint32_t firstHttpMs = 0;
+  bool wifiFastPath = false;
+  bool httpRequestSeen = false; // lo marca el hook del servidor
+
+  // Heap y coste del scrape anterior
+  heapMonitor heap;
+  uint32_t scrapeUs = 0;
+
+  void loopBegin(unsigned long us) { loopStartedAt = us; }
+
+  void loopEnd(unsigned long us)
+  {
+    uint32_t d = us - loopStartedAt;
+    loops++;
+    loopUsTotal += d;
+    if (d > loopUsMax)
+      loopUsMax = d;
+  }
+
+  void acquisitionDone(unsigned long ms, bool ok)
+  {
+    acquisitions++;
+    acquisitionMsTotal += ms;
+    acquisitionMsLast = ms;
+    if (!ok)
+      acquisitionFailures++;
+  }
+
+  void bmsCommandDone(bool gotPrompt, size_t bytes, bool overrun)
+  {
+    bmsCommands++;
+    if (overrun)
+      bmsOverrunCommands++;
+    if (!gotPrompt)
+      bmsTimeouts++;
+    if (bytes == 0)
+      bmsEmpty++;
+  }
+};
+
+static firmwareHealth health;
+
+#endif // FIRMWAREHEALTH_H
@@ -0,0 +1,164 @@
+#ifndef GZIPENCODER_H
+#define GZIPENCODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "crc32.h"
+
+// ================== Compresión gzip en memoria (deflate con Huffman fijo) ==================
+//
+// El core de ESP8266 solo trae descompresor, así que aquí va un compresor
+// mínimo: LZ77 voraz con una tabla hash de un candidato por trigrama y
+// códigos Huffman fijos (RFC 1951, bloque tipo 1). No llega a zlib, pero el
+// texto repetitivo (line protocol, JSON) baja a una cuarta parte o menos, con
+// 2 KB de tabla estática y sin heap. Entrada de hasta 64 KB.
+
+#define GZIP_HASH_BITS 10
+#define GZIP_MAX_DISTANCE 32768
+#define GZIP_MIN_MATCH 3
+#define GZIP_MAX_MATCH 258
+
+// Escritor de bits LSB primero sobre un buffer fijo
+struct _gzipBits
+{
+  uint8_t *out;
+  size_t cap;
+  size_t len = 0;
+  uint32_t acc = 0;
+  uint8_t count = 0;
+  bool overflow = false;
+
+  _gzipBits(uint8_t *o, size_t c) : out(o), cap(c) {}
+
+  void put(uint32_t bits, uint8_t n)
+  {
+    acc |= bits << count;
+    count += n;
+    while (count >= 8)
+    {
+      if (len < cap)
+        out[len++] = acc & 0xFF;
+      else
+        overflow = true;
+      acc >>= 8;
+      count -= 8;
+    }
+  }
+
+  // Los códigos Huffman van con el bit más significativo primero
+  void code(uint32_t c, uint8_t n)
+  {
+    uint32_t r = 0;
+    for (uint8_t i = 0; i < n; i++)
+      r |= ((c >> i) & 1) << (n - 1 - i);
+    put(r, n);
+  }
+
+  void flush()
+  {
+    if (count)
+      put(0, 8 - count);
+  }
+};
+
+static void _gzipLiteral(_gzipBits &bits, uint16_t sym)
+{
+  if (sym < 144)
+    bits.code(0x30 + sym, 8);
+  else if (sym < 256)
+    bits.code(0x190 + sym - 144, 9);
+  else if (sym < 280)
+    bits.code(sym - 256, 7);
+  else
+    bits.code(0xC0 + sym - 280, 8);
+}
+
+static void _gzipMatch(_gzipBits &bits, uint16_t length, uint16_t distance)
+{
+  static const uint16_t lenBase[] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                     35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+  static const uint8_t lenExtra[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                     3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+  static const uint16_t distBase[] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+                                      193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+                                      6145, 8193, 12289, 16385, 24577};
+  static const uint8_t distExtra[] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+                                      6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+  uint8_t l = 28;
+  while (lenBase[l] > length)
+    l--;
+  _gzipLiteral(bits, 257 + l);
+  bits.put(length - lenBase[l], lenExtra[l]);
+
+  uint8_t d = 29;
+  while (distBase[d] > distance)
+    d--;
+  bits.code(d, 5);
+  bits.put(distance - distBase[d], distExtra[d]);
+}
+
+// Comprime 'in' como fichero gzip completo en 'out'. Devuelve los bytes
+// escritos, o 0 si no cabe en 'cap' (el llamante envía entonces sin comprimir).
+static size_t gzipCompress(const uint8_t *in, size_t len, uint8_t *out, size_t cap)
+{
+  static uint16_t head[1 << GZIP_HASH_BITS]; // posición + 1 del último trigrama con ese hash
+  if (len > 0xFFFF || cap < 18)
+    return 0;
+  memset(head, 0, sizeof(head));
+
+  static const uint8_t header[10] = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF};
+  memcpy(out, header, sizeof(header));
+  _gzipBits bits(out + 10, cap - 18);
+  bits.put(1, 1); // último bloque
+  bits.put(1, 2); // Huffman fijo
+
+  size_t i = 0;
+  while (i < len && !bits.overflow)
+  {
+    uint16_t best = 0;
+    size_t from = 0;
+    if (i + GZIP_MIN_MATCH <= len)
+    {
+      uint32_t h = ((in[i] << 10) ^ (in[i + 1] << 5) ^ in[i + 2]) * 2654435761u >> (32 - GZIP_HASH_BITS);
+      if (head[h] && i - (head[h] - 1) <= GZIP_MAX_DISTANCE)
+      {
+        from = head[h] - 1;
+        size_t limit = len - i < GZIP_MAX_MATCH ? len - i : GZIP_MAX_MATCH;
+        while (best < limit && in[from + best] == in[i + best])
+          best++;
+      }
+      head[h] = i + 1;
+    }
+
+    if (best >= GZIP_MIN_MATCH)
+    {
+      _gzipMatch(bits, best, i - from);
+      // Se indexan también las posiciones dentro de la coincidencia
+      for (size_t k = i + 1; k < i + best && k + GZIP_MIN_MATCH <= len; k++)
+        head[((in[k] << 10) ^ (in[k + 1] << 5) ^ in[k + 2]) * 2654435761u >> (32 - GZIP_HASH_BITS)] = k + 1;
+      i += best;
+    }
+    else
+    {
+      _gzipLiteral(bits, in[i]);
+      i++;
+    }
+  }
+  _gzipLiteral(bits, 256); // fin de bloque
+  bits.flush();
+  if (bits.overflow)
+    return 0;
+
+  size_t n = 10 + bits.len;
+  uint32_t crc = crc32Update(0, in, len);
+  for (int k = 0; k < 4; k++)
+    out[n++] = crc >> (8 * k);
+  for (int k = 0; k < 4; k++)
+    out[n++] = len >> (8 * k);
+  return n;
+}
+
+#endif // GZIPENCODER_H
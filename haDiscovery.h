@@ -0,0 +1,244 @@
+#ifndef HADISCOVERY_H
+#define HADISCOVERY_H
+
+#include "batteryStack.h"
+#include "buildinfo.h"
+#include "logger.h"
+#include "mqttPublisher.h"
+
+// ================== Home Assistant MQTT discovery ==================
+//
+// Publica (retenido) un config por cada topic de estado que exista ahora:
+//   <HA_DISCOVERY_PREFIX>/sensor/<nodo>/<métrica>/config
+// a partir de los módulos y celdas detectados en batteryStack. Se anuncia una
+// vez por arranque y otra cada vez que cambia la topología (módulos presentes
+// o número de celdas); las entidades que desaparecen se borran con un config
+// vacío. El primer anuncio de cada arranque borra además todos los slots
+// vacíos, porque el broker puede retener configs de antes del reinicio que
+// este arranque no ha anunciado. Los estados siguen siendo los topics
+// pequeños de mqttPublisher.h.
+//
+// Mientras hay anuncios pendientes no se publican estados; al terminar se
+// fuerza una ráfaga completa para que HA tenga valor inicial de todo.
+
+#ifndef HA_DISCOVERY_PREFIX
+#define HA_DISCOVERY_PREFIX "homeassistant"
+#endif
+#ifndef HA_DISCOVERY_CELLS
+#define HA_DISCOVERY_CELLS 1 // 0 = sin una entidad por celda
+#endif
+
+// Unidad, device_class y nombre legible de cada métrica (mismo orden que mqttMetricId)
+struct haMetricInfo
+{
+  const char *label;
+  const char *unit;
+  const char *deviceClass;
+};
+
+static const haMetricInfo _haMetricInfo[] = {
+    {"SOC", "%", "battery"},
+    {"Voltage", "V", "voltage"},
+    {"Current", "A", "current"},
+    {"Power", "W", "power"},
+    {"Temperature", "°C", "temperature"},
+    {"Cell imbalance", "mV", "voltage"},
+    {"Highest cell", "V", "voltage"},
+    {"Lowest cell", "V", "voltage"},
+    {"State", nullptr, nullptr},
+    {"Cell", "V", "voltage"},
+};
+
+struct haDiscovery
+{
+  char node[24];               // WIFI_HOSTNAME en minúsculas, solo [a-z0-9_]
+  uint8_t announced[(MQTT_METRIC_SLOTS + 7) / 8];
+  uint32_t announcedTopology = 0;
+  uint8_t knownCells[MAX_PYLON_BATTERIES_SUPPORTED]; // última cuenta de celdas no nula
+  uint32_t pendingTopology = 0;
+  bool running = false;
+  bool sweep = false;          // primer anuncio del arranque: borra todo lo ausente
+  uint16_t cursor = 0;
+  uint16_t configs = 0;        // configs publicados (incluidos borrados)
+
+  void begin()
+  {
+    size_t n = 0;
+    for (const char *p = WIFI_HOSTNAME; *p && n < sizeof(node) - 1; p++)
+    {
+      char c = *p;
+      if (c >= 'A' && c <= 'Z')
+        c += 'a' - 'A';
+      node[n++] = ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) ? c : '_';
+    }
+    node[n] = '\0';
+    memset(announced, 0, sizeof(announced));
+    memset(knownCells, 0, sizeof(knownCells));
+  }
+
+  // Huella de la topología: módulos presentes y celdas de cada uno. Un
+  // 'bat N' sin respuesta deja el módulo con 0 celdas durante una adquisición;
+  // cuenta la última cifra no nula para no borrar y volver a anunciar sus
+  // entidades de celda.
+  uint32_t topologyOf(const batteryStack &st)
+  {
+    uint32_t h = 2166136261UL; // FNV-1a
+    for (int i = 0; i < MAX_PYLON_BATTERIES_SUPPORTED; i++)
+    {
+      if (!st.batts[i].isPresent)
+      {
+        knownCells[i] = 0;
+        continue;
+      }
+      if (st.batts[i].cellCount > 0)
+        knownCells[i] = st.batts[i].cellCount;
+      h = (h ^ (uint32_t)(i + 1)) * 16777619UL;
+      h = (h ^ knownCells[i]) * 16777619UL;
+    }
+    return h | 1; // 0 = nunca anunciado
+  }
+
+  bool isAnnounced(uint16_t slot) const { return announced[slot >> 3] & (1 << (slot & 7)); }
+
+  void setAnnounced(uint16_t slot, bool on)
+  {
+    if (on)
+      announced[slot >> 3] |= 1 << (slot & 7);
+    else
+      announced[slot >> 3] &= ~(1 << (slot & 7));
+  }
+
+  // Sufijo único de la métrica: "soc", "2_voltage", "2_cell_7"
+  static void suffixOf(char *buf, size_t cap, const mqttMetric &m)
+  {
+    if (m.module == 0)
+      snprintf(buf, cap, "%s", _mqttMetricInfo[m.id].name);
+    else if (m.id == MQTT_CELL)
+      snprintf(buf, cap, "%u_cell_%u", m.module, m.cell);
+    else
+      snprintf(buf, cap, "%u_%s", m.module, _mqttMetricInfo[m.id].name);
+  }
+
+  size_t formatConfig(char *buf, size_t cap, const mqttMetric &m, const char *suffix)
+  {
+    const haMetricInfo &info = _haMetricInfo[m.id];
+    char stateTopic[64];
+    mqttFormatTopic(stateTopic, sizeof(stateTopic), m);
+
+    bufferSink sink((uint8_t *)buf, cap - 1);
+    textWriter<bufferSink> out(sink);
+    // Claves abreviadas de HA para que cada config ocupe menos
+    out.print("{\"name\":\"");
+    if (m.module == 0)
+      out.printf("Stack %s", info.label);
+    else if (m.id == MQTT_CELL)
+      out.printf("Module %u cell %u", m.module, m.cell);
+    else
+      out.printf("Module %u %s", m.module, info.label);
+    out.printf("\",\"uniq_id\":\"%s_%s\",\"stat_t\":\"%s\",\"avty_t\":\"%sstatus\"",
+               node, suffix, stateTopic, MQTT_TOPIC_ROOT);
+    if (info.unit)
+      out.printf(",\"unit_of_meas\":\"%s\",\"dev_cla\":\"%s\",\"stat_cla\":\"measurement\"", info.unit, info.deviceClass);
+    if (m.id == MQTT_CELL)
+      out.print(",\"ent_cat\":\"diagnostic\"");
+    out.printf(",\"dev\":{\"ids\":[\"%s\"],\"name\":\"%s\",\"mf\":\"Pylontech\",\"mdl\":\"US2000/US3000\",\"sw\":\"%s\"}}",
+               node, WIFI_HOSTNAME, FIRMWARE_VERSION);
+    buf[sink.len] = '\0';
+    return sink.len;
+  }
+
+  // Un paso del anuncio; devuelve true mientras queden configs por publicar
+  bool step(mqttPublisher &pub)
+  {
+    const batteryStack &st = *pub.stack;
+    if (!running)
+    {
+      if (st.generation == 0 || st.batteryCount == 0)
+        return false;
+      uint32_t topology = topologyOf(st);
+      if (topology == announcedTopology)
+        return false;
+      running = true;
+      sweep = announcedTopology == 0;
+      pendingTopology = topology;
+      cursor = 0;
+      LOG_I(HA, "Publishing discovery configs");
+    }
+
+    char suffix[24];
+    char topic[96];
+    char payload[512];
+    int budget = MQTT_PUBLISH_BUDGET;
+
+    while (cursor < MQTT_METRIC_SLOTS && budget > 0)
+    {
+      mqttMetric m = {};
+      bool present = mqttMetricAt(st, cursor, m);
+      // Celdas que faltan solo en esta adquisición: el config se queda
+      if (!present && m.module && m.id == MQTT_CELL && m.cell <= knownCells[m.module - 1])
+        present = true;
+      if (present && m.id == MQTT_CELL && !HA_DISCOVERY_CELLS)
+        present = false;
+
+      if (present != isAnnounced(cursor) || (sweep && !present))
+      {
+        if (!present)
+          m = slotMetric(cursor); // solo para nombrar el topic a borrar
+        suffixOf(suffix, sizeof(suffix), m);
+        snprintf(topic, sizeof(topic), "%s/sensor/%s/%s/config", HA_DISCOVERY_PREFIX, node, suffix);
+        size_t len = present ? formatConfig(payload, sizeof(payload), m, suffix) : 0;
+        if (!pub.publish(topic, payload, len, true))
+          return true; // sin sitio en el buffer: se reintenta en la siguiente vuelta
+        setAnnounced(cursor, present);
+        configs++;
+        budget--;
+      }
+      cursor++;
+    }
+
+    if (cursor < MQTT_METRIC_SLOTS)
+      return true;
+
+    running = false;
+    announcedTopology = pendingTopology;
+    pub.slots.reset(); // valor inicial para todas las entidades
+    LOG_I(HA, "Discovery done (%u configs)", configs);
+    return false;
+  }
+
+  // Identidad del slot sin mirar el snapshot (para módulos que ya no están)
+  static mqttMetric slotMetric(uint16_t slot)
+  {
+    mqttMetric m = {};
+    if (slot < MQTT_METRICS_PER_SCOPE)
+    {
+      m.id = slot;
+      return m;
+    }
+    slot -= MQTT_METRICS_PER_SCOPE;
+    m.module = slot / MQTT_SLOTS_PER_MODULE + 1;
+    uint16_t k = slot % MQTT_SLOTS_PER_MODULE;
+    if (k >= MQTT_METRICS_PER_SCOPE)
+    {
+      m.id = MQTT_CELL;
+      m.cell = k - MQTT_METRICS_PER_SCOPE + 1;
+    }
+    else
+    {
+      m.id = k;
+    }
+    return m;
+  }
+};
+
+static haDiscovery _haDiscovery;
+
+// Engancha el anuncio al publicador: corre antes de cada ciclo de estados
+void setupHaDiscovery(mqttPublisher &pub)
+{
+  _haDiscovery.begin();
+  pub.preCycle = [](mqttPublisher &p)
+  { return _haDiscovery.step(p); };
+}
+
+#endif // HADISCOVERY_H
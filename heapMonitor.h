@@ -0,0 +1,227 @@
+#ifndef HEAPMONITOR_H
+#define HEAPMONITOR_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "routeTable.h"
+#include "telemetryCodec.h"
+
+#if defined(ESP8266)
+#include <umm_malloc/umm_malloc.h>
+#endif
+
+// ================== Heap: libre, bloque máximo, fragmentación ==================
+//
+// Se muestrea una vez por segundo desde loop() (y con cada scrape): heap
+// libre, bloque libre más grande y fragmentación (100 - bloque*100/libre).
+// Las marcas de agua (mínimo libre, mínimo bloque, máxima fragmentación) son
+// desde el arranque y no se ponen a cero.
+//
+// Por ruta HTTP (routeTable.h), entre el hook del servidor y el final de
+// handleClient():
+//   - retained: suma de (libre antes - libre después); si crece sin parar,
+//     la ruta se queda memoria;
+//   - blockLossMax: la mayor caída del bloque máximo en una petición, lo que
+//     la ruta fragmenta;
+//   - allocs y peak: mallocs+reallocs y uso transitorio máximo durante la
+//     petición. Solo con las estadísticas completas de umm_malloc
+//     (-DUMM_STATS_FULL en los build_flags del core ESP8266); sin ellas
+//     /heap da "allocs":null.
+
+#define HEAP_SAMPLE_MS 1000
+
+#if defined(ESP8266) && defined(UMM_STATS_FULL)
+#define HEAP_ALLOC_STATS 1
+#endif
+
+struct heapRouteStats
+{
+  uint32_t requests;
+  uint32_t allocs;
+  uint32_t peakMax;
+  uint64_t peakSum;
+  int32_t retained;
+  uint32_t blockLossMax;
+};
+
+struct heapMonitor
+{
+  // Último muestreo
+  uint32_t freeBytes = 0;
+  uint32_t maxBlock = 0;
+  uint8_t fragmentation = 0;
+  uint32_t samples = 0;
+  unsigned long sampledAt = 0;
+
+  // Marcas de agua desde el arranque
+  uint32_t minFree = UINT32_MAX;
+  uint32_t minMaxBlock = UINT32_MAX;
+  uint8_t maxFragmentation = 0;
+  unsigned long minFreeAt = 0;
+
+  // Por ruta (indexado como httpRoutes) y petición en curso
+  heapRouteStats routes[HTTP_MAX_ROUTES];
+  unsigned long routesResetAt = 0;
+  uint32_t reqFree = 0;
+  uint32_t reqBlock = 0;
+  uint32_t reqAllocs = 0;
+
+  heapMonitor() { memset(routes, 0, sizeof(routes)); }
+
+  static void read(uint32_t &free, uint32_t &block)
+  {
+#if defined(ESP8266)
+    free = ESP.getFreeHeap();
+    block = ESP.getMaxFreeBlockSize();
+#elif defined(ESP32)
+    free = ESP.getFreeHeap();
+    block = ESP.getMaxAllocHeap();
+#else
+    free = block = 0;
+#endif
+  }
+
+  static uint32_t allocCount()
+  {
+#ifdef HEAP_ALLOC_STATS
+    return umm_get_malloc_count() + umm_get_realloc_count();
+#else
+    return 0;
+#endif
+  }
+
+  // Peticiones de memoria que umm_malloc no pudo atender desde el arranque
+  static uint32_t oomCount()
+  {
+#if defined(ESP8266) && (defined(UMM_STATS) || defined(UMM_STATS_FULL))
+    return umm_get_oom_count();
+#else
+    return 0;
+#endif
+  }
+
+  void watermark(uint32_t free, uint32_t block, unsigned long now)
+  {
+    if (free < minFree)
+    {
+      minFree = free;
+      minFreeAt = now;
+    }
+    if (block < minMaxBlock)
+      minMaxBlock = block;
+  }
+
+  void sample(unsigned long now)
+  {
+    read(freeBytes, maxBlock);
+    if (freeBytes == 0)
+      return;
+    fragmentation = maxBlock >= freeBytes ? 0 : 100 - (uint64_t)maxBlock * 100 / freeBytes;
+    if (fragmentation > maxFragmentation)
+      maxFragmentation = fragmentation;
+    watermark(freeBytes, maxBlock, now);
+    samples++;
+    sampledAt = now;
+  }
+
+  // Llamar en cada vuelta de loop()
+  void loop(unsigned long now)
+  {
+    if (samples == 0 || now - sampledAt >= HEAP_SAMPLE_MS)
+      sample(now);
+  }
+
+  // Desde el hook del servidor, ya con la ruta anotada
+  void requestBegin()
+  {
+    read(reqFree, reqBlock);
+    reqAllocs = allocCount();
+#ifdef HEAP_ALLOC_STATS
+    umm_free_heap_size_min_reset();
+#endif
+  }
+
+  // Tras handleClient(), si hubo petición
+  void requestEnd(int8_t route, unsigned long now)
+  {
+    uint32_t free, block;
+    read(free, block);
+    if (route < 0 || reqFree == 0)
+      return;
+    heapRouteStats &r = routes[route];
+    r.requests++;
+    r.retained += (int32_t)(reqFree - free);
+    if (reqBlock > block && reqBlock - block > r.blockLossMax)
+      r.blockLossMax = reqBlock - block;
+#ifdef HEAP_ALLOC_STATS
+    uint32_t low = umm_free_heap_size_min();
+    uint32_t peak = reqFree > low ? reqFree - low : 0;
+    r.allocs += allocCount() - reqAllocs;
+    r.peakSum += peak;
+    if (peak > r.peakMax)
+      r.peakMax = peak;
+    watermark(low, block, now);
+#else
+    watermark(free, block, now);
+#endif
+    reqFree = 0;
+  }
+
+  // Resumen para MQTT (<root>heap); devuelve la longitud
+  size_t formatMqtt(char *buf, size_t cap) const
+  {
+    int n = snprintf(buf, cap, "{\"free\":%lu,\"maxBlock\":%lu,\"fragmentation\":%u,\"minFree\":%lu,\"minMaxBlock\":%lu,\"maxFragmentation\":%u,\"oom\":%lu}",
+                     (unsigned long)freeBytes, (unsigned long)maxBlock, fragmentation,
+                     (unsigned long)(samples ? minFree : 0), (unsigned long)(samples ? minMaxBlock : 0),
+                     maxFragmentation, (unsigned long)oomCount());
+    return n < 0 ? 0 : (size_t)n < cap ? n : cap - 1;
+  }
+
+  void resetRoutes(unsigned long now)
+  {
+    memset(routes, 0, sizeof(routes));
+    routesResetAt = now;
+  }
+};
+
+// ================== /heap ==================
+
+template <typename Sink>
+void writeHeapJson(Sink &sink, const heapMonitor &h, const routeTable &names, unsigned long now)
+{
+  textWriter<Sink> out(sink);
+  out.printf("{\"free\":%lu,\"maxBlock\":%lu,\"fragmentation\":%u,\"samples\":%lu,",
+             (unsigned long)h.freeBytes, (unsigned long)h.maxBlock, h.fragmentation, (unsigned long)h.samples);
+  out.printf("\"minFree\":%lu,\"minFreeAgoMs\":%ld,\"minMaxBlock\":%lu,\"maxFragmentation\":%u,\"oom\":%lu,",
+             (unsigned long)(h.samples ? h.minFree : 0), h.samples ? (long)(now - h.minFreeAt) : -1L,
+             (unsigned long)(h.samples ? h.minMaxBlock : 0), h.maxFragmentation, (unsigned long)heapMonitor::oomCount());
+#ifdef HEAP_ALLOC_STATS
+  out.print("\"allocStats\":true,");
+#else
+  out.print("\"allocStats\":false,");
+#endif
+  out.printf("\"routesWindowMs\":%lu,\"routes\":[", now - h.routesResetAt);
+  bool first = true;
+  for (uint8_t i = 0; i < names.count; i++)
+  {
+    const heapRouteStats &r = h.routes[i];
+    if (r.requests == 0)
+      continue;
+    out.printf("%s{\"name\":\"%s\",\"requests\":%lu,\"retained\":%ld,\"blockLossMax\":%lu,",
+               first ? "" : ",", names.names[i], (unsigned long)r.requests, (long)r.retained,
+               (unsigned long)r.blockLossMax);
+#ifdef HEAP_ALLOC_STATS
+    out.printf("\"allocs\":%lu,\"allocsPerRequest\":%lu,\"peakMax\":%lu,\"peakMean\":%lu}",
+               (unsigned long)r.allocs, (unsigned long)(r.allocs / r.requests), (unsigned long)r.peakMax,
+               (unsigned long)(r.peakSum / r.requests));
+#else
+    out.print("\"allocs\":null}");
+#endif
+    first = false;
+  }
+  out.print("]}");
+}
+
+#endif // HEAPMONITOR_H
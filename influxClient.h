@@ -0,0 +1,52 @@
+#ifndef INFLUXCLIENT_H
+#define INFLUXCLIENT_H
+
+#ifdef ESP8266
+#include <ESP8266HTTPClient.h>
+#else
+#include <HTTPClient.h>
+#endif
+#include <WiFiClient.h>
+
+#include "PylontechMonitoring.h"
+#include "influxExporter.h"
+
+// ================== Transporte InfluxDB sobre HTTPClient ==================
+// POST síncrono a INFLUX_URL con la conexión reutilizada entre lotes. Como
+// solo hay un POST por lote (minutos), el tiempo que bloquea loop() queda
+// acotado por INFLUX_HTTP_TIMEOUT_MS.
+
+#ifndef INFLUX_HTTP_TIMEOUT_MS
+#define INFLUX_HTTP_TIMEOUT_MS 3000
+#endif
+#ifndef INFLUX_TOKEN
+#define INFLUX_TOKEN "" // InfluxDB 2.x: "Authorization: Token ..."; vacío en 1.x sin auth
+#endif
+
+struct httpInfluxTransport : influxTransport
+{
+  WiFiClient client;
+  HTTPClient http;
+
+  void begin()
+  {
+    http.setReuse(true);
+    http.setTimeout(INFLUX_HTTP_TIMEOUT_MS);
+  }
+
+  int post(const uint8_t *body, size_t len, bool gzipped) override
+  {
+    if (!http.begin(client, INFLUX_URL))
+      return -1;
+    http.addHeader("Content-Type", "text/plain; charset=utf-8");
+    if (gzipped)
+      http.addHeader("Content-Encoding", "gzip");
+    if (INFLUX_TOKEN[0])
+      http.addHeader("Authorization", "Token " INFLUX_TOKEN);
+    int code = http.POST((uint8_t *)body, len);
+    http.end();
+    return code;
+  }
+};
+
+#endif // INFLUXCLIENT_H
@@ -0,0 +1,237 @@
+#ifndef INFLUXEXPORTER_H
+#define INFLUXEXPORTER_H
+
+#include "batteryStack.h"
+#include "logger.h"
+#include "gzipEncoder.h"
+#include "telemetryCodec.h"
+
+// ================== Exportador InfluxDB (line protocol por lotes) ==================
+//
+// En lugar de que la base de datos sondee la web, el dispositivo empuja las
+// muestras. Cada adquisición nueva (como mucho una cada
+// INFLUX_SAMPLE_INTERVAL_SEC) añade al lote una línea con los agregados de la
+// pila y otra por módulo, con sello de tiempo en segundos:
+//
+//   pylontech,host=H soc=87i,voltage=49.811,current=-8.830,power=-439.8,... 1718000000
+//   pylontech_module,host=H,module=1 soc=87i,...,cell01=3.320,...,cell15=3.341 1718000000
+//
+// El lote se envía con un POST cuando pasa de INFLUX_FLUSH_BYTES o cuando la
+// muestra más antigua tiene INFLUX_FLUSH_INTERVAL_SEC. Se comprime con gzip
+// (gzipEncoder.h) si así ocupa menos. Si el servidor no responde o devuelve
+// 5xx/429, el lote se conserva y se reintenta con espera exponencial; mientras
+// tanto se siguen añadiendo muestras hasta llenar el buffer, y las que ya no
+// caben se descartan (se conserva lo más antiguo). Un 4xx descarta el lote:
+// reenviarlo no lo arreglaría.
+//
+// Sin NTP no se muestrea: un sello de "segundos desde arranque" ensuciaría la serie.
+
+#ifndef INFLUX_BATCH_BYTES
+#define INFLUX_BATCH_BYTES 6144 // buffer del lote (estático, no heap; + la mitad para gzip)
+#endif
+#ifndef INFLUX_FLUSH_BYTES
+#define INFLUX_FLUSH_BYTES (INFLUX_BATCH_BYTES * 3 / 4)
+#endif
+#ifndef INFLUX_FLUSH_INTERVAL_SEC
+#define INFLUX_FLUSH_INTERVAL_SEC 120
+#endif
+#ifndef INFLUX_SAMPLE_INTERVAL_SEC
+#define INFLUX_SAMPLE_INTERVAL_SEC 30
+#endif
+#ifndef INFLUX_GZIP
+#define INFLUX_GZIP 1
+#endif
+#define INFLUX_GZIP_BYTES (INFLUX_BATCH_BYTES / 2) // si comprimido no cabe, va en claro
+#define INFLUX_RETRY_MIN_MS 5000
+#define INFLUX_RETRY_MAX_MS 300000
+#define INFLUX_MEASUREMENT "pylontech"
+
+// Una muestra: agregados de la pila y una línea por módulo presente
+template <typename Sink>
+static void writeInfluxSample(Sink &sink, const batteryStack &st, const char *host, uint32_t timestamp)
+{
+  textWriter<Sink> out(sink);
+
+  out.printf(INFLUX_MEASUREMENT ",host=%s soc=%ldi,voltage=", host, (long)st.soc);
+  out.milli(st.avgVoltage, 3);
+  out.print(",current=");
+  out.milli(st.currentDC, 3);
+  out.print(",power=");
+  out.milli((long)((long long)st.avgVoltage * st.currentDC / 1000), 1);
+  out.print(",temperature=");
+  out.milli(st.temp, 1);
+  out.printf(",imbalance=%ldi,modules=%di", st.imbalanceMv(), (int)st.batteryCount);
+  if (st.cellVoltHighBatt != 0)
+  {
+    out.print(",cell_high=");
+    out.milli(st.cellVoltHigh, 3);
+    out.print(",cell_low=");
+    out.milli(st.cellVoltLow, 3);
+  }
+  out.printf(",state=\"%s\" %lu\n", st.baseState, (unsigned long)timestamp);
+
+  for (int i = 0; i < MAX_PYLON_BATTERIES_SUPPORTED; i++)
+  {
+    const pylonBattery &b = st.batts[i];
+    if (!b.isPresent)
+      continue;
+    out.printf(INFLUX_MEASUREMENT "_module,host=%s,module=%d soc=%ldi,voltage=", host, i + 1, (long)b.soc);
+    out.milli(b.voltage, 3);
+    out.print(",current=");
+    out.milli(b.current, 3);
+    out.print(",power=");
+    out.milli((long)((long long)b.voltage * b.current / 1000), 1);
+    out.print(",temperature=");
+    out.milli(b.tempr, 1);
+    out.printf(",imbalance=%ldi", b.imbalanceMv());
+    if (b.cellVoltHigh > 0)
+    {
+      out.print(",cell_high=");
+      out.milli(b.cellVoltHigh, 3);
+      out.print(",cell_low=");
+      out.milli(b.cellVoltLow, 3);
+    }
+    out.printf(",state=\"%s\"", b.baseState);
+    for (int c = 0; c < b.cellCount; c++)
+    {
+      out.printf(",cell%02d=", c + 1);
+      out.milli(b.cellVolt[c], 3);
+    }
+    out.printf(" %lu\n", (unsigned long)timestamp);
+  }
+}
+
+// Envío HTTP. Permite sustituir HTTPClient por un cliente de host en las pruebas.
+struct influxTransport
+{
+  // POST del lote; devuelve el código HTTP, o <= 0 si no hubo respuesta
+  virtual int post(const uint8_t *body, size_t len, bool gzipped) = 0;
+};
+
+struct influxExporter
+{
+  influxTransport *transport = nullptr;
+  const batteryStack *stack = nullptr;
+  const char *host = "";
+
+  uint8_t batch[INFLUX_BATCH_BYTES];
+  uint8_t packed[INFLUX_GZIP_BYTES];
+  size_t len = 0;
+  uint16_t batchSamples = 0;
+  unsigned long firstSampleAt = 0;
+  unsigned long lastSampleAt = 0;
+  uint32_t sampledGeneration = 0;
+  bool full = false; // una muestra ya no cupo: enviar en cuanto se pueda
+
+  // Reintentos
+  unsigned long nextPostAt = 0;
+  unsigned long backoffMs = 0;
+
+  // Estadísticas
+  uint32_t samples = 0;
+  uint32_t delivered = 0; // muestras aceptadas por el servidor
+  uint32_t dropped = 0;   // muestras que no cupieron en el lote
+  uint32_t rejected = 0;  // muestras descartadas por un 4xx
+  uint32_t posts = 0;
+  uint32_t failures = 0;
+  uint32_t rawBytes = 0;
+  uint32_t sentBytes = 0;
+  int lastStatus = 0;
+
+  void begin(influxTransport &t, const batteryStack &st, const char *hostTag)
+  {
+    transport = &t;
+    stack = &st;
+    host = hostTag;
+  }
+
+  // Llamar tras cada adquisición
+  void sample(uint32_t timestamp, bool synced, unsigned long now)
+  {
+    if (!stack || stack->generation == sampledGeneration || stack->batteryCount == 0 || !synced)
+      return;
+    if (sampledGeneration != 0 && now - lastSampleAt < INFLUX_SAMPLE_INTERVAL_SEC * 1000UL)
+      return;
+    sampledGeneration = stack->generation;
+    lastSampleAt = now;
+    samples++;
+
+    bufferSink sink(batch + len, sizeof(batch) - len);
+    writeInfluxSample(sink, *stack, host, timestamp);
+    if (sink.overflow)
+    {
+      dropped++;
+      full = true;
+      return;
+    }
+    if (batchSamples == 0)
+      firstSampleAt = now;
+    len += sink.len;
+    batchSamples++;
+  }
+
+  // Llamar en cada vuelta de loop(); el POST (si toca) bloquea como mucho
+  // INFLUX_HTTP_TIMEOUT_MS, una vez por lote
+  void loop(unsigned long now)
+  {
+    if (!transport || batchSamples == 0)
+      return;
+    bool due = full || len >= INFLUX_FLUSH_BYTES || now - firstSampleAt >= INFLUX_FLUSH_INTERVAL_SEC * 1000UL;
+    if (!due || (backoffMs && (long)(now - nextPostAt) < 0))
+      return;
+    flush(now);
+  }
+
+  void flush(unsigned long now)
+  {
+    const uint8_t *body = batch;
+    size_t bodyLen = len;
+    bool gzipped = false;
+#if INFLUX_GZIP
+    size_t n = gzipCompress(batch, len, packed, sizeof(packed));
+    if (n > 0 && n < len)
+    {
+      body = packed;
+      bodyLen = n;
+      gzipped = true;
+    }
+#endif
+
+    posts++;
+    int code = transport->post(body, bodyLen, gzipped);
+    lastStatus = code;
+
+    if (code >= 200 && code < 300)
+    {
+      delivered += batchSamples;
+      rawBytes += len;
+      sentBytes += bodyLen;
+      reset();
+      backoffMs = 0;
+      return;
+    }
+
+    failures++;
+    if (code >= 400 && code < 500 && code != 429)
+    {
+      LOG_W(INFLUX, "HTTP %d: batch of %u samples discarded", code, (unsigned)batchSamples);
+      rejected += batchSamples;
+      reset();
+      backoffMs = 0;
+      return;
+    }
+
+    backoffMs = backoffMs == 0 ? INFLUX_RETRY_MIN_MS : (backoffMs * 2 > INFLUX_RETRY_MAX_MS ? INFLUX_RETRY_MAX_MS : backoffMs * 2);
+    nextPostAt = now + backoffMs;
+    LOG_W(INFLUX, "POST failed (%d), retrying in %lus", code, backoffMs / 1000);
+  }
+
+  void reset()
+  {
+    len = 0;
+    batchSamples = 0;
+    full = false;
+  }
+};
+
+#endif // INFLUXEXPORTER_H
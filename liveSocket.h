@@ -0,0 +1,212 @@
+#ifndef LIVESOCKET_H
+#define LIVESOCKET_H
+
+#include <WebSocketsServer.h>
+
+#include "batteryStack.h"
+#include "logger.h"
+#include "PylontechMonitoring.h"
+#include "webInterface.h"
+
+// ================== WebSocket: telemetría en vivo + consola BMS ==================
+//
+// Mensajes servidor -> cliente (texto JSON, uno por frame):
+//   {"type":"telemetry","generation":..,"uptime":..,"modules":[{"id":1,"soc":..,...}]}
+//   {"type":"line","data":"..."}      una línea de salida del BMS
+//   {"type":"done","ok":true}         fin del comando (prompt o timeout)
+//   {"type":"busy"}                   la cola interactiva de la consola está llena (bmsScheduler.h)
+//   {"type":"error","msg":"..."}      comando rechazado (más largo que BMS_CMD_MAX - 1)
+//   {"type":"log","seq":..,"ms":..,"level":"I","tag":"MQTT","msg":"..."}   tras "!log"
+//
+// Cliente -> servidor: cada frame de texto es un comando de consola ("bat", "pwr 2"...),
+// salvo los que empiezan por '!', que son del monitor:
+//   !log [nivel]   recibir el log (logger.h) desde el registro más antiguo del
+//                  anillo, hasta 'nivel' (1 errores ... 4 depuración, por defecto 4)
+//   !nolog         dejar de recibirlo
+
+#ifndef WEBSOCKET_CONSOLE_TIMEOUT_MS
+#define WEBSOCKET_CONSOLE_TIMEOUT_MS 5000
+#endif
+#define WEBSOCKET_LOG_BUDGET 4 // registros del log por cliente y vuelta de loop()
+
+static WebSocketsServer *_liveWs = nullptr;
+static batteryStack *_liveStack = nullptr;
+// Sube al desconectarse un cliente: la salida de un comando encolado antes no
+// va a quien herede su número
+static uint8_t _liveClientEpoch[WEBSOCKETS_SERVER_CLIENT_MAX];
+
+// Suscripciones al log: nivel máximo (0 = sin suscripción) y próxima secuencia
+static uint8_t _liveLogLevel[WEBSOCKETS_SERVER_CLIENT_MAX];
+static uint32_t _liveLogNext[WEBSOCKETS_SERVER_CLIENT_MAX];
+
+static bool _liveConsoleOwner(uint8_t num, uint8_t epoch)
+{
+  return _liveWs && num < WEBSOCKETS_SERVER_CLIENT_MAX && _liveClientEpoch[num] == epoch;
+}
+
+static void _liveConsoleLine(uint8_t num, uint8_t epoch, const char *line)
+{
+  if (!_liveConsoleOwner(num, epoch))
+    return;
+  String msg;
+  msg.reserve(strlen(line) + 32);
+  msg = F("{\"type\":\"line\",\"data\":\"");
+  _jsonEscapeAppend(msg, line);
+  msg += F("\"}");
+  _liveWs->sendTXT(num, msg);
+}
+
+static void _liveConsoleDone(uint8_t num, uint8_t epoch, bool ok)
+{
+  if (_liveConsoleOwner(num, epoch))
+    _liveWs->sendTXT(num, ok ? "{\"type\":\"done\",\"ok\":true}" : "{\"type\":\"done\",\"ok\":false}");
+}
+
+static void _liveSocketEvent(uint8_t num, WStype_t type, uint8_t *payload, size_t length)
+{
+  switch (type)
+  {
+  case WStype_CONNECTED:
+    LOG_D(WS, "Client %u connected", num);
+    break;
+
+  case WStype_DISCONNECTED:
+    // Sus comandos siguen hasta el prompt para no dejar la consola a medias
+    if (num < WEBSOCKETS_SERVER_CLIENT_MAX)
+    {
+      _liveClientEpoch[num]++;
+      _liveLogLevel[num] = 0;
+    }
+    break;
+
+  case WStype_TEXT:
+  {
+    String cmd;
+    cmd.reserve(length + 1);
+    for (size_t i = 0; i < length; i++)
+      cmd += (char)payload[i];
+    cmd.trim();
+    if (cmd.length() == 0)
+      break;
+
+    if (cmd[0] == '!')
+    {
+      if (num >= WEBSOCKETS_SERVER_CLIENT_MAX)
+        break;
+      if (cmd.startsWith("!log"))
+      {
+        long level = cmd.length() > 4 ? cmd.substring(4).toInt() : LOG_LEVEL_DEBUG;
+        _liveLogLevel[num] = level < LOG_LEVEL_ERROR ? LOG_LEVEL_ERROR : level > LOG_LEVEL_DEBUG ? LOG_LEVEL_DEBUG : level;
+        _liveLogNext[num] = logBuffer.firstSeq;
+      }
+      else if (cmd == "!nolog")
+      {
+        _liveLogLevel[num] = 0;
+      }
+      break;
+    }
+
+    uint8_t epoch = num < WEBSOCKETS_SERVER_CLIENT_MAX ? _liveClientEpoch[num] : 0;
+    auto onLine = [num, epoch](const char *line)
+    { _liveConsoleLine(num, epoch, line); };
+    auto onDone = [num, epoch](bool ok)
+    { _liveConsoleDone(num, epoch, ok); };
+    if (!bmsQueue.submit(BMS_INTERACTIVE, cmd.c_str(), WEBSOCKET_CONSOLE_TIMEOUT_MS, onLine, onDone))
+      _liveWs->sendTXT(num, bmsQueue.lastReject == BMS_CMD_TOO_LONG ? "{\"type\":\"error\",\"msg\":\"command too long\"}"
+                                                                     : "{\"type\":\"busy\"}");
+    break;
+  }
+
+  default:
+    break;
+  }
+}
+
+void setupLiveSocket(WebSocketsServer &ws, batteryStack *batteryData)
+{
+  _liveWs = &ws;
+  _liveStack = batteryData;
+  ws.onEvent(_liveSocketEvent);
+  ws.begin();
+}
+
+// Envía a los suscritos los registros nuevos del log, unos pocos por vuelta
+static void _liveLogPump()
+{
+  logRecord r;
+  String msg;
+  for (uint8_t c = 0; c < WEBSOCKETS_SERVER_CLIENT_MAX; c++)
+  {
+    if (_liveLogLevel[c] == 0)
+      continue;
+    for (int sent = 0; sent < WEBSOCKET_LOG_BUDGET && logBuffer.read(_liveLogNext[c], r);)
+    {
+      _liveLogNext[c] = r.seq + 1;
+      if (r.level > _liveLogLevel[c])
+        continue;
+      char head[96];
+      snprintf(head, sizeof(head), "{\"type\":\"log\",\"seq\":%lu,\"ms\":%lu,\"level\":\"%c\",\"tag\":\"%s\",\"msg\":\"",
+               (unsigned long)r.seq, (unsigned long)r.ms, _logLevelLetters[r.level], _logTagNames[r.tag]);
+      msg.reserve(sizeof(head) + LOG_LINE_MAX + 8);
+      msg = head;
+      _jsonEscapeAppend(msg, r.text);
+      msg += F("\"}");
+      _liveWs->sendTXT(c, msg);
+      sent++;
+    }
+  }
+}
+
+// Llamar en cada vuelta de loop(): atiende clientes (la consola avanza con bmsQueue.poll())
+void liveSocketLoop()
+{
+  if (_liveWs)
+  {
+    _liveWs->loop();
+    _liveLogPump();
+  }
+}
+
+// Difunde el estado de las baterías presentes tras cada adquisición
+void liveSocketBroadcastTelemetry()
+{
+  if (!_liveWs || !_liveStack || _liveWs->connectedClients() == 0)
+    return;
+
+  String msg;
+  msg.reserve(96 + 128 * 2);
+  msg = F("{\"type\":\"telemetry\",\"generation\":");
+  msg += String(_liveStack->generation);
+  msg += F(",\"uptime\":");
+  msg += String(millis());
+  msg += F(",\"modules\":[");
+
+  bool first = true;
+  for (int i = 0; i < MAX_PYLON_BATTERIES_SUPPORTED; i++)
+  {
+    const pylonBattery &b = _liveStack->batts[i];
+    if (!b.isPresent)
+      continue;
+    if (!first)
+      msg += ',';
+    first = false;
+    msg += F("{\"id\":");
+    msg += String(i + 1);
+    msg += F(",\"soc\":");
+    msg += String(b.soc);
+    msg += F(",\"voltage\":");
+    msg += String(b.voltage / 1000.0f, 3);
+    msg += F(",\"current\":");
+    msg += String(b.current / 1000.0f, 3);
+    msg += F(",\"temperature\":");
+    msg += String(b.tempr / 1000.0f, 1);
+    msg += F(",\"imbalanceMv\":");
+    msg += String(b.imbalanceMv());
+    msg += '}';
+  }
+  msg += F("]}");
+
+  _liveWs->broadcastTXT(msg);
+}
+
+#endif // LIVESOCKET_H
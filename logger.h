@@ -0,0 +1,222 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// ================== Log con niveles en un anillo en RAM ==================
+//
+// En el ESP8266 Serial es la consola del BMS (#define Serial2 Serial), así
+// que el log no puede salir por ahí: cada LOG_x(TAG, fmt, ...) formatea una
+// línea y la guarda como registro binario en un anillo de LOG_RING_BYTES;
+// /log y el WebSocket (!log) la leen desde allí. Cuando el anillo se llena se
+// pisan los registros más antiguos.
+//
+//   registro: longitud del texto (1) | nivel << 5 | tag (1) | millis() (4, LE) | texto
+//
+// Los niveles por encima de LOG_LEVEL no generan código: quedan como
+// 'if (0) logWrite(...)', que el compilador elimina entero (ni la llamada ni
+// la cadena de formato llegan al binario) pero sigue comprobando el formato
+// y cuenta como uso de las variables que solo se registran. El nivel es
+// global: con -D en los build_flags vale para todas las unidades; con un
+// #define antes de incluir este fichero, solo para las cabeceras del sketch.
+//
+// 'mirror', si se asigna, recibe además cada línea ya formateada ("[TAG]
+// texto"), p. ej. para sacarla por Serial1 (GPIO2, solo TX) en el ESP8266.
+//
+// El anillo es una variable inline (C++17) para que wifiConfig.cpp y el
+// sketch escriban en el mismo.
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+#ifndef LOG_RING_BYTES
+#define LOG_RING_BYTES 4096
+#endif
+#define LOG_LINE_MAX 120 // caracteres de texto por registro (se recorta)
+#define LOG_RECORD_HEADER 6
+
+enum logTag : uint8_t
+{
+  LOG_TAG_BOOT,
+  LOG_TAG_WIFI,
+  LOG_TAG_WIFICFG,
+  LOG_TAG_NET,
+  LOG_TAG_OTA,
+  LOG_TAG_HTTP,
+  LOG_TAG_WS,
+  LOG_TAG_BMS,
+  LOG_TAG_BATTERY,
+  LOG_TAG_HISTORY,
+  LOG_TAG_NTP,
+  LOG_TAG_MQTT,
+  LOG_TAG_OUTBOX,
+  LOG_TAG_HA,
+  LOG_TAG_INFLUX,
+  LOG_TAG_MODBUS,
+  LOG_TAG_UDP,
+  LOG_TAG_COUNT
+};
+
+static const char *const _logTagNames[LOG_TAG_COUNT] = {
+    "BOOT", "WiFi", "WiFiConfig", "NET", "OTA", "HTTP", "WS", "BMS", "BATTERY",
+    "HISTORY", "NTP", "MQTT", "OUTBOX", "HA", "INFLUX", "MODBUS", "UDP"};
+
+static const char _logLevelLetters[] = "-EWID";
+
+struct logRecord
+{
+  uint32_t seq;
+  uint32_t ms;
+  uint8_t level;
+  uint8_t tag;
+  uint8_t len;
+  char text[LOG_LINE_MAX + 1];
+};
+
+struct logRing
+{
+  uint8_t buf[LOG_RING_BYTES];
+  uint16_t head = 0; // próximo byte a escribir
+  uint16_t tail = 0; // primer byte del registro más antiguo
+  uint16_t used = 0;
+  uint32_t firstSeq = 0; // secuencia del registro más antiguo
+  uint32_t nextSeq = 0;  // secuencia del próximo registro
+  uint32_t overwritten = 0;
+  uint32_t perLevel[LOG_LEVEL_DEBUG + 1] = {0};
+  void (*mirror)(const char *line) = nullptr;
+
+  uint8_t at(uint16_t pos) const { return buf[pos % LOG_RING_BYTES]; }
+
+  void put(const uint8_t *p, size_t n)
+  {
+    for (size_t i = 0; i < n; i++)
+    {
+      buf[head] = p[i];
+      head = (head + 1) % LOG_RING_BYTES;
+    }
+    used += n;
+  }
+
+  // Descarta el registro más antiguo
+  void dropOldest()
+  {
+    uint16_t size = LOG_RECORD_HEADER + at(tail);
+    tail = (tail + size) % LOG_RING_BYTES;
+    used -= size;
+    firstSeq++;
+    overwritten++;
+  }
+
+  void push(uint8_t level, uint8_t tag, uint32_t ms, const char *text, size_t len)
+  {
+    if (len > LOG_LINE_MAX)
+      len = LOG_LINE_MAX;
+    size_t size = LOG_RECORD_HEADER + len;
+    while (used + size > LOG_RING_BYTES)
+      dropOldest();
+    uint8_t header[LOG_RECORD_HEADER] = {(uint8_t)len, (uint8_t)(level << 5 | tag), (uint8_t)ms,
+                                         (uint8_t)(ms >> 8), (uint8_t)(ms >> 16), (uint8_t)(ms >> 24)};
+    put(header, sizeof(header));
+    put((const uint8_t *)text, len);
+    nextSeq++;
+    perLevel[level]++;
+  }
+
+  uint32_t count() const { return nextSeq - firstSeq; }
+
+  // Primer registro con secuencia >= 'seq' (o el más antiguo si ese ya se
+  // ha pisado). false si no hay ninguno tan nuevo.
+  bool read(uint32_t seq, logRecord &r) const
+  {
+    if (seq < firstSeq)
+      seq = firstSeq;
+    if (seq >= nextSeq)
+      return false;
+    uint16_t pos = tail;
+    for (uint32_t s = firstSeq; s < seq; s++)
+      pos = (pos + LOG_RECORD_HEADER + at(pos)) % LOG_RING_BYTES;
+    r.seq = seq;
+    r.len = at(pos);
+    r.level = at(pos + 1) >> 5;
+    r.tag = at(pos + 1) & 0x1F;
+    r.ms = (uint32_t)at(pos + 2) | (uint32_t)at(pos + 3) << 8 | (uint32_t)at(pos + 4) << 16 | (uint32_t)at(pos + 5) << 24;
+    for (uint8_t i = 0; i < r.len; i++)
+      r.text[i] = at(pos + LOG_RECORD_HEADER + i);
+    r.text[r.len] = 0;
+    return true;
+  }
+
+  void clear()
+  {
+    head = tail = used = 0;
+    firstSeq = nextSeq;
+  }
+};
+
+inline logRing logBuffer;
+
+__attribute__((format(printf, 3, 4))) inline void logWrite(uint8_t level, uint8_t tag, const char *fmt, ...)
+{
+  char line[LOG_LINE_MAX + 1];
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(line, sizeof(line), fmt, ap);
+  va_end(ap);
+  if (n < 0)
+    return;
+  size_t len = (size_t)n < sizeof(line) ? n : sizeof(line) - 1;
+  // Sin saltos de línea finales heredados de los printf
+  while (len && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+    len--;
+  line[len] = 0;
+  logBuffer.push(level, tag, millis(), line, len);
+  if (logBuffer.mirror)
+  {
+    char out[LOG_LINE_MAX + 16];
+    snprintf(out, sizeof(out), "[%s] %s", _logTagNames[tag], line);
+    logBuffer.mirror(out);
+  }
+}
+
+#define LOG_AT(level, tag, ...)                            \
+  do                                                       \
+  {                                                        \
+    if (LOG_LEVEL >= level)                                \
+      logWrite(level, LOG_TAG_##tag, __VA_ARGS__);         \
+  } while (0)
+
+#define LOG_E(tag, ...) LOG_AT(LOG_LEVEL_ERROR, tag, __VA_ARGS__)
+#define LOG_W(tag, ...) LOG_AT(LOG_LEVEL_WARN, tag, __VA_ARGS__)
+#define LOG_I(tag, ...) LOG_AT(LOG_LEVEL_INFO, tag, __VA_ARGS__)
+#define LOG_D(tag, ...) LOG_AT(LOG_LEVEL_DEBUG, tag, __VA_ARGS__)
+
+// ================== /log ==================
+
+// Una línea de texto por registro: "<seq> <segundos.ms> <nivel> [TAG] texto"
+template <typename Sink>
+void writeLogText(Sink &sink, const logRing &ring, uint32_t since, uint8_t maxLevel)
+{
+  logRecord r;
+  char head[40];
+  for (uint32_t seq = since; ring.read(seq, r); seq = r.seq + 1)
+  {
+    if (r.level > maxLevel)
+      continue;
+    int n = snprintf(head, sizeof(head), "%lu %lu.%03lu %c [%s] ", (unsigned long)r.seq, (unsigned long)(r.ms / 1000),
+                     (unsigned long)(r.ms % 1000), _logLevelLetters[r.level], _logTagNames[r.tag]);
+    sink.write(head, n);
+    sink.write(r.text, r.len);
+    sink.write("\n", 1);
+  }
+}
+
+#endif // LOGGER_H
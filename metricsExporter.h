@@ -0,0 +1,347 @@
+#ifndef METRICSEXPORTER_H
+#define METRICSEXPORTER_H
+
+#include <string.h>
+
+#include "batteryStack.h"
+#include "firmwareHealth.h"
+
+// ================== /metrics en formato de texto de Prometheus ==================
+//
+// Las familias (nombre, ayuda, tipo, ámbito) están en una tabla constante en
+// flash; por cada una se emite # HELP / # TYPE y una muestra por pila, módulo
+// o celda según su ámbito. Los valores salen del snapshot y de firmwareHealth
+// sin printf: enteros en unidades del struct escritos con el punto decimal en
+// su sitio (49811 mV -> 49.811). Todo se escribe sobre un Sink, igual que
+// telemetryCodec.h, así que en el servidor va por trozos sin buffer grande.
+
+enum promType : uint8_t
+{
+  PROM_GAUGE,
+  PROM_COUNTER,
+  PROM_SUMMARY // solo _sum y _count
+};
+
+enum promScope : uint8_t
+{
+  PROM_STACK,
+  PROM_MODULE, // {module="N"}
+  PROM_CELL,   // {module="N",cell="M"}
+  PROM_HEALTH
+};
+
+enum promSource : uint8_t
+{
+  PROM_SRC_MODULES,
+  PROM_SRC_SOC,
+  PROM_SRC_VOLTAGE,
+  PROM_SRC_CURRENT,
+  PROM_SRC_POWER,
+  PROM_SRC_TEMPERATURE,
+  PROM_SRC_IMBALANCE,
+  PROM_SRC_CELL_MAX,
+  PROM_SRC_CELL_MIN,
+  PROM_SRC_STATE, // 1 con la etiqueta state="..."
+  PROM_SRC_CELL,
+  PROM_SRC_ENERGY_IN,
+  PROM_SRC_ENERGY_OUT,
+  PROM_SRC_GENERATION,
+  PROM_SRC_SNAPSHOT_AGE,
+  PROM_SRC_ACQ_SUM,
+  PROM_SRC_ACQ_COUNT,
+  PROM_SRC_ACQ_LAST,
+  PROM_SRC_ACQ_FAILURES,
+  PROM_SRC_BMS_COMMANDS,
+  PROM_SRC_BMS_TIMEOUTS,
+  PROM_SRC_BMS_EMPTY,
+  PROM_SRC_BMS_OVERRUN,
+  PROM_SRC_UART_RX_BYTES,
+  PROM_SRC_UART_RX_ERRORS,
+  PROM_SRC_UART_OVERRUNS,
+  PROM_SRC_UART_OVERRUN_AGE,
+  PROM_SRC_UART_RX_PEAK,
+  PROM_SRC_UART_RX_BUFFER,
+  PROM_SRC_LOOP_SUM,
+  PROM_SRC_LOOP_COUNT,
+  PROM_SRC_LOOP_MAX,
+  PROM_SRC_HEAP_FREE,
+  PROM_SRC_HEAP_BLOCK,
+  PROM_SRC_HEAP_FRAG,
+  PROM_SRC_HEAP_MIN_FREE,
+  PROM_SRC_HEAP_MIN_BLOCK,
+  PROM_SRC_HEAP_OOM,
+  PROM_SRC_UPTIME,
+  PROM_SRC_SCRAPE,
+  PROM_SRC_BOOT_WIFI,
+  PROM_SRC_BOOT_HTTP,
+  PROM_SRC_WIFI_FAST,
+};
+
+// 'decimals': potencia de diez del valor entero (3 = milésimas).
+// 'countSource': solo para PROM_SUMMARY.
+struct promFamily
+{
+  char name[48];
+  char help[52];
+  uint8_t type;
+  uint8_t scope;
+  uint8_t source;
+  uint8_t decimals;
+  uint8_t countSource;
+};
+
+static const promFamily _promFamilies[] PROGMEM = {
+    {"pylontech_stack_modules", "Modules present in the last acquisition.", PROM_GAUGE, PROM_STACK, PROM_SRC_MODULES, 0, 0},
+    {"pylontech_stack_soc_percent", "Average state of charge.", PROM_GAUGE, PROM_STACK, PROM_SRC_SOC, 0, 0},
+    {"pylontech_stack_voltage_volts", "Average module voltage.", PROM_GAUGE, PROM_STACK, PROM_SRC_VOLTAGE, 3, 0},
+    {"pylontech_stack_current_amperes", "Stack current, negative when discharging.", PROM_GAUGE, PROM_STACK, PROM_SRC_CURRENT, 3, 0},
+    {"pylontech_stack_power_watts", "Stack power, negative when discharging.", PROM_GAUGE, PROM_STACK, PROM_SRC_POWER, 3, 0},
+    {"pylontech_stack_temperature_celsius", "Average module temperature.", PROM_GAUGE, PROM_STACK, PROM_SRC_TEMPERATURE, 3, 0},
+    {"pylontech_stack_cell_imbalance_volts", "Highest minus lowest cell in the stack.", PROM_GAUGE, PROM_STACK, PROM_SRC_IMBALANCE, 3, 0},
+    {"pylontech_stack_cell_max_volts", "Highest cell voltage in the stack.", PROM_GAUGE, PROM_STACK, PROM_SRC_CELL_MAX, 3, 0},
+    {"pylontech_stack_cell_min_volts", "Lowest cell voltage in the stack.", PROM_GAUGE, PROM_STACK, PROM_SRC_CELL_MIN, 3, 0},
+    {"pylontech_stack_state", "Stack state (label), always 1.", PROM_GAUGE, PROM_STACK, PROM_SRC_STATE, 0, 0},
+    {"pylontech_stack_energy_charged_joules_total", "Energy into the stack since boot.", PROM_COUNTER, PROM_STACK, PROM_SRC_ENERGY_IN, 6, 0},
+    {"pylontech_stack_energy_discharged_joules_total", "Energy out of the stack since boot.", PROM_COUNTER, PROM_STACK, PROM_SRC_ENERGY_OUT, 6, 0},
+
+    {"pylontech_module_soc_percent", "Module state of charge.", PROM_GAUGE, PROM_MODULE, PROM_SRC_SOC, 0, 0},
+    {"pylontech_module_voltage_volts", "Module voltage.", PROM_GAUGE, PROM_MODULE, PROM_SRC_VOLTAGE, 3, 0},
+    {"pylontech_module_current_amperes", "Module current, negative when discharging.", PROM_GAUGE, PROM_MODULE, PROM_SRC_CURRENT, 3, 0},
+    {"pylontech_module_power_watts", "Module power, negative when discharging.", PROM_GAUGE, PROM_MODULE, PROM_SRC_POWER, 3, 0},
+    {"pylontech_module_temperature_celsius", "Module temperature.", PROM_GAUGE, PROM_MODULE, PROM_SRC_TEMPERATURE, 3, 0},
+    {"pylontech_module_cell_imbalance_volts", "Highest minus lowest cell in the module.", PROM_GAUGE, PROM_MODULE, PROM_SRC_IMBALANCE, 3, 0},
+    {"pylontech_module_cell_max_volts", "Highest cell voltage in the module.", PROM_GAUGE, PROM_MODULE, PROM_SRC_CELL_MAX, 3, 0},
+    {"pylontech_module_cell_min_volts", "Lowest cell voltage in the module.", PROM_GAUGE, PROM_MODULE, PROM_SRC_CELL_MIN, 3, 0},
+    {"pylontech_module_state", "Module state (label), always 1.", PROM_GAUGE, PROM_MODULE, PROM_SRC_STATE, 0, 0},
+    {"pylontech_cell_voltage_volts", "Cell voltage.", PROM_GAUGE, PROM_CELL, PROM_SRC_CELL, 3, 0},
+
+    {"pylontech_snapshot_generation", "Acquisitions published since boot.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_GENERATION, 0, 0},
+    {"pylontech_snapshot_age_seconds", "Time since the last acquisition.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_SNAPSHOT_AGE, 3, 0},
+    {"pylontech_acquisition_duration_seconds", "Time spent polling the BMS per acquisition.", PROM_SUMMARY, PROM_HEALTH, PROM_SRC_ACQ_SUM, 3, PROM_SRC_ACQ_COUNT},
+    {"pylontech_acquisition_last_duration_seconds", "Duration of the last acquisition.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_ACQ_LAST, 3, 0},
+    {"pylontech_acquisition_failures_total", "Acquisitions that found no modules.", PROM_COUNTER, PROM_HEALTH, PROM_SRC_ACQ_FAILURES, 0, 0},
+    {"pylontech_bms_commands_total", "Commands sent on the BMS console.", PROM_COUNTER, PROM_HEALTH, PROM_SRC_BMS_COMMANDS, 0, 0},
+    {"pylontech_bms_timeouts_total", "BMS commands without prompt before timeout.", PROM_COUNTER, PROM_HEALTH, PROM_SRC_BMS_TIMEOUTS, 0, 0},
+    {"pylontech_bms_empty_responses_total", "BMS commands with no reply at all.", PROM_COUNTER, PROM_HEALTH, PROM_SRC_BMS_EMPTY, 0, 0},
+    {"pylontech_bms_overrun_responses_total", "BMS replies that lost bytes to an RX overrun.", PROM_COUNTER, PROM_HEALTH, PROM_SRC_BMS_OVERRUN, 0, 0},
+    {"pylontech_bms_uart_rx_bytes_total", "Bytes read from the BMS UART.", PROM_COUNTER, PROM_HEALTH, PROM_SRC_UART_RX_BYTES, 0, 0},
+    {"pylontech_bms_uart_rx_errors_total", "BMS UART framing or parity errors.", PROM_COUNTER, PROM_HEALTH, PROM_SRC_UART_RX_ERRORS, 0, 0},
+    {"pylontech_bms_uart_overruns_total", "Times the BMS UART RX buffer overflowed.", PROM_COUNTER, PROM_HEALTH, PROM_SRC_UART_OVERRUNS, 0, 0},
+    {"pylontech_bms_uart_last_overrun_age_seconds", "Time since the last RX buffer overflow.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_UART_OVERRUN_AGE, 3, 0},
+    {"pylontech_bms_uart_rx_peak_bytes", "Highest RX buffer fill seen since boot.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_UART_RX_PEAK, 0, 0},
+    {"pylontech_bms_uart_rx_buffer_bytes", "Size of the BMS UART RX buffer.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_UART_RX_BUFFER, 0, 0},
+    {"pylontech_loop_duration_seconds", "Time spent in each loop() pass.", PROM_SUMMARY, PROM_HEALTH, PROM_SRC_LOOP_SUM, 6, PROM_SRC_LOOP_COUNT},
+    {"pylontech_loop_max_duration_seconds", "Longest loop() pass since boot.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_LOOP_MAX, 6, 0},
+    {"pylontech_heap_free_bytes", "Free heap.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_HEAP_FREE, 0, 0},
+    {"pylontech_heap_max_block_bytes", "Largest allocatable heap block.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_HEAP_BLOCK, 0, 0},
+    {"pylontech_heap_fragmentation_percent", "100 - largest block * 100 / free heap.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_HEAP_FRAG, 0, 0},
+    {"pylontech_heap_min_free_bytes", "Lowest free heap seen since boot.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_HEAP_MIN_FREE, 0, 0},
+    {"pylontech_heap_min_max_block_bytes", "Smallest largest-block seen since boot.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_HEAP_MIN_BLOCK, 0, 0},
+    {"pylontech_heap_oom_total", "Allocations the heap could not satisfy.", PROM_COUNTER, PROM_HEALTH, PROM_SRC_HEAP_OOM, 0, 0},
+    {"pylontech_uptime_seconds", "Time since boot.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_UPTIME, 3, 0},
+    {"pylontech_scrape_duration_seconds", "Time spent serving the previous scrape.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_SCRAPE, 6, 0},
+    {"pylontech_boot_wifi_connect_seconds", "Time from boot to WiFi association.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_BOOT_WIFI, 3, 0},
+    {"pylontech_boot_first_http_seconds", "Time from boot to the first HTTP response.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_BOOT_HTTP, 3, 0},
+    {"pylontech_wifi_fast_reconnect", "1 if WiFi came up via cached BSSID and channel.", PROM_GAUGE, PROM_HEALTH, PROM_SRC_WIFI_FAST, 0, 0},
+};
+
+#define PROM_FAMILY_COUNT (sizeof(_promFamilies) / sizeof(_promFamilies[0]))
+
+// Valor de una fuente en la unidad entera del struct; false si no existe
+// (p. ej. extremos de celda sin 'bat N')
+static bool _promValue(uint8_t source, const batteryStack &st, const pylonBattery *b, int cell,
+                       const firmwareHealth &h, unsigned long now, int64_t &v)
+{
+  switch (source)
+  {
+  case PROM_SRC_MODULES: v = st.batteryCount; return true;
+  case PROM_SRC_SOC: v = b ? b->soc : st.soc; return true;
+  case PROM_SRC_VOLTAGE: v = b ? b->voltage : st.avgVoltage; return true;
+  case PROM_SRC_CURRENT: v = b ? b->current : st.currentDC; return true;
+  case PROM_SRC_POWER: v = b ? (int64_t)b->voltage * b->current / 1000 : (int64_t)st.avgVoltage * st.currentDC / 1000; return true;
+  case PROM_SRC_TEMPERATURE: v = b ? b->tempr : st.temp; return true;
+  case PROM_SRC_IMBALANCE: v = b ? b->imbalanceMv() : st.imbalanceMv(); return b ? b->cellCount > 0 : st.cellCount > 0;
+  case PROM_SRC_CELL_MAX: v = b ? b->cellVoltHigh : st.cellVoltHigh; return b ? b->cellVoltHigh > 0 : st.cellVoltHighBatt != 0;
+  case PROM_SRC_CELL_MIN: v = b ? b->cellVoltLow : st.cellVoltLow; return b ? b->cellVoltHigh > 0 : st.cellVoltLowBatt != 0;
+  case PROM_SRC_STATE: v = 1; return true;
+  case PROM_SRC_CELL: v = b->cellVolt[cell]; return true;
+  case PROM_SRC_ENERGY_IN: v = st.energyChargedUj; return true;
+  case PROM_SRC_ENERGY_OUT: v = st.energyDischargedUj; return true;
+  case PROM_SRC_GENERATION: v = st.generation; return true;
+  case PROM_SRC_SNAPSHOT_AGE: v = now - st.acquiredAt; return st.generation > 0;
+  case PROM_SRC_ACQ_SUM: v = h.acquisitionMsTotal; return true;
+  case PROM_SRC_ACQ_COUNT: v = h.acquisitions; return true;
+  case PROM_SRC_ACQ_LAST: v = h.acquisitionMsLast; return h.acquisitions > 0;
+  case PROM_SRC_ACQ_FAILURES: v = h.acquisitionFailures; return true;
+  case PROM_SRC_BMS_COMMANDS: v = h.bmsCommands; return true;
+  case PROM_SRC_BMS_TIMEOUTS: v = h.bmsTimeouts; return true;
+  case PROM_SRC_BMS_EMPTY: v = h.bmsEmpty; return true;
+  case PROM_SRC_BMS_OVERRUN: v = h.bmsOverrunCommands; return true;
+  case PROM_SRC_UART_RX_BYTES: v = h.uartRxBytes; return true;
+  case PROM_SRC_UART_RX_ERRORS: v = h.uartRxErrors; return true;
+  case PROM_SRC_UART_OVERRUNS: v = h.uartOverruns; return true;
+  case PROM_SRC_UART_OVERRUN_AGE: v = now - h.uartLastOverrunMs; return h.uartOverruns > 0;
+  case PROM_SRC_UART_RX_PEAK: v = h.uartRxPeak; return true;
+  case PROM_SRC_UART_RX_BUFFER: v = h.uartRxBuffer; return h.uartRxBuffer > 0;
+  case PROM_SRC_LOOP_SUM: v = h.loopUsTotal; return true;
+  case PROM_SRC_LOOP_COUNT: v = h.loops; return true;
+  case PROM_SRC_LOOP_MAX: v = h.loopUsMax; return true;
+  case PROM_SRC_HEAP_FREE: v = h.heap.freeBytes; return h.heap.samples > 0;
+  case PROM_SRC_HEAP_BLOCK: v = h.heap.maxBlock; return h.heap.samples > 0;
+  case PROM_SRC_HEAP_FRAG: v = h.heap.fragmentation; return h.heap.samples > 0;
+  case PROM_SRC_HEAP_MIN_FREE: v = h.heap.minFree; return h.heap.samples > 0;
+  case PROM_SRC_HEAP_MIN_BLOCK: v = h.heap.minMaxBlock; return h.heap.samples > 0;
+  case PROM_SRC_HEAP_OOM: v = heapMonitor::oomCount(); return h.heap.samples > 0;
+  case PROM_SRC_UPTIME: v = now; return true;
+  case PROM_SRC_SCRAPE: v = h.scrapeUs; return h.scrapeUs > 0;
+  case PROM_SRC_BOOT_WIFI: v = h.wifiConnectMs; return h.wifiConnectMs > 0;
+  case PROM_SRC_BOOT_HTTP: v = h.firstHttpMs; return h.firstHttpMs > 0;
+  case PROM_SRC_WIFI_FAST: v = h.wifiFastPath; return h.wifiConnectMs > 0;
+  }
+  return false;
+}
+
+template <typename Sink>
+struct promWriter
+{
+  Sink &out;
+  explicit promWriter(Sink &s) : out(s) {}
+
+  void text(const char *s) { out.write(s, strlen(s)); }
+
+  void integer(uint64_t v)
+  {
+    char tmp[21];
+    int i = sizeof(tmp);
+    do
+    {
+      tmp[--i] = '0' + v % 10;
+      v /= 10;
+    } while (v);
+    out.write(tmp + i, sizeof(tmp) - i);
+  }
+
+  // Entero con el punto 'decimals' posiciones a la izquierda: (49811, 3) -> 49.811
+  void fixed(int64_t v, uint8_t decimals)
+  {
+    static const uint32_t p10[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+    if (v < 0)
+    {
+      out.write("-", 1);
+      v = -v;
+    }
+    integer((uint64_t)v / p10[decimals]);
+    if (decimals == 0)
+      return;
+    char frac[8];
+    uint32_t f = (uint64_t)v % p10[decimals];
+    frac[0] = '.';
+    for (int i = decimals; i > 0; i--)
+    {
+      frac[i] = '0' + f % 10;
+      f /= 10;
+    }
+    out.write(frac, decimals + 1);
+  }
+
+  void sample(const char *name, const char *suffix, int module, int cell, const char *state,
+              int64_t v, uint8_t decimals)
+  {
+    text(name);
+    text(suffix);
+    if (module || state)
+    {
+      const char *sep = "{";
+      if (module)
+      {
+        text("{module=\"");
+        integer(module);
+        out.write("\"", 1);
+        sep = ",";
+      }
+      if (cell)
+      {
+        text(",cell=\"");
+        integer(cell);
+        out.write("\"", 1);
+      }
+      if (state)
+      {
+        text(sep);
+        text("state=\"");
+        text(state);
+        out.write("\"", 1);
+      }
+      out.write("}", 1);
+    }
+    out.write(" ", 1);
+    fixed(v, decimals);
+    out.write("\n", 1);
+  }
+};
+
+static const char *_promTypeName(uint8_t type)
+{
+  return type == PROM_COUNTER ? "counter" : type == PROM_SUMMARY ? "summary" : "gauge";
+}
+
+// Todas las familias con muestras. Sin adquisición todavía solo salen las de salud.
+template <typename Sink>
+static void writePrometheusMetrics(Sink &sink, const batteryStack &st, const firmwareHealth &h, unsigned long now)
+{
+  promWriter<Sink> out(sink);
+
+  for (size_t i = 0; i < PROM_FAMILY_COUNT; i++)
+  {
+    promFamily f;
+    memcpy_P(&f, &_promFamilies[i], sizeof(f));
+    if (f.scope != PROM_HEALTH && st.generation == 0)
+      continue;
+
+    out.text("# HELP ");
+    out.text(f.name);
+    out.text(" ");
+    out.text(f.help);
+    out.text("\n# TYPE ");
+    out.text(f.name);
+    out.text(" ");
+    out.text(_promTypeName(f.type));
+    out.text("\n");
+
+    int64_t v;
+    if (f.type == PROM_SUMMARY)
+    {
+      _promValue(f.source, st, nullptr, 0, h, now, v);
+      out.sample(f.name, "_sum", 0, 0, nullptr, v, f.decimals);
+      _promValue(f.countSource, st, nullptr, 0, h, now, v);
+      out.sample(f.name, "_count", 0, 0, nullptr, v, 0);
+      continue;
+    }
+
+    if (f.scope == PROM_STACK || f.scope == PROM_HEALTH)
+    {
+      if (_promValue(f.source, st, nullptr, 0, h, now, v))
+        out.sample(f.name, "", 0, 0, f.source == PROM_SRC_STATE ? st.baseState : nullptr, v, f.decimals);
+      continue;
+    }
+
+    for (int m = 0; m < MAX_PYLON_BATTERIES_SUPPORTED; m++)
+    {
+      const pylonBattery &b = st.batts[m];
+      if (!b.isPresent)
+        continue;
+      if (f.scope == PROM_CELL)
+      {
+        for (int c = 0; c < b.cellCount; c++)
+          if (_promValue(f.source, st, &b, c, h, now, v))
+            out.sample(f.name, "", m + 1, c + 1, nullptr, v, f.decimals);
+      }
+      else if (_promValue(f.source, st, &b, 0, h, now, v))
+      {
+        out.sample(f.name, "", m + 1, 0, f.source == PROM_SRC_STATE ? b.baseState : nullptr, v, f.decimals);
+      }
+    }
+  }
+}
+
+#endif // METRICSEXPORTER_H
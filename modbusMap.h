@@ -0,0 +1,201 @@
+#ifndef MODBUSMAP_H
+#define MODBUSMAP_H
+
+#include <string.h>
+
+#include "batteryStack.h"
+
+// ================== Mapa de registros Modbus del snapshot ==================
+//
+// Registros de 16 bits leídos con FC03 (holding) o FC04 (input); ambos
+// devuelven el mismo mapa. Todo es de solo lectura y sale del snapshot de la
+// última adquisición: cada registro se calcula en tiempo constante a partir
+// de su dirección, sin tocar el UART. Los valores con signo van en
+// complemento a dos (int16).
+//
+// Pila (0..19)
+//   0  versión del mapa (1)          10 desequilibrio, mV
+//   1  generación (16 bits bajos)    11 celda más alta, mV
+//   2  generación (16 bits altos)    12 celda más baja, mV
+//   3  antigüedad del snapshot, s    13 módulo de la celda más alta (1-based)
+//   4  módulos presentes             14 módulo de la celda más baja (1-based)
+//   5  SOC, %                        15 estado (ver MODBUS_STATE_*)
+//   6  tensión media, mV             16 celdas con lectura
+//   7  corriente, int16 x10 mA       17..19 reservados (0)
+//   8  potencia, int16 W
+//   9  temperatura, int16 x0.1 °C
+//
+// Módulo N (1..16): base = 100 + (N-1) * 32
+//   +0  presente (0/1)               +8  celda más baja, mV
+//   +1  SOC, %                       +9  índice de la celda más alta
+//   +2  tensión, mV                  +10 índice de la celda más baja
+//   +3  corriente, int16 x10 mA      +11 estado (MODBUS_STATE_*)
+//   +4  potencia, int16 W            +12 celdas con lectura
+//   +5  temperatura, int16 x0.1 °C   +13..15 reservados (0)
+//   +6  desequilibrio, mV            +16..31 celda 1..16, mV (0 si no hay)
+//   +7  celda más alta, mV
+//
+// Un módulo ausente devuelve 0 en todo su bloque.
+
+#define MODBUS_MAP_VERSION 1
+#define MODBUS_STACK_REGS 20
+#define MODBUS_MODULE_BASE 100
+#define MODBUS_MODULE_STRIDE 32
+#define MODBUS_REGISTER_COUNT (MODBUS_MODULE_BASE + MAX_PYLON_BATTERIES_SUPPORTED * MODBUS_MODULE_STRIDE)
+#define MODBUS_MAX_READ 125 // límite del protocolo por petición
+
+#define MODBUS_STATE_ABSENT 0
+#define MODBUS_STATE_IDLE 1
+#define MODBUS_STATE_CHARGE 2
+#define MODBUS_STATE_DISCHARGE 3
+#define MODBUS_STATE_OTHER 4
+
+// Códigos de excepción
+#define MODBUS_EX_ILLEGAL_FUNCTION 0x01
+#define MODBUS_EX_ILLEGAL_ADDRESS 0x02
+#define MODBUS_EX_ILLEGAL_VALUE 0x03
+
+static uint16_t _modbusState(const char *s)
+{
+  if (!strcmp(s, "Idle"))
+    return MODBUS_STATE_IDLE;
+  if (!strcmp(s, "Charge"))
+    return MODBUS_STATE_CHARGE;
+  if (!strcmp(s, "Dischg"))
+    return MODBUS_STATE_DISCHARGE;
+  if (!strcmp(s, "Absent") || !s[0])
+    return MODBUS_STATE_ABSENT;
+  return MODBUS_STATE_OTHER;
+}
+
+// Satura al rango de int16 y devuelve su representación en 16 bits
+static uint16_t _modbusS16(long v)
+{
+  if (v > 32767)
+    v = 32767;
+  if (v < -32768)
+    v = -32768;
+  return (uint16_t)(int16_t)v;
+}
+
+static uint16_t _modbusU16(long v)
+{
+  return v < 0 ? 0 : (v > 65535 ? 65535 : (uint16_t)v);
+}
+
+static uint16_t modbusRegister(const batteryStack &st, uint16_t addr, unsigned long now)
+{
+  if (addr < MODBUS_STACK_REGS)
+  {
+    switch (addr)
+    {
+    case 0: return MODBUS_MAP_VERSION;
+    case 1: return st.generation & 0xFFFF;
+    case 2: return st.generation >> 16;
+    case 3: return st.generation ? _modbusU16((now - st.acquiredAt) / 1000) : 0xFFFF;
+    case 4: return st.batteryCount;
+    case 5: return _modbusU16(st.soc);
+    case 6: return _modbusU16(st.avgVoltage);
+    case 7: return _modbusS16(st.currentDC / 10);
+    case 8: return _modbusS16((long)((long long)st.avgVoltage * st.currentDC / 1000000));
+    case 9: return _modbusS16(st.temp / 100);
+    case 10: return _modbusU16(st.imbalanceMv());
+    case 11: return _modbusU16(st.cellVoltHigh);
+    case 12: return _modbusU16(st.cellVoltLow);
+    case 13: return st.cellVoltHighBatt;
+    case 14: return st.cellVoltLowBatt;
+    case 15: return _modbusState(st.baseState);
+    case 16: return _modbusU16(st.cellCount);
+    default: return 0;
+    }
+  }
+
+  if (addr < MODBUS_MODULE_BASE || addr >= MODBUS_REGISTER_COUNT)
+    return 0;
+
+  const pylonBattery &b = st.batts[(addr - MODBUS_MODULE_BASE) / MODBUS_MODULE_STRIDE];
+  uint16_t k = (addr - MODBUS_MODULE_BASE) % MODBUS_MODULE_STRIDE;
+  if (!b.isPresent)
+    return 0;
+  if (k >= 16)
+    return k - 16 < b.cellCount ? b.cellVolt[k - 16] : 0;
+
+  switch (k)
+  {
+  case 0: return 1;
+  case 1: return _modbusU16(b.soc);
+  case 2: return _modbusU16(b.voltage);
+  case 3: return _modbusS16(b.current / 10);
+  case 4: return _modbusS16((long)((long long)b.voltage * b.current / 1000000));
+  case 5: return _modbusS16(b.tempr / 100);
+  case 6: return _modbusU16(b.imbalanceMv());
+  case 7: return _modbusU16(b.cellVoltHigh);
+  case 8: return _modbusU16(b.cellVoltLow);
+  case 9: return b.cellVoltHighId;
+  case 10: return b.cellVoltLowId;
+  case 11: return _modbusState(b.baseState);
+  case 12: return b.cellCount;
+  default: return 0;
+  }
+}
+
+// Procesa una trama Modbus TCP completa (cabecera MBAP + PDU) y escribe la
+// respuesta en 'resp'. Devuelve su longitud, o 0 si la trama no es válida y
+// hay que cerrar la conexión.
+static size_t modbusProcess(const uint8_t *req, size_t len, uint8_t *resp, size_t cap,
+                            const batteryStack &st, unsigned long now)
+{
+  if (len < 8 || cap < 9 + 2 * MODBUS_MAX_READ)
+    return 0;
+  uint16_t protocol = (req[2] << 8) | req[3];
+  uint16_t length = (req[4] << 8) | req[5];
+  if (protocol != 0 || length < 2 || (size_t)length + 6 != len)
+    return 0;
+
+  // Transaction id y unit id se devuelven tal cual
+  memcpy(resp, req, 4);
+  resp[6] = req[6];
+  uint8_t fc = req[7];
+  uint8_t exception = 0;
+
+  if (fc != 0x03 && fc != 0x04)
+  {
+    exception = MODBUS_EX_ILLEGAL_FUNCTION;
+  }
+  else if (length != 6)
+  {
+    exception = MODBUS_EX_ILLEGAL_VALUE;
+  }
+  else
+  {
+    uint16_t start = (req[8] << 8) | req[9];
+    uint16_t count = (req[10] << 8) | req[11];
+    if (count < 1 || count > MODBUS_MAX_READ)
+      exception = MODBUS_EX_ILLEGAL_VALUE;
+    else if ((uint32_t)start + count > MODBUS_REGISTER_COUNT)
+      exception = MODBUS_EX_ILLEGAL_ADDRESS;
+    else
+    {
+      resp[7] = fc;
+      resp[8] = count * 2;
+      for (uint16_t i = 0; i < count; i++)
+      {
+        uint16_t v = modbusRegister(st, start + i, now);
+        resp[9 + 2 * i] = v >> 8;
+        resp[10 + 2 * i] = v & 0xFF;
+      }
+      size_t pduLen = 2 + count * 2;
+      resp[4] = (pduLen + 1) >> 8;
+      resp[5] = (pduLen + 1) & 0xFF;
+      return 7 + pduLen;
+    }
+  }
+
+  resp[4] = 0;
+  resp[5] = 3;
+  resp[7] = fc | 0x80;
+  resp[8] = exception;
+  return 9;
+}
+
+#endif // MODBUSMAP_H
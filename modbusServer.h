@@ -0,0 +1,128 @@
+#ifndef MODBUSSERVER_H
+#define MODBUSSERVER_H
+
+#include "batteryStack.h"
+#include "logger.h"
+#include "modbusMap.h"
+
+// ================== Servidor Modbus TCP (solo lectura) ==================
+// Atiende FC03/FC04 sobre el mapa de modbusMap.h. No bloquea: en cada vuelta
+// de loop() acepta conexiones, lee lo que haya y responde a cada trama
+// completa. Varias tramas encadenadas en una conexión se atienden en orden.
+
+#ifndef MODBUS_TCP_PORT
+#define MODBUS_TCP_PORT 502
+#endif
+#ifndef MODBUS_MAX_CLIENTS
+#define MODBUS_MAX_CLIENTS 2
+#endif
+#define MODBUS_IDLE_TIMEOUT_MS 60000
+#define MODBUS_MAX_ADU 260
+
+struct modbusConnection
+{
+  WiFiClient client;
+  uint8_t buf[MODBUS_MAX_ADU];
+  size_t len = 0;
+  unsigned long lastActivity = 0;
+};
+
+struct modbusTcpServer
+{
+  WiFiServer server;
+  const batteryStack *stack = nullptr;
+  modbusConnection conns[MODBUS_MAX_CLIENTS];
+  uint32_t requests = 0;
+  uint32_t rejected = 0; // tramas mal formadas o conexiones sin hueco
+
+  explicit modbusTcpServer(uint16_t port = MODBUS_TCP_PORT) : server(port) {}
+
+  void begin(const batteryStack &st)
+  {
+    stack = &st;
+    server.begin();
+    server.setNoDelay(true);
+    LOG_I(MODBUS, "Listening on port %u", MODBUS_TCP_PORT);
+  }
+
+  void loop()
+  {
+    if (!stack)
+      return;
+    unsigned long now = millis();
+
+    if (server.hasClient())
+    {
+      WiFiClient incoming = server.accept();
+      modbusConnection *slot = nullptr;
+      for (auto &c : conns)
+        if (!c.client.connected())
+          slot = &c;
+      if (slot)
+      {
+        slot->client = incoming;
+        slot->client.setNoDelay(true);
+        slot->len = 0;
+        slot->lastActivity = now;
+      }
+      else
+      {
+        incoming.stop();
+        rejected++;
+      }
+    }
+
+    for (auto &c : conns)
+    {
+      if (!c.client.connected())
+        continue;
+      if (now - c.lastActivity > MODBUS_IDLE_TIMEOUT_MS)
+      {
+        c.client.stop();
+        continue;
+      }
+      serve(c, now);
+    }
+  }
+
+  void serve(modbusConnection &c, unsigned long now)
+  {
+    int avail = c.client.available();
+    if (avail > 0)
+    {
+      size_t room = sizeof(c.buf) - c.len;
+      c.len += c.client.read(c.buf + c.len, (size_t)avail < room ? avail : room);
+      c.lastActivity = now;
+    }
+
+    static uint8_t resp[MODBUS_MAX_ADU];
+    while (c.len >= 6)
+    {
+      size_t frame = 6 + ((c.buf[4] << 8) | c.buf[5]);
+      if (frame > MODBUS_MAX_ADU)
+      {
+        rejected++;
+        c.client.stop();
+        c.len = 0;
+        return;
+      }
+      if (c.len < frame)
+        return; // trama incompleta: se espera al resto
+
+      size_t n = modbusProcess(c.buf, frame, resp, sizeof(resp), *stack, now);
+      if (n == 0)
+      {
+        rejected++;
+        c.client.stop();
+        c.len = 0;
+        return;
+      }
+      c.client.write(resp, n);
+      requests++;
+      memmove(c.buf, c.buf + frame, c.len - frame);
+      c.len -= frame;
+    }
+  }
+};
+
+#endif // MODBUSSERVER_H
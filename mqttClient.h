@@ -0,0 +1,59 @@
+#ifndef MQTTCLIENT_H
+#define MQTTCLIENT_H
+
+#include <AsyncMqttClient.h>
+
+#include "PylontechMonitoring.h"
+#include "mqttPublisher.h"
+
+// ================== Transporte MQTT sobre AsyncMqttClient ==================
+// connect() vuelve en el acto; la conexión TCP y el CONNACK se resuelven en
+// segundo plano (ESPAsyncTCP / AsyncTCP), así que loop() nunca espera al broker.
+
+#ifndef MQTT_CONNECT_TIMEOUT_MS
+#define MQTT_CONNECT_TIMEOUT_MS 15000 // intento colgado sin callback
+#endif
+
+struct asyncMqttTransport : mqttTransport
+{
+  AsyncMqttClient client;
+  char willTopic[64];
+  bool connecting = false;
+  unsigned long connectStartedAt = 0;
+  int lastDisconnectReason = -1;
+
+  void begin()
+  {
+    snprintf(willTopic, sizeof(willTopic), "%sstatus", MQTT_TOPIC_ROOT);
+    client.setServer(MQTT_SERVER, MQTT_PORT);
+    client.setCredentials(MQTT_USER, MQTT_PASSWORD);
+    client.setClientId(WIFI_HOSTNAME);
+    client.setWill(willTopic, 1, true, "offline");
+    client.onConnect([this](bool)
+                     { connecting = false; });
+    client.onDisconnect([this](AsyncMqttClientDisconnectReason reason)
+                        {
+                          connecting = false;
+                          lastDisconnectReason = (int)reason;
+                        });
+  }
+
+  bool connected() override { return client.connected(); }
+
+  void connect() override
+  {
+    if (connecting && millis() - connectStartedAt < MQTT_CONNECT_TIMEOUT_MS)
+      return;
+    connecting = true;
+    connectStartedAt = millis();
+    client.connect();
+  }
+
+  bool publish(const char *topic, const char *payload, size_t len, bool retain) override
+  {
+    // QoS 0: 0 significa que el mensaje no cupo en el buffer de envío
+    return client.publish(topic, 0, retain, payload, len) != 0;
+  }
+};
+
+#endif // MQTTCLIENT_H
@@ -0,0 +1,455 @@
+#ifndef MQTTPUBLISHER_H
+#define MQTTPUBLISHER_H
+
+#include <functional>
+
+#include "batteryStack.h"
+#include "heapMonitor.h"
+#include "logger.h"
+#include "PylontechMonitoring.h"
+#include "telemetryCodec.h"
+#include "telemetryOutbox.h"
+
+// ================== Publicación MQTT del snapshot ==================
+//
+// Un topic por métrica bajo MQTT_TOPIC_ROOT, valor en texto plano:
+//   <root>soc, <root>voltage, ...           agregados de la pila
+//   <root>N/soc, <root>N/voltage, ...       módulo N (1-based)
+//   <root>N/cell/M                          tensión de la celda M del módulo N
+//   <root>status                            online/offline (retenido, LWT)
+//   <root>backlog                           registros guardados sin conexión (JSON con "ts")
+//   <root>heap                              heap y marcas de agua (JSON, cada MQTT_HEAP_INTERVAL_MS)
+//
+// Todo sale del snapshot de la última adquisición; nunca se toca el UART.
+// El publicador no bloquea: conecta a través de mqttTransport (que solo
+// lanza el intento) y reintenta con espera exponencial. Por cada adquisición
+// nueva (como mucho cada MQTT_PUSH_FREQ_SEC) se envían solo las métricas que
+// han cambiado más que su banda muerta o que llevan demasiado sin enviarse.
+
+#ifndef MQTT_PUBLISH_BUDGET
+#define MQTT_PUBLISH_BUDGET 24 // mensajes como máximo por vuelta de loop()
+#endif
+#define MQTT_RECONNECT_MIN_MS 1000
+#define MQTT_RECONNECT_MAX_MS 60000
+#define MQTT_HEAP_INTERVAL_MS 60000
+
+// Métricas que tienen tanto la pila como cada módulo
+enum mqttMetricId : uint8_t
+{
+  MQTT_SOC,
+  MQTT_VOLTAGE,
+  MQTT_CURRENT,
+  MQTT_POWER,
+  MQTT_TEMPERATURE,
+  MQTT_IMBALANCE,
+  MQTT_CELL_HIGH,
+  MQTT_CELL_LOW,
+  MQTT_STATE,
+  MQTT_METRICS_PER_SCOPE,
+  MQTT_CELL = MQTT_METRICS_PER_SCOPE // tensión de una celda concreta
+};
+
+// Nombre del topic, decimales del valor (en milésimas; -1 = entero tal cual)
+// y filtro de publicación: solo se envía si el valor se mueve al menos
+// 'deadband' (en unidades del struct) o si lleva 'maxSilenceSec' sin enviarse.
+struct mqttMetricInfo
+{
+  const char *name;
+  int8_t decimals;
+  long deadband;
+  uint16_t maxSilenceSec;
+};
+
+static const mqttMetricInfo _mqttMetricInfo[] = {
+    {"soc", -1, 1, 600},            // %
+    {"voltage", 3, 50, 300},        // mV
+    {"current", 3, 200, 120},       // mA
+    {"power", 1, 10000, 120},       // mW
+    {"temperature", 1, 500, 900},   // m°C
+    {"imbalance", -1, 5, 900},      // mV
+    {"cell_high", 3, 5, 900},       // mV
+    {"cell_low", 3, 5, 900},        // mV
+    {"state", -1, 1, 900},          // cualquier cambio
+    {"cell", 3, 5, 1800},           // mV
+};
+
+// Cada métrica posible tiene un slot fijo: primero las de la pila y luego,
+// por módulo, sus métricas seguidas de sus celdas.
+#define MQTT_SLOTS_PER_MODULE (MQTT_METRICS_PER_SCOPE + MAX_CELLS_PER_BATTERY)
+#define MQTT_METRIC_SLOTS (MQTT_METRICS_PER_SCOPE + MAX_PYLON_BATTERIES_SUPPORTED * MQTT_SLOTS_PER_MODULE)
+
+struct mqttMetric
+{
+  uint8_t id;
+  uint8_t module; // 0 = pila, 1..N = módulo
+  uint8_t cell;   // 1..16 si id == MQTT_CELL
+  long value;     // milésimas o entero según _mqttMetricInfo
+  const char *text; // solo MQTT_STATE
+};
+
+// Los estados ("Charge", "Dischg"...) se comparan por sus primeros 4 caracteres
+static long _mqttStateKey(const char *s)
+{
+  long key = 0;
+  for (int i = 0; i < 4 && s[i]; i++)
+    key = (key << 8) | (uint8_t)s[i];
+  return key;
+}
+
+// Rellena la métrica del slot; false si ese módulo/celda no existe ahora
+static bool mqttMetricAt(const batteryStack &st, uint16_t slot, mqttMetric &m)
+{
+  if (st.batteryCount == 0 || slot >= MQTT_METRIC_SLOTS)
+    return false;
+
+  m.module = 0;
+  m.cell = 0;
+  m.text = nullptr;
+
+  if (slot < MQTT_METRICS_PER_SCOPE)
+  {
+    m.id = slot;
+    switch (m.id)
+    {
+    case MQTT_SOC: m.value = st.soc; break;
+    case MQTT_VOLTAGE: m.value = st.avgVoltage; break;
+    case MQTT_CURRENT: m.value = st.currentDC; break;
+    case MQTT_POWER: m.value = (long)((long long)st.avgVoltage * st.currentDC / 1000); break;
+    case MQTT_TEMPERATURE: m.value = st.temp; break;
+    case MQTT_IMBALANCE: m.value = st.imbalanceMv(); break;
+    case MQTT_CELL_HIGH: m.value = st.cellVoltHigh; break;
+    case MQTT_CELL_LOW: m.value = st.cellVoltLow; break;
+    default: m.text = st.baseState; m.value = _mqttStateKey(st.baseState); break;
+    }
+    // Sin 'bat N' no hay extremos de celda
+    return (m.id != MQTT_CELL_HIGH && m.id != MQTT_CELL_LOW) || st.cellVoltHighBatt != 0;
+  }
+
+  slot -= MQTT_METRICS_PER_SCOPE;
+  int idx = slot / MQTT_SLOTS_PER_MODULE;
+  int k = slot % MQTT_SLOTS_PER_MODULE;
+  const pylonBattery &b = st.batts[idx];
+  if (!b.isPresent)
+    return false;
+  m.module = idx + 1;
+
+  if (k >= MQTT_METRICS_PER_SCOPE)
+  {
+    m.id = MQTT_CELL;
+    m.cell = k - MQTT_METRICS_PER_SCOPE + 1;
+    m.value = b.cellVolt[m.cell - 1];
+    return m.cell <= b.cellCount;
+  }
+
+  m.id = k;
+  switch (m.id)
+  {
+  case MQTT_SOC: m.value = b.soc; break;
+  case MQTT_VOLTAGE: m.value = b.voltage; break;
+  case MQTT_CURRENT: m.value = b.current; break;
+  case MQTT_POWER: m.value = (long)((long long)b.voltage * b.current / 1000); break;
+  case MQTT_TEMPERATURE: m.value = b.tempr; break;
+  case MQTT_IMBALANCE: m.value = b.imbalanceMv(); break;
+  case MQTT_CELL_HIGH: m.value = b.cellVoltHigh; break;
+  case MQTT_CELL_LOW: m.value = b.cellVoltLow; break;
+  default: m.text = b.baseState; m.value = _mqttStateKey(b.baseState); break;
+  }
+  // 'pwr' ya trae Vlow/Vhigh aunque 'bat N' no haya respondido
+  return (m.id != MQTT_CELL_HIGH && m.id != MQTT_CELL_LOW) || b.cellVoltHigh > 0;
+}
+
+// <root>[N/]name[/M]
+static size_t mqttFormatTopic(char *buf, size_t cap, const mqttMetric &m)
+{
+  int n;
+  if (m.module == 0)
+    n = snprintf(buf, cap, "%s%s", MQTT_TOPIC_ROOT, _mqttMetricInfo[m.id].name);
+  else if (m.id == MQTT_CELL)
+    n = snprintf(buf, cap, "%s%u/cell/%u", MQTT_TOPIC_ROOT, m.module, m.cell);
+  else
+    n = snprintf(buf, cap, "%s%u/%s", MQTT_TOPIC_ROOT, m.module, _mqttMetricInfo[m.id].name);
+  return n < 0 ? 0 : ((size_t)n < cap ? n : cap - 1);
+}
+
+static size_t mqttFormatValue(char *buf, size_t cap, const mqttMetric &m)
+{
+  bufferSink sink((uint8_t *)buf, cap - 1);
+  textWriter<bufferSink> out(sink);
+  if (m.text)
+    out.print(m.text);
+  else if (_mqttMetricInfo[m.id].decimals < 0)
+    out.printf("%ld", m.value);
+  else
+    out.milli(m.value, _mqttMetricInfo[m.id].decimals);
+  buf[sink.len] = '\0';
+  return sink.len;
+}
+
+// Último valor enviado por slot, para el filtro de banda muerta.
+// Tiempos en segundos desde el arranque módulo 65536 (maxSilenceSec < 18 h).
+struct mqttSlotState
+{
+  int32_t value[MQTT_METRIC_SLOTS];
+  uint16_t sentAt[MQTT_METRIC_SLOTS];
+  uint8_t sent[(MQTT_METRIC_SLOTS + 7) / 8];
+
+  void reset() { memset(sent, 0, sizeof(sent)); }
+
+  bool wasSent(uint16_t slot) const { return sent[slot >> 3] & (1 << (slot & 7)); }
+
+  void forget(uint16_t slot) { sent[slot >> 3] &= ~(1 << (slot & 7)); }
+
+  bool due(uint16_t slot, const mqttMetric &m, uint16_t nowSec) const
+  {
+    if (!wasSent(slot))
+      return true;
+    const mqttMetricInfo &info = _mqttMetricInfo[m.id];
+    if ((uint16_t)(nowSec - sentAt[slot]) >= info.maxSilenceSec)
+      return true;
+    long delta = m.value - value[slot];
+    return (delta < 0 ? -delta : delta) >= info.deadband;
+  }
+
+  void mark(uint16_t slot, long v, uint16_t nowSec)
+  {
+    value[slot] = v;
+    sentAt[slot] = nowSec;
+    sent[slot >> 3] |= 1 << (slot & 7);
+  }
+};
+
+// Conexión con el broker. connect() solo lanza el intento; el resultado se
+// ve en connected(). Permite sustituir el cliente real por uno en proceso.
+struct mqttTransport
+{
+  virtual bool connected() = 0;
+  virtual void connect() = 0;
+  virtual bool publish(const char *topic, const char *payload, size_t len, bool retain) = 0;
+};
+
+struct mqttPublisher
+{
+  mqttTransport *transport = nullptr;
+  const batteryStack *stack = nullptr;
+  unsigned long pushIntervalMs = MQTT_PUSH_FREQ_SEC * 1000UL;
+
+  // Reconexión
+  bool wasConnected = false;
+  unsigned long nextConnectAt = 0;
+  unsigned long backoffMs = MQTT_RECONNECT_MIN_MS;
+
+  // Ciclo de publicación en curso: una ráfaga con lo que ha cambiado
+  mqttSlotState slots;
+  bool cycleActive = false;
+  uint16_t cursor = 0;
+  uint32_t cycleGeneration = 0;
+  uint32_t publishedGeneration = 0;
+  unsigned long lastPushAt = 0;
+  uint16_t cycleSec = 0;
+
+  // Tarea previa a los ciclos de estados (discovery de Home Assistant):
+  // mientras devuelva true no se publican estados ni se vacía el buzón
+  std::function<bool(mqttPublisher &)> preCycle;
+
+  // Buzón sin conexión (opcional)
+  telemetryOutbox *outbox = nullptr;
+  bool queuedAny = false;
+  unsigned long lastQueuedAt = 0;
+  unsigned long lastDrainAt = 0;
+  uint32_t replayed = 0;
+
+  // Heap del firmware (opcional)
+  const heapMonitor *heap = nullptr;
+  unsigned long lastHeapAt = 0;
+  bool heapSent = false;
+
+  // Estadísticas
+  uint32_t messages = 0;
+  uint32_t failures = 0;
+  uint32_t suppressed = 0; // métricas dentro de su banda muerta
+  uint32_t connectAttempts = 0;
+  uint16_t lastBurst = 0;  // mensajes del último ciclo
+
+  void begin(mqttTransport &t, const batteryStack &st)
+  {
+    transport = &t;
+    stack = &st;
+  }
+
+  void attachOutbox(telemetryOutbox &o) { outbox = &o; }
+  void attachHeap(const heapMonitor &h) { heap = &h; }
+
+  // Llamar tras cada adquisición: sin broker, guarda un registro con sello de
+  // tiempo cada OUTBOX_INTERVAL_SEC para reenviarlo al reconectar. El sello
+  // es UTC con 'synced'; sin NTP, segundos desde el arranque.
+  void queueIfOffline(uint32_t timestamp, bool synced, unsigned long now)
+  {
+    if (!outbox || !transport || transport->connected() || stack->batteryCount == 0)
+      return;
+    if (queuedAny && now - lastQueuedAt < OUTBOX_INTERVAL_SEC * 1000UL)
+      return;
+    outboxRecord r;
+    outboxRecordFromStack(r, *stack, timestamp, synced);
+    outbox->push(r);
+    queuedAny = true;
+    lastQueuedAt = now;
+  }
+
+  bool publish(const char *topic, const char *payload, size_t len, bool retain)
+  {
+    if (!transport->publish(topic, payload, len, retain))
+    {
+      failures++;
+      return false;
+    }
+    messages++;
+    return true;
+  }
+
+  // Llamar en cada vuelta de loop()
+  void loop(unsigned long now)
+  {
+    if (!transport || !stack)
+      return;
+
+    if (!transport->connected())
+    {
+      if (wasConnected)
+      {
+        wasConnected = false;
+        cycleActive = false;
+        LOG_W(MQTT, "Disconnected");
+      }
+      if ((long)(now - nextConnectAt) >= 0)
+      {
+        connectAttempts++;
+        transport->connect();
+        nextConnectAt = now + backoffMs;
+        backoffMs = backoffMs * 2 > MQTT_RECONNECT_MAX_MS ? MQTT_RECONNECT_MAX_MS : backoffMs * 2;
+      }
+      return;
+    }
+
+    if (!wasConnected)
+    {
+      wasConnected = true;
+      backoffMs = MQTT_RECONNECT_MIN_MS;
+      publishedGeneration = 0; // tras reconectar se publica todo de nuevo
+      slots.reset();
+      queuedAny = false; // el próximo corte empieza a guardar en el acto
+      heapSent = false;
+      LOG_I(MQTT, "Connected");
+      char topic[64];
+      snprintf(topic, sizeof(topic), "%sstatus", MQTT_TOPIC_ROOT);
+      publish(topic, "online", 6, true);
+    }
+
+    if (!cycleActive && preCycle && preCycle(*this))
+      return;
+
+    if (!cycleActive)
+    {
+      drainOutbox(now);
+      publishHeap(now);
+      if (stack->generation == 0 || stack->generation == publishedGeneration)
+        return;
+      if (publishedGeneration != 0 && now - lastPushAt < pushIntervalMs)
+        return;
+      cycleActive = true;
+      cursor = 0;
+      cycleGeneration = stack->generation;
+      cycleSec = now / 1000;
+      lastPushAt = now;
+      lastBurst = 0;
+    }
+
+    publishSome();
+  }
+
+  // Recorre los slots desde el cursor y publica seguidas las métricas que han
+  // salido de su banda muerta o cuyo latido ha vencido. Normalmente la ráfaga
+  // entera cabe en una vuelta; tras reconectar (todo pendiente) se reparte en
+  // tandas de MQTT_PUBLISH_BUDGET. Si el cliente no acepta un mensaje (buffer
+  // TCP lleno) se reintenta en la siguiente vuelta.
+  void publishSome()
+  {
+    char topic[64];
+    char value[24];
+    int budget = MQTT_PUBLISH_BUDGET;
+
+    while (cursor < MQTT_METRIC_SLOTS && budget > 0)
+    {
+      mqttMetric m;
+      if (!mqttMetricAt(*stack, cursor, m))
+      {
+        slots.forget(cursor); // si el módulo vuelve, se publica de inmediato
+      }
+      else if (!slots.due(cursor, m, cycleSec))
+      {
+        suppressed++;
+      }
+      else
+      {
+        size_t len = mqttFormatValue(value, sizeof(value), m);
+        mqttFormatTopic(topic, sizeof(topic), m);
+        if (!publish(topic, value, len, false))
+          return;
+        slots.mark(cursor, m.value, cycleSec);
+        lastBurst++;
+        budget--;
+      }
+      cursor++;
+    }
+
+    if (cursor >= MQTT_METRIC_SLOTS)
+    {
+      cycleActive = false;
+      publishedGeneration = cycleGeneration;
+    }
+  }
+
+  void publishHeap(unsigned long now)
+  {
+    if (!heap || heap->samples == 0 || (heapSent && now - lastHeapAt < MQTT_HEAP_INTERVAL_MS))
+      return;
+    char topic[64];
+    char payload[160];
+    snprintf(topic, sizeof(topic), "%sheap", MQTT_TOPIC_ROOT);
+    size_t len = heap->formatMqtt(payload, sizeof(payload));
+    if (publish(topic, payload, len, false))
+    {
+      heapSent = true;
+      lastHeapAt = now;
+    }
+  }
+
+  // Reenvía el buzón, del más antiguo al más nuevo, OUTBOX_DRAIN_BATCH
+  // registros cada OUTBOX_DRAIN_INTERVAL_MS. Un registro solo sale del buzón
+  // cuando el cliente lo ha aceptado.
+  void drainOutbox(unsigned long now)
+  {
+    if (!outbox || outbox->size() == 0 || now - lastDrainAt < OUTBOX_DRAIN_INTERVAL_MS)
+      return;
+    lastDrainAt = now;
+
+    char topic[64];
+    char payload[256];
+    snprintf(topic, sizeof(topic), "%sbacklog", MQTT_TOPIC_ROOT);
+
+    outboxRecord r;
+    for (int i = 0; i < OUTBOX_DRAIN_BATCH && outbox->peek(r); i++)
+    {
+      size_t len = outboxFormatJson(payload, sizeof(payload), r);
+      if (!publish(topic, payload, len, false))
+        break;
+      outbox->pop();
+      replayed++;
+    }
+    outbox->commit();
+
+    if (outbox->size() == 0)
+      LOG_I(OUTBOX, "Backlog drained (%u records replayed, %u dropped)", (unsigned)replayed, (unsigned)outbox->dropped);
+  }
+};
+
+#endif // MQTTPUBLISHER_H
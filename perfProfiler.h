@@ -0,0 +1,231 @@
+#ifndef PERFPROFILER_H
+#define PERFPROFILER_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "routeTable.h"
+#include "telemetryCodec.h"
+
+// ================== Perfil de latencia de loop() ==================
+//
+// PERF_SCOPE(etapa) al principio de un bloque mide con micros() hasta el
+// final del bloque y suma la muestra al histograma de la etapa: cubetas
+// log2 fijas (1 µs, 2 µs, 4 µs ... 16 s), sin heap ni floats en el camino
+// caliente. Las rutas HTTP (routeTable.h) tienen sus propios histogramas.
+//
+// Por cada vuelta de loop() se acumula el tiempo de cada etapa; si la vuelta
+// es la más larga desde el último reset, la etapa (hoja) que más tiempo se
+// llevó queda como causa del peor bloqueo.
+//
+// Con DISABLE_PERF las macros no generan código ni reservan memoria.
+
+#ifndef DISABLE_PERF
+
+#define PERF_BUCKETS 25     // cubeta i: [2^(i-1), 2^i) µs; la 0 es < 1 µs, la última >= 8 s
+
+enum perfStage : uint8_t
+{
+  PERF_LOOP,        // vuelta completa (contenedor)
+  PERF_ACQUISITION, // updateBatteryData (contenedor)
+  PERF_BMS_SERIAL,  // esperas en la consola del BMS
+  PERF_PARSE,
+  PERF_HTTP,
+  PERF_WEBSOCKET,
+  PERF_OTA,
+  PERF_NTP,
+  PERF_FLASH, // guardado del histórico
+  PERF_WIFI,
+  PERF_MQTT,
+  PERF_MODBUS,
+  PERF_INFLUX,
+  PERF_UDP,
+  PERF_STAGE_COUNT
+};
+
+static const char *const _perfStageNames[PERF_STAGE_COUNT] = {
+    "loop", "acquisition", "bms_serial", "parse", "http", "websocket", "ota",
+    "ntp", "flash", "wifi", "mqtt", "modbus", "influx", "udp"};
+
+// Contienen otras etapas: no cuentan como causa de un bloqueo si hay hojas
+static inline bool _perfIsContainer(uint8_t stage) { return stage == PERF_LOOP || stage == PERF_ACQUISITION; }
+
+struct perfHistogram
+{
+  uint32_t count;
+  uint32_t maxUs;
+  uint64_t sumUs;
+  uint32_t buckets[PERF_BUCKETS];
+
+  void add(uint32_t us)
+  {
+    uint8_t b = 0;
+    for (uint32_t v = us; v && b < PERF_BUCKETS - 1; v >>= 1)
+      b++;
+    buckets[b]++;
+    count++;
+    sumUs += us;
+    if (us > maxUs)
+      maxUs = us;
+  }
+
+  // Percentil interpolado linealmente dentro de su cubeta y acotado por el
+  // máximo real: error de como mucho el ancho de la cubeta (x2)
+  uint32_t percentile(uint8_t pct) const
+  {
+    if (count == 0)
+      return 0;
+    uint32_t rank = ((uint64_t)count * pct + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t b = 0; b < PERF_BUCKETS; b++)
+    {
+      if (seen + buckets[b] >= rank)
+      {
+        uint32_t lower = b ? 1u << (b - 1) : 0;
+        uint32_t upper = 1u << b;
+        uint32_t v = lower + (uint64_t)(upper - lower) * (rank - seen) / buckets[b];
+        return v < maxUs ? v : maxUs;
+      }
+      seen += buckets[b];
+    }
+    return maxUs;
+  }
+};
+
+struct perfProfiler
+{
+  perfHistogram stages[PERF_STAGE_COUNT];
+  perfHistogram routes[HTTP_MAX_ROUTES]; // indexado como httpRoutes
+
+  // Vuelta en curso y peor bloqueo
+  uint32_t loopStageUs[PERF_STAGE_COUNT];
+  uint32_t stallUs;
+  uint8_t stallCause;
+  unsigned long stallAt; // millis()
+
+  // Vueltas por segundo (ventana de un segundo cerrada)
+  unsigned long windowStart;
+  uint32_t windowLoops;
+  uint32_t loopsPerSecond;
+  unsigned long resetAt;
+
+  perfProfiler() { reset(0); }
+
+  void reset(unsigned long now)
+  {
+    memset(stages, 0, sizeof(stages));
+    memset(routes, 0, sizeof(routes));
+    memset(loopStageUs, 0, sizeof(loopStageUs));
+    stallUs = 0;
+    stallCause = PERF_LOOP;
+    stallAt = 0;
+    windowStart = now;
+    windowLoops = 0;
+    loopsPerSecond = 0;
+    resetAt = now;
+  }
+
+  void record(uint8_t stage, uint32_t us, unsigned long nowMs)
+  {
+    stages[stage].add(us);
+    if (stage == PERF_HTTP)
+      routeDone(us);
+    if (stage != PERF_LOOP)
+    {
+      loopStageUs[stage] += us;
+      return;
+    }
+
+    // Fin de vuelta: causa del bloqueo y ventana de vueltas por segundo
+    if (us > stallUs)
+    {
+      uint8_t cause = PERF_LOOP;
+      uint32_t worst = 0;
+      for (uint8_t s = 1; s < PERF_STAGE_COUNT; s++)
+        if (!_perfIsContainer(s) && loopStageUs[s] > worst)
+        {
+          worst = loopStageUs[s];
+          cause = s;
+        }
+      if (worst == 0 && loopStageUs[PERF_ACQUISITION])
+        cause = PERF_ACQUISITION;
+      stallUs = us;
+      stallCause = cause;
+      stallAt = nowMs;
+    }
+    memset(loopStageUs, 0, sizeof(loopStageUs));
+
+    windowLoops++;
+    if (nowMs - windowStart >= 1000)
+    {
+      loopsPerSecond = (uint64_t)windowLoops * 1000 / (nowMs - windowStart);
+      windowLoops = 0;
+      windowStart = nowMs;
+    }
+  }
+
+  // La petición en curso acaba de atenderse en 'us'
+  void routeDone(uint32_t us)
+  {
+    if (httpRoutes.current >= 0)
+      routes[httpRoutes.current].add(us);
+  }
+};
+
+static perfProfiler perf;
+
+struct perfScope
+{
+  uint8_t stage;
+  unsigned long started;
+  explicit perfScope(uint8_t s) : stage(s), started(micros()) {}
+  ~perfScope() { perf.record(stage, micros() - started, millis()); }
+};
+#define PERF_CAT2(a, b) a##b
+#define PERF_CAT(a, b) PERF_CAT2(a, b)
+#define PERF_SCOPE(stage) perfScope PERF_CAT(_perfScope, __LINE__)(stage)
+
+// ================== /perf ==================
+
+template <typename Out>
+static void _perfHistogramJson(Out &out, const char *name, const perfHistogram &h)
+{
+  out.printf("{\"name\":\"%s\",\"count\":%lu,\"p50Us\":%lu,\"p99Us\":%lu,\"maxUs\":%lu,\"meanUs\":%lu,\"totalMs\":%lu}",
+             name, (unsigned long)h.count, (unsigned long)h.percentile(50), (unsigned long)h.percentile(99),
+             (unsigned long)h.maxUs, (unsigned long)(h.count ? h.sumUs / h.count : 0), (unsigned long)(h.sumUs / 1000));
+}
+
+template <typename Sink>
+void writePerfJson(Sink &sink, const perfProfiler &p, const routeTable &names, unsigned long now)
+{
+  textWriter<Sink> out(sink);
+  out.printf("{\"windowMs\":%lu,\"loopsPerSecond\":%lu,\"stall\":{\"us\":%lu,\"cause\":\"%s\",\"agoMs\":%ld},\"stages\":[",
+             now - p.resetAt, (unsigned long)p.loopsPerSecond, (unsigned long)p.stallUs,
+             _perfStageNames[p.stallCause], p.stallUs ? (long)(now - p.stallAt) : -1L);
+  bool first = true;
+  for (uint8_t s = 0; s < PERF_STAGE_COUNT; s++)
+  {
+    if (p.stages[s].count == 0)
+      continue;
+    out.print(first ? "" : ",");
+    _perfHistogramJson(out, _perfStageNames[s], p.stages[s]);
+    first = false;
+  }
+  out.print("],\"routes\":[");
+  first = true;
+  for (uint8_t r = 0; r < names.count; r++)
+  {
+    if (p.routes[r].count == 0)
+      continue;
+    out.print(first ? "" : ",");
+    _perfHistogramJson(out, names.names[r], p.routes[r]);
+    first = false;
+  }
+  out.print("]}");
+}
+
+#else
+#define PERF_SCOPE(stage) ((void)0)
+#endif // DISABLE_PERF
+
+#endif // PERFPROFILER_H
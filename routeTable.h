@@ -0,0 +1,59 @@
+#ifndef ROUTETABLE_H
+#define ROUTETABLE_H
+
+#include <ctype.h>
+#include <stdint.h>
+#include <string.h>
+
+// ================== Rutas HTTP vistas ==================
+//
+// Tabla fija de nombres de ruta (URI sin query), asignados la primera vez
+// que se ven. El hook del servidor anota en 'current' la ruta de la petición
+// en curso; los que llevan estadísticas por ruta (perfProfiler, heapMonitor)
+// las guardan en arrays paralelos indexados igual. Tras handleClient() el
+// loop la devuelve a -1.
+
+#define HTTP_MAX_ROUTES 16
+#define HTTP_ROUTE_LEN 24
+
+struct routeTable
+{
+  char names[HTTP_MAX_ROUTES][HTTP_ROUTE_LEN];
+  uint8_t count = 0;
+  int8_t current = -1; // ruta de la petición en curso (-1 ninguna)
+
+  routeTable() { memset(names, 0, sizeof(names)); }
+
+  // Índice de la ruta. Las que no caben en la tabla, las demasiado largas o
+  // con caracteres raros (escáneres) van a "other".
+  int8_t lookup(const char *uri)
+  {
+    size_t len = strcspn(uri, "?");
+    bool plain = len < HTTP_ROUTE_LEN;
+    for (size_t i = 0; i < len && plain; i++)
+      plain = isalnum((unsigned char)uri[i]) || strchr("/_-.", uri[i]);
+    if (!plain)
+      return other();
+    for (uint8_t i = 0; i < count; i++)
+      if (strncmp(names[i], uri, len) == 0 && names[i][len] == 0)
+        return i;
+    if (count >= HTTP_MAX_ROUTES - 1)
+      return other();
+    memcpy(names[count], uri, len);
+    names[count][len] = 0;
+    return count++;
+  }
+
+  int8_t other()
+  {
+    for (uint8_t i = 0; i < count; i++)
+      if (strcmp(names[i], "other") == 0)
+        return i;
+    strcpy(names[count], "other");
+    return count++;
+  }
+};
+
+static routeTable httpRoutes;
+
+#endif // ROUTETABLE_H
@@ -0,0 +1,444 @@
+#ifndef TELEMETRYCODEC_H
+#define TELEMETRYCODEC_H
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "batteryStack.h"
+
+// ================== Serialización del snapshot (JSON / CBOR) ==================
+//
+// Ambos formatos se escriben directamente desde batteryStack sobre un "Sink"
+// cualquiera que ofrezca write(const char *data, size_t len): el escritor por
+// trozos del servidor web, un buffer fijo (datagrama UDP) o memoria en el host.
+//
+// Mismo esquema en los dos formatos. En JSON las magnitudes van en unidades
+// (V, A, W, °C con decimales); en CBOR van como enteros en milésimas
+// (mV, mA, mW, m°C), tal cual están en el struct.
+
+// Sink sobre un buffer fijo; overflow indica que no cupo todo
+struct bufferSink
+{
+  uint8_t *buf;
+  size_t cap;
+  size_t len = 0;
+  bool overflow = false;
+
+  bufferSink(uint8_t *b, size_t c) : buf(b), cap(c) {}
+
+  void write(const char *data, size_t n)
+  {
+    if (len + n > cap)
+    {
+      overflow = true;
+      n = cap - len;
+    }
+    memcpy(buf + len, data, n);
+    len += n;
+  }
+};
+
+// ---------- Texto ----------
+template <typename Sink>
+struct textWriter
+{
+  Sink &out;
+  explicit textWriter(Sink &s) : out(s) {}
+
+  void print(const char *s) { out.write(s, strlen(s)); }
+
+  void printf(const char *fmt, ...)
+  {
+    char tmp[160];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(tmp, sizeof(tmp), fmt, ap);
+    va_end(ap);
+    if (n > 0)
+      out.write(tmp, (size_t)n < sizeof(tmp) ? (size_t)n : sizeof(tmp) - 1);
+  }
+
+  // Valor en milésimas con 'decimals' decimales, sin pasar por float: 49972 -> "49.972"
+  void milli(long v, int decimals)
+  {
+    static const long div[] = {1000, 100, 10, 1};
+    static const long p10[] = {1, 10, 100, 1000};
+    bool neg = v < 0;
+    if (neg)
+      v = -v;
+    long scaled = (v + div[decimals] / 2) / div[decimals]; // redondeo
+    if (decimals == 0)
+      printf("%s%ld", neg && scaled ? "-" : "", scaled);
+    else
+      printf("%s%ld.%0*ld", neg && scaled ? "-" : "", scaled / p10[decimals], decimals, scaled % p10[decimals]);
+  }
+};
+
+// ---------- CBOR (RFC 8949), solo los tipos que usamos ----------
+template <typename Sink>
+struct cborWriter
+{
+  Sink &out;
+  explicit cborWriter(Sink &s) : out(s) {}
+
+  void head(uint8_t major, uint32_t v)
+  {
+    uint8_t b[5];
+    size_t n;
+    major <<= 5;
+    if (v < 24)
+    {
+      b[0] = major | v;
+      n = 1;
+    }
+    else if (v <= 0xFF)
+    {
+      b[0] = major | 24;
+      b[1] = v;
+      n = 2;
+    }
+    else if (v <= 0xFFFF)
+    {
+      b[0] = major | 25;
+      b[1] = v >> 8;
+      b[2] = v;
+      n = 3;
+    }
+    else
+    {
+      b[0] = major | 26;
+      b[1] = v >> 24;
+      b[2] = v >> 16;
+      b[3] = v >> 8;
+      b[4] = v;
+      n = 5;
+    }
+    out.write((const char *)b, n);
+  }
+
+  void integer(long v)
+  {
+    if (v >= 0)
+      head(0, (uint32_t)v);
+    else
+      head(1, (uint32_t)(-1 - v));
+  }
+  void text(const char *s)
+  {
+    size_t n = strlen(s);
+    head(3, n);
+    out.write(s, n);
+  }
+  void boolean(bool v)
+  {
+    uint8_t b = v ? 0xF5 : 0xF4;
+    out.write((const char *)&b, 1);
+  }
+  void array(uint32_t n) { head(4, n); }
+  void map(uint32_t n) { head(5, n); }
+
+  // Pares clave/valor
+  void kv(const char *key, long v)
+  {
+    text(key);
+    integer(v);
+  }
+  void kv(const char *key, const char *v)
+  {
+    text(key);
+    text(v);
+  }
+};
+
+// ================== /snapshot ==================
+
+static int _presentBatteries(const batteryStack &st)
+{
+  int n = 0;
+  for (int i = 0; i < MAX_PYLON_BATTERIES_SUPPORTED; i++)
+    if (st.batts[i].isPresent)
+      n++;
+  return n;
+}
+
+// Primer índice de la cola de 'tail' entradas del histórico
+static int _historyTailStart(const batteryStack &st, int tail)
+{
+  if (tail < 0)
+    tail = 0;
+  if (tail > st.history.entryCount)
+    tail = st.history.entryCount;
+  return st.history.entryCount - tail;
+}
+
+template <typename Sink>
+void writeSnapshotJson(Sink &sink, const batteryStack &st, int historyTail, unsigned long now)
+{
+  textWriter<Sink> out(sink);
+  out.printf("{\"generation\":%u,\"historyGeneration\":%u,\"age\":%lu,",
+             (unsigned)st.generation, (unsigned)st.history.generation, (unsigned long)(now - st.acquiredAt));
+
+  // Agregados de la pila
+  out.printf("\"stack\":{\"batteryCount\":%d,\"soc\":%d,\"voltage\":", st.batteryCount, st.soc);
+  out.milli(st.avgVoltage, 3);
+  out.print(",\"current\":");
+  out.milli(st.currentDC, 3);
+  out.print(",\"power\":");
+  out.milli((long)((long long)st.avgVoltage * st.currentDC / 1000), 1);
+  out.print(",\"temperature\":");
+  out.milli(st.temp, 1);
+  out.printf(",\"state\":\"%s\",\"cellCount\":%d,\"imbalanceMv\":%ld", st.baseState, st.cellCount, st.imbalanceMv());
+  if (st.cellVoltHighBatt)
+  {
+    out.printf(",\"maxCell\":{\"battery\":%u,\"cell\":%u,\"voltage\":", st.cellVoltHighBatt, st.batts[st.cellVoltHighBatt - 1].cellVoltHighId);
+    out.milli(st.cellVoltHigh, 3);
+    out.printf("},\"minCell\":{\"battery\":%u,\"cell\":%u,\"voltage\":", st.cellVoltLowBatt, st.batts[st.cellVoltLowBatt - 1].cellVoltLowId);
+    out.milli(st.cellVoltLow, 3);
+    out.print("}");
+  }
+  out.print("},\"modules\":[");
+
+  // Resumen por módulo
+  bool first = true;
+  for (int i = 0; i < MAX_PYLON_BATTERIES_SUPPORTED; i++)
+  {
+    const pylonBattery &b = st.batts[i];
+    if (!b.isPresent)
+      continue;
+    out.printf("%s{\"id\":%d,\"soc\":%ld,\"voltage\":", first ? "" : ",", i + 1, b.soc);
+    first = false;
+    out.milli(b.voltage, 3);
+    out.print(",\"current\":");
+    out.milli(b.current, 3);
+    out.print(",\"power\":");
+    out.milli((long)((long long)b.voltage * b.current / 1000), 1);
+    out.print(",\"temperature\":");
+    out.milli(b.tempr, 1);
+    out.printf(",\"state\":\"%s\",\"cellCount\":%u,\"imbalanceMv\":%ld", b.baseState, b.cellCount, b.imbalanceMv());
+    if (b.cellCount > 0)
+    {
+      out.printf(",\"maxCell\":{\"cell\":%u,\"voltage\":", b.cellVoltHighId);
+      out.milli(b.cellVoltHigh, 3);
+      out.printf("},\"minCell\":{\"cell\":%u,\"voltage\":", b.cellVoltLowId);
+      out.milli(b.cellVoltLow, 3);
+      out.print("}");
+    }
+    out.print("}");
+  }
+
+  // Cola del histórico (más antiguo primero)
+  out.printf("],\"historyTotal\":%u,\"history\":[", st.history.entryCount);
+  first = true;
+  for (int i = _historyTailStart(st, historyTail); i < st.history.entryCount; i++)
+  {
+    const balanceHistoryEntry *e = st.history.getEntry(i);
+    if (!e)
+      continue;
+    out.printf("%s{\"timestamp\":%lu,\"batteryId\":%u,\"balanceMv\":%d,\"socPercent\":%u%s}",
+               first ? "" : ",", (unsigned long)e->timestamp, e->batteryId, e->balanceMv, e->socPercent,
+               e->flags & HISTORY_UNSYNCED ? ",\"synced\":false" : "");
+    first = false;
+  }
+  out.print("]}");
+}
+
+template <typename Sink>
+static void _cborHistoryEntries(cborWriter<Sink> &out, const batteryStack &st, int from)
+{
+  int n = 0;
+  for (int i = from; i < st.history.entryCount; i++)
+    if (st.history.getEntry(i))
+      n++;
+  out.array(n);
+  for (int i = from; i < st.history.entryCount; i++)
+  {
+    const balanceHistoryEntry *e = st.history.getEntry(i);
+    if (!e)
+      continue;
+    bool unsynced = e->flags & HISTORY_UNSYNCED;
+    out.map(unsynced ? 5 : 4);
+    out.kv("timestamp", (long)e->timestamp);
+    out.kv("batteryId", e->batteryId);
+    out.kv("balanceMv", e->balanceMv);
+    out.kv("socPercent", e->socPercent);
+    if (unsynced)
+    {
+      out.text("synced");
+      out.boolean(false);
+    }
+  }
+}
+
+template <typename Sink>
+void writeSnapshotCbor(Sink &sink, const batteryStack &st, int historyTail, unsigned long now)
+{
+  cborWriter<Sink> out(sink);
+  out.map(7);
+  out.kv("generation", (long)st.generation);
+  out.kv("historyGeneration", (long)st.history.generation);
+  out.kv("age", (long)(now - st.acquiredAt));
+
+  out.text("stack");
+  out.map(st.cellVoltHighBatt ? 11 : 9);
+  out.kv("batteryCount", st.batteryCount);
+  out.kv("soc", st.soc);
+  out.kv("voltage", st.avgVoltage);
+  out.kv("current", st.currentDC);
+  out.kv("power", (long)((long long)st.avgVoltage * st.currentDC / 1000));
+  out.kv("temperature", st.temp);
+  out.kv("state", st.baseState);
+  out.kv("cellCount", st.cellCount);
+  out.kv("imbalanceMv", st.imbalanceMv());
+  if (st.cellVoltHighBatt)
+  {
+    out.text("maxCell");
+    out.map(3);
+    out.kv("battery", st.cellVoltHighBatt);
+    out.kv("cell", st.batts[st.cellVoltHighBatt - 1].cellVoltHighId);
+    out.kv("voltage", st.cellVoltHigh);
+    out.text("minCell");
+    out.map(3);
+    out.kv("battery", st.cellVoltLowBatt);
+    out.kv("cell", st.batts[st.cellVoltLowBatt - 1].cellVoltLowId);
+    out.kv("voltage", st.cellVoltLow);
+  }
+
+  out.text("modules");
+  out.array(_presentBatteries(st));
+  for (int i = 0; i < MAX_PYLON_BATTERIES_SUPPORTED; i++)
+  {
+    const pylonBattery &b = st.batts[i];
+    if (!b.isPresent)
+      continue;
+    out.map(b.cellCount > 0 ? 11 : 9);
+    out.kv("id", i + 1);
+    out.kv("soc", b.soc);
+    out.kv("voltage", b.voltage);
+    out.kv("current", b.current);
+    out.kv("power", (long)((long long)b.voltage * b.current / 1000));
+    out.kv("temperature", b.tempr);
+    out.kv("state", b.baseState);
+    out.kv("cellCount", b.cellCount);
+    out.kv("imbalanceMv", b.imbalanceMv());
+    if (b.cellCount > 0)
+    {
+      out.text("maxCell");
+      out.map(2);
+      out.kv("cell", b.cellVoltHighId);
+      out.kv("voltage", b.cellVoltHigh);
+      out.text("minCell");
+      out.map(2);
+      out.kv("cell", b.cellVoltLowId);
+      out.kv("voltage", b.cellVoltLow);
+    }
+  }
+
+  out.kv("historyTotal", st.history.entryCount);
+  out.text("history");
+  _cborHistoryEntries(out, st, _historyTailStart(st, historyTail));
+}
+
+// ================== /battery-data ==================
+
+template <typename Sink>
+static void _jsonReadings(textWriter<Sink> &out, long soc, long mV, long mA, long mC)
+{
+  out.printf("\"soc\":%ld,\"voltage\":", soc);
+  out.milli(mV, 3);
+  out.print(",\"current\":");
+  out.milli(mA, 3);
+  out.print(",\"power\":");
+  out.milli((long)((long long)mV * mA / 1000), 1);
+  out.print(",\"temperature\":");
+  out.milli(mC, 1);
+}
+
+// Estado del equilibrio con los umbrales LiFePO4 (40 / 60 mV)
+template <typename Sink>
+static void _jsonBalance(textWriter<Sink> &out, long imbalanceMv, int cellCount, long maxMv, long minMv, int maxCellId, int minCellId)
+{
+  if (cellCount == 0)
+    out.print(",\"balanceStatus\":\"N/A\",\"balanceMessage\":\"Sin datos\",");
+  else if (imbalanceMv <= 40)
+    out.printf(",\"balanceStatus\":\"Normal\",\"balanceMessage\":\"Balance óptimo (%ldmV)\",", imbalanceMv);
+  else if (imbalanceMv <= 60)
+    out.printf(",\"balanceStatus\":\"Advertencia\",\"balanceMessage\":\"Desequilibrio moderado (%ldmV)\",", imbalanceMv);
+  else
+    out.printf(",\"balanceStatus\":\"Crítico\",\"balanceMessage\":\"Desequilibrio alto (%ldmV)\",", imbalanceMv);
+  out.printf("\"imbalanceMv\":%ld,\"cellCount\":%d,\"maxCellVoltage\":", imbalanceMv, cellCount);
+  out.milli(maxMv, 3);
+  out.print(",\"minCellVoltage\":");
+  out.milli(minMv, 3);
+  out.printf(",\"maxCellId\":%d,\"minCellId\":%d", maxCellId, minCellId);
+}
+
+// Vista de sistema (module 0) o de un módulo (1-based); un módulo que no
+// está presente da un objeto con "error"
+template <typename Sink>
+void writeBatteryDataJson(Sink &sink, const batteryStack &st, int module, unsigned long now)
+{
+  textWriter<Sink> out(sink);
+  if (module == 0)
+  {
+    const pylonBattery *hi = st.cellVoltHighBatt ? &st.batts[st.cellVoltHighBatt - 1] : nullptr;
+    const pylonBattery *lo = st.cellVoltLowBatt ? &st.batts[st.cellVoltLowBatt - 1] : nullptr;
+    out.print("{");
+    _jsonReadings(out, st.soc, st.avgVoltage, st.currentDC, st.temp);
+    _jsonBalance(out, st.imbalanceMv(), st.cellCount, st.cellVoltHigh, st.cellVoltLow,
+                 hi ? hi->cellVoltHighId : 0, lo ? lo->cellVoltLowId : 0);
+    out.printf(",\"maxCellBattery\":%u,\"minCellBattery\":%u,\"batteryCount\":%d",
+               st.cellVoltHighBatt, st.cellVoltLowBatt, st.batteryCount);
+  }
+  else
+  {
+    if (module < 1 || module > MAX_PYLON_BATTERIES_SUPPORTED || !st.batts[module - 1].isPresent)
+    {
+      out.print("{\"soc\":0,\"voltage\":0.0,\"current\":0.0,\"power\":0.0,\"temperature\":0.0,"
+                "\"error\":\"Batería no disponible\"}");
+      return;
+    }
+    const pylonBattery &b = st.batts[module - 1];
+    out.print("{");
+    _jsonReadings(out, b.soc, b.voltage, b.current, b.tempr);
+    _jsonBalance(out, b.imbalanceMv(), b.cellCount, b.cellVoltHigh, b.cellVoltLow, b.cellVoltHighId, b.cellVoltLowId);
+    out.printf(",\"baseState\":\"%s\"", b.baseState);
+  }
+  out.printf(",\"generation\":%u,\"age\":%lu}", (unsigned)st.generation, (unsigned long)(now - st.acquiredAt));
+}
+
+// ================== /balance-history ==================
+
+template <typename Sink>
+void writeHistoryJson(Sink &sink, const batteryStack &st, unsigned long now)
+{
+  textWriter<Sink> out(sink);
+  out.print("{\"data\":[");
+  bool first = true;
+  for (int i = 0; i < st.history.entryCount; i++)
+  {
+    const balanceHistoryEntry *e = st.history.getEntry(i);
+    if (!e)
+      continue;
+    out.printf("%s{\"timestamp\":%lu,\"batteryId\":%u,\"balanceMv\":%d,\"socPercent\":%u%s}",
+               first ? "" : ",", (unsigned long)e->timestamp, e->batteryId, e->balanceMv, e->socPercent,
+               e->flags & HISTORY_UNSYNCED ? ",\"synced\":false" : "");
+    first = false;
+  }
+  out.printf("],\"totalEntries\":%u,\"maxEntries\":%u,\"currentTime\":%lu}",
+             st.history.entryCount, MAX_BALANCE_HISTORY_ENTRIES, now);
+}
+
+template <typename Sink>
+void writeHistoryCbor(Sink &sink, const batteryStack &st, unsigned long now)
+{
+  cborWriter<Sink> out(sink);
+  out.map(4);
+  out.text("data");
+  _cborHistoryEntries(out, st, 0);
+  out.kv("totalEntries", st.history.entryCount);
+  out.kv("maxEntries", MAX_BALANCE_HISTORY_ENTRIES);
+  out.kv("currentTime", (long)now);
+}
+
+#endif // TELEMETRYCODEC_H
@@ -0,0 +1,357 @@
+#ifndef TELEMETRYOUTBOX_H
+#define TELEMETRYOUTBOX_H
+
+#include "batteryStack.h"
+#include "logger.h"
+#include "telemetryCodec.h"
+
+// ================== Buzón de telemetría sin conexión (store-and-forward) ==================
+//
+// Mientras no hay enlace con el broker se guarda un registro con sello de
+// tiempo cada OUTBOX_INTERVAL_SEC. Los registros nuevos van a un anillo en RAM;
+// cuando se llena se vuelca entero a un fichero circular en LittleFS. Al
+// reconectar se vacía del más antiguo al más nuevo (primero el fichero, luego
+// la RAM) en tandas limitadas para no saturar al broker ni a loop().
+//
+// Con el buzón lleno manda OUTBOX_DROP_POLICY: OUTBOX_DROP_OLDEST sobrescribe
+// lo más antiguo (conserva lo reciente), OUTBOX_DROP_NEWEST descarta lo nuevo
+// (conserva el inicio del corte).
+//
+// Antes de la primera sincronización NTP los registros llevan segundos desde
+// el arranque y OUTBOX_FLAG_UNSYNCED. Cada registro lleva además la marca del
+// arranque en que se escribió (un contador en la cabecera del fichero), así
+// que al llegar la hora fixUnsynced() re-sella los de este arranque; los de
+// arranques anteriores no tienen corrección posible y conservan la marca.
+
+#ifndef OUTBOX_RAM_RECORDS
+#define OUTBOX_RAM_RECORDS 16 // 512 bytes de heap
+#endif
+#ifndef OUTBOX_FILE_RECORDS
+#define OUTBOX_FILE_RECORDS 2048 // 64 KB en flash: ~34 h a un registro por minuto
+#endif
+#ifndef OUTBOX_INTERVAL_SEC
+#define OUTBOX_INTERVAL_SEC 60
+#endif
+#ifndef OUTBOX_DRAIN_BATCH
+#define OUTBOX_DRAIN_BATCH 10 // registros por tanda al reconectar
+#endif
+#ifndef OUTBOX_DRAIN_INTERVAL_MS
+#define OUTBOX_DRAIN_INTERVAL_MS 500
+#endif
+#ifndef OUTBOX_DROP_POLICY
+#define OUTBOX_DROP_POLICY OUTBOX_DROP_OLDEST
+#endif
+
+#define OUTBOX_FILE "/outbox.dat"
+#define OUTBOX_MAGIC 0x584F424FUL // "OBOX"
+
+enum outboxDropPolicy : uint8_t
+{
+  OUTBOX_DROP_OLDEST,
+  OUTBOX_DROP_NEWEST
+};
+
+#define OUTBOX_FLAG_UNSYNCED 0x01 // el sello no viene de NTP (segundos desde arranque)
+
+// Agregados de la pila en un instante; 32 bytes fijos, tal cual en flash
+struct outboxRecord
+{
+  uint32_t timestamp;   // Unix UTC (o segundos desde arranque si OUTBOX_FLAG_UNSYNCED)
+  int32_t voltage;      // mV
+  int32_t current;      // mA
+  int32_t temperature;  // m°C
+  uint16_t cellHigh;    // mV
+  uint16_t cellLow;     // mV
+  uint16_t imbalance;   // mV
+  uint8_t soc;          // %
+  uint8_t batteryCount;
+  char state[6];        // sin terminador si ocupa los 6
+  uint8_t boot;         // arranque que lo escribió, 1-255 (0: firmware anterior)
+  uint8_t flags;
+};
+static_assert(sizeof(outboxRecord) == 32, "outboxRecord is stored raw in flash");
+
+// 'boot' ocupa la mitad alta del antiguo 'head' de 32 bits (siempre 0): los
+// ficheros anteriores se leen igual y empiezan en el arranque 0
+struct outboxFileHeader
+{
+  uint32_t magic;
+  uint16_t recordSize;
+  uint16_t capacity;
+  uint16_t head;  // slot del registro más antiguo
+  uint16_t boot;  // contador de arranques, 1-255
+  uint32_t count; // registros pendientes
+};
+static_assert(sizeof(outboxFileHeader) == 16, "outboxFileHeader is stored raw in flash");
+
+static void outboxRecordFromStack(outboxRecord &r, const batteryStack &st, uint32_t timestamp, bool synced)
+{
+  memset(&r, 0, sizeof(r));
+  r.timestamp = timestamp;
+  r.voltage = st.avgVoltage;
+  r.current = st.currentDC;
+  r.temperature = st.temp;
+  r.cellHigh = st.cellVoltHigh;
+  r.cellLow = st.cellVoltLow;
+  r.imbalance = st.imbalanceMv();
+  r.soc = st.soc;
+  r.batteryCount = st.batteryCount;
+  memcpy(r.state, st.baseState, strnlen(st.baseState, sizeof(r.state)));
+  if (!synced)
+    r.flags |= OUTBOX_FLAG_UNSYNCED;
+}
+
+// {"ts":..,"soc":..,"voltage":..,...} con las mismas unidades que los topics en vivo
+static size_t outboxFormatJson(char *buf, size_t cap, const outboxRecord &r)
+{
+  bufferSink sink((uint8_t *)buf, cap - 1);
+  textWriter<bufferSink> out(sink);
+  out.printf("{\"ts\":%lu,\"synced\":%s,\"soc\":%u,\"voltage\":", (unsigned long)r.timestamp,
+             r.flags & OUTBOX_FLAG_UNSYNCED ? "false" : "true", r.soc);
+  out.milli(r.voltage, 3);
+  out.print(",\"current\":");
+  out.milli(r.current, 3);
+  out.print(",\"power\":");
+  out.milli((long)((long long)r.voltage * r.current / 1000), 1);
+  out.print(",\"temperature\":");
+  out.milli(r.temperature, 1);
+  out.printf(",\"imbalance\":%u,\"cell_high\":", r.imbalance);
+  out.milli(r.cellHigh, 3);
+  out.print(",\"cell_low\":");
+  out.milli(r.cellLow, 3);
+  out.printf(",\"batteries\":%u,\"state\":\"%.*s\"}", r.batteryCount, (int)strnlen(r.state, sizeof(r.state)), r.state);
+  buf[sink.len] = '\0';
+  return sink.len;
+}
+
+struct telemetryOutbox
+{
+  outboxRecord ram[OUTBOX_RAM_RECORDS];
+  uint8_t ramHead = 0;
+  uint8_t ramCount = 0;
+
+  outboxFileHeader file = {OUTBOX_MAGIC, sizeof(outboxRecord), OUTBOX_FILE_RECORDS, 0, 1, 0};
+  bool fileOk = false;
+  bool fileDirty = false; // cabecera pendiente de escribir tras vaciar
+
+  uint8_t policy = OUTBOX_DROP_POLICY;
+  uint32_t dropped = 0;
+  uint32_t spilled = 0;
+
+  // Abre o crea el fichero. Un fichero con otro formato se descarta.
+  bool begin()
+  {
+    fileOk = false;
+    if (!LittleFS.begin())
+    {
+      LOG_W(OUTBOX, "LittleFS unavailable, RAM only");
+      return false;
+    }
+
+    if (LittleFS.exists(OUTBOX_FILE))
+    {
+      File f = LittleFS.open(OUTBOX_FILE, "r");
+      outboxFileHeader h;
+      bool valid = f && f.read((uint8_t *)&h, sizeof(h)) == sizeof(h) && h.magic == OUTBOX_MAGIC &&
+                   h.recordSize == sizeof(outboxRecord) && h.capacity == OUTBOX_FILE_RECORDS &&
+                   h.head < h.capacity && h.count <= h.capacity;
+      if (f)
+        f.close();
+      if (valid)
+      {
+        file = h;
+        file.boot = file.boot % 255 + 1;
+        fileOk = true;
+        writeHeader();
+        LOG_I(OUTBOX, "%u records pending from previous run (boot %u)", (unsigned)file.count, file.boot);
+        return true;
+      }
+      LittleFS.remove(OUTBOX_FILE);
+    }
+
+    file.head = 0;
+    file.count = 0;
+    fileOk = writeHeader();
+    return fileOk;
+  }
+
+  uint32_t size() const { return file.count + ramCount; }
+  uint32_t capacity() const { return (fileOk ? OUTBOX_FILE_RECORDS : 0) + OUTBOX_RAM_RECORDS; }
+
+  void push(const outboxRecord &r)
+  {
+    if (ramCount == OUTBOX_RAM_RECORDS && fileOk && (file.count < OUTBOX_FILE_RECORDS || policy == OUTBOX_DROP_OLDEST))
+      spill();
+
+    if (ramCount == OUTBOX_RAM_RECORDS)
+    {
+      dropped++;
+      if (policy == OUTBOX_DROP_NEWEST)
+        return;
+      // Sin fichero (o sin sitio en él): el anillo de RAM pisa lo más antiguo
+      ramHead = (ramHead + 1) % OUTBOX_RAM_RECORDS;
+      ramCount--;
+    }
+    outboxRecord &slot = ram[(ramHead + ramCount) % OUTBOX_RAM_RECORDS];
+    slot = r;
+    slot.boot = file.boot;
+    ramCount++;
+  }
+
+  // Primera sincronización: suma bootUtc a los sellos de uptime de este
+  // arranque. Son los más recientes, así que se recorre del más nuevo hacia
+  // atrás (RAM y después fichero) hasta el primero de otro arranque.
+  int fixUnsynced(uint32_t bootUtc)
+  {
+    int fixed = 0;
+    for (int i = ramCount - 1; i >= 0; i--)
+    {
+      outboxRecord &r = ram[(ramHead + i) % OUTBOX_RAM_RECORDS];
+      if (r.boot != file.boot)
+        return fixed;
+      fixed += restamp(r, bootUtc);
+    }
+    if (!fileOk || file.count == 0)
+      return fixed;
+
+    File f = LittleFS.open(OUTBOX_FILE, "r+");
+    if (!f)
+      return fixed;
+    for (uint32_t i = file.count; i-- > 0;)
+    {
+      uint32_t offset = slotOffset((file.head + i) % OUTBOX_FILE_RECORDS);
+      outboxRecord r;
+      if (!f.seek(offset, SeekSet) || f.read((uint8_t *)&r, sizeof(r)) != sizeof(r) || r.boot != file.boot)
+        break;
+      if (!restamp(r, bootUtc))
+        continue;
+      if (!f.seek(offset, SeekSet) || f.write((const uint8_t *)&r, sizeof(r)) != sizeof(r))
+      {
+        LOG_E(OUTBOX, "Write failed while re-stamping");
+        break;
+      }
+      fixed++;
+    }
+    f.close();
+    return fixed;
+  }
+
+  static bool restamp(outboxRecord &r, uint32_t bootUtc)
+  {
+    if (!(r.flags & OUTBOX_FLAG_UNSYNCED))
+      return false;
+    r.timestamp += bootUtc;
+    r.flags &= ~OUTBOX_FLAG_UNSYNCED;
+    return true;
+  }
+
+  // Registro más antiguo pendiente
+  bool peek(outboxRecord &r)
+  {
+    if (file.count > 0)
+    {
+      File f = LittleFS.open(OUTBOX_FILE, "r");
+      bool ok = f && f.seek(slotOffset(file.head), SeekSet) && f.read((uint8_t *)&r, sizeof(r)) == sizeof(r);
+      if (f)
+        f.close();
+      if (!ok)
+      {
+        // Fichero ilegible: se abandona lo que quedaba en flash
+        LOG_E(OUTBOX, "Read failed, discarding file backlog");
+        dropped += file.count;
+        file.count = 0;
+        fileDirty = true;
+        return peek(r);
+      }
+      return true;
+    }
+    if (ramCount > 0)
+    {
+      r = ram[ramHead];
+      return true;
+    }
+    return false;
+  }
+
+  void pop()
+  {
+    if (file.count > 0)
+    {
+      file.head = (file.head + 1) % OUTBOX_FILE_RECORDS;
+      file.count--;
+      fileDirty = true;
+    }
+    else if (ramCount > 0)
+    {
+      ramHead = (ramHead + 1) % OUTBOX_RAM_RECORDS;
+      ramCount--;
+    }
+  }
+
+  // Persiste la cabecera tras una tanda de pop(); una sola escritura por tanda
+  void commit()
+  {
+    if (fileDirty && fileOk)
+      writeHeader();
+    fileDirty = false;
+  }
+
+  void clear()
+  {
+    ramHead = ramCount = 0;
+    file.head = file.count = 0;
+    fileDirty = true;
+    commit();
+  }
+
+  static uint32_t slotOffset(uint32_t slot) { return sizeof(outboxFileHeader) + slot * sizeof(outboxRecord); }
+
+  bool writeHeader()
+  {
+    File f = LittleFS.open(OUTBOX_FILE, LittleFS.exists(OUTBOX_FILE) ? "r+" : "w");
+    if (!f)
+      return false;
+    bool ok = f.write((const uint8_t *)&file, sizeof(file)) == sizeof(file);
+    f.close();
+    return ok;
+  }
+
+  // Vuelca el anillo de RAM al final del fichero circular. Las escrituras van
+  // siempre en secuencia, así que el fichero solo crece hasta la capacidad.
+  void spill()
+  {
+    File f = LittleFS.open(OUTBOX_FILE, "r+");
+    if (!f)
+    {
+      LOG_E(OUTBOX, "Cannot open file, RAM only");
+      fileOk = false;
+      return;
+    }
+    while (ramCount > 0)
+    {
+      if (file.count == OUTBOX_FILE_RECORDS)
+      {
+        file.head = (file.head + 1) % OUTBOX_FILE_RECORDS;
+        file.count--;
+        dropped++;
+      }
+      uint32_t slot = (file.head + file.count) % OUTBOX_FILE_RECORDS;
+      if (!f.seek(slotOffset(slot), SeekSet) ||
+          f.write((const uint8_t *)&ram[ramHead], sizeof(outboxRecord)) != sizeof(outboxRecord))
+      {
+        LOG_E(OUTBOX, "Write failed, RAM only");
+        fileOk = false;
+        break;
+      }
+      file.count++;
+      spilled++;
+      ramHead = (ramHead + 1) % OUTBOX_RAM_RECORDS;
+      ramCount--;
+    }
+    f.seek(0, SeekSet);
+    f.write((const uint8_t *)&file, sizeof(file));
+    f.close();
+  }
+};
+
+#endif // TELEMETRYOUTBOX_H
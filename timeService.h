@@ -0,0 +1,282 @@
+#ifndef TIMESERVICE_H
+#define TIMESERVICE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include <WiFiUdp.h>
+
+#include "logger.h"
+
+// ================== Servicio de hora ==================
+//
+// Un único reloj para todo el firmware:
+//   - monótono de 64 bits en ms desde el arranque (extiende millis(), que
+//     da la vuelta a los 49 días);
+//   - hora UTC = ancla (epoch, monótono) del último intercambio NTP más la
+//     deriva del cristal estimada entre sincronizaciones, así que entre una
+//     y otra la hora no se desvía ni salta hacia atrás por un reintento fallido;
+//   - utc() nunca retrocede: si una sincronización encuentra el reloj
+//     adelantado, el error se absorbe poco a poco (a NTP_SLEW_PPB) en lugar de
+//     corregirlo de golpe. Si va atrasado, se salta hacia delante.
+//
+// El intercambio NTP no bloquea: se envía la petición y loop() recoge la
+// respuesta cuando llega (o la da por perdida tras NTP_TIMEOUT_MS). Solo la
+// resolución DNS del servidor es síncrona, y se hace una vez (o tras fallos).
+//
+// Antes de la primera sincronización no hay epoch: quien guarde muestras debe
+// sellarlas con uptimeSeconds() y marcarlas; bootEpoch() (hora local) o
+// bootUtc() permiten corregirlas cuando llega la hora.
+
+#ifndef NTP_SERVER
+#define NTP_SERVER "pool.ntp.org"
+#endif
+#define NTP_PORT 123
+#define NTP_LOCAL_PORT 2390
+#define NTP_PACKET_SIZE 48
+#define NTP_RESYNC_MS 3600000UL         // con hora: cada hora
+#define NTP_RETRY_MS 15000UL            // sin hora o tras un fallo
+#define NTP_TIMEOUT_MS 2000UL
+#define NTP_DRIFT_MIN_INTERVAL_MS 600000UL // la deriva solo se mide sobre intervalos largos
+#define NTP_MAX_DRIFT_PPB 500000L          // ±500 ppm: más es un error, no deriva
+#define NTP_SLEW_PPB 5000000LL             // 5 ms por segundo para absorber un adelanto
+#define NTP_UNIX_OFFSET 2208988800UL       // 1900 -> 1970
+
+struct timeService
+{
+  int32_t utcOffset; // segundos, hora local = UTC + utcOffset
+
+  // Reloj monótono
+  uint64_t monoMs = 0;
+  uint32_t lastMillis = 0;
+
+  // Ancla UTC y deriva (ppb: ms de error por cada 10^9 ms monótonos)
+  bool synced = false;
+  bool firstSyncPending = false;
+  int64_t anchorEpochMs = 0;
+  uint64_t anchorMono = 0;
+  int32_t driftPpb = 0;
+  int64_t slewMs = 0; // adelanto (<= 0) que queda por absorber desde el ancla
+
+  // Intercambio en curso
+  WiFiUDP udp;
+  bool udpStarted = false;
+  IPAddress serverIp;
+  bool serverResolved = false;
+  bool pending = false;
+  uint64_t sentAt = 0;
+  uint64_t lastAttempt = 0;
+  uint32_t cookie = 0; // va en el transmit timestamp y vuelve en el originate
+
+  // Estadísticas (para /time-info)
+  uint32_t syncs = 0;
+  uint32_t failures = 0;
+  uint32_t lastRttMs = 0;
+  int32_t lastCorrectionMs = 0; // epoch medido menos el previsto
+  uint64_t lastSyncMono = 0;
+
+  explicit timeService(int32_t offset = 0) : utcOffset(offset) {}
+
+  // Avanza el reloj monótono; llamar al menos una vez cada 49 días (loop())
+  uint64_t tick(uint32_t ms)
+  {
+    monoMs += (uint32_t)(ms - lastMillis);
+    lastMillis = ms;
+    return monoMs;
+  }
+
+  uint64_t monotonicMs() const { return monoMs; }
+  uint32_t uptimeSeconds() const { return monoMs / 1000; }
+  bool isSynced() const { return synced; }
+
+  // Parte de slewMs ya absorbida 'elapsed' ms después del ancla
+  int64_t slewedMs(int64_t elapsed) const
+  {
+    if (elapsed <= 0 || slewMs == 0)
+      return 0;
+    int64_t max = elapsed * NTP_SLEW_PPB / 1000000000LL;
+    return -slewMs < max ? slewMs : -max;
+  }
+
+  // Adelanto que aún queda por absorber (ms, <= 0)
+  int32_t slewPendingMs() const { return slewMs - slewedMs((int64_t)(monoMs - anchorMono)); }
+
+  // UTC en ms para un instante del reloj monótono (solo con isSynced())
+  int64_t epochMsAt(uint64_t mono) const
+  {
+    int64_t elapsed = (int64_t)(mono - anchorMono);
+    return anchorEpochMs + elapsed + elapsed * driftPpb / 1000000000LL + slewedMs(elapsed);
+  }
+
+  uint32_t utc() const { return synced ? epochMsAt(monoMs) / 1000 : 0; }
+  uint32_t localTime() const { return synced ? utc() + utcOffset : 0; }
+
+  // UTC del arranque: sello de uptime + bootUtc() = UTC
+  uint32_t bootUtc() const { return synced ? epochMsAt(0) / 1000 : 0; }
+  // Hora local del arranque: sello de uptime + bootEpoch() = hora local
+  uint32_t bootEpoch() const { return synced ? bootUtc() + utcOffset : 0; }
+
+  // true una sola vez, tras la primera sincronización del arranque
+  bool takeFirstSync()
+  {
+    bool r = firstSyncPending;
+    firstSyncPending = false;
+    return r;
+  }
+
+  // "HH:MM:SS" en hora local, o "--:--:--" sin hora
+  void formatTime(char *buf, size_t cap) const
+  {
+    if (!synced)
+    {
+      snprintf(buf, cap, "--:--:--");
+      return;
+    }
+    uint32_t t = localTime();
+    snprintf(buf, cap, "%02u:%02u:%02u", (unsigned)(t / 3600 % 24), (unsigned)(t / 60 % 60), (unsigned)(t % 60));
+  }
+
+  // Rellena una petición cliente (modo 3, versión 4)
+  void buildRequest(uint8_t *pkt, uint64_t now)
+  {
+    memset(pkt, 0, NTP_PACKET_SIZE);
+    pkt[0] = 0x23; // LI 0, VN 4, modo 3
+    cookie = (uint32_t)now ^ 0x5A5A1234u;
+    pkt[40] = cookie >> 24;
+    pkt[41] = cookie >> 16;
+    pkt[42] = cookie >> 8;
+    pkt[43] = cookie;
+  }
+
+  // Procesa una respuesta recibida en 'recvMono'. false si no es válida o
+  // no es la respuesta a nuestra petición.
+  bool handleReply(const uint8_t *pkt, size_t len, uint64_t recvMono)
+  {
+    if (len < NTP_PACKET_SIZE || (pkt[0] & 0x07) != 4 || pkt[1] == 0 || pkt[1] > 15)
+      return false;
+    uint32_t originate = (uint32_t)pkt[24] << 24 | (uint32_t)pkt[25] << 16 | (uint32_t)pkt[26] << 8 | pkt[27];
+    if (originate != cookie)
+      return false;
+    uint32_t secs = (uint32_t)pkt[40] << 24 | (uint32_t)pkt[41] << 16 | (uint32_t)pkt[42] << 8 | pkt[43];
+    uint32_t frac = (uint32_t)pkt[44] << 24 | (uint32_t)pkt[45] << 16 | (uint32_t)pkt[46] << 8 | pkt[47];
+    if (secs < NTP_UNIX_OFFSET)
+      return false;
+
+    // Hora del servidor al enviar + media ida y vuelta
+    uint32_t rtt = recvMono - sentAt;
+    int64_t measured = (int64_t)(secs - NTP_UNIX_OFFSET) * 1000 + ((uint64_t)frac * 1000 >> 32) + rtt / 2;
+
+    if (synced)
+    {
+      int64_t predicted = epochMsAt(recvMono);
+      int64_t err = measured - predicted;
+      uint64_t span = recvMono - anchorMono;
+      // Corrige la mitad del error observado para no perseguir el jitter; lo
+      // que quedaba por absorber de la vez anterior no es deriva, y un error
+      // mayor que NTP_MAX_DRIFT_PPB sobre el intervalo es un salto de hora
+      int64_t pending = slewMs - slewedMs((int64_t)span);
+      int64_t observed = span ? (err - pending) * 1000000000LL / (int64_t)span : 0;
+      if (span >= NTP_DRIFT_MIN_INTERVAL_MS && observed <= NTP_MAX_DRIFT_PPB && observed >= -NTP_MAX_DRIFT_PPB)
+      {
+        int64_t ppb = driftPpb + observed / 2;
+        if (ppb > NTP_MAX_DRIFT_PPB)
+          ppb = NTP_MAX_DRIFT_PPB;
+        if (ppb < -NTP_MAX_DRIFT_PPB)
+          ppb = -NTP_MAX_DRIFT_PPB;
+        driftPpb = ppb;
+      }
+      lastCorrectionMs = err;
+      // Adelantado: el ancla sigue la hora prevista y el error se absorbe
+      if (err < 0)
+      {
+        measured = predicted;
+        slewMs = err;
+      }
+      else
+      {
+        slewMs = 0;
+      }
+    }
+    else
+    {
+      firstSyncPending = true;
+    }
+
+    anchorEpochMs = measured;
+    anchorMono = recvMono;
+    synced = true;
+    syncs++;
+    lastRttMs = rtt;
+    lastSyncMono = recvMono;
+    return true;
+  }
+
+  // Llamar en cada vuelta de loop(); 'online' cuando hay WiFi
+  void loop(uint32_t ms, bool online)
+  {
+    uint64_t now = tick(ms);
+    if (!online)
+      return;
+
+    if (!udpStarted)
+    {
+      udp.begin(NTP_LOCAL_PORT);
+      udpStarted = true;
+    }
+
+    if (pending)
+    {
+      int n = udp.parsePacket();
+      if (n > 0)
+      {
+        uint8_t pkt[NTP_PACKET_SIZE];
+        int got = udp.read(pkt, sizeof(pkt));
+        if (handleReply(pkt, got > 0 ? got : 0, now))
+        {
+          pending = false;
+          if (syncs == 1)
+            LOG_I(NTP, "Time synchronized (rtt %lu ms)", (unsigned long)lastRttMs);
+        }
+      }
+      else if (now - sentAt > NTP_TIMEOUT_MS)
+      {
+        pending = false;
+        failures++;
+        serverResolved = false; // el pool puede haber cambiado de servidor
+        LOG_W(NTP, "No reply, will retry");
+      }
+      return;
+    }
+
+    uint64_t interval = synced && lastSyncMono >= lastAttempt ? NTP_RESYNC_MS : NTP_RETRY_MS;
+    if (lastAttempt != 0 && now - lastAttempt < interval)
+      return;
+    lastAttempt = now ? now : 1;
+
+    if (!serverResolved)
+    {
+      serverResolved = WiFi.hostByName(NTP_SERVER, serverIp) == 1;
+      if (!serverResolved)
+      {
+        failures++;
+        return;
+      }
+    }
+
+    uint8_t pkt[NTP_PACKET_SIZE];
+    buildRequest(pkt, now);
+    while (udp.parsePacket() > 0) // descarta respuestas tardías
+      udp.flush();
+    if (udp.beginPacket(serverIp, NTP_PORT) && udp.write(pkt, sizeof(pkt)) == sizeof(pkt) && udp.endPacket())
+    {
+      pending = true;
+      sentAt = tick(millis());
+    }
+    else
+    {
+      failures++;
+    }
+  }
+};
+
+#endif // TIMESERVICE_H
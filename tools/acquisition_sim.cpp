@@ -0,0 +1,205 @@
+// Núcleo de adquisición en el host: parsers, agregación del snapshot e
+// histórico, los mismos ficheros que compila el firmware.
+//
+// Sin argumentos recorre de 1 a 16 módulos sobre transcripciones con el
+// formato de la consola (tools/bmsTranscripts.h) y comprueba cada valor del
+// snapshot contra el modelo que las generó; después prueba el caso de un
+// solo módulo que no responde a 'pwr', y llena el histórico hasta dar la
+// vuelta, lo guarda en LittleFS (ficheros bajo $HOSTFS_ROOT) y lo vuelve a
+// cargar:
+//
+//     cmake -S . -B build && cmake --build build && ./build/acquisition_sim [-v]
+//
+// Con un adaptador USB-serie conectado al puerto de consola del BMS hace
+// una adquisición real y muestra el snapshot:
+//
+//     ./build/acquisition_sim --tty /dev/ttyUSB0 [--record capturas/]
+//
+// --record guarda además la salida de cada comando (y de 'stat') en el
+// directorio, para tools/parser_bench.cpp --captures.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "tools/hostArduino.h"
+#include "batteryStack.h"
+#include "bmsAcquisition.h"
+#include "tools/hostBmsConsole.h"
+
+static batteryStack st;
+static batteryStack reloaded;
+static int failures = 0;
+
+static void expect(bool ok, const char *what, int module, long got, long want)
+{
+  if (ok)
+    return;
+  failures++;
+  printf("MISMATCH %s (module %d): got %ld, want %ld\n", what, module, got, want);
+}
+
+static void expectEq(const char *what, int module, long got, long want) { expect(got == want, what, module, got, want); }
+
+static void checkSnapshot(int modules, int cells, int cycle)
+{
+  expectEq("batteryCount", 0, st.batteryCount, modules);
+  long sumCurrent = 0;
+  for (int m = 0; m < MAX_PYLON_BATTERIES_SUPPORTED; m++)
+  {
+    const pylonBattery &b = st.batts[m];
+    expectEq("isPresent", m + 1, b.isPresent, m < modules);
+    if (m >= modules)
+      continue;
+    bmsModuleModel want = bmsModelAt(m, cells, cycle);
+    expectEq("voltage", m + 1, b.voltage, want.voltage);
+    expectEq("current", m + 1, b.current, want.current);
+    expectEq("tempr", m + 1, b.tempr, want.tempr);
+    expectEq("soc", m + 1, b.soc, want.soc);
+    expectEq("cellCount", m + 1, b.cellCount, cells);
+    expect(strcmp(b.baseState, want.state) == 0, "baseState", m + 1, 0, 0);
+    long high = 0, low = 0;
+    for (int c = 0; c < cells; c++)
+    {
+      expectEq("cellVolt", m + 1, b.cellVolt[c], want.cellMv[c]);
+      high = c == 0 || want.cellMv[c] > high ? want.cellMv[c] : high;
+      low = c == 0 || want.cellMv[c] < low ? want.cellMv[c] : low;
+    }
+    expectEq("cellVoltHigh", m + 1, b.cellVoltHigh, high);
+    expectEq("cellVoltLow", m + 1, b.cellVoltLow, low);
+    sumCurrent += want.current;
+  }
+  expectEq("currentDC", 0, st.currentDC, sumCurrent);
+  expectEq("cellCount", 0, st.cellCount, modules * cells);
+}
+
+static void printSnapshot(const batteryStack &s)
+{
+  printf("%d modules, SOC %d%%, %.3f V, %.3f A, %.1f C, %s, imbalance %ld mV\n", s.batteryCount, s.soc,
+         s.avgVoltage / 1000.0, s.currentDC / 1000.0, s.temp / 1000.0, s.baseState, s.imbalanceMv());
+  for (int m = 0; m < MAX_PYLON_BATTERIES_SUPPORTED; m++)
+  {
+    const pylonBattery &b = s.batts[m];
+    if (b.isPresent)
+      printf("  %2d: %6.3f V %7.3f A SOC %3ld%% %-7s %2u cells %ld-%ld mV\n", m + 1, b.voltage / 1000.0,
+             b.current / 1000.0, b.soc, b.baseState, b.cellCount, b.cellVoltLow, b.cellVoltHigh);
+  }
+}
+
+static int runTty(const char *path, const char *recordDir)
+{
+  ttyConsole tty;
+  if (!tty.open(path))
+  {
+    perror(path);
+    return 1;
+  }
+  st.init();
+  if (recordDir)
+  {
+    recordingConsole rec(tty, recordDir);
+    acquireStack(rec, st);
+    rec.command("stat", 3000);
+    printf("%d captures saved to %s\n", rec.saved, recordDir);
+  }
+  else
+  {
+    acquireStack(tty, st);
+  }
+  printSnapshot(st);
+  return st.batteryCount > 0 ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+  bool verbose = false;
+  const char *tty = nullptr;
+  const char *recordDir = nullptr;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--tty") == 0 && i + 1 < argc)
+      tty = argv[++i];
+    else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+      recordDir = argv[++i];
+    else
+      verbose |= strcmp(argv[i], "-v") == 0;
+  }
+  if (tty)
+    return runTty(tty, recordDir);
+  if (verbose)
+    logBuffer.mirror = [](const char *line)
+    { puts(line); };
+
+  // Every stack size, a few cycles each so the values move
+  const int cells = 15;
+  st.init();
+  for (int modules = 1; modules <= MAX_PYLON_BATTERIES_SUPPORTED; modules++)
+  {
+    transcriptConsole console(modules, cells);
+    for (int cycle = 0; cycle < 4; cycle++)
+    {
+      console.cycle = cycle * 7;
+      acquireStack(console, st);
+      checkSnapshot(modules, cells, console.cycle);
+    }
+    if (verbose)
+      printf("%2d modules: %u commands, %llu bytes parsed\n", modules, (unsigned)console.commands,
+             (unsigned long long)console.bytes);
+  }
+  printf("acquisition: 1-%d modules x 4 cycles checked, generation %u\n", MAX_PYLON_BATTERIES_SUPPORTED,
+         (unsigned)st.generation);
+
+  // A single module that does not know 'pwr': 'bat' alone fills module 1
+  transcriptConsole single(1, 16);
+  single.answersPwr = false;
+  acquireStack(single, st);
+  bmsModuleModel want = bmsModelAt(0, 16, 0);
+  expectEq("single batteryCount", 1, st.batteryCount, 1);
+  expectEq("single voltage", 1, st.batts[0].voltage, want.voltage);
+  expectEq("single current", 1, st.batts[0].current, want.current);
+  expectEq("single soc", 1, st.batts[0].soc, want.soc);
+  expectEq("single cellCount", 1, st.batts[0].cellCount, 16);
+  printf("single module without 'pwr': %d cells, %.3f V\n", st.batts[0].cellCount, st.batts[0].voltage / 1000.0);
+
+  // History: wrap the ring, persist and load it back
+  transcriptConsole console(3, cells);
+  st.init();
+  const int records = MAX_BALANCE_HISTORY_ENTRIES / 3 + 10;
+  for (int i = 0; i < records; i++)
+  {
+    console.cycle = i;
+    acquireStack(console, st);
+    st.recordBalanceHistory(1700000000UL + i * 900, true);
+  }
+  LittleFS.begin();
+  LittleFS.remove("/balance_history.dat");
+  bool saved = st.saveBalanceHistory();
+  reloaded.init();
+  bool loaded = reloaded.loadBalanceHistory();
+  expect(saved && loaded, "history save/load", 0, saved, loaded);
+  expectEq("history entryCount", 0, reloaded.history.entryCount, MAX_BALANCE_HISTORY_ENTRIES);
+  expectEq("history currentIndex", 0, reloaded.history.currentIndex, st.history.currentIndex);
+  unsigned long lastTs = 0;
+  for (uint16_t i = 0; i < st.history.entryCount; i++)
+  {
+    const balanceHistoryEntry *a = st.history.getEntry(i);
+    const balanceHistoryEntry *b = reloaded.history.getEntry(i);
+    if (!a || !b || memcmp(a, b, sizeof(*a)) != 0)
+    {
+      expect(false, "history entry", i, 0, 0);
+      break;
+    }
+    expect(a->timestamp >= lastTs, "history order", i, a->timestamp, lastTs);
+    lastTs = a->timestamp;
+  }
+  printf("history: %d records into %d slots, saved and reloaded from %s\n", records * 3,
+         MAX_BALANCE_HISTORY_ENTRIES, LittleFS.root().c_str());
+
+  if (failures)
+  {
+    printf("FAIL (%d)\n", failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+"""Compara dos ejecuciones de parser_bench (JSON lines) y marca regresiones.
+
+Empareja las medidas por (bench, modules, source). Es regresión que ns_per_op
+suba más que --threshold por ciento o que aparezcan reservas de memoria
+(allocs_per_op) donde antes no había o haya más. Sale con 1 si hay alguna,
+para cortar la cadena antes de flashear. Sin dependencias.
+
+    ./build/parser_bench > base.jsonl        # en la versión de referencia
+    ./build/parser_bench > new.jsonl         # con los cambios
+    python3 tools/bench_compare.py base.jsonl new.jsonl [--threshold 15]
+
+Los tiempos del host tienen ruido: conviene --min-ms alto en parser_bench y
+el mismo equipo para las dos ejecuciones.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    runs = {}
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith("{"):
+                continue
+            r = json.loads(line)
+            runs[(r["bench"], r["modules"], r["source"])] = r
+    return runs
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("base")
+    ap.add_argument("new")
+    ap.add_argument("--threshold", type=float, default=15.0, help="subida de ns_per_op tolerada, en %%")
+    ap.add_argument("-v", action="store_true", help="muestra también las medidas sin regresión")
+    args = ap.parse_args()
+
+    base, new = load(args.base), load(args.new)
+    regressions = 0
+    for key in sorted(base.keys() & new.keys()):
+        b, n = base[key], new[key]
+        change = (n["ns_per_op"] / b["ns_per_op"] - 1) * 100 if b["ns_per_op"] else 0.0
+        slower = change > args.threshold
+        allocs = n["allocs_per_op"] > b["allocs_per_op"]
+        if slower or allocs:
+            regressions += 1
+        if slower or allocs or args.v:
+            flag = "REGRESSION" if slower or allocs else "ok"
+            print("%-10s %-26s %2d modules: %10.1f -> %10.1f ns/op (%+6.1f%%), allocs %.2f -> %.2f"
+                  % (flag, key[0], key[1], b["ns_per_op"], n["ns_per_op"], change,
+                     b["allocs_per_op"], n["allocs_per_op"]))
+
+    missing = sorted(base.keys() - new.keys())
+    for key in missing:
+        print("MISSING    %-26s %2d modules" % (key[0], key[1]))
+    print("%d compared, %d regressions, %d missing" % (len(base.keys() & new.keys()), regressions, len(missing)))
+    return 1 if regressions or missing else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
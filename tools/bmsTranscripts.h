@@ -0,0 +1,197 @@
+// Salidas de la consola del BMS (pwr, bat N, pwrsys, stat) con el formato de un
+// US2000/US3000: eco del comando, '@', cabecera de columnas a ancho fijo,
+// CRLF y el prompt final. Los valores derivan poco a poco con 'cycle' (las
+// mismas celdas que syntheticStack.h); el formato es el de la consola real,
+// los números no son capturas.
+
+#ifndef BMSTRANSCRIPTS_H
+#define BMSTRANSCRIPTS_H
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#define BMS_TRANSCRIPT_PROMPT "pylon>"
+#define BMS_TRANSCRIPT_PWR_ROWS 8 // 'pwr' lista al menos 8 direcciones, presentes o no
+
+struct bmsModuleModel
+{
+  int cells;
+  long cellMv[16];
+  long cellMc[16];
+  long voltage; // mV, suma de celdas
+  long current; // mA
+  long tempr;   // mC, media de celdas
+  int soc;
+  const char *state;
+};
+
+inline bmsModuleModel bmsModelAt(int m, int cells, int cycle)
+{
+  bmsModuleModel b;
+  b.cells = cells;
+  b.voltage = 0;
+  long sumMc = 0;
+  for (int c = 0; c < cells; c++)
+  {
+    b.cellMv[c] = 3320 + (c * 7 + m * 3 + cycle) % 23;
+    b.cellMc[c] = 24100 + m * 300 + (c % 5 - 2) * 100;
+    b.voltage += b.cellMv[c];
+    sumMc += b.cellMc[c];
+  }
+  b.tempr = sumMc / cells;
+  b.current = -3041 + m * 97 - cycle * 5;
+  b.soc = 87 - m - cycle / 3;
+  if (b.soc < 5)
+    b.soc = 5;
+  b.state = b.current < -100 ? "Dischg" : b.current > 100 ? "Charge" : "Idle";
+  return b;
+}
+
+inline void _bmsAppendf(std::string &out, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+inline void _bmsAppendf(std::string &out, const char *fmt, ...)
+{
+  char line[256];
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(line, sizeof(line), fmt, ap);
+  va_end(ap);
+  out.append(line, n < 0 ? 0 : (size_t)n < sizeof(line) ? n : sizeof(line) - 1);
+}
+
+inline void _bmsTranscriptHead(std::string &out, const char *cmd)
+{
+  _bmsAppendf(out, "%s\r\n@\r\n\r\n", cmd);
+}
+
+inline void _bmsTranscriptTail(std::string &out)
+{
+  out += "Command completed successfully\r\n$$\r\n\r\n" BMS_TRANSCRIPT_PROMPT;
+}
+
+inline std::string bmsTranscriptPwr(int modules, int cells, int cycle)
+{
+  std::string out;
+  _bmsTranscriptHead(out, "pwr");
+  out += "Power Volt   Curr   Tempr  Tlow   Thigh  Vlow   Vhigh  Base.St  Volt.St  Curr.St  Temp.St  Coulomb  "
+         "Time                 B.V.St   B.T.St  \r\n";
+  int rows = modules > BMS_TRANSCRIPT_PWR_ROWS ? modules : BMS_TRANSCRIPT_PWR_ROWS;
+  for (int m = 0; m < rows; m++)
+  {
+    if (m >= modules)
+    {
+      _bmsAppendf(out, "%-6d%-7s%-7s%-7s%-7s%-7s%-7s%-7s%-9s%-9s%-9s%-9s%-9s%-21s%-9s%-9s\r\n", m + 1, "-", "-",
+                  "-", "-", "-", "-", "-", "Absent", "-", "-", "-", "-", "-", "-", "-");
+      continue;
+    }
+    bmsModuleModel b = bmsModelAt(m, cells, cycle);
+    long vLow = b.cellMv[0], vHigh = b.cellMv[0], tLow = b.cellMc[0], tHigh = b.cellMc[0];
+    for (int c = 1; c < cells; c++)
+    {
+      vLow = b.cellMv[c] < vLow ? b.cellMv[c] : vLow;
+      vHigh = b.cellMv[c] > vHigh ? b.cellMv[c] : vHigh;
+      tLow = b.cellMc[c] < tLow ? b.cellMc[c] : tLow;
+      tHigh = b.cellMc[c] > tHigh ? b.cellMc[c] : tHigh;
+    }
+    char soc[12];
+    snprintf(soc, sizeof(soc), "%d%%", b.soc);
+    _bmsAppendf(out, "%-6d%-7ld%-7ld%-7ld%-7ld%-7ld%-7ld%-7ld%-9s%-9s%-9s%-9s%-9s", m + 1, b.voltage, b.current,
+                b.tempr, tLow, tHigh, vLow, vHigh, b.state, "Normal", "Normal", "Normal", soc);
+    _bmsAppendf(out, "2024-01-14 10:%02d:%02d  %-9s%-9s\r\n", cycle / 60 % 60, cycle % 60, "Normal", "Normal");
+  }
+  _bmsTranscriptTail(out);
+  return out;
+}
+
+// 'bat N' (module 1-based); 'bat' a secas responde como el módulo 1
+inline std::string bmsTranscriptBat(int module, int cells, int cycle, const char *cmd)
+{
+  std::string out;
+  _bmsTranscriptHead(out, cmd);
+  out += "Battery  Volt     Curr     Tempr    Base State   Volt. State  Curr. State  Temp. State  SOC          "
+         "Coulomb      BAL      \r\n";
+  bmsModuleModel b = bmsModelAt(module - 1, cells, cycle);
+  for (int c = 0; c < cells; c++)
+  {
+    char soc[12], coulomb[24];
+    snprintf(soc, sizeof(soc), "%d%%", b.soc);
+    snprintf(coulomb, sizeof(coulomb), "%d mAH", b.soc * 740);
+    _bmsAppendf(out, "%-9d%-9ld%-9ld%-9ld%-13s%-13s%-13s%-13s%-13s%-13s%-9s\r\n", c, b.cellMv[c], b.current,
+                b.cellMc[c], b.state, "Normal", "Normal", "Normal", soc, coulomb, "N");
+  }
+  _bmsTranscriptTail(out);
+  return out;
+}
+
+// Corriente total de la pila: la suma de los módulos
+inline long bmsTranscriptSystemCurrent(int modules, int cells, int cycle)
+{
+  long sum = 0;
+  for (int m = 0; m < modules; m++)
+    sum += bmsModelAt(m, cells, cycle).current;
+  return sum;
+}
+
+inline std::string bmsTranscriptPwrsys(int modules, int cells, int cycle)
+{
+  std::string out;
+  _bmsTranscriptHead(out, "pwrsys");
+  long current = bmsTranscriptSystemCurrent(modules, cells, cycle);
+  long volt = 0, soc = 0;
+  for (int m = 0; m < modules; m++)
+  {
+    bmsModuleModel b = bmsModelAt(m, cells, cycle);
+    volt += b.voltage;
+    soc += b.soc;
+  }
+  volt /= modules;
+  soc /= modules;
+  _bmsAppendf(out, "System is %s\r\n", current < -100 ? "discharging" : current > 100 ? "charging" : "idle");
+  _bmsAppendf(out, " Total Num                : %-8d\r\n", modules);
+  _bmsAppendf(out, " Present Num              : %-8d\r\n", modules);
+  _bmsAppendf(out, " Sleep Num                : %-8d\r\n", 0);
+  _bmsAppendf(out, " System Volt              : %-8ld mV\r\n", volt);
+  _bmsAppendf(out, " System Curr              : %-8ld mA\r\n", current);
+  _bmsAppendf(out, " System RC                : %-8ld mAH\r\n", soc * 740 * modules);
+  _bmsAppendf(out, " System FCC               : %-8ld mAH\r\n", 74000L * modules);
+  _bmsAppendf(out, " System SOC               : %-8ld %%\r\n", soc);
+  _bmsAppendf(out, " System SOH               : %-8d %%\r\n", 100);
+  _bmsAppendf(out, " Recommend chg voltage    : %-8d mV\r\n", 53250);
+  _bmsAppendf(out, " Recommend dsg voltage    : %-8d mV\r\n", 47000);
+  _bmsAppendf(out, " Recommend chg current    : %-8ld mA\r\n", 37000L * modules);
+  _bmsAppendf(out, " Recommend dsg current    : %-8ld mA\r\n", -37000L * modules);
+  _bmsTranscriptTail(out);
+  return out;
+}
+
+// 'stat': contadores de vida del módulo 1, "clave : valor" (el firmware no
+// lo interpreta; sirve para medir el troceado de líneas)
+inline std::string bmsTranscriptStat(int cycle)
+{
+  static const char *const keys[] = {
+      "Device address", "Data Items", "Pwr Percent", "Charge Cnt.", "Charge Times", "Discharge Cnt.",
+      "Discharge Times", "Cycle Times", "Bat Volt Low Cnt", "Bat Volt High Cnt", "Bat Temp Low Cnt",
+      "Bat Temp High Cnt", "Chg Curr High Cnt", "Dsg Curr High Cnt", "Short Circuit Cnt", "Pwr Volt Low Cnt",
+      "Pwr Volt High Cnt", "Shut Down Cnt", "Reset Cnt", "Charge Sum (AH)", "Discharge Sum (AH)", "Status"};
+  std::string out;
+  _bmsTranscriptHead(out, "stat");
+  const int n = sizeof(keys) / sizeof(keys[0]);
+  for (int i = 0; i < n - 1; i++)
+    _bmsAppendf(out, "%-20s: %d\r\n", keys[i], i == 0 ? 1 : i == 1 ? n - 3 : (i * 37 + cycle) % 1000);
+  _bmsAppendf(out, "%-20s: %s\r\n", keys[n - 1], "Normal");
+  _bmsTranscriptTail(out);
+  return out;
+}
+
+inline std::string bmsTranscriptUnknown(const char *cmd)
+{
+  std::string out;
+  _bmsTranscriptHead(out, cmd);
+  out += "Unknown command '";
+  out += cmd;
+  out += "'\r\n$$\r\n\r\n" BMS_TRANSCRIPT_PROMPT;
+  return out;
+}
+
+#endif // BMSTRANSCRIPTS_H
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""Decodifica las respuestas CBOR del monitor y las imprime como JSON.
+
+Sin dependencias: solo cubre los tipos que emite telemetryCodec.h
+(enteros, texto, arrays y mapas de longitud definida). Los valores llegan
+en milésimas (mV, mA, mW, m°C); --units los convierte a V, A, W y °C.
+
+    python3 tools/cbor_decode.py http://192.168.1.50/snapshot
+    python3 tools/cbor_decode.py http://192.168.1.50/balance-history --units
+    curl -s -H 'Accept: application/cbor' http://.../snapshot | python3 tools/cbor_decode.py
+"""
+
+import argparse
+import json
+import sys
+import urllib.request
+
+MILLI_KEYS = ("voltage", "current", "power", "temperature")
+
+
+def decode(data, pos=0):
+    """Devuelve (valor, posición siguiente)."""
+    ib = data[pos]
+    major, info = ib >> 5, ib & 0x1F
+    pos += 1
+    if info < 24:
+        arg = info
+    elif info in (24, 25, 26, 27):
+        n = 1 << (info - 24)
+        arg = int.from_bytes(data[pos:pos + n], "big")
+        pos += n
+    else:
+        raise ValueError("longitud indefinida o tipo no soportado en offset %d" % (pos - 1))
+
+    if major == 0:
+        return arg, pos
+    if major == 1:
+        return -1 - arg, pos
+    if major in (2, 3):
+        raw = bytes(data[pos:pos + arg])
+        return (raw if major == 2 else raw.decode("utf-8")), pos + arg
+    if major == 4:
+        items = []
+        for _ in range(arg):
+            item, pos = decode(data, pos)
+            items.append(item)
+        return items, pos
+    if major == 5:
+        obj = {}
+        for _ in range(arg):
+            key, pos = decode(data, pos)
+            obj[key], pos = decode(data, pos)
+        return obj, pos
+    if major == 7 and info in (20, 21, 22):
+        return {20: False, 21: True, 22: None}[info], pos
+    raise ValueError("tipo mayor %d no soportado" % major)
+
+
+def to_units(value):
+    if isinstance(value, dict):
+        return {k: (v / 1000.0 if k in MILLI_KEYS and isinstance(v, int) else to_units(v))
+                for k, v in value.items()}
+    if isinstance(value, list):
+        return [to_units(v) for v in value]
+    return value
+
+
+def read_source(src):
+    if src in (None, "-"):
+        return sys.stdin.buffer.read()
+    if src.startswith(("http://", "https://")):
+        req = urllib.request.Request(src, headers={"Accept": "application/cbor"})
+        with urllib.request.urlopen(req, timeout=10) as resp:
+            return resp.read()
+    with open(src, "rb") as f:
+        return f.read()
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("source", nargs="?", help="URL, fichero o '-' para stdin")
+    ap.add_argument("--units", action="store_true", help="convertir milésimas a V/A/W/°C")
+    args = ap.parse_args()
+
+    data = read_source(args.source)
+    value, end = decode(data)
+    if end != len(data):
+        print("aviso: %d bytes sobrantes tras el objeto" % (len(data) - end), file=sys.stderr)
+    if args.units:
+        value = to_units(value)
+    json.dump(value, sys.stdout, indent=2, ensure_ascii=False)
+    print()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
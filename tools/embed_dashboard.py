@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""Genera dashboardPage.h a partir de web/index.html.
+
+La página se minimiza (sin sangrías ni saltos entre etiquetas), se comprime
+con gzip de forma determinista y se emite como array PROGMEM junto con un
+ETag derivado del contenido. Ejecutar tras cualquier cambio en web/:
+
+    python3 tools/embed_dashboard.py
+"""
+
+import gzip
+import hashlib
+import os
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SRC = os.path.join(ROOT, "web", "index.html")
+DST = os.path.join(ROOT, "dashboardPage.h")
+
+
+def minify(html):
+    out = []
+    in_script = False
+    for raw in html.split("\n"):
+        line = raw.strip()
+        if not line:
+            continue
+        if in_script:
+            # JS: un salto de línea entre sentencias es siempre seguro
+            out.append("\n" + line)
+        else:
+            out.append(line)
+        if line.startswith("<script"):
+            in_script = True
+        if "</script>" in line:
+            in_script = False
+    return "".join(out).replace("\n</script>", "</script>")
+
+
+def main():
+    with open(SRC, encoding="utf-8") as f:
+        page = minify(f.read()).encode("utf-8")
+
+    gz = gzip.compress(page, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(gz).hexdigest()[:16]
+
+    rows = []
+    for i in range(0, len(gz), 16):
+        rows.append("  " + ", ".join("0x%02x" % b for b in gz[i:i + 16]) + ",")
+
+    with open(DST, "w", encoding="utf-8", newline="\n") as f:
+        f.write("// Generado por tools/embed_dashboard.py a partir de web/index.html - NO EDITAR\n")
+        f.write("#ifndef DASHBOARDPAGE_H\n#define DASHBOARDPAGE_H\n\n")
+        f.write("// %d bytes sin comprimir, %d bytes gzip\n" % (len(page), len(gz)))
+        f.write("#define DASHBOARD_ETAG \"\\\"%s\\\"\"\n" % etag)
+        f.write("#define DASHBOARD_HTML_GZ_LEN %d\n\n" % len(gz))
+        f.write("static const uint8_t DASHBOARD_HTML_GZ[] PROGMEM = {\n")
+        f.write("\n".join(rows))
+        f.write("\n};\n\n#endif // DASHBOARDPAGE_H\n")
+
+    print("dashboardPage.h: %d -> %d bytes, ETag %s" % (len(page), len(gz), etag))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,143 @@
+// Lo mínimo de Arduino que batteryStack.h, los parsers y la adquisición del
+// BMS y los módulos de telemetría necesitan para compilar en el host
+// (herramientas de tools/ y CMakeLists.txt, no el firmware): reloj, LittleFS
+// sobre ficheros POSIX y un Serial que no es el BMS (la consola va por
+// bmsConsole, tools/hostBmsConsole.h). Serial escribe en stdout solo si
+// hostSerialEcho está activo.
+
+#ifndef HOSTARDUINO_H
+#define HOSTARDUINO_H
+
+#define PYLONTECH_HOST 1
+
+#include <chrono>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+inline bool hostSerialEcho = false;
+
+// Reloj desde la primera llamada, como tras el arranque
+inline unsigned long micros()
+{
+  using namespace std::chrono;
+  static const auto t0 = steady_clock::now();
+  return duration_cast<microseconds>(steady_clock::now() - t0).count();
+}
+inline unsigned long millis() { return micros() / 1000; }
+
+// Sin flash separada: las tablas PROGMEM se leen como memoria normal
+#define PROGMEM
+#define memcpy_P memcpy
+
+struct _hostSerial
+{
+  void print(const char *s)
+  {
+    if (hostSerialEcho)
+      std::fputs(s, stdout);
+  }
+  void print(long v)
+  {
+    if (hostSerialEcho)
+      std::printf("%ld", v);
+  }
+  void println(const char *s = "")
+  {
+    print(s);
+    print("\n");
+  }
+  void println(long v)
+  {
+    print(v);
+    print("\n");
+  }
+  void printf(const char *fmt, ...)
+  {
+    if (!hostSerialEcho)
+      return;
+    va_list ap;
+    va_start(ap, fmt);
+    std::vprintf(fmt, ap);
+    va_end(ap);
+  }
+};
+inline _hostSerial Serial;
+
+// PylontechMonitoring.h declara las IPs estáticas
+struct IPAddress
+{
+  uint8_t octets[4];
+  IPAddress() : octets{0, 0, 0, 0} {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets{a, b, c, d} {}
+};
+
+// LittleFS sobre ficheros normales bajo $HOSTFS_ROOT (por defecto /tmp/pylontech-hostfs)
+enum SeekMode
+{
+  SeekSet,
+  SeekCur,
+  SeekEnd
+};
+
+struct File
+{
+  FILE *fp = nullptr;
+
+  explicit operator bool() const { return fp != nullptr; }
+  size_t write(const uint8_t *buf, size_t n) { return fp ? std::fwrite(buf, 1, n, fp) : 0; }
+  size_t read(uint8_t *buf, size_t n) { return fp ? std::fread(buf, 1, n, fp) : 0; }
+  bool seek(uint32_t pos, SeekMode mode = SeekSet)
+  {
+    static const int whence[] = {SEEK_SET, SEEK_CUR, SEEK_END};
+    return fp && std::fseek(fp, pos, whence[mode]) == 0;
+  }
+  size_t size() const
+  {
+    if (!fp)
+      return 0;
+    long cur = std::ftell(fp);
+    std::fseek(fp, 0, SEEK_END);
+    long end = std::ftell(fp);
+    std::fseek(fp, cur, SEEK_SET);
+    return end;
+  }
+  void close()
+  {
+    if (fp)
+      std::fclose(fp);
+    fp = nullptr;
+  }
+};
+
+struct _hostFs
+{
+  std::string root()
+  {
+    const char *env = std::getenv("HOSTFS_ROOT");
+    return env ? env : "/tmp/pylontech-hostfs";
+  }
+  bool begin()
+  {
+    mkdir(root().c_str(), 0755);
+    return true;
+  }
+  bool exists(const char *path) { return access((root() + path).c_str(), F_OK) == 0; }
+  bool remove(const char *path) { return std::remove((root() + path).c_str()) == 0; }
+  File open(const char *path, const char *mode)
+  {
+    File f;
+    f.fp = std::fopen((root() + path).c_str(), mode);
+    return f;
+  }
+};
+inline _hostFs LittleFS;
+
+#endif // HOSTARDUINO_H
@@ -0,0 +1,154 @@
+// Consolas del BMS para el host, detrás de la misma bmsConsole que usa el
+// firmware (bmsAcquisition.h):
+//   - transcriptConsole: responde con bmsTranscripts.h, sin hardware;
+//   - ttyConsole: un BMS real a través de un adaptador USB-serie (termios),
+//     con la misma secuencia que bmsConsoleSession: "\r", espera del prompt,
+//     comando y lectura hasta el prompt o el timeout;
+//   - recordingConsole: pasa los comandos a otra consola y guarda cada
+//     salida en <dir>/<comando>.txt ("bat 3" -> bat3.txt), las capturas que
+//     lee tools/parser_bench.cpp.
+
+#ifndef HOSTBMSCONSOLE_H
+#define HOSTBMSCONSOLE_H
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "bmsAcquisition.h"
+#include "tools/bmsTranscripts.h"
+
+struct transcriptConsole : bmsConsole
+{
+  int modules;
+  int cells;
+  int cycle = 0;
+  bool answersPwr = true; // false: un solo módulo que no conoce 'pwr'
+  uint32_t commands = 0;
+  uint64_t bytes = 0;
+  std::string last;
+
+  transcriptConsole(int m, int c) : modules(m), cells(c) {}
+
+  const char *command(const char *cmd, uint32_t) override
+  {
+    if (strcmp(cmd, "pwr") == 0 && answersPwr)
+      last = bmsTranscriptPwr(modules, cells, cycle);
+    else if (strcmp(cmd, "pwrsys") == 0)
+      last = bmsTranscriptPwrsys(modules, cells, cycle);
+    else if (strcmp(cmd, "stat") == 0)
+      last = bmsTranscriptStat(cycle);
+    else if (strcmp(cmd, "bat") == 0)
+      last = bmsTranscriptBat(1, cells, cycle, cmd);
+    else if (strncmp(cmd, "bat ", 4) == 0 && atoi(cmd + 4) >= 1 && atoi(cmd + 4) <= modules)
+      last = bmsTranscriptBat(atoi(cmd + 4), cells, cycle, cmd);
+    else
+      last = bmsTranscriptUnknown(cmd);
+    commands++;
+    bytes += last.size();
+    return last.c_str();
+  }
+};
+
+struct ttyConsole : bmsConsole
+{
+  int fd = -1;
+  std::string last;
+
+  bool open(const char *path)
+  {
+    fd = ::open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0)
+      return false;
+    termios t;
+    if (tcgetattr(fd, &t) != 0)
+      return false;
+    cfmakeraw(&t);
+    cfsetispeed(&t, B115200);
+    cfsetospeed(&t, B115200);
+    t.c_cflag |= CLOCAL | CREAD;
+    return tcsetattr(fd, TCSANOW, &t) == 0;
+  }
+
+  ~ttyConsole()
+  {
+    if (fd >= 0)
+      ::close(fd);
+  }
+
+  static bool isPrompt(const std::string &s)
+  {
+    return s.size() >= 6 && (s.compare(s.size() - 6, 6, "pylon>") == 0 ||
+                             (s.size() >= 12 && s.compare(s.size() - 12, 12, "pylon_debug>") == 0));
+  }
+
+  // Lee hasta el prompt o el timeout; true si llegó el prompt
+  bool readUntilPrompt(std::string &out, uint32_t timeoutMs)
+  {
+    unsigned long t0 = millis();
+    char buf[256];
+    while (millis() - t0 < timeoutMs)
+    {
+      pollfd p = {fd, POLLIN, 0};
+      if (poll(&p, 1, 10) <= 0)
+        continue;
+      ssize_t n = ::read(fd, buf, sizeof(buf));
+      for (ssize_t i = 0; i < n; i++)
+      {
+        out += buf[i];
+        if (isPrompt(out))
+          return true;
+      }
+    }
+    return false;
+  }
+
+  void discardInput() { tcflush(fd, TCIFLUSH); }
+
+  const char *command(const char *cmd, uint32_t timeoutMs) override
+  {
+    std::string wake;
+    discardInput();
+    (void)!::write(fd, "\r", 1);
+    readUntilPrompt(wake, 700);
+    discardInput();
+    std::string line = std::string(cmd) + "\r";
+    (void)!::write(fd, line.data(), line.size());
+    last.clear();
+    readUntilPrompt(last, timeoutMs);
+    return last.c_str();
+  }
+};
+
+struct recordingConsole : bmsConsole
+{
+  bmsConsole &inner;
+  std::string dir;
+  int saved = 0;
+
+  recordingConsole(bmsConsole &c, const char *d) : inner(c), dir(d) {}
+
+  const char *command(const char *cmd, uint32_t timeoutMs) override
+  {
+    const char *out = inner.command(cmd, timeoutMs);
+    std::string name;
+    for (const char *p = cmd; *p; p++)
+      if (*p != ' ')
+        name += *p;
+    FILE *f = fopen((dir + "/" + name + ".txt").c_str(), "wb");
+    if (f)
+    {
+      fwrite(out, 1, strlen(out), f);
+      fclose(f);
+      saved++;
+    }
+    return out;
+  }
+};
+
+#endif // HOSTBMSCONSOLE_H
@@ -0,0 +1,189 @@
+// <Arduino.h> para compilar la capa web (webInterface.h, bmsUart.h) en el
+// host: solo lo usa tools/web_load.cpp, con tools/hostinclude en la ruta de
+// include. Sobre tools/hostArduino.h añade:
+//   - String: el subconjunto del de Arduino que usan los handlers;
+//   - delay()/yield(), F(), PGM_P, esp_random() y ESP.restart();
+//   - HardwareSerial/Serial2: la línea del BMS simulada. Lo que el firmware
+//     escribe hasta '\r' es un comando; la respuesta la da 'responder' y va
+//     llegando al ritmo del baudrate (10 bits por byte) a un anillo de
+//     setRxBufferSize() bytes que, si no se lee a tiempo, se desborda como
+//     el de la ISR (hasOverrun()).
+
+#ifndef HOST_ARDUINO_CORE_H
+#define HOST_ARDUINO_CORE_H
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include "tools/hostArduino.h"
+
+#define F(s) (s)
+typedef const char *PGM_P;
+
+inline void delay(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline void yield() {}
+
+inline uint32_t esp_random() { return (uint32_t)std::rand() * 2654435761u ^ (uint32_t)micros(); }
+
+struct _hostEsp
+{
+  void restart() { std::fprintf(stderr, "ESP.restart() ignored on the host\n"); }
+};
+inline _hostEsp ESP;
+
+// ---------- String ----------
+class String
+{
+public:
+  String(const char *s = "") : s_(s ? s : "") {}
+  String(const std::string &s) : s_(s) {}
+  explicit String(char c) : s_(1, c) {}
+  String(int v) : s_(std::to_string(v)) {}
+  String(unsigned v) : s_(std::to_string(v)) {}
+  String(long v) : s_(std::to_string(v)) {}
+  String(unsigned long v) : s_(std::to_string(v)) {}
+  String(double v, unsigned decimals = 2)
+  {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+    s_ = buf;
+  }
+
+  const char *c_str() const { return s_.c_str(); }
+  unsigned length() const { return s_.size(); }
+  bool reserve(unsigned n)
+  {
+    s_.reserve(n);
+    return true;
+  }
+  void clear() { s_.clear(); }
+
+  String &operator+=(const String &o)
+  {
+    s_ += o.s_;
+    return *this;
+  }
+  String &operator+=(const char *o)
+  {
+    s_ += o;
+    return *this;
+  }
+  String &operator+=(char c)
+  {
+    s_ += c;
+    return *this;
+  }
+
+  bool operator==(const String &o) const { return s_ == o.s_; }
+  bool operator==(const char *o) const { return s_ == o; }
+  bool operator!=(const String &o) const { return s_ != o.s_; }
+
+  bool startsWith(const char *p) const { return s_.compare(0, std::strlen(p), p) == 0; }
+  bool endsWith(const char *p) const
+  {
+    size_t n = std::strlen(p);
+    return s_.size() >= n && s_.compare(s_.size() - n, n, p) == 0;
+  }
+  int indexOf(const char *p) const
+  {
+    size_t at = s_.find(p);
+    return at == std::string::npos ? -1 : (int)at;
+  }
+  String substring(unsigned from, unsigned to = ~0u) const
+  {
+    return from >= s_.size() ? String() : String(s_.substr(from, to - from));
+  }
+  long toInt() const { return std::atol(s_.c_str()); }
+
+  friend String operator+(const String &a, const String &b) { return String(a.s_ + b.s_); }
+  friend String operator+(const String &a, const char *b) { return String(a.s_ + b); }
+  friend String operator+(const char *a, const String &b) { return String(a + b.s_); }
+
+private:
+  std::string s_;
+};
+
+// ---------- Línea del BMS ----------
+class HardwareSerial
+{
+public:
+  typedef std::function<std::string(const char *command)> Responder;
+  Responder responder; // "" es el "\r" suelto con que se despierta la consola
+
+  size_t setRxBufferSize(size_t n)
+  {
+    rxSize = n;
+    return n;
+  }
+  void begin(unsigned long b) { baud = b; }
+
+  bool hasOverrun()
+  {
+    bool o = overrun;
+    overrun = false;
+    return o;
+  }
+  bool hasRxError() { return false; }
+
+  int available()
+  {
+    size_t due = (size_t)((uint64_t)(micros() - replyAt) * (baud / 10) / 1000000);
+    if (due > reply.size())
+      due = reply.size();
+    for (; delivered < due; delivered++)
+    {
+      if (rx.size() < rxSize)
+        rx.push_back(reply[delivered]);
+      else
+        overrun = true; // anillo lleno: el byte se pierde
+    }
+    return (int)rx.size();
+  }
+
+  int read()
+  {
+    if (!available())
+      return -1;
+    int c = (uint8_t)rx.front();
+    rx.pop_front();
+    return c;
+  }
+
+  size_t print(const char *s)
+  {
+    for (const char *p = s; *p; p++)
+    {
+      if (*p == '\r')
+        command();
+      else if (*p != '\n')
+        line += *p;
+    }
+    return std::strlen(s);
+  }
+  size_t print(const String &s) { return print(s.c_str()); }
+
+private:
+  unsigned long baud = 115200;
+  size_t rxSize = 256;
+  std::deque<char> rx;
+  std::string line;
+  std::string reply;
+  size_t delivered = 0;
+  unsigned long replyAt = 0;
+  bool overrun = false;
+
+  // El BMS empieza a contestar en cuanto recibe el '\r'
+  void command()
+  {
+    available(); // lo que quedara de la respuesta anterior ya está en el anillo
+    reply = responder ? responder(line.c_str()) : std::string();
+    delivered = 0;
+    replyAt = micros();
+    line.clear();
+  }
+};
+inline HardwareSerial Serial2;
+
+#endif // HOST_ARDUINO_CORE_H
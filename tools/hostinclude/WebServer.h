@@ -0,0 +1,340 @@
+// <WebServer.h> para el host (tools/web_load.cpp): el subconjunto de
+// ESP8266WebServer que usa webInterface.h, sobre sockets POSIX y con el
+// mismo modelo de ejecución que en el ESP:
+//   - un solo hilo: handleClient(), llamado desde el loop, atiende como mucho
+//     un cliente pendiente y no vuelve hasta haber respondido;
+//   - leer la petición bloquea hasta HTTP_MAX_DATA_WAIT;
+//   - una petición por conexión (Connection: close);
+//   - cola de conexiones pendientes pequeña (backlog), como la del ESP.
+// CONTENT_LENGTH_UNKNOWN responde con Transfer-Encoding: chunked, igual que
+// el core con HTTP/1.1.
+
+#ifndef HOST_WEBSERVER_H
+#define HOST_WEBSERVER_H
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Arduino.h"
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+#define CONTENT_LENGTH_NOT_SET ((size_t)-2)
+#ifndef HTTP_MAX_DATA_WAIT
+#define HTTP_MAX_DATA_WAIT 5000
+#endif
+#ifndef HOST_WEBSERVER_BACKLOG
+#define HOST_WEBSERVER_BACKLOG 5
+#endif
+
+struct WiFiClient; // el hook lo recibe; en el host siempre es nullptr
+
+class WebServer
+{
+public:
+  typedef std::function<void(void)> THandlerFunction;
+  typedef std::function<String(const String &)> ContentTypeFunction;
+  enum ClientFuture
+  {
+    CLIENT_REQUEST_CAN_CONTINUE,
+    CLIENT_REQUEST_IS_HANDLED,
+    CLIENT_MUST_STOP,
+    CLIENT_IS_GIVEN
+  };
+  typedef std::function<ClientFuture(const String &method, const String &url, WiFiClient *client,
+                                     ContentTypeFunction contentType)>
+      HookFunction;
+
+  int backlog = HOST_WEBSERVER_BACKLOG;
+
+  explicit WebServer(int port = 80) : port_(port) {}
+  ~WebServer()
+  {
+    if (listenFd_ >= 0)
+      ::close(listenFd_);
+  }
+
+  bool begin()
+  {
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port_);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(listenFd_, (sockaddr *)&addr, sizeof(addr)) < 0 || listen(listenFd_, backlog) < 0)
+    {
+      std::perror("WebServer bind/listen");
+      return false;
+    }
+    fcntl(listenFd_, F_SETFL, O_NONBLOCK); // handleClient() no espera si no hay nadie
+    return true;
+  }
+  bool begin(uint16_t port)
+  {
+    port_ = port;
+    return begin();
+  }
+
+  void on(const char *uri, THandlerFunction fn) { routes_.push_back({uri, fn}); }
+  void onNotFound(THandlerFunction fn) { notFound_ = fn; }
+  void addHook(HookFunction hook) { hooks_.push_back(hook); }
+  void collectHeaders(const char *keys[], size_t count) { collected_.assign(keys, keys + count); }
+
+  void handleClient()
+  {
+    int fd = accept(listenFd_, nullptr, nullptr);
+    if (fd < 0)
+      return;
+    timeval tv = {HTTP_MAX_DATA_WAIT / 1000, (HTTP_MAX_DATA_WAIT % 1000) * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    client_ = fd;
+    if (readRequest())
+      dispatch();
+    ::close(fd);
+    client_ = -1;
+  }
+
+  String uri() const { return String(path_); }
+  bool hasArg(const char *name) const { return find(args_, name, false) != nullptr; }
+  String arg(const char *name) const
+  {
+    const std::string *v = find(args_, name, false);
+    return v ? String(*v) : String();
+  }
+  String header(const char *name) const
+  {
+    const std::string *v = find(headers_, name, true);
+    return v ? String(*v) : String();
+  }
+
+  void sendHeader(const String &name, const String &value, bool first = false)
+  {
+    std::string line = std::string(name.c_str()) + ": " + value.c_str() + "\r\n";
+    responseHeaders_ = first ? line + responseHeaders_ : responseHeaders_ + line;
+  }
+  void setContentLength(size_t len) { contentLength_ = len; }
+
+  void send(int code, const char *contentType = nullptr, const String &content = String())
+  {
+    size_t len = contentLength_ == CONTENT_LENGTH_NOT_SET ? content.length() : contentLength_;
+    sendHead(code, contentType, len);
+    if (chunked_)
+    {
+      if (content.length())
+        sendContent(content); // un trozo vacío sería el final
+    }
+    else
+      writeAll(content.c_str(), content.length());
+  }
+
+  void send_P(int code, PGM_P contentType, PGM_P content, size_t len)
+  {
+    sendHead(code, contentType, len);
+    writeAll(content, len);
+  }
+
+  void sendContent(const char *data, size_t len)
+  {
+    if (!chunked_)
+    {
+      writeAll(data, len);
+      return;
+    }
+    char size[16];
+    int n = std::snprintf(size, sizeof(size), "%zx\r\n", len);
+    writeAll(size, n);
+    writeAll(data, len);
+    writeAll("\r\n", 2);
+    if (len == 0)
+      chunked_ = false; // trozo final
+  }
+  void sendContent(const String &content) { sendContent(content.c_str(), content.length()); }
+
+private:
+  typedef std::vector<std::pair<std::string, std::string>> pairs;
+
+  struct route
+  {
+    std::string uri;
+    THandlerFunction fn;
+  };
+
+  int port_;
+  int listenFd_ = -1;
+  int client_ = -1;
+  std::vector<route> routes_;
+  std::vector<HookFunction> hooks_;
+  std::vector<std::string> collected_;
+  THandlerFunction notFound_;
+
+  std::string method_, path_, url_;
+  pairs args_, headers_;
+  std::string responseHeaders_;
+  size_t contentLength_ = CONTENT_LENGTH_NOT_SET;
+  bool chunked_ = false;
+
+  static const std::string *find(const pairs &list, const char *name, bool caseless)
+  {
+    for (const auto &p : list)
+      if (caseless ? strcasecmp(p.first.c_str(), name) == 0 : p.first == name)
+        return &p.second;
+    return nullptr;
+  }
+
+  static std::string urlDecode(const std::string &s)
+  {
+    std::string out;
+    for (size_t i = 0; i < s.size(); i++)
+    {
+      if (s[i] == '+')
+        out += ' ';
+      else if (s[i] == '%' && i + 2 < s.size() && isxdigit((unsigned char)s[i + 1]) && isxdigit((unsigned char)s[i + 2]))
+      {
+        out += (char)std::strtol(s.substr(i + 1, 2).c_str(), nullptr, 16);
+        i += 2;
+      }
+      else
+        out += s[i];
+    }
+    return out;
+  }
+
+  // Cabeceras de la petición; el cuerpo, si lo hay, se ignora
+  bool readRequest()
+  {
+    std::string req;
+    char buf[512];
+    while (req.find("\r\n\r\n") == std::string::npos)
+    {
+      ssize_t n = recv(client_, buf, sizeof(buf), 0);
+      if (n <= 0 || req.size() > 8192)
+        return false;
+      req.append(buf, n);
+    }
+
+    size_t eol = req.find("\r\n");
+    std::string first = req.substr(0, eol);
+    size_t sp1 = first.find(' '), sp2 = first.rfind(' ');
+    if (sp1 == std::string::npos || sp2 <= sp1)
+      return false;
+    method_ = first.substr(0, sp1);
+    url_ = first.substr(sp1 + 1, sp2 - sp1 - 1);
+    size_t q = url_.find('?');
+    path_ = url_.substr(0, q);
+
+    args_.clear();
+    if (q != std::string::npos)
+    {
+      std::string query = url_.substr(q + 1);
+      for (size_t at = 0; at <= query.size();)
+      {
+        size_t amp = query.find('&', at);
+        std::string kv = query.substr(at, amp == std::string::npos ? std::string::npos : amp - at);
+        size_t eq = kv.find('=');
+        if (!kv.empty())
+          args_.push_back({urlDecode(kv.substr(0, eq)), eq == std::string::npos ? "" : urlDecode(kv.substr(eq + 1))});
+        if (amp == std::string::npos)
+          break;
+        at = amp + 1;
+      }
+    }
+
+    headers_.clear();
+    for (size_t at = eol + 2; at < req.size();)
+    {
+      size_t end = req.find("\r\n", at);
+      std::string line = req.substr(at, end - at);
+      if (line.empty())
+        break;
+      size_t colon = line.find(':');
+      if (colon != std::string::npos)
+      {
+        size_t v = line.find_first_not_of(' ', colon + 1);
+        headers_.push_back({line.substr(0, colon), v == std::string::npos ? "" : line.substr(v)});
+      }
+      at = end + 2;
+    }
+    return true;
+  }
+
+  void dispatch()
+  {
+    responseHeaders_.clear();
+    contentLength_ = CONTENT_LENGTH_NOT_SET;
+    chunked_ = false;
+
+    for (auto &hook : hooks_)
+      if (hook(String(method_), String(path_), nullptr, nullptr) != CLIENT_REQUEST_CAN_CONTINUE)
+        return;
+    for (auto &r : routes_)
+    {
+      if (r.uri == path_)
+      {
+        r.fn();
+        return;
+      }
+    }
+    if (notFound_)
+      notFound_();
+    else
+      send(404, "text/plain", String("Not found: ") + path_.c_str());
+  }
+
+  static const char *reason(int code)
+  {
+    switch (code)
+    {
+    case 200: return "OK";
+    case 202: return "Accepted";
+    case 303: return "See Other";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default: return "";
+    }
+  }
+
+  void sendHead(int code, const char *contentType, size_t len)
+  {
+    std::string head = "HTTP/1.1 " + std::to_string(code) + " " + reason(code) + "\r\n";
+    if (contentType && *contentType)
+      head += std::string("Content-Type: ") + contentType + "\r\n";
+    chunked_ = len == CONTENT_LENGTH_UNKNOWN;
+    if (chunked_)
+      head += "Transfer-Encoding: chunked\r\n";
+    else
+      head += "Content-Length: " + std::to_string(len) + "\r\n";
+    head += "Connection: close\r\n" + responseHeaders_ + "\r\n";
+    writeAll(head.data(), head.size());
+    responseHeaders_.clear();
+    contentLength_ = CONTENT_LENGTH_NOT_SET;
+  }
+
+  void writeAll(const char *data, size_t len)
+  {
+    while (len > 0 && client_ >= 0)
+    {
+      ssize_t n = ::send(client_, data, len, MSG_NOSIGNAL);
+      if (n <= 0)
+        return; // el cliente se fue o no lee: se abandona la respuesta
+      data += n;
+      len -= n;
+    }
+  }
+};
+
+#endif // HOST_WEBSERVER_H
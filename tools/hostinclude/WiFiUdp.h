@@ -0,0 +1,27 @@
+// <WiFiUdp.h> para el host (tools/web_load.cpp): sin red hacia NTP. La
+// resolución del servidor falla siempre, así que timeService cuenta fallos y
+// reintenta sin enviar nada, y la hora sigue siendo el uptime.
+
+#ifndef HOST_WIFIUDP_H
+#define HOST_WIFIUDP_H
+
+#include "Arduino.h"
+
+struct WiFiUDP
+{
+  uint8_t begin(uint16_t) { return 1; }
+  int parsePacket() { return 0; }
+  int read(uint8_t *, size_t) { return 0; }
+  void flush() {}
+  int beginPacket(const IPAddress &, uint16_t) { return 0; }
+  size_t write(const uint8_t *, size_t) { return 0; }
+  int endPacket() { return 0; }
+};
+
+struct _hostWiFi
+{
+  int hostByName(const char *, IPAddress &) { return 0; }
+};
+inline _hostWiFi WiFi;
+
+#endif // HOST_WIFIUDP_H
@@ -0,0 +1,183 @@
+// Exportador InfluxDB contra un sumidero HTTP local (host).
+//
+// Simula seis horas de adquisiciones cada 10 s sobre un batteryStack
+// sintético, con el reloj acelerado, y envía los lotes por HTTP de verdad a
+// tools/influx_sink.py. Entre el minuto 60 y el 150 la "red" se cae (el
+// transporte no llega a conectar) para forzar los reintentos y el llenado del
+// lote. Al final pide /stats al sumidero y comprueba que recibió exactamente
+// las líneas de las muestras entregadas, sin duplicados ni líneas inválidas:
+//
+//     python3 tools/influx_sink.py --port 8086 --fail-rate 0.2 &
+//     g++ -O2 -std=c++17 -I. tools/influx_sim.cpp -o influx_sim && ./influx_sim [url] [modulos] [-v]
+
+#include <cstdlib>
+#include <string>
+
+#include <netdb.h>
+#include <sys/socket.h>
+
+#include "tools/hostArduino.h"
+#include "batteryStack.h"
+#include "influxExporter.h"
+#include "tools/syntheticStack.h"
+
+// HTTP/1.1 mínimo sobre sockets POSIX: una conexión por petición
+struct posixHttp
+{
+  std::string host, port, path;
+
+  bool parse(const std::string &url)
+  {
+    if (url.compare(0, 7, "http://") != 0)
+      return false;
+    std::string rest = url.substr(7);
+    size_t slash = rest.find('/');
+    std::string hostPort = rest.substr(0, slash);
+    path = slash == std::string::npos ? "/" : rest.substr(slash);
+    size_t colon = hostPort.find(':');
+    host = hostPort.substr(0, colon);
+    port = colon == std::string::npos ? "80" : hostPort.substr(colon + 1);
+    return true;
+  }
+
+  // Devuelve el código HTTP (o -1) y el cuerpo de la respuesta en 'reply'
+  int request(const char *method, const std::string &target, const std::string &headers,
+              const uint8_t *body, size_t len, std::string *reply = nullptr)
+  {
+    addrinfo hints = {}, *res = nullptr;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &res) != 0)
+      return -1;
+    int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    int ok = fd >= 0 ? connect(fd, res->ai_addr, res->ai_addrlen) : -1;
+    freeaddrinfo(res);
+    if (ok < 0)
+    {
+      if (fd >= 0)
+        close(fd);
+      return -1;
+    }
+
+    std::string req = std::string(method) + " " + target + " HTTP/1.1\r\nHost: " + host +
+                      "\r\nConnection: close\r\nContent-Length: " + std::to_string(len) + "\r\n" + headers + "\r\n";
+    req.append((const char *)body, len);
+    send(fd, req.data(), req.size(), 0);
+
+    std::string resp;
+    char buf[4096];
+    ssize_t n;
+    while ((n = recv(fd, buf, sizeof(buf), 0)) > 0)
+      resp.append(buf, n);
+    close(fd);
+
+    if (resp.compare(0, 5, "HTTP/") != 0)
+      return -1;
+    if (reply)
+    {
+      size_t sep = resp.find("\r\n\r\n");
+      *reply = sep == std::string::npos ? "" : resp.substr(sep + 4);
+    }
+    return atoi(resp.c_str() + resp.find(' ') + 1);
+  }
+};
+
+struct sinkTransport : influxTransport
+{
+  posixHttp http;
+  bool networkDown = false;
+  bool verbose = false;
+
+  int post(const uint8_t *body, size_t len, bool gzipped) override
+  {
+    if (networkDown)
+      return -1;
+    std::string headers = "Content-Type: text/plain; charset=utf-8\r\n";
+    if (gzipped)
+      headers += "Content-Encoding: gzip\r\n";
+    int code = http.request("POST", http.path, headers, body, len);
+    if (verbose)
+      printf("  POST %zu bytes%s -> %d\n", len, gzipped ? " gzip" : "", code);
+    return code;
+  }
+};
+
+// Busca "key":<número> en el JSON de /stats
+static long statField(const std::string &json, const char *key)
+{
+  std::string k = std::string("\"") + key + "\":";
+  size_t p = json.find(k);
+  return p == std::string::npos ? -1 : atol(json.c_str() + p + k.size());
+}
+
+int main(int argc, char **argv)
+{
+  std::string url = "http://127.0.0.1:8086/api/v2/write?org=home&bucket=pylontech&precision=s";
+  int modules = 3;
+  bool verbose = false;
+  for (int i = 1; i < argc; i++)
+  {
+    if (!strcmp(argv[i], "-v"))
+      verbose = true;
+    else if (!strncmp(argv[i], "http://", 7))
+      url = argv[i];
+    else
+      modules = atoi(argv[i]);
+  }
+
+  sinkTransport link;
+  link.verbose = verbose;
+  if (!link.http.parse(url))
+  {
+    fprintf(stderr, "bad url: %s\n", url.c_str());
+    return 1;
+  }
+
+  static batteryStack st;
+  static influxExporter influx;
+  st.init();
+  influx.begin(link, st, "sim");
+
+  const unsigned long duration = 6 * 3600 * 1000UL;
+  const unsigned long epoch = 1718000000;
+  unsigned long lastAcq = 0;
+  int cycle = 0;
+
+  for (unsigned long now = 0; now < duration; now += 1000)
+  {
+    link.networkDown = now >= 60 * 60000UL && now < 150 * 60000UL;
+    if (now == 0 || now - lastAcq >= 10000)
+    {
+      syntheticAcquire(st, modules, 15, cycle++, now);
+      lastAcq = now;
+      influx.sample(epoch + now / 1000, true, now);
+    }
+    influx.loop(now);
+  }
+
+  // Vaciar lo pendiente con la red ya de vuelta
+  link.networkDown = false;
+  for (int tries = 0; influx.batchSamples > 0 && tries < 50; tries++)
+    influx.flush(duration);
+
+  std::string stats;
+  int code = link.http.request("GET", "/stats", "", nullptr, 0, &stats);
+  if (code != 200)
+  {
+    fprintf(stderr, "sink /stats failed (%d); is tools/influx_sink.py running?\n", code);
+    return 1;
+  }
+
+  long lines = statField(stats, "lines");
+  long expected = (long)influx.delivered * (1 + modules);
+  printf("samples %u: delivered %u, dropped %u, rejected %u\n", influx.samples, influx.delivered, influx.dropped, influx.rejected);
+  printf("posts %u (%u failed), %u -> %u bytes (%.1fx)\n", influx.posts, influx.failures, influx.rawBytes, influx.sentBytes,
+         influx.sentBytes ? (double)influx.rawBytes / influx.sentBytes : 0.0);
+  printf("sink: %ld lines, %ld requests (%ld failed, %ld gzip), %ld bad, %ld duplicates\n", lines,
+         statField(stats, "requests"), statField(stats, "failed"), statField(stats, "gzip"),
+         statField(stats, "bad"), statField(stats, "duplicates"));
+
+  bool ok = lines == expected && statField(stats, "bad") == 0 && statField(stats, "duplicates") == 0 &&
+            influx.delivered + influx.dropped + influx.rejected == influx.samples && influx.batchSamples == 0;
+  printf("%s (expected %ld lines)\n", ok ? "OK" : "MISMATCH", expected);
+  return ok ? 0 : 1;
+}
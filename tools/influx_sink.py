@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""Sumidero HTTP local que imita el endpoint de escritura de InfluxDB.
+
+Acepta POST en cualquier ruta (p. ej. /api/v2/write?...&precision=s), con o sin
+Content-Encoding: gzip, valida cada línea de line protocol y responde 204.
+GET /stats devuelve un resumen en JSON. Sin dependencias.
+
+    python3 tools/influx_sink.py --port 8086 [--fail-rate 0.2] [-v]
+
+--fail-rate responde 503 a esa fracción de POST (antes de ingerir nada), para
+probar los reintentos del exportador.
+"""
+
+import argparse
+import gzip
+import json
+import random
+import re
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+# medida,tags campos timestamp
+LINE = re.compile(r'^([A-Za-z_][\w]*)((?:,[\w]+=[^,= ]+)*) ((?:[\w]+=(?:-?\d+i|-?\d+(?:\.\d+)?|"[^"]*"),?)+) (\d+)$')
+
+lock = threading.Lock()
+stats = {"requests": 0, "failed": 0, "gzip": 0, "bytes": 0, "rawBytes": 0,
+         "lines": 0, "bad": 0, "duplicates": 0, "series": {}}
+seen = set()
+
+
+class Handler(BaseHTTPRequestHandler):
+    def log_message(self, fmt, *args):
+        if self.server.verbose:
+            super().log_message(fmt, *args)
+
+    def do_GET(self):
+        if self.path != "/stats":
+            self.send_error(404)
+            return
+        with lock:
+            body = json.dumps(stats).encode()
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def do_POST(self):
+        body = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+        with lock:
+            stats["requests"] += 1
+            if random.random() < self.server.fail_rate:
+                stats["failed"] += 1
+                self.send_response(503)
+                self.send_header("Content-Length", "0")
+                self.end_headers()
+                return
+
+            raw = body
+            if self.headers.get("Content-Encoding") == "gzip":
+                stats["gzip"] += 1
+                raw = gzip.decompress(body)
+            stats["bytes"] += len(body)
+            stats["rawBytes"] += len(raw)
+
+            bad = 0
+            for line in raw.decode().splitlines():
+                m = LINE.match(line)
+                if not m:
+                    bad += 1
+                    print("bad line: %r" % line)
+                    continue
+                stats["lines"] += 1
+                key = (m.group(1) + m.group(2), m.group(4))
+                if key in seen:
+                    stats["duplicates"] += 1
+                seen.add(key)
+                series = m.group(1) + m.group(2)
+                stats["series"][series] = stats["series"].get(series, 0) + 1
+            stats["bad"] += bad
+
+        if self.server.verbose:
+            print("POST %d bytes%s -> %d bytes, %d lines" % (
+                len(body), " (gzip)" if raw is not body else "", len(raw), raw.count(b"\n")))
+        code = 400 if bad else 204
+        self.send_response(code)
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--port", type=int, default=8086)
+    ap.add_argument("--fail-rate", type=float, default=0.0)
+    ap.add_argument("--seed", type=int, default=1)
+    ap.add_argument("-v", "--verbose", action="store_true")
+    args = ap.parse_args()
+
+    random.seed(args.seed)
+    srv = ThreadingHTTPServer(("127.0.0.1", args.port), Handler)
+    srv.fail_rate = args.fail_rate
+    srv.verbose = args.verbose
+    print("Influx sink on http://127.0.0.1:%d (fail rate %.2f)" % (args.port, args.fail_rate), flush=True)
+    try:
+        srv.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
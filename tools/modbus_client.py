@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Lee el mapa Modbus TCP del monitor (modbusMap.h) y lo muestra decodificado.
+
+Sin dependencias. Usa FC04 (input registers) por defecto; --holding usa FC03.
+
+    python3 tools/modbus_client.py 192.168.1.50
+    python3 tools/modbus_client.py 127.0.0.1 --port 1502 --json
+    python3 tools/modbus_client.py 192.168.1.50 --raw 100 32   # registros crudos
+"""
+
+import argparse
+import json
+import socket
+import struct
+import sys
+
+MODULE_BASE = 100
+MODULE_STRIDE = 32
+MAX_MODULES = 16
+STATES = {0: "Absent", 1: "Idle", 2: "Charge", 3: "Dischg", 4: "Other"}
+
+
+class ModbusError(Exception):
+    pass
+
+
+class Client:
+    def __init__(self, host, port, unit=1, fc=4, timeout=5.0):
+        self.sock = socket.create_connection((host, port), timeout=timeout)
+        self.unit = unit
+        self.fc = fc
+        self.tid = 0
+
+    def _recv(self, n):
+        data = b""
+        while len(data) < n:
+            chunk = self.sock.recv(n - len(data))
+            if not chunk:
+                raise ModbusError("conexión cerrada por el servidor")
+            data += chunk
+        return data
+
+    def read(self, start, count):
+        self.tid = (self.tid + 1) & 0xFFFF
+        self.sock.sendall(struct.pack(">HHHBBHH", self.tid, 0, 6, self.unit, self.fc, start, count))
+        tid, proto, length, unit = struct.unpack(">HHHB", self._recv(7))
+        pdu = self._recv(length - 1)
+        if tid != self.tid or proto != 0:
+            raise ModbusError("cabecera MBAP inesperada")
+        if pdu[0] & 0x80:
+            raise ModbusError("excepción %d en %d..%d" % (pdu[1], start, start + count - 1))
+        return list(struct.unpack(">%dH" % (pdu[1] // 2), pdu[2:]))
+
+
+def s16(v):
+    return v - 0x10000 if v & 0x8000 else v
+
+
+def decode_stack(r):
+    return {
+        "mapVersion": r[0],
+        "generation": r[1] | (r[2] << 16),
+        "ageSeconds": r[3],
+        "batteryCount": r[4],
+        "soc": r[5],
+        "voltage": r[6] / 1000.0,
+        "current": s16(r[7]) / 100.0,
+        "power": s16(r[8]),
+        "temperature": s16(r[9]) / 10.0,
+        "imbalanceMv": r[10],
+        "cellHigh": r[11] / 1000.0,
+        "cellLow": r[12] / 1000.0,
+        "cellHighModule": r[13],
+        "cellLowModule": r[14],
+        "state": STATES.get(r[15], r[15]),
+        "cellCount": r[16],
+    }
+
+
+def decode_module(n, r):
+    cells = [v / 1000.0 for v in r[16:16 + r[12]]]
+    return {
+        "id": n,
+        "soc": r[1],
+        "voltage": r[2] / 1000.0,
+        "current": s16(r[3]) / 100.0,
+        "power": s16(r[4]),
+        "temperature": s16(r[5]) / 10.0,
+        "imbalanceMv": r[6],
+        "cellHigh": r[7] / 1000.0,
+        "cellLow": r[8] / 1000.0,
+        "cellHighId": r[9],
+        "cellLowId": r[10],
+        "state": STATES.get(r[11], r[11]),
+        "cells": cells,
+    }
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("host")
+    ap.add_argument("--port", type=int, default=502)
+    ap.add_argument("--unit", type=int, default=1)
+    ap.add_argument("--holding", action="store_true", help="FC03 en lugar de FC04")
+    ap.add_argument("--json", action="store_true", help="salida JSON")
+    ap.add_argument("--raw", nargs=2, type=int, metavar=("START", "COUNT"), help="volcar registros crudos")
+    args = ap.parse_args()
+
+    cli = Client(args.host, args.port, args.unit, 3 if args.holding else 4)
+
+    if args.raw:
+        start, count = args.raw
+        for i, v in enumerate(cli.read(start, count)):
+            print("%5d  %5d  0x%04x  %6d" % (start + i, v, v, s16(v)))
+        return 0
+
+    stack = decode_stack(cli.read(0, 20))
+    modules = []
+    # Módulos de 3 en 3: 96 registros por petición (4 serían 128 > 125)
+    for first in range(0, MAX_MODULES, 3):
+        n = min(3, MAX_MODULES - first)
+        regs = cli.read(MODULE_BASE + first * MODULE_STRIDE, n * MODULE_STRIDE)
+        for k in range(n):
+            block = regs[k * MODULE_STRIDE:(k + 1) * MODULE_STRIDE]
+            if block[0]:
+                modules.append(decode_module(first + k + 1, block))
+
+    if args.json:
+        json.dump({"stack": stack, "modules": modules}, sys.stdout, indent=2)
+        print()
+        return 0
+
+    print("Stack: gen %(generation)d (%(ageSeconds)ds)  %(batteryCount)d modules  SOC %(soc)d%%  "
+          "%(voltage).3f V  %(current).2f A  %(power)d W  %(temperature).1f °C  %(state)s  "
+          "imbalance %(imbalanceMv)d mV" % stack)
+    for m in modules:
+        print("  #%(id)-2d SOC %(soc)3d%%  %(voltage).3f V  %(current)7.2f A  %(power)5d W  "
+              "%(temperature).1f °C  %(state)-6s  cells %(cellLow).3f..%(cellHigh).3f V" % m)
+    return 0
+
+
+if __name__ == "__main__":
+    try:
+        sys.exit(main())
+    except (ModbusError, OSError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        sys.exit(1)
@@ -0,0 +1,105 @@
+// Servidor Modbus TCP de host con el mismo mapa que el firmware (modbusMap.h)
+// sobre un batteryStack sintético que se "adquiere" cada 30 s. Sirve para
+// probar clientes (tools/modbus_client.py, mbpoll, el PLC...) sin hardware:
+//
+//     g++ -O2 -std=c++17 -I. tools/modbus_sim.cpp -o modbus_sim && ./modbus_sim [puerto] [modulos]
+//     python3 tools/modbus_client.py 127.0.0.1 --port 1502
+//     mbpoll -m tcp -p 1502 -t 4 -r 1 -c 20 127.0.0.1
+//
+// Un cliente cada vez; las tramas se procesan con modbusProcess(), la misma
+// función que usa modbusServer.h en el dispositivo.
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include "tools/hostArduino.h"
+#include "batteryStack.h"
+#include "modbusMap.h"
+#include "tools/syntheticStack.h"
+
+#define SIM_ACQUISITION_MS 30000 // como ACQUISITION_INTERVAL_MS del firmware
+
+static unsigned long nowMs()
+{
+  using namespace std::chrono;
+  static const auto t0 = steady_clock::now();
+  return duration_cast<milliseconds>(steady_clock::now() - t0).count();
+}
+
+int main(int argc, char **argv)
+{
+  int port = argc > 1 ? atoi(argv[1]) : 1502;
+  int modules = argc > 2 ? atoi(argv[2]) : 3;
+  signal(SIGPIPE, SIG_IGN);
+
+  int srv = socket(AF_INET, SOCK_STREAM, 0);
+  int one = 1;
+  setsockopt(srv, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(srv, (sockaddr *)&addr, sizeof(addr)) < 0 || listen(srv, 4) < 0)
+  {
+    perror("bind/listen");
+    return 1;
+  }
+  printf("Modbus TCP sim on port %d, %d modules, %d registers\n", port, modules, MODBUS_REGISTER_COUNT);
+  fflush(stdout);
+
+  static batteryStack st;
+  st.init();
+  int cycle = 0;
+  syntheticAcquire(st, modules, 15, cycle++, nowMs());
+
+  for (;;)
+  {
+    int c = accept(srv, nullptr, nullptr);
+    if (c < 0)
+      continue;
+    setsockopt(c, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    uint8_t buf[260], resp[260];
+    size_t len = 0;
+    for (;;)
+    {
+      ssize_t n = recv(c, buf + len, sizeof(buf) - len, 0);
+      if (n <= 0)
+        break;
+      len += n;
+
+      if (nowMs() - st.acquiredAt >= SIM_ACQUISITION_MS)
+        syntheticAcquire(st, modules, 15, cycle++, nowMs());
+
+      bool closeConn = false;
+      while (len >= 6)
+      {
+        size_t frame = 6 + ((buf[4] << 8) | buf[5]);
+        if (frame > sizeof(buf))
+        {
+          closeConn = true;
+          break;
+        }
+        if (len < frame)
+          break;
+        size_t out = modbusProcess(buf, frame, resp, sizeof(resp), st, nowMs());
+        if (out == 0 || send(c, resp, out, 0) != (ssize_t)out)
+        {
+          closeConn = true;
+          break;
+        }
+        memmove(buf, buf + frame, len - frame);
+        len -= frame;
+      }
+      if (closeConn)
+        break;
+    }
+    close(c);
+  }
+}
@@ -0,0 +1,300 @@
+// Publicador MQTT contra un broker en proceso (host, sin red).
+//
+// Simula diez minutos de funcionamiento con adquisiciones cada
+// ACQUISITION_INTERVAL_MS sobre un batteryStack sintético y un broker de
+// juguete que rechaza las primeras conexiones, de vez en cuando un publish
+// (buffer lleno) y se cae durante cinco minutos; a los 7:30 el 'bat 1' de
+// una adquisición no contesta y en el minuto 8 desaparece un módulo.
+// Comprueba que la reconexión no bloquea, que cada ciclo termina, que el
+// último valor de cada topic está dentro de la banda muerta del snapshot, que
+// el buzón reenvía el corte completo y en orden, con los registros de antes
+// de la primera hora NTP re-sellados (no los de un arranque anterior), que
+// los configs de Home Assistant retenidos cubren exactamente los topics de
+// estado actuales (también los que dejó retenidos un arranque anterior con
+// más módulos y celdas) y que el 'bat' perdido no los borra ni los vuelve a
+// anunciar:
+//
+//     g++ -O2 -std=c++17 -I. tools/mqtt_sim.cpp -o mqtt_sim && ./mqtt_sim [modulos] [-v]
+//
+// Para probar contra un Mosquitto real basta el firmware y
+//     mosquitto_sub -h <broker> -t 'pylontech/#' -v
+
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+// Buzón pequeño para que el corte pase por RAM y por el fichero
+#ifndef OUTBOX_FILE_RECORDS
+#define OUTBOX_FILE_RECORDS 64
+#endif
+#define OUTBOX_RAM_RECORDS 4
+#define OUTBOX_INTERVAL_SEC 10
+
+#include "tools/hostArduino.h"
+#include "batteryStack.h"
+#include "mqttPublisher.h"
+#include "haDiscovery.h"
+#include "tools/syntheticStack.h"
+
+struct loopbackBroker : mqttTransport
+{
+  unsigned long *clock;
+  int refuseConnects = 3; // intentos que fallan antes de aceptar
+  int connectAfterMs = 200; // el CONNACK llega más tarde
+  int failEvery = 37;     // uno de cada N publish no cabe en el buffer
+  bool down = false;       // broker caído: conexión cerrada y sin aceptar
+  bool isConnected = false;
+  unsigned long connectReadyAt = 0;
+  bool pending = false;
+  int publishCalls = 0;
+  int connectCalls = 0;
+  std::map<std::string, std::string> topics;
+  std::vector<std::string> backlog;
+
+  bool connected() override
+  {
+    if (down)
+      isConnected = pending = false;
+    if (pending && *clock >= connectReadyAt)
+    {
+      pending = false;
+      isConnected = true;
+    }
+    return isConnected;
+  }
+
+  void connect() override
+  {
+    connectCalls++;
+    if (connectCalls <= refuseConnects || down)
+      return;
+    pending = true;
+    connectReadyAt = *clock + connectAfterMs;
+  }
+
+  bool publish(const char *topic, const char *payload, size_t len, bool) override
+  {
+    if (++publishCalls % failEvery == 0)
+      return false;
+    topics[topic] = std::string(payload, len);
+    if (!strcmp(topic, MQTT_TOPIC_ROOT "backlog"))
+      backlog.push_back(topics[topic]);
+    return true;
+  }
+};
+
+int main(int argc, char **argv)
+{
+  int modules = argc > 1 ? atoi(argv[1]) : 3;
+  bool verbose = false;
+  for (int i = 1; i < argc; i++)
+    if (!strcmp(argv[i], "-v"))
+      verbose = hostSerialEcho = true;
+  if (verbose)
+    logBuffer.mirror = [](const char *line) { std::puts(line); };
+  if (modules < 1 || modules > MAX_PYLON_BATTERIES_SUPPORTED)
+    modules = 3;
+
+  unsigned long now = 0;
+  static batteryStack st;
+  st.init();
+  loopbackBroker broker;
+  broker.clock = &now;
+  mqttPublisher pub;
+  pub.begin(broker, st);
+  LittleFS.begin();
+  LittleFS.remove(OUTBOX_FILE);
+
+  // Un arranque anterior dejó en el fichero registros sin hora (pila vacía,
+  // "batteries":0); no se pueden corregir y tienen que salir tal cual
+  const int previousRecords = OUTBOX_RAM_RECORDS + 1;
+  {
+    telemetryOutbox previous;
+    previous.begin();
+    for (int i = 0; i < previousRecords; i++)
+    {
+      outboxRecord r;
+      outboxRecordFromStack(r, st, 60 + i * 60, false);
+      previous.push(r);
+    }
+    previous.spill();
+  }
+
+  telemetryOutbox outbox;
+  outbox.begin();
+  pub.attachOutbox(outbox);
+  setupHaDiscovery(pub);
+
+  // Configs retenidos de un arranque anterior con el módulo 16 y una celda 16
+  // en el módulo 1: el primer anuncio tiene que borrarlos aunque este
+  // arranque no los anunció
+  const mqttMetric previousBoot[] = {
+      haDiscovery::slotMetric(2 * MQTT_METRICS_PER_SCOPE + 15),
+      haDiscovery::slotMetric(MQTT_METRICS_PER_SCOPE + (MAX_PYLON_BATTERIES_SUPPORTED - 1) * MQTT_SLOTS_PER_MODULE)};
+  for (const mqttMetric &m : previousBoot)
+  {
+    if (m.id != MQTT_CELL && m.module <= modules)
+      continue; // con 16 módulos el 16 está presente
+    char suffix[24], topic[96], payload[512];
+    haDiscovery::suffixOf(suffix, sizeof(suffix), m);
+    snprintf(topic, sizeof(topic), "%s/sensor/%s/%s/config", HA_DISCOVERY_PREFIX, _haDiscovery.node, suffix);
+    _haDiscovery.formatConfig(payload, sizeof(payload), m, suffix);
+    broker.topics[topic] = payload;
+  }
+
+  // Diez minutos con adquisiciones, el broker caído de 2:00 a 7:00, sin hora
+  // NTP hasta las 5:20, el módulo 1 sin celdas en la primera adquisición desde
+  // 7:30, un módulo menos desde 8:00 y un periodo de publicación más para el
+  // último ciclo
+  const unsigned long duration = 600000, outageFrom = 120000, outageTo = 420000, glitchAt = 450000, shrinkAt = 480000;
+  const unsigned long syncAt = 320000;
+  const uint32_t bootUtc = 1700000000UL;
+  int restamped = -1;
+  size_t backlogAtSync = 0;
+  bool glitched = false;
+  uint16_t configsAtGlitch = 0, configsAtShrink = 0;
+  int cycle = 0, queued = 0;
+  unsigned long lastAcq = 0;
+  uint32_t lastPublished = 0;
+  int loops = 0, maxLoopsPerCycle = 0;
+  for (now = 0; now <= duration + MQTT_PUSH_FREQ_SEC * 1000UL; now += 10)
+  {
+    broker.down = now >= outageFrom && now < outageTo;
+    if (now >= syncAt && restamped < 0)
+    {
+      restamped = outbox.fixUnsynced(bootUtc);
+      backlogAtSync = broker.backlog.size();
+    }
+    if (now <= duration && (st.generation == 0 || now - lastAcq >= ACQUISITION_INTERVAL_MS))
+    {
+      bool glitch = !glitched && now >= glitchAt;
+      if (glitch)
+      {
+        glitched = true;
+        configsAtGlitch = _haDiscovery.configs;
+      }
+      if (now >= shrinkAt && !configsAtShrink)
+        configsAtShrink = _haDiscovery.configs;
+      syntheticAcquire(st, now >= shrinkAt && modules > 1 ? modules - 1 : modules, 15, cycle++, now, glitch ? 0 : -1);
+      lastAcq = now;
+      uint32_t before = outbox.size() + outbox.dropped;
+      bool synced = restamped >= 0;
+      pub.queueIfOffline(synced ? bootUtc + now / 1000 : now / 1000, synced, now);
+      queued += outbox.size() + outbox.dropped - before;
+    }
+    bool wasActive = pub.cycleActive;
+    pub.loop(now);
+    if (wasActive || pub.cycleActive || pub.publishedGeneration != lastPublished)
+      loops++;
+    if (pub.publishedGeneration != lastPublished)
+    {
+      lastPublished = pub.publishedGeneration;
+      if (loops > maxLoopsPerCycle)
+        maxLoopsPerCycle = loops;
+      loops = 0;
+      if (verbose)
+        printf("t=%6lums generation %u: %3u messages (%u total, %u rejected, %u suppressed)\n",
+               now, (unsigned)lastPublished, pub.lastBurst, (unsigned)pub.messages,
+               (unsigned)pub.failures, (unsigned)pub.suppressed);
+    }
+  }
+
+  // Cada topic debe tener el último valor enviado, y este estar dentro de la
+  // banda muerta del valor actual
+  int expected = 0, mismatches = 0;
+  for (uint16_t slot = 0; slot < MQTT_METRIC_SLOTS; slot++)
+  {
+    mqttMetric m;
+    if (!mqttMetricAt(st, slot, m))
+      continue;
+    expected++;
+    long current = m.value;
+    m.value = pub.slots.value[slot];
+    char topic[64], value[24];
+    mqttFormatTopic(topic, sizeof(topic), m);
+    mqttFormatValue(value, sizeof(value), m);
+    long delta = current > m.value ? current - m.value : m.value - current;
+    auto it = broker.topics.find(topic);
+    if (it == broker.topics.end() || it->second != value || (delta && delta >= _mqttMetricInfo[m.id].deadband))
+    {
+      mismatches++;
+      printf("MISMATCH %s: broker=%s sent=%s now=%ld\n", topic,
+             it == broker.topics.end() ? "(none)" : it->second.c_str(), value, current);
+    }
+  }
+
+  // Un config no vacío por cada topic de estado actual, y ninguno más
+  int configs = 0, configErrors = 0;
+  for (const auto &kv : broker.topics)
+  {
+    if (kv.first.compare(0, strlen(HA_DISCOVERY_PREFIX), HA_DISCOVERY_PREFIX) != 0 || kv.second.empty())
+      continue;
+    configs++;
+    size_t at = kv.second.find("\"stat_t\":\"");
+    std::string stateTopic = kv.second.substr(at + 10, kv.second.find('"', at + 10) - at - 10);
+    bool found = false;
+    for (uint16_t slot = 0; slot < MQTT_METRIC_SLOTS && !found; slot++)
+    {
+      mqttMetric m;
+      char topic[64];
+      if (mqttMetricAt(st, slot, m))
+      {
+        mqttFormatTopic(topic, sizeof(topic), m);
+        found = stateTopic == topic;
+      }
+    }
+    if (!found)
+    {
+      configErrors++;
+      printf("STALE CONFIG %s -> %s\n", kv.first.c_str(), stateTopic.c_str());
+    }
+  }
+  if (configs != expected)
+    configErrors++;
+  // Entre el 'bat' perdido y el cambio de topología no se publica ningún config
+  int flapped = configsAtShrink - configsAtGlitch;
+  if (flapped)
+    configErrors++;
+
+  // El corte llega entero, sin duplicados y del más antiguo al más nuevo. Lo
+  // que sale después de la sincronización lleva hora real (los de este
+  // arranque se re-sellan); solo los del arranque anterior siguen sin ella
+  unsigned long lastTs = 0;
+  bool ordered = true;
+  int previousReplayed = 0, unsyncedAfterSync = 0;
+  for (size_t i = 0; i < broker.backlog.size(); i++)
+  {
+    const std::string &msg = broker.backlog[i];
+    bool synced = msg.find("\"synced\":true") != std::string::npos;
+    if (msg.find("\"batteries\":0") != std::string::npos)
+      previousReplayed += !synced;
+    else if (i >= backlogAtSync && !synced)
+      unsyncedAfterSync++;
+    if (!synced)
+      continue;
+    unsigned long ts = strtoul(msg.c_str() + 6, nullptr, 10); // {"ts":...
+    ordered = ordered && ts > lastTs;
+    lastTs = ts;
+  }
+  bool stampsOk = previousReplayed == previousRecords && unsyncedAfterSync == 0 && restamped > 0;
+
+  printf("%d modules: %u messages (%u suppressed by deadband), %d connect attempts, max %d loop() calls per cycle\n",
+         modules, (unsigned)pub.messages, (unsigned)pub.suppressed, broker.connectCalls, maxLoopsPerCycle);
+  printf("state topics: %d checked, %d mismatches; discovery: %d configs live, %u published, %d after a lost 'bat'\n",
+         expected, mismatches, configs, _haDiscovery.configs, flapped);
+  printf("outbox: %d queued (+%d from the previous boot), %u spilled to file, %d replayed %s, %u dropped, %u left\n",
+         queued, previousRecords, (unsigned)outbox.spilled, (int)broker.backlog.size(),
+         ordered ? "in order" : "OUT OF ORDER", (unsigned)outbox.dropped, (unsigned)outbox.size());
+  printf("first NTP sync: %d records re-stamped, %d unsynced from the previous boot, %d unsynced after the sync\n",
+         restamped, previousReplayed, unsyncedAfterSync);
+  printf("status=%s\n", broker.topics[MQTT_TOPIC_ROOT "status"].c_str());
+  if (mismatches || configErrors || pub.publishedGeneration != st.generation || !ordered || !stampsOk ||
+      (int)(broker.backlog.size() + outbox.dropped) != queued + previousRecords || outbox.size() != 0)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,290 @@
+// Rendimiento de los parsers de la consola, de los escritores JSON de
+// /battery-data y /balance-history y del histórico, con las mismas cabeceras
+// que compila el firmware.
+//
+// Por defecto usa salidas de pwr, bat N, pwrsys y stat con el formato de la
+// consola (tools/bmsTranscripts.h) para 1 a 16 módulos de 15 celdas. Con
+// --captures <dir> usa en su lugar las capturas de un BMS real, grabadas con
+// 'acquisition_sim --tty /dev/ttyUSB0 --record <dir>'.
+//
+// Una línea JSON por medida (JSON lines), para guardarla y comparar con
+// tools/bench_compare.py antes de flashear:
+//
+//     ./build/parser_bench > bench.jsonl
+//     {"bench":"parse_pwr","modules":4,"source":"synthetic","bytes":1626,"ns_per_op":...,
+//      "mb_per_s":...,"allocs_per_op":0,"alloc_bytes_per_op":0}
+//
+// allocs_per_op cuenta los operator new del camino medido (en el firmware
+// serían mallocs del heap que fragmenta). Los tiempos son del host: sirven
+// para comparar versiones entre sí, no como tiempos del ESP.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "tools/hostArduino.h"
+#include "batteryStack.h"
+#include "bmsAcquisition.h"
+#include "bmsParser.h"
+#include "telemetryCodec.h"
+#include "tools/bmsTranscripts.h"
+
+// ---------- Recuento de reservas ----------
+static uint64_t allocCount = 0;
+static uint64_t allocBytes = 0;
+
+void *operator new(size_t n)
+{
+  allocCount++;
+  allocBytes += n;
+  if (void *p = std::malloc(n ? n : 1))
+    return p;
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+// ---------- Capturas ----------
+struct captureSet
+{
+  int modules = 0;
+  std::map<std::string, std::string> outputs; // comando -> salida
+  size_t batBytes = 0;
+
+  const std::string &get(const std::string &cmd) const
+  {
+    static const std::string empty;
+    auto it = outputs.find(cmd);
+    return it == outputs.end() ? empty : it->second;
+  }
+};
+
+struct replayConsole : bmsConsole
+{
+  const captureSet &set;
+  explicit replayConsole(const captureSet &s) : set(s) {}
+  const char *command(const char *cmd, uint32_t) override { return set.get(cmd).c_str(); }
+};
+
+static captureSet syntheticCaptures(int modules, int cells)
+{
+  captureSet c;
+  c.modules = modules;
+  c.outputs["pwr"] = bmsTranscriptPwr(modules, cells, 0);
+  c.outputs["pwrsys"] = bmsTranscriptPwrsys(modules, cells, 0);
+  c.outputs["stat"] = bmsTranscriptStat(0);
+  for (int m = 1; m <= modules; m++)
+  {
+    std::string cmd = "bat " + std::to_string(m);
+    c.outputs[cmd] = bmsTranscriptBat(m, cells, 0, cmd.c_str());
+    c.batBytes += c.outputs[cmd].size();
+  }
+  return c;
+}
+
+static bool readFile(const std::string &path, std::string &out)
+{
+  FILE *f = fopen(path.c_str(), "rb");
+  if (!f)
+    return false;
+  char buf[4096];
+  size_t n;
+  out.clear();
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+    out.append(buf, n);
+  fclose(f);
+  return true;
+}
+
+static bool loadCaptures(const char *dir, captureSet &c)
+{
+  std::string d(dir);
+  if (!readFile(d + "/pwr.txt", c.outputs["pwr"]))
+    return false;
+  readFile(d + "/pwrsys.txt", c.outputs["pwrsys"]);
+  readFile(d + "/stat.txt", c.outputs["stat"]);
+  for (int m = 1; m <= MAX_PYLON_BATTERIES_SUPPORTED; m++)
+  {
+    std::string out;
+    if (!readFile(d + "/bat" + std::to_string(m) + ".txt", out))
+      continue;
+    c.outputs["bat " + std::to_string(m)] = out;
+    c.batBytes += out.size();
+  }
+  static batteryStack probe;
+  probe.clearBatteries();
+  c.modules = parsePwrOutput(c.get("pwr").c_str(), probe);
+  return true;
+}
+
+// ---------- Medida ----------
+struct countingSink
+{
+  size_t len = 0;
+  uint32_t sum = 0;
+  void write(const char *data, size_t n)
+  {
+    len += n;
+    sum += (uint8_t)data[0];
+  }
+};
+
+static uint32_t guard = 0;
+static double minMs = 50;
+
+// Repite fn hasta llenar minMs y escribe la línea JSON
+template <typename Fn>
+static void bench(const char *name, int modules, const char *source, size_t bytes, Fn fn)
+{
+  fn(); // calentamiento
+  uint64_t iterations = 0, allocs0 = allocCount, bytes0 = allocBytes;
+  auto t0 = std::chrono::steady_clock::now();
+  double elapsedNs = 0;
+  for (uint64_t batch = 16; elapsedNs < minMs * 1e6; batch *= 2)
+  {
+    for (uint64_t i = 0; i < batch; i++)
+      guard += fn();
+    iterations += batch;
+    elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+  }
+  double ns = elapsedNs / iterations;
+  printf("{\"bench\":\"%s\",\"modules\":%d,\"source\":\"%s\",\"bytes\":%zu,\"ns_per_op\":%.1f,\"mb_per_s\":%.1f,"
+         "\"allocs_per_op\":%.2f,\"alloc_bytes_per_op\":%.1f}\n",
+         name, modules, source, bytes, ns, bytes ? bytes * 1e3 / ns : 0.0,
+         (double)(allocCount - allocs0) / iterations, (double)(allocBytes - bytes0) / iterations);
+  fflush(stdout);
+}
+
+static void fillHistory(batteryStack &st, int modules)
+{
+  st.history.init();
+  for (int i = 0; i < MAX_BALANCE_HISTORY_ENTRIES; i++)
+    st.history.addEntry(1 + i % modules, 12 + i % 9, 80 + i % 15, 1700000000UL + i * 900);
+}
+
+static void runSet(const captureSet &c, const char *source)
+{
+  static batteryStack st;
+  st.init();
+  const int m = c.modules;
+  const std::string &pwr = c.get("pwr"), &pwrsys = c.get("pwrsys"), &stat = c.get("stat");
+
+  bench("parse_pwr", m, source, pwr.size(), [&]
+        {
+    st.clearBatteries();
+    return (uint32_t)parsePwrOutput(pwr.c_str(), st); });
+
+  std::vector<const char *> bats;
+  for (int i = 1; i <= m; i++)
+    bats.push_back(c.get("bat " + std::to_string(i)).c_str());
+  bench("parse_bat", m, source, c.batBytes, [&]
+        {
+    uint32_t cells = 0;
+    for (int i = 0; i < m; i++)
+      cells += parseBatOutput(bats[i], st.batts[i]);
+    return cells; });
+
+  bench("parse_pwrsys", m, source, pwrsys.size(), [&]
+        {
+    long mA = 0;
+    parsePwrsysCurrent(pwrsys.c_str(), mA);
+    return (uint32_t)mA; });
+
+  if (!stat.empty())
+    bench("split_stat", m, source, stat.size(), [&]
+          {
+      uint32_t tokens = 0;
+      forEachBmsLine(stat.c_str(), [&](char *line)
+                     {
+        char *tok[8];
+        tokens += splitTokens(line, tok, 8); });
+      return tokens; });
+
+  // Secuencia completa sobre las capturas (commit del snapshot incluido)
+  replayConsole console(c);
+  size_t acqBytes = pwr.size() + c.batBytes + pwrsys.size();
+  bench("acquisition", m, source, acqBytes, [&]
+        { return (uint32_t)acquireStack(console, st); });
+
+  // /battery-data (vista de sistema y de un módulo) y /balance-history lleno
+  acquireStack(console, st);
+  fillHistory(st, m);
+  countingSink probe;
+  writeBatteryDataJson(probe, st, 0, 0);
+  bench("json_battery_data", m, source, probe.len, [&]
+        {
+    countingSink s;
+    writeBatteryDataJson(s, st, 0, 0);
+    return s.sum; });
+  probe = countingSink();
+  writeBatteryDataJson(probe, st, 1, 0);
+  bench("json_battery_data_module", m, source, probe.len, [&]
+        {
+    countingSink s;
+    writeBatteryDataJson(s, st, 1, 0);
+    return s.sum; });
+  probe = countingSink();
+  writeHistoryJson(probe, st, 0);
+  bench("json_balance_history", m, source, probe.len, [&]
+        {
+    countingSink s;
+    writeHistoryJson(s, st, 0);
+    return s.sum; });
+
+  // Histórico: una vuelta completa del anillo por operación
+  bench("history_append", m, source, 0, [&]
+        {
+    for (int i = 0; i < MAX_BALANCE_HISTORY_ENTRIES; i++)
+      st.history.addEntry(1 + i % m, (int16_t)(i % 50), 80, 1700000000UL + i * 900);
+    return (uint32_t)st.history.currentIndex; });
+  bench("history_iterate", m, source, 0, [&]
+        {
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < st.history.entryCount; i++)
+      if (const balanceHistoryEntry *e = st.history.getEntry(i))
+        sum += e->balanceMv;
+    return sum; });
+}
+
+int main(int argc, char **argv)
+{
+  const char *captures = nullptr;
+  int maxModules = MAX_PYLON_BATTERIES_SUPPORTED;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--captures") == 0 && i + 1 < argc)
+      captures = argv[++i];
+    else if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc)
+      minMs = atof(argv[++i]);
+    else if (strcmp(argv[i], "--modules") == 0 && i + 1 < argc)
+      maxModules = atoi(argv[++i]);
+    else
+    {
+      fprintf(stderr, "usage: %s [--captures dir] [--modules N] [--min-ms ms]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  if (captures)
+  {
+    captureSet c;
+    if (!loadCaptures(captures, c))
+    {
+      fprintf(stderr, "%s: no pwr.txt\n", captures);
+      return 1;
+    }
+    runSet(c, "captured");
+  }
+  else
+  {
+    for (int modules = 1; modules <= maxModules; modules++)
+      runSet(syntheticCaptures(modules, 15), "synthetic");
+  }
+  return guard == 0xFFFFFFFF ? 1 : 0;
+}
@@ -0,0 +1,272 @@
+// Cola de la consola del BMS (bmsScheduler.h) en el host, contra una consola
+// simulada en <Arduino.h> de tools/hostinclude (Serial2 a BMS_UART_BAUD, con
+// su anillo de recepción). Los plazos se acortan para que todo dure unos
+// segundos de reloj real.
+//
+// Comprueba el orden por clase con la consola libre, el límite de cada cola
+// y el motivo del rechazo, el despacho por plazo (un trabajo de telemetría
+// vencido pasa delante de uno interactivo que aún está en plazo), que un
+// trabajo de background vencido se descarta sin ejecutarse, el timeout sin
+// prompt, que onDone puede encolar el siguiente paso, y los contadores de
+// /bms-queue:
+//
+//     cmake -S . -B build && cmake --build build && ./build/scheduler_sim [-v]
+
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <Arduino.h>
+
+#define BMS_INTERACTIVE_DEADLINE_MS 250
+#define BMS_TELEMETRY_DEADLINE_MS 200
+#define BMS_BACKGROUND_DEADLINE_MS 300
+
+#include "bmsScheduler.h"
+#include "telemetryCodec.h"
+
+// "slow": ~0,5 s de salida a 115200 baudios; "mute": sin prompt; el resto,
+// unas pocas líneas
+static std::string consoleReply(const char *cmd)
+{
+  if (!*cmd)
+    return "\r\npylon>";
+  std::string out = std::string(cmd) + "\r\n@\r\n";
+  if (!strcmp(cmd, "mute"))
+    return out + "no prompt";
+  int lines = !strcmp(cmd, "slow") ? 72 : 2;
+  for (int i = 0; i < lines; i++)
+    out += "1      3330     -3000    24000    Dischg   Normal   Normal   Normal   87%   \r\n";
+  return out + "Command completed successfully\r\n$$\r\n\r\npylon>";
+}
+
+struct jobLog
+{
+  std::string cmd;
+  int lines = 0;
+  bool finished = false;
+  bool ok = false;
+};
+
+// Sink de writeBmsQueueJson sobre un std::string
+struct stringSink
+{
+  std::string &s;
+  explicit stringSink(std::string &out) : s(out) {}
+  void write(const char *data, size_t n) { s.append(data, n); }
+};
+
+static std::deque<jobLog> jobs;
+static std::vector<std::string> finishOrder;
+static int failures = 0;
+static bool verbose = false;
+
+static void expect(bool ok, const char *what, long got, long want)
+{
+  if (ok)
+    return;
+  failures++;
+  printf("MISMATCH %s: got %ld, want %ld\n", what, got, want);
+}
+
+static uint32_t submit(bmsPriority p, const char *cmd, uint32_t timeoutMs = 2000)
+{
+  jobs.push_back(jobLog());
+  jobLog *j = &jobs.back();
+  j->cmd = cmd;
+  return bmsQueue.submit(p, cmd, timeoutMs, [j](const char *)
+                         { j->lines++; }, [j](bool ok)
+                         {
+    j->finished = true;
+    j->ok = ok;
+    finishOrder.push_back(j->cmd + (ok ? "" : j->lines ? ":timeout" : ":expired"));
+    if (verbose)
+      printf("%8lu ms  %-10s %s\n", millis(), j->cmd.c_str(), ok ? "ok" : j->lines ? "timeout" : "expired"); });
+}
+
+static void runFor(unsigned long ms)
+{
+  unsigned long t0 = millis();
+  while (millis() - t0 < ms)
+  {
+    bmsQueue.poll(millis());
+    delay(1);
+  }
+}
+
+static void runUntilIdle()
+{
+  unsigned long t0 = millis();
+  while (!bmsQueue.idle() && millis() - t0 < 10000)
+  {
+    bmsQueue.poll(millis());
+    delay(1);
+  }
+  expect(bmsQueue.idle(), "queue drained", bmsQueue.queued(), 0);
+}
+
+static void expectOrder(const char *what, const std::vector<std::string> &want)
+{
+  if (finishOrder == want)
+    return;
+  failures++;
+  printf("MISMATCH %s:", what);
+  for (const std::string &s : finishOrder)
+    printf(" %s", s.c_str());
+  printf("  (want");
+  for (const std::string &s : want)
+    printf(" %s", s.c_str());
+  printf(")\n");
+}
+
+static void reset()
+{
+  finishOrder.clear();
+  bmsQueue.resetStats(millis());
+}
+
+// Con la consola libre, por clase
+static void checkPriority()
+{
+  reset();
+  submit(BMS_BACKGROUND, "bg");
+  submit(BMS_TELEMETRY, "tel");
+  submit(BMS_INTERACTIVE, "int");
+  runUntilIdle();
+  expectOrder("class order", {"int", "tel", "bg"});
+}
+
+// BMS_QUEUE_DEPTH por clase; el comando largo no cuenta como cola llena
+static void checkDepth()
+{
+  reset();
+  uint32_t ids[BMS_QUEUE_DEPTH];
+  for (int i = 0; i < BMS_QUEUE_DEPTH; i++)
+    ids[i] = submit(BMS_INTERACTIVE, "pwr");
+  expect(ids[0] != 0 && ids[BMS_QUEUE_DEPTH - 1] != 0, "accepted up to the depth", 0, 1);
+  expect(bmsQueue.pending(ids[0]), "queued job pending", 0, 1);
+  expect(submit(BMS_INTERACTIVE, "pwr") == 0, "rejected past the depth", 1, 0);
+  expect(bmsQueue.lastReject == BMS_QUEUE_FULL, "reject reason", bmsQueue.lastReject, BMS_QUEUE_FULL);
+  expect(submit(BMS_TELEMETRY, "pwr") != 0, "other class still accepts", 0, 1);
+  char longCmd[BMS_CMD_MAX + 1];
+  memset(longCmd, 'x', BMS_CMD_MAX);
+  longCmd[BMS_CMD_MAX] = '\0';
+  expect(submit(BMS_BACKGROUND, longCmd) == 0, "long command rejected", 1, 0);
+  expect(bmsQueue.lastReject == BMS_CMD_TOO_LONG, "reject reason", bmsQueue.lastReject, BMS_CMD_TOO_LONG);
+
+  const bmsQueueStats *s = bmsQueue.stats;
+  expect(s[BMS_INTERACTIVE].submitted == BMS_QUEUE_DEPTH, "interactive submitted", s[BMS_INTERACTIVE].submitted,
+         BMS_QUEUE_DEPTH);
+  expect(s[BMS_INTERACTIVE].rejected == 1, "interactive rejected", s[BMS_INTERACTIVE].rejected, 1);
+  expect(s[BMS_BACKGROUND].rejected == 0, "too long is not 'queue full'", s[BMS_BACKGROUND].rejected, 0);
+  runUntilIdle();
+  expect(!bmsQueue.pending(ids[0]), "finished job not pending", 1, 0);
+  expect(s[BMS_INTERACTIVE].completed == BMS_QUEUE_DEPTH, "interactive completed", s[BMS_INTERACTIVE].completed,
+         BMS_QUEUE_DEPTH);
+}
+
+// Mientras "slow" ocupa la consola, la telemetría vence y el background
+// caduca; el interactivo que llega cuando "slow" casi ha terminado aún está
+// en plazo y va después de la telemetría vencida
+static void checkDeadlines()
+{
+  reset();
+  submit(BMS_INTERACTIVE, "slow");
+  bmsQueue.poll(millis()); // en curso
+  submit(BMS_TELEMETRY, "tel");
+  submit(BMS_BACKGROUND, "bg");
+  while (bmsQueue.running >= 0 && bmsQueue.bytes < 4500)
+    runFor(1);
+  expect(bmsQueue.running == BMS_INTERACTIVE, "slow still running", bmsQueue.running, BMS_INTERACTIVE);
+  submit(BMS_INTERACTIVE, "int");
+  runUntilIdle();
+  expectOrder("deadline order", {"slow", "bg:expired", "tel", "int"});
+
+  const bmsQueueStats *s = bmsQueue.stats;
+  expect(s[BMS_TELEMETRY].late == 1, "telemetry late", s[BMS_TELEMETRY].late, 1);
+  expect(s[BMS_TELEMETRY].waitMsMax > BMS_TELEMETRY_DEADLINE_MS, "telemetry wait", s[BMS_TELEMETRY].waitMsMax,
+         BMS_TELEMETRY_DEADLINE_MS);
+  expect(s[BMS_INTERACTIVE].late == 0, "interactive late", s[BMS_INTERACTIVE].late, 0);
+  expect(s[BMS_BACKGROUND].expired == 1 && s[BMS_BACKGROUND].completed == 0, "background expired",
+         s[BMS_BACKGROUND].expired, 1);
+  expect(s[BMS_INTERACTIVE].runMsMax >= 350, "slow run time", s[BMS_INTERACTIVE].runMsMax, 400);
+}
+
+// Sin prompt: timeout y la consola sigue
+static void checkTimeout()
+{
+  reset();
+  submit(BMS_INTERACTIVE, "mute", 100);
+  submit(BMS_INTERACTIVE, "pwr");
+  runUntilIdle();
+  expectOrder("timeout", {"mute:timeout", "pwr"});
+  expect(bmsQueue.stats[BMS_INTERACTIVE].timeouts == 1, "timeouts", bmsQueue.stats[BMS_INTERACTIVE].timeouts, 1);
+  expect(bmsQueue.stats[BMS_INTERACTIVE].completed == 2, "completed", bmsQueue.stats[BMS_INTERACTIVE].completed, 2);
+}
+
+// onDone encola el paso siguiente, como la adquisición: sale en la misma
+// vuelta y su espera no da la vuelta por debajo de cero
+static void checkChained()
+{
+  reset();
+  static int steps;
+  steps = 0;
+  std::function<void(bool)> next = [&next](bool)
+  {
+    if (++steps < 4)
+      bmsQueue.submit(BMS_TELEMETRY, "bat", 2000, nullptr, next);
+  };
+  bmsQueue.submit(BMS_TELEMETRY, "pwr", 2000, nullptr, next);
+  runUntilIdle();
+  expect(steps == 4, "chained steps", steps, 4);
+  expect(bmsQueue.stats[BMS_TELEMETRY].waitMsMax < 50, "chained wait (ms)", bmsQueue.stats[BMS_TELEMETRY].waitMsMax, 0);
+  expect(bmsQueue.stats[BMS_TELEMETRY].late == 0, "chained late", bmsQueue.stats[BMS_TELEMETRY].late, 0);
+}
+
+// El JSON de /bms-queue con un trabajo en cola
+static void checkJson()
+{
+  reset();
+  submit(BMS_INTERACTIVE, "slow");
+  bmsQueue.poll(millis());
+  submit(BMS_TELEMETRY, "pwr");
+  std::string json;
+  stringSink sink(json);
+  writeBmsQueueJson(sink, bmsQueue, millis());
+  expect(json.find("\"running\":{\"cmd\":\"slow\",\"class\":\"interactive\"") != std::string::npos, "running in JSON", 0, 1);
+  expect(json.find("\"jobs\":[{\"id\":") != std::string::npos, "queued job in JSON", 0, 1);
+  if (verbose)
+    printf("%s\n", json.c_str());
+  runUntilIdle();
+}
+
+int main(int argc, char **argv)
+{
+  for (int i = 1; i < argc; i++)
+    if (!strcmp(argv[i], "-v"))
+      verbose = true;
+  if (verbose)
+    logBuffer.mirror = [](const char *line) { std::puts(line); };
+
+  Serial2.responder = consoleReply;
+  bmsPort.begin(BMS_UART_BAUD);
+
+  checkPriority();
+  checkDepth();
+  checkDeadlines();
+  checkTimeout();
+  checkChained();
+  checkJson();
+
+  printf("%zu jobs, deadlines %d/%d/%d ms, depth %d\n", jobs.size(), BMS_INTERACTIVE_DEADLINE_MS,
+         BMS_TELEMETRY_DEADLINE_MS, BMS_BACKGROUND_DEADLINE_MS, BMS_QUEUE_DEPTH);
+  if (failures)
+  {
+    printf("FAIL (%d)\n", failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,44 @@
+// Adquisición sintética para las herramientas de host: rellena batteryStack
+// como lo harían parsePwrOutput + parseBatOutput + commitAcquisition, con
+// valores que derivan poco a poco con 'cycle'. No son capturas reales.
+
+#ifndef SYNTHETICSTACK_H
+#define SYNTHETICSTACK_H
+
+#include <cstring>
+
+#include "batteryStack.h"
+
+// noCells: módulo (0..) cuyo 'bat N' no contesta en esta adquisición, o -1
+inline void syntheticAcquire(batteryStack &st, int modules, int cells, int cycle, unsigned long now, int noCells = -1)
+{
+  st.clearBatteries();
+  for (int m = 0; m < modules; m++)
+  {
+    pylonBattery &b = st.batts[m];
+    b.isPresent = true;
+    b.cellCount = m == noCells ? 0 : cells;
+    for (int c = 0; c < b.cellCount; c++)
+    {
+      b.cellVolt[c] = 3320 + (c * 7 + m * 3 + cycle) % 23;
+      if (c == 0 || b.cellVolt[c] > b.cellVoltHigh)
+      {
+        b.cellVoltHigh = b.cellVolt[c];
+        b.cellVoltHighId = c + 1;
+      }
+      if (c == 0 || b.cellVolt[c] < b.cellVoltLow)
+      {
+        b.cellVoltLow = b.cellVolt[c];
+        b.cellVoltLowId = c + 1;
+      }
+    }
+    b.voltage = 49800 + m * 11 + cycle;
+    b.current = -3041 + m * 97 - cycle * 5;
+    b.tempr = 24100 + m * 300;
+    b.soc = 87 - m - cycle / 3;
+    strcpy(b.baseState, "Dischg");
+  }
+  st.commitAcquisition(false, 0, now);
+}
+
+#endif // SYNTHETICSTACK_H
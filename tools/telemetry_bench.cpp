@@ -0,0 +1,108 @@
+// Tamaño y coste de serialización del snapshot: JSON frente a CBOR, y el
+// scrape de /metrics (Prometheus).
+//
+// Programa de host (no se compila en el dispositivo). Rellena un batteryStack
+// sintético de 1..16 módulos con 16 celdas y dos días de histórico, y mide
+// bytes y ns por serialización con los mismos escritores de telemetryCodec.h
+// que usa el servidor web:
+//
+//     g++ -O2 -std=c++17 -I. tools/telemetry_bench.cpp -o telemetry_bench && ./telemetry_bench
+//
+// Los tiempos son del host; en el ESP la relación entre formatos es la que
+// interesa, no el valor absoluto.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+
+#include "tools/hostArduino.h"
+#include "batteryStack.h"
+#include "telemetryCodec.h"
+#include "metricsExporter.h"
+#include "tools/syntheticStack.h"
+
+// Sink que solo cuenta bytes (y toca el dato para que no se optimice)
+struct countingSink
+{
+  size_t len = 0;
+  uint32_t sum = 0;
+  void write(const char *data, size_t n)
+  {
+    len += n;
+    sum += (uint8_t)data[0];
+  }
+};
+
+static void fillStack(batteryStack &st, int modules)
+{
+  syntheticAcquire(st, modules, 16, 0, 0);
+
+  // Dos días de histórico (un punto cada 15 min)
+  st.history.init();
+  for (int i = 0; i < 192; i++)
+    st.history.addEntry(1700000000UL + i * 900, 1 + i % modules, 12 + i % 9, 80 + i % 15);
+}
+
+template <typename Fn>
+static double nsPerOp(Fn fn, size_t &bytes)
+{
+  const int iterations = 2000;
+  countingSink warm;
+  fn(warm);
+  bytes = warm.len;
+
+  auto t0 = std::chrono::steady_clock::now();
+  uint32_t guard = 0;
+  for (int i = 0; i < iterations; i++)
+  {
+    countingSink s;
+    fn(s);
+    guard += s.sum;
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  if (guard == 0xFFFFFFFF)
+    std::puts("");
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+}
+
+int main()
+{
+  static batteryStack st;
+  std::printf("%-8s %-10s %10s %10s %8s %12s %12s\n",
+              "modules", "payload", "json B", "cbor B", "ratio", "json ns/op", "cbor ns/op");
+
+  for (int modules : {1, 2, 4, 8, 16})
+  {
+    fillStack(st, modules);
+    struct
+    {
+      const char *name;
+      int tail;
+    } cases[] = {{"snapshot", 48}, {"snap+all", 192}};
+
+    for (auto &c : cases)
+    {
+      size_t jb, cb;
+      double jt = nsPerOp([&](countingSink &s) { writeSnapshotJson(s, st, c.tail, 0); }, jb);
+      double ct = nsPerOp([&](countingSink &s) { writeSnapshotCbor(s, st, c.tail, 0); }, cb);
+      std::printf("%-8d %-10s %10zu %10zu %7.2fx %12.0f %12.0f\n", modules, c.name, jb, cb, (double)jb / cb, jt, ct);
+    }
+
+    size_t jb, cb;
+    double jt = nsPerOp([&](countingSink &s) { writeHistoryJson(s, st, 0); }, jb);
+    double ct = nsPerOp([&](countingSink &s) { writeHistoryCbor(s, st, 0); }, cb);
+    std::printf("%-8d %-10s %10zu %10zu %7.2fx %12.0f %12.0f\n", modules, "history", jb, cb, (double)jb / cb, jt, ct);
+  }
+
+  std::printf("\n%-8s %10s %12s\n", "modules", "metrics B", "ns/scrape");
+  for (int modules : {1, 2, 4, 8, 16})
+  {
+    fillStack(st, modules);
+    size_t mb;
+    double mt = nsPerOp([&](countingSink &s) { writePrometheusMetrics(s, st, health, 0); }, mb);
+    std::printf("%-8d %10zu %12.0f\n", modules, mb, mt);
+  }
+  return 0;
+}
@@ -0,0 +1,271 @@
+// Servicio de hora en el host: timeService.h contra un servidor NTP simulado
+// y un cristal que no va a su frecuencia, sin red ni esperas reales.
+//
+// Comprueba el parseo de las respuestas (modo, stratum, cookie, epoch), la
+// deriva estimada tras un día de resincronizaciones horarias y lo que se
+// desvía la hora en seis horas sin NTP, que la hora UTC en ms no retrocede
+// nunca (tampoco cuando el servidor la encuentra adelantada, ni al dar la
+// vuelta millis()), y la corrección del histórico sellado antes de tener
+// hora (balanceHistory::fixUnsynced) y que el primer registro de cada
+// arranque espera a la primera lectura del BMS:
+//
+//     cmake -S . -B build && cmake --build build && ./build/time_sim [ppm] [-v]
+//
+// ppm: error del cristal, 80 por defecto (el reloj del ESP va adelantado).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <Arduino.h>
+
+#include "batteryStack.h"
+#include "timeService.h"
+
+static int failures = 0;
+
+static void expect(bool ok, const char *what, long long got, long long want)
+{
+  if (ok)
+    return;
+  failures++;
+  printf("MISMATCH %s: got %lld, want %lld\n", what, got, want);
+}
+
+// Respuesta de servidor (modo 4) con 'epochMs' en el transmit timestamp y
+// 'originate' en su sitio
+static void buildReply(uint8_t *pkt, int64_t epochMs, uint32_t originate, uint8_t mode = 4, uint8_t stratum = 2)
+{
+  memset(pkt, 0, NTP_PACKET_SIZE);
+  pkt[0] = 0x20 | mode;
+  pkt[1] = stratum;
+  uint32_t secs = (uint32_t)(epochMs / 1000) + NTP_UNIX_OFFSET;
+  uint32_t frac = (uint32_t)(((uint64_t)(epochMs % 1000) << 32) / 1000);
+  uint32_t words[] = {originate, 0, 0, 0, secs, frac}; // originate, receive, transmit
+  for (int w = 0; w < 6; w++)
+    for (int b = 0; b < 4; b++)
+      pkt[24 + w * 4 + b] = words[w] >> (24 - b * 8);
+}
+
+// Reloj del dispositivo y servidor: el monótono avanza (1 + ppm) veces lo que
+// avanza la hora real
+struct simClock
+{
+  timeService ts;
+  double ppm;
+  int64_t trueStartMs = 1700000000000LL;
+  uint32_t millis0;
+  int64_t lastUtcMs = 0;
+  uint32_t backwards = 0;
+
+  simClock(double p, uint32_t start) : ppm(p), millis0(start) { ts.lastMillis = start; }
+
+  int64_t trueMs() const { return trueStartMs + (int64_t)(ts.monotonicMs() / (1 + ppm / 1e6)); }
+
+  // Avanza 'ms' del monótono comprobando que la hora UTC no retrocede
+  void advance(uint64_t ms, uint32_t stepMs = 100)
+  {
+    for (uint64_t done = 0; done < ms; done += stepMs)
+    {
+      ts.tick(millis0 + (uint32_t)(ts.monotonicMs() + stepMs));
+      if (!ts.isSynced())
+        continue;
+      int64_t utc = ts.epochMsAt(ts.monotonicMs());
+      if (utc < lastUtcMs)
+        backwards++;
+      lastUtcMs = utc;
+    }
+  }
+
+  // Un intercambio con 'rttMs' de ida y vuelta simétrica
+  bool sync(uint32_t rttMs = 40)
+  {
+    uint8_t pkt[NTP_PACKET_SIZE];
+    ts.buildRequest(pkt, ts.monotonicMs());
+    ts.sentAt = ts.monotonicMs();
+    advance(rttMs / 2, rttMs / 2);
+    int64_t serverMs = trueMs();
+    advance(rttMs - rttMs / 2, rttMs - rttMs / 2);
+    buildReply(pkt, serverMs, ts.cookie);
+    return ts.handleReply(pkt, sizeof(pkt), ts.monotonicMs());
+  }
+
+  int64_t errorMs() const { return ts.epochMsAt(ts.monotonicMs()) - trueMs(); }
+};
+
+static void checkParsing()
+{
+  simClock c(0, 0);
+  c.advance(5000);
+  uint8_t pkt[NTP_PACKET_SIZE];
+  c.ts.buildRequest(pkt, c.ts.monotonicMs());
+  c.ts.sentAt = c.ts.monotonicMs();
+  int64_t now = c.trueMs();
+
+  buildReply(pkt, now, c.ts.cookie);
+  expect(!c.ts.handleReply(pkt, NTP_PACKET_SIZE - 1, c.ts.monotonicMs()), "short packet rejected", 1, 0);
+  buildReply(pkt, now, c.ts.cookie, 3);
+  expect(!c.ts.handleReply(pkt, sizeof(pkt), c.ts.monotonicMs()), "client mode rejected", 1, 0);
+  buildReply(pkt, now, c.ts.cookie, 4, 0);
+  expect(!c.ts.handleReply(pkt, sizeof(pkt), c.ts.monotonicMs()), "kiss-o'-death rejected", 1, 0);
+  buildReply(pkt, now, c.ts.cookie, 4, 16);
+  expect(!c.ts.handleReply(pkt, sizeof(pkt), c.ts.monotonicMs()), "unsynchronized server rejected", 1, 0);
+  buildReply(pkt, now, c.ts.cookie ^ 1);
+  expect(!c.ts.handleReply(pkt, sizeof(pkt), c.ts.monotonicMs()), "foreign originate rejected", 1, 0);
+  buildReply(pkt, now, c.ts.cookie);
+  memset(pkt + 40, 0, 4);
+  expect(!c.ts.handleReply(pkt, sizeof(pkt), c.ts.monotonicMs()), "pre-1970 time rejected", 1, 0);
+  expect(!c.ts.isSynced() && c.ts.utc() == 0, "no time before a valid reply", c.ts.utc(), 0);
+
+  expect(c.sync(60), "valid reply accepted", 0, 1);
+  expect(c.ts.takeFirstSync(), "first sync reported", 0, 1);
+  expect(!c.ts.takeFirstSync(), "first sync reported once", 1, 0);
+  expect(c.ts.lastRttMs == 60, "rtt", c.ts.lastRttMs, 60);
+  expect(llabs(c.errorMs()) <= 1, "epoch after the first sync (ms)", c.errorMs(), 0);
+  expect(c.ts.utc() == (uint32_t)(c.trueMs() / 1000), "utc()", c.ts.utc(), c.trueMs() / 1000);
+  c.ts.utcOffset = 7200;
+  expect(c.ts.localTime() == c.ts.utc() + 7200, "localTime()", c.ts.localTime(), c.ts.utc() + 7200);
+  long long boot = (c.trueMs() - 5060) / 1000 + 7200;
+  expect(llabs(c.ts.bootEpoch() - boot) <= 1, "bootEpoch()", c.ts.bootEpoch(), boot);
+}
+
+// Un día con NTP cada hora y después seis horas sin él
+static void checkDrift(double ppm, bool verbose)
+{
+  simClock c(ppm, 0xFFFF0000u); // millis() da la vuelta a los 65 s
+  c.advance(3000);
+  c.sync();
+  for (int h = 1; h <= 24; h++)
+  {
+    c.advance(NTP_RESYNC_MS);
+    int64_t before = c.errorMs();
+    c.sync(30 + h * 7 % 25); // algo de jitter en el RTT
+    if (verbose)
+      printf("h=%2d error before sync %+5lld ms, drift %+8.3f ppm, pending slew %d ms\n", h, (long long)before,
+             c.ts.driftPpb / 1000.0, (int)c.ts.slewPendingMs());
+  }
+  long long wantPpb = (long long)(-ppm * 1000);
+  expect(llabs(c.ts.driftPpb - wantPpb) <= 2000, "drift after a day (ppb)", c.ts.driftPpb, wantPpb);
+  expect(llabs(c.ts.lastCorrectionMs) <= 20, "last hourly correction (ms)", c.ts.lastCorrectionMs, 0);
+
+  // Holdover: sin la deriva serían ppm * 21,6 ms
+  c.advance(60000); // lo que quede de la última corrección
+  int64_t start = c.errorMs();
+  c.advance(6 * 3600000ULL, 1000);
+  int64_t holdover = c.errorMs() - start;
+  printf("drift %+.3f ppm (crystal %+.1f ppm), 6 h holdover error %+lld ms (uncorrected %+.0f ms)\n",
+         c.ts.driftPpb / 1000.0, ppm, (long long)holdover, ppm * 21.6);
+  expect(llabs(holdover) <= 50, "6 h holdover error (ms)", holdover, 0);
+  expect(c.backwards == 0, "UTC went backwards", c.backwards, 0);
+}
+
+// La hora real se mueve respecto al reloj: queda adelantado y luego atrasado
+static void checkMonotonic()
+{
+  simClock c(0, 0);
+  c.advance(1000);
+  c.sync();
+  c.advance(60000);
+  c.trueStartMs -= 3000; // 3 s de adelanto
+  c.sync();
+  expect(llabs(c.ts.lastCorrectionMs + 3000) <= 1, "correction seen", c.ts.lastCorrectionMs, -3000);
+  expect(llabs(c.errorMs() - 3000) <= 1, "no backward step (ms ahead)", c.errorMs(), 3000);
+  expect(llabs(c.ts.slewPendingMs() + 3000) <= 1, "slew pending", c.ts.slewPendingMs(), -3000);
+  // 3 s a 5 ms/s: 600 s
+  c.advance(300000);
+  expect(llabs(c.errorMs() - 1500) <= 1, "half absorbed after 300 s", c.errorMs(), 1500);
+  c.advance(301000);
+  expect(llabs(c.errorMs()) <= 1 && c.ts.slewPendingMs() == 0, "absorbed after 600 s", c.errorMs(), 0);
+
+  // Un resync a mitad de absorber sigue con lo que queda
+  c.trueStartMs -= 2000;
+  c.sync();
+  c.advance(100000);
+  c.sync();
+  expect(llabs(c.ts.slewPendingMs() + 1500) <= 1, "resync while slewing", c.ts.slewPendingMs(), -1500);
+  expect(c.ts.driftPpb == 0, "a 2 s step taken as drift (ppb)", c.ts.driftPpb, 0);
+  c.advance(400000);
+
+  // Atrasado: salta hacia delante
+  c.trueStartMs += 5000;
+  c.sync();
+  expect(llabs(c.errorMs()) <= 1 && c.ts.slewPendingMs() == 0, "forward step", c.errorMs(), 0);
+  expect(llabs(c.ts.lastCorrectionMs - 5000) <= 1, "forward correction", c.ts.lastCorrectionMs, 5000);
+  c.advance(1000);
+  expect(c.backwards == 0, "UTC went backwards", c.backwards, 0);
+}
+
+static void checkFixUnsynced()
+{
+  static batteryStack st;
+  st.init();
+  balanceHistory &h = st.history;
+  h.addEntry(1, 10, 80, 1699990000UL, HISTORY_UNSYNCED | HISTORY_TIME_LOST); // de un arranque anterior
+  h.addEntry(1, 11, 81, 120, HISTORY_UNSYNCED);
+  h.addEntry(2, 12, 82, 1020, HISTORY_UNSYNCED);
+  h.addEntry(1, 13, 83, 1700003000UL);
+  h.lastSaveTime = 1020;
+  uint32_t generation = h.generation;
+
+  const unsigned long bootEpoch = 1700001000UL;
+  expect(h.fixUnsynced(bootEpoch) == 2, "entries fixed", 2, 2);
+  const unsigned long want[] = {1699990000UL, bootEpoch + 120, bootEpoch + 1020, 1700003000UL};
+  const uint8_t wantFlags[] = {HISTORY_UNSYNCED | HISTORY_TIME_LOST, 0, 0, 0};
+  for (int i = 0; i < 4; i++)
+  {
+    const balanceHistoryEntry *e = h.getEntry(i);
+    expect(e && e->timestamp == want[i], "fixed timestamp", e ? e->timestamp : 0, want[i]);
+    expect(e && e->flags == wantFlags[i], "fixed flags", e ? e->flags : 0xFF, wantFlags[i]);
+  }
+  expect(h.lastSaveTime == bootEpoch + 1020, "lastSaveTime", h.lastSaveTime, bootEpoch + 1020);
+  expect(h.generation != generation, "generation bumped", h.generation, generation + 1);
+  expect(h.fixUnsynced(bootEpoch) == 0, "second fix is a no-op", 1, 0);
+}
+
+// El primer registro del arranque no se consume antes de tener datos
+static void checkFirstRecord()
+{
+  static batteryStack st;
+  st.init();
+  expect(!st.shouldRecordHistory(0), "record before the first acquisition", 1, 0);
+  st.commitAcquisition(false, 0, 4000);
+  expect(st.shouldRecordHistory(4), "record after the first acquisition", 0, 1);
+  st.updateLastSaveTime(4, 4);
+  expect(!st.shouldRecordHistory(5), "second record right away", 1, 0);
+  expect(st.shouldRecordHistory(4 + 15 * 60), "record after 15 min", 0, 1);
+}
+
+int main(int argc, char **argv)
+{
+  double ppm = 80;
+  bool verbose = false;
+  for (int i = 1; i < argc; i++)
+  {
+    if (!strcmp(argv[i], "-v"))
+      verbose = true;
+    else
+      ppm = atof(argv[i]);
+  }
+  if (ppm <= -NTP_MAX_DRIFT_PPB / 1000 || ppm >= NTP_MAX_DRIFT_PPB / 1000)
+  {
+    fprintf(stderr, "ppm: between %ld and %ld\n", -NTP_MAX_DRIFT_PPB / 1000, NTP_MAX_DRIFT_PPB / 1000);
+    return 2;
+  }
+  if (verbose)
+    logBuffer.mirror = [](const char *line) { std::puts(line); };
+
+  checkParsing();
+  checkDrift(ppm, verbose);
+  checkDrift(-ppm, verbose);
+  checkMonotonic();
+  checkFixUnsynced();
+  checkFirstRecord();
+
+  if (failures)
+  {
+    printf("FAIL (%d)\n", failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""Oyente del snapshot UDP del monitor (udpSnapshot.h).
+
+Se une al grupo multicast, comprueba cabecera y CRC-32 de cada datagrama,
+reúne las partes, decodifica el CBOR (tools/cbor_decode.py) y muestra un
+resumen por snapshot. Cuenta huecos en la secuencia, duplicados y errores.
+Sin dependencias.
+
+    python3 tools/udp_listen.py                           # 239.255.42.1:42424
+    python3 tools/udp_listen.py --group 239.255.42.1 --json
+    python3 tools/udp_listen.py --group '' --count 20     # unicast (sin grupo), sale tras 20
+"""
+
+import argparse
+import json
+import os
+import socket
+import struct
+import sys
+import zlib
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from cbor_decode import decode, to_units  # noqa: E402
+
+HEADER = struct.Struct(">4sBBBBIII")
+
+
+class Stats:
+    def __init__(self):
+        self.snapshots = 0
+        self.datagrams = 0
+        self.lost = 0
+        self.duplicates = 0
+        self.bad = 0
+        self.last_seq = None
+
+    def summary(self):
+        return "%d snapshots, %d datagrams, %d lost, %d duplicates, %d bad" % (
+            self.snapshots, self.datagrams, self.lost, self.duplicates, self.bad)
+
+
+def open_socket(group, port, iface):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.bind(("", port))
+    if group:
+        mreq = socket.inet_aton(group) + socket.inet_aton(iface)
+        sock.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP, mreq)
+    return sock
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--group", default="239.255.42.1", help="grupo multicast ('' = solo unicast)")
+    ap.add_argument("--port", type=int, default=42424)
+    ap.add_argument("--iface", default="0.0.0.0", help="IP de la interfaz para unirse al grupo")
+    ap.add_argument("--count", type=int, default=0, help="salir tras N snapshots")
+    ap.add_argument("--timeout", type=float, default=0, help="salir tras N s sin datos")
+    ap.add_argument("--json", action="store_true", help="imprimir cada snapshot como JSON")
+    args = ap.parse_args()
+
+    sock = open_socket(args.group, args.port, args.iface)
+    if args.timeout:
+        sock.settimeout(args.timeout)
+    st = Stats()
+    pending = {}  # seq -> {part: bytes}
+
+    try:
+        while not args.count or st.snapshots < args.count:
+            try:
+                data, sender = sock.recvfrom(2048)
+            except socket.timeout:
+                break
+            st.datagrams += 1
+            if len(data) < HEADER.size:
+                st.bad += 1
+                continue
+            magic, version, part, parts, _flags, seq, generation, crc = HEADER.unpack_from(data)
+            payload = data[HEADER.size:]
+            if magic != b"PYLS" or version != 1 or part >= parts or zlib.crc32(payload) != crc:
+                st.bad += 1
+                print("bad datagram from %s (seq %d)" % (sender[0], seq), file=sys.stderr)
+                continue
+
+            if st.last_seq is not None and seq <= st.last_seq:
+                st.duplicates += 1
+                continue
+            chunks = pending.setdefault(seq, {})
+            chunks[part] = payload
+            if len(chunks) < parts:
+                continue
+            del pending[seq]
+            # Partes de snapshots anteriores que ya no se completarán
+            for old in [s for s in pending if s < seq]:
+                del pending[old]
+
+            if st.last_seq is not None and seq > st.last_seq + 1:
+                st.lost += seq - st.last_seq - 1
+            st.last_seq = seq
+            st.snapshots += 1
+
+            snap, _ = decode(b"".join(chunks[i] for i in range(parts)))
+            if args.json:
+                print(json.dumps(to_units(snap)))
+            else:
+                s = snap["stack"]
+                print("seq %d gen %d (%d part%s, %d B): %d modules  SOC %d%%  %.3f V  %.3f A  %s" % (
+                    seq, generation, parts, "" if parts == 1 else "s", sum(len(c) for c in chunks.values()),
+                    s["batteryCount"], s["soc"], s["voltage"] / 1000.0, s["current"] / 1000.0, s["state"]))
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+    print(st.summary(), file=sys.stderr)
+    return 0 if st.bad == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
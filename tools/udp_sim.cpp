@@ -0,0 +1,87 @@
+// Emisor de host del snapshot UDP (udpSnapshot.h) sobre un batteryStack
+// sintético, para probar oyentes sin hardware. Envía una adquisición por
+// periodo al grupo (o a una dirección unicast, útil en loopback):
+//
+//     g++ -O2 -std=c++17 -I. tools/udp_sim.cpp -o udp_sim
+//     ./udp_sim [destino] [puerto] [modulos] [snapshots] [periodo_ms] [--drop N]
+//     ./udp_sim 239.255.42.1 42424 16 20 500
+//     python3 tools/udp_listen.py --group 239.255.42.1
+//
+// --drop N omite el envío de cada N-ésimo snapshot (la secuencia avanza igual)
+// para comprobar que el oyente detecta los huecos.
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "tools/hostArduino.h"
+#include "batteryStack.h"
+#include "udpSnapshot.h"
+#include "tools/syntheticStack.h"
+
+int main(int argc, char **argv)
+{
+  const char *dest = "239.255.42.1";
+  int port = UDP_SNAPSHOT_PORT, modules = 3, count = 10, periodMs = 1000, drop = 0;
+  int pos = 0;
+  for (int i = 1; i < argc; i++)
+  {
+    if (!strcmp(argv[i], "--drop") && i + 1 < argc)
+    {
+      drop = atoi(argv[++i]);
+      continue;
+    }
+    switch (pos++)
+    {
+    case 0: dest = argv[i]; break;
+    case 1: port = atoi(argv[i]); break;
+    case 2: modules = atoi(argv[i]); break;
+    case 3: count = atoi(argv[i]); break;
+    case 4: periodMs = atoi(argv[i]); break;
+    }
+  }
+
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  unsigned char ttl = 1, loop = 1;
+  setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+  setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+  sockaddr_in to = {};
+  to.sin_family = AF_INET;
+  to.sin_port = htons(port);
+  if (inet_pton(AF_INET, dest, &to.sin_addr) != 1)
+  {
+    fprintf(stderr, "bad address: %s\n", dest);
+    return 1;
+  }
+
+  static batteryStack st;
+  static uint8_t cbor[UDP_SNAPSHOT_MAX_BYTES];
+  st.init();
+  unsigned sent = 0, datagrams = 0;
+
+  for (int seq = 1; seq <= count; seq++)
+  {
+    syntheticAcquire(st, modules, 16, seq, seq * 10000UL);
+    bool skip = drop > 0 && seq % drop == 0;
+    uint8_t parts = udpSnapshotSend(st, seq, cbor, sizeof(cbor), [&](const uint8_t *header, const uint8_t *payload, size_t n)
+                                    {
+      if (skip)
+        return;
+      uint8_t dgram[UDP_SNAPSHOT_DATAGRAM];
+      memcpy(dgram, header, UDP_SNAPSHOT_HEADER);
+      memcpy(dgram + UDP_SNAPSHOT_HEADER, payload, n);
+      if (sendto(fd, dgram, UDP_SNAPSHOT_HEADER + n, 0, (sockaddr *)&to, sizeof(to)) > 0)
+        datagrams++; });
+    if (!skip)
+      sent++;
+    printf("seq %d: %u part(s)%s\n", seq, parts, skip ? " (dropped)" : "");
+    fflush(stdout);
+    std::this_thread::sleep_for(std::chrono::milliseconds(periodMs));
+  }
+  printf("sent %u snapshots in %u datagrams\n", sent, datagrams);
+  return 0;
+}
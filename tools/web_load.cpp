@@ -0,0 +1,312 @@
+// Prueba de carga de la interfaz web en el host: los handlers reales de
+// webInterface.h sobre tools/hostinclude (un WebServer de un solo hilo como
+// ESP8266WebServer y la línea del BMS simulada a BMS_UART_BAUD), con un loop()
+// que hace lo mismo que el del sketch: adquisición cada
+// ACQUISITION_INTERVAL_MS por la cola de la consola (bmsScheduler.h), que
+// avanza en cada vuelta, y handleClient() de una petición cada vez.
+//
+// El BMS contesta con tools/bmsTranscripts.h (--modules N, 8 por defecto).
+// Para cada ruta y cada número de clientes concurrentes, los clientes (hilos
+// con una conexión por petición, como un navegador contra el ESP) piden sin
+// pausa durante --seconds y se escribe una línea JSON:
+//
+//     cmake -S . -B build && cmake --build build && ./build/web_load > load.jsonl
+//     {"path":"/battery-data","clients":4,"requests":...,"failures":0,"fail_rate":0.000,
+//      "req_per_s":...,"p50_ms":...,"p99_ms":...,"max_ms":...,"bytes_per_req":...,"acquisitions":1}
+//
+// failures: sin conexión, sin respuesta completa en --timeout-ms o estado
+// distinto de 200. bytes_per_req incluye cabeceras. Los tiempos de CPU son
+// del host; lo que se parece al ESP es el modelo: un hilo, un cliente cada
+// vez, una cola de conexiones corta y las esperas de la consola del BMS.
+//
+//     ./build/web_load --paths /,/battery-data --clients 1,8,32 --seconds 10
+//     ./build/web_load --serve [--port 8080]   # solo el servidor, para un navegador o curl
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <Arduino.h>
+
+#include "PylontechMonitoring.h"
+#include "batteryStack.h"
+#include "bmsAcquisition.h"
+#include "webInterface.h"
+#include "tools/hostBmsConsole.h"
+
+// ---------- Lo que define el sketch ----------
+static int serverPort = 8080;
+static WebServer server(serverPort);
+static batteryStack stack;
+bool wifiConnected = true;
+timeService timeSvc(2 * 3600);
+static uint32_t acquisitions = 0;
+static unsigned long intervalMs = ACQUISITION_INTERVAL_MS;
+
+static queuedAcquisition acquisition;
+
+// /force-update
+bool updateBatteryData() { return acquisition.start(stack); }
+
+unsigned long getCurrentTimestamp()
+{
+  return timeSvc.isSynced() ? timeSvc.localTime() : timeSvc.uptimeSeconds();
+}
+
+// El histórico lleno, para que /balance-history tenga su tamaño real
+static void fillHistory(int modules)
+{
+  for (int i = 0; i < MAX_BALANCE_HISTORY_ENTRIES; i++)
+    stack.history.addEntry(1 + i % modules, 12 + i % 9, 80 + i % 15, 1700000000UL + i * 900);
+}
+
+static void setup(int modules)
+{
+  static transcriptConsole bms(modules, 15);
+  Serial2.responder = [](const char *cmd)
+  {
+    if (!*cmd)
+      return std::string("\r\n" BMS_TRANSCRIPT_PROMPT);
+    bms.cycle++;
+    return std::string(bms.command(cmd, 0));
+  };
+  bmsPort.begin(BMS_UART_BAUD);
+  stack.init();
+  acquisition.onDone = [](int present, unsigned long ms)
+  {
+    health.acquisitionDone(ms, present > 0);
+    acquisitions++;
+  };
+  fillHistory(modules);
+
+  setupWebInterface(server, &stack);
+  server.addHook([](const String &, const String &url, WiFiClient *, WebServer::ContentTypeFunction)
+                 {
+    httpRoutes.current = httpRoutes.lookup(url.c_str());
+    health.heap.requestBegin();
+    return WebServer::CLIENT_REQUEST_CAN_CONTINUE; });
+}
+
+// Las partes de loop() del sketch que ocupan el hilo: hora, adquisición y HTTP
+static void loop()
+{
+  health.loopBegin(micros());
+  PERF_SCOPE(PERF_LOOP);
+  {
+    PERF_SCOPE(PERF_NTP);
+    timeSvc.loop(millis(), wifiConnected);
+  }
+
+  static unsigned long lastBatteryUpdate = 0;
+  unsigned long currentTime = millis();
+  if ((stack.generation == 0 || currentTime - lastBatteryUpdate > intervalMs) && acquisition.start(stack))
+    lastBatteryUpdate = currentTime;
+  bmsQueue.poll(millis());
+
+  {
+    PERF_SCOPE(PERF_HTTP);
+    server.handleClient();
+  }
+  if (httpRoutes.current >= 0)
+  {
+    health.heap.requestEnd(httpRoutes.current, millis());
+    httpRoutes.current = -1;
+  }
+
+  bmsPort.poll();
+  health.heap.loop(millis());
+  health.loopEnd(micros());
+}
+
+// ---------- Clientes ----------
+struct clientStats
+{
+  std::vector<uint32_t> latencyUs;
+  uint32_t failures = 0;
+  uint64_t bytes = 0;
+};
+
+// GET con una conexión nueva; true si llegó la respuesta completa con 200
+static bool httpGet(const char *path, int timeoutMs, uint64_t &bytes)
+{
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  timeval tv = {timeoutMs / 1000, (timeoutMs % 1000) * 1000};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(serverPort);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  bool ok = false;
+  if (connect(fd, (sockaddr *)&addr, sizeof(addr)) == 0)
+  {
+    std::string req = std::string("GET ") + path + " HTTP/1.1\r\nHost: pylontech\r\nConnection: close\r\n\r\n";
+    if (::send(fd, req.data(), req.size(), MSG_NOSIGNAL) == (ssize_t)req.size())
+    {
+      std::string resp;
+      char buf[4096];
+      ssize_t n;
+      while ((n = recv(fd, buf, sizeof(buf), 0)) > 0)
+        resp.append(buf, n);
+      // n < 0: timeout; 0: el servidor cerró tras responder
+      ok = n == 0 && resp.compare(0, 12, "HTTP/1.1 200") == 0;
+      bytes += resp.size();
+    }
+  }
+  ::close(fd);
+  return ok;
+}
+
+static void runLevel(const char *path, int clients, double seconds, int timeoutMs)
+{
+  std::vector<clientStats> stats(clients);
+  std::vector<std::thread> threads;
+  std::atomic<bool> stop(false);
+  std::atomic<int> running(clients);
+  uint32_t acquisitions0 = acquisitions;
+
+  for (int c = 0; c < clients; c++)
+    threads.emplace_back([&, c]
+                         {
+      clientStats &s = stats[c];
+      while (!stop)
+      {
+        auto t0 = std::chrono::steady_clock::now();
+        bool ok = httpGet(path, timeoutMs, s.bytes);
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+        if (ok)
+          s.latencyUs.push_back((uint32_t)us);
+        else
+          s.failures++;
+      }
+      running--; });
+
+  // El servidor sigue en este hilo hasta que el último cliente termina su petición
+  auto t0 = std::chrono::steady_clock::now();
+  double elapsed = 0;
+  while (running > 0)
+  {
+    loop();
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    if (elapsed >= seconds)
+      stop = true;
+  }
+  for (auto &t : threads)
+    t.join();
+
+  std::vector<uint32_t> all;
+  uint32_t failures = 0;
+  uint64_t bytes = 0;
+  for (auto &s : stats)
+  {
+    all.insert(all.end(), s.latencyUs.begin(), s.latencyUs.end());
+    failures += s.failures;
+    bytes += s.bytes;
+  }
+  std::sort(all.begin(), all.end());
+  size_t n = all.size(), total = n + failures;
+  auto pct = [&](int p)
+  { return n ? all[std::min(n - 1, n * p / 100)] / 1000.0 : 0.0; };
+  printf("{\"path\":\"%s\",\"clients\":%d,\"requests\":%zu,\"failures\":%u,\"fail_rate\":%.3f,\"req_per_s\":%.1f,"
+         "\"p50_ms\":%.2f,\"p99_ms\":%.2f,\"max_ms\":%.2f,\"bytes_per_req\":%.0f,\"acquisitions\":%u}\n",
+         path, clients, total, failures, total ? (double)failures / total : 0.0, n / elapsed, pct(50), pct(99),
+         n ? all.back() / 1000.0 : 0.0, total ? (double)bytes / total : 0.0, acquisitions - acquisitions0);
+  fflush(stdout);
+}
+
+static std::vector<std::string> splitList(const char *s)
+{
+  std::vector<std::string> out;
+  std::string cur;
+  for (; *s; s++)
+  {
+    if (*s == ',')
+    {
+      if (!cur.empty())
+        out.push_back(cur);
+      cur.clear();
+    }
+    else
+      cur += *s;
+  }
+  if (!cur.empty())
+    out.push_back(cur);
+  return out;
+}
+
+int main(int argc, char **argv)
+{
+  const char *paths = "/,/battery-data,/modules,/balance-history";
+  const char *clientList = "1,2,4,8,16,32";
+  double seconds = 5;
+  int timeoutMs = 5000, modules = 8;
+  bool serve = false, verbose = false;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--paths") == 0 && i + 1 < argc)
+      paths = argv[++i];
+    else if (strcmp(argv[i], "--clients") == 0 && i + 1 < argc)
+      clientList = argv[++i];
+    else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+      seconds = atof(argv[++i]);
+    else if (strcmp(argv[i], "--timeout-ms") == 0 && i + 1 < argc)
+      timeoutMs = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--modules") == 0 && i + 1 < argc)
+      modules = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--interval-ms") == 0 && i + 1 < argc)
+      intervalMs = strtoul(argv[++i], nullptr, 10);
+    else if (strcmp(argv[i], "--backlog") == 0 && i + 1 < argc)
+      server.backlog = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc)
+      serverPort = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--serve") == 0)
+      serve = true;
+    else if (strcmp(argv[i], "-v") == 0)
+      verbose = true;
+    else
+    {
+      fprintf(stderr,
+              "usage: %s [--paths a,b] [--clients 1,2,4] [--seconds s] [--timeout-ms ms] [--modules N]\n"
+              "          [--interval-ms ms] [--backlog N] [--port P] [--serve] [-v]\n",
+              argv[0]);
+      return 2;
+    }
+  }
+  if (modules < 1 || modules > MAX_PYLON_BATTERIES_SUPPORTED)
+  {
+    fprintf(stderr, "--modules: 1-%d\n", MAX_PYLON_BATTERIES_SUPPORTED);
+    return 2;
+  }
+  if (verbose)
+    logBuffer.mirror = [](const char *line)
+    { fprintf(stderr, "%s\n", line); };
+
+  setup(modules);
+  if (!server.begin(serverPort))
+    return 1;
+  while (acquisitions == 0) // primera adquisición, como tras el arranque
+    loop();
+  fprintf(stderr, "web_load: http://localhost:%d/, %d modules, BMS at %d baud, acquisition every %lu ms\n",
+          serverPort, modules, BMS_UART_BAUD, intervalMs);
+
+  if (serve)
+  {
+    for (;;)
+      loop();
+  }
+  for (const std::string &path : splitList(paths))
+    for (const std::string &c : splitList(clientList))
+      runLevel(path.c_str(), atoi(c.c_str()), seconds, timeoutMs);
+  return 0;
+}
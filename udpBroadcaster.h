@@ -0,0 +1,68 @@
+#ifndef UDPBROADCASTER_H
+#define UDPBROADCASTER_H
+
+#include <WiFiUdp.h>
+
+#include "batteryStack.h"
+#include "logger.h"
+#include "udpSnapshot.h"
+
+// ================== Difusión multicast del snapshot ==================
+// Un envío por adquisición, sea cual sea el número de oyentes: el servidor
+// web no ve ninguna petición. Formato en udpSnapshot.h.
+
+#ifndef UDP_SNAPSHOT_TTL
+#define UDP_SNAPSHOT_TTL 1 // solo la red local
+#endif
+
+struct udpSnapshotBroadcaster
+{
+  WiFiUDP udp;
+  IPAddress group;
+  uint16_t port;
+  const batteryStack *stack = nullptr;
+  uint8_t cbor[UDP_SNAPSHOT_MAX_BYTES];
+  uint32_t seq = 0;
+  uint32_t sentGeneration = 0;
+  uint32_t datagrams = 0;
+  uint32_t failures = 0;
+
+  udpSnapshotBroadcaster(IPAddress g, uint16_t p = UDP_SNAPSHOT_PORT) : group(g), port(p) {}
+
+  void begin(const batteryStack &st)
+  {
+    stack = &st;
+    LOG_I(UDP, "Multicasting snapshots to %s:%u", group.toString().c_str(), port);
+  }
+
+  // Llamar en cada vuelta de loop(); solo trabaja cuando hay generación nueva
+  void loop()
+  {
+    if (!stack || stack->generation == 0 || stack->generation == sentGeneration)
+      return;
+    sentGeneration = stack->generation;
+    seq++;
+
+    uint8_t parts = udpSnapshotSend(*stack, seq, cbor, sizeof(cbor), [this](const uint8_t *header, const uint8_t *payload, size_t n)
+                                    {
+#ifdef ESP8266
+      bool ok = udp.beginPacketMulticast(group, port, WiFi.localIP(), UDP_SNAPSHOT_TTL);
+#else
+      bool ok = udp.beginPacket(group, port);
+#endif
+      ok = ok && udp.write(header, UDP_SNAPSHOT_HEADER) == UDP_SNAPSHOT_HEADER;
+      ok = ok && udp.write(payload, n) == n;
+      ok = ok && udp.endPacket();
+      if (ok)
+        datagrams++;
+      else
+        failures++; });
+    if (parts == 0)
+    {
+      failures++;
+      LOG_E(UDP, "Snapshot does not fit UDP_SNAPSHOT_MAX_BYTES");
+    }
+  }
+};
+
+#endif // UDPBROADCASTER_H
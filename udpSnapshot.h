@@ -0,0 +1,73 @@
+#ifndef UDPSNAPSHOT_H
+#define UDPSNAPSHOT_H
+
+#include "batteryStack.h"
+#include "crc32.h"
+#include "telemetryCodec.h"
+
+// ================== Snapshot CBOR en datagramas UDP ==================
+//
+// Cada adquisición nueva se codifica una vez en CBOR (el mismo esquema que
+// /snapshot con Accept: application/cbor, sin histórico) y se envía por
+// multicast. Cabecera fija de 20 bytes, enteros en orden de red:
+//
+//   0  "PYLS"                      8  secuencia (uint32, +1 por snapshot)
+//   4  versión (1)                12  generación del snapshot (uint32)
+//   5  parte (0-based)            16  CRC-32 de la carga de este datagrama
+//   6  partes                     20  carga: trozo del CBOR
+//   7  flags (0)
+//
+// Hasta unos 8 módulos el CBOR cabe en un solo datagrama de MTU Ethernet
+// (1472 bytes de carga UDP). Pilas mayores se parten en varias partes con la
+// misma secuencia en lugar de depender de la fragmentación IP, que lwIP no
+// siempre hace; el receptor concatena las partes en orden. Un hueco en la
+// secuencia indica snapshots perdidos.
+
+#define UDP_SNAPSHOT_VERSION 1
+#define UDP_SNAPSHOT_HEADER 20
+#define UDP_SNAPSHOT_DATAGRAM 1472                 // carga UDP máxima sin fragmentar (MTU 1500)
+#define UDP_SNAPSHOT_MAX_BYTES 3072                // CBOR de 16 módulos x 16 celdas: ~2.6 KB
+#ifndef UDP_SNAPSHOT_PORT
+#define UDP_SNAPSHOT_PORT 42424
+#endif
+
+static void _udpPut32(uint8_t *p, uint32_t v)
+{
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+// Codifica el snapshot en 'cbor' y llama a send(cabecera, carga, len) por
+// cada parte (sin copiar la carga a otro buffer). Devuelve las partes
+// enviadas, o 0 si el CBOR no cabe en 'cap'.
+template <typename Send>
+static uint8_t udpSnapshotSend(const batteryStack &st, uint32_t seq, uint8_t *cbor, size_t cap, Send send)
+{
+  bufferSink sink(cbor, cap);
+  writeSnapshotCbor(sink, st, 0, st.acquiredAt);
+  if (sink.overflow)
+    return 0;
+
+  const size_t chunk = UDP_SNAPSHOT_DATAGRAM - UDP_SNAPSHOT_HEADER;
+  uint8_t parts = (sink.len + chunk - 1) / chunk;
+  uint8_t header[UDP_SNAPSHOT_HEADER];
+  for (uint8_t part = 0; part < parts; part++)
+  {
+    size_t off = part * chunk;
+    size_t n = sink.len - off < chunk ? sink.len - off : chunk;
+    memcpy(header, "PYLS", 4);
+    header[4] = UDP_SNAPSHOT_VERSION;
+    header[5] = part;
+    header[6] = parts;
+    header[7] = 0;
+    _udpPut32(header + 8, seq);
+    _udpPut32(header + 12, st.generation);
+    _udpPut32(header + 16, crc32Update(0, cbor + off, n));
+    send(header, cbor + off, n);
+  }
+  return parts;
+}
+
+#endif // UDPSNAPSHOT_H
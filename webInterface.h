@@ -10,1189 +10,343 @@
 
 #include "batteryStack.h"
 #include "PylontechMonitoring.h"
+#include "bmsScheduler.h"
+#include "bmsUart.h"
+#include "dashboardPage.h"
+#include "logger.h"
+#include "telemetryCodec.h"
+#include "metricsExporter.h"
+#include "timeService.h"
+#include "perfProfiler.h"
 
-#ifndef DBG_WEB
-#define DBG_WEB 0
-#endif
-#ifndef DBG_BMS
-#define DBG_BMS 0
-#endif
-
-// En tu .ino:  #define Serial2 Serial
-extern HardwareSerial Serial2;
+// ================== Estado UI ==================
+// Último comando de /cmd: la cola de la consola va llenando la salida y
+// /console la devuelve con su estado
+static String lastCommandOutput;
+static uint32_t lastCommandId = 0; // 0: ninguno
+static bool lastCommandDone = true;
+static bool lastCommandOk = false;
+static uint32_t _lastCommandSeq = 0; // la salida de un /cmd anterior aún en cola se descarta
 
-// ================== Consola BMS ==================
-static inline bool _isBmsPrompt(const String &s)
+// Añade s a out escapado como cadena JSON (sin comillas)
+static void _jsonEscapeAppend(String &out, const char *s)
 {
-  return s.endsWith("pylon>") || s.endsWith("pylon_debug>");
+  for (; *s; s++)
+  {
+    char c = *s;
+    if (c == '"' || c == '\\')
+    {
+      out += '\\';
+      out += c;
+    }
+    else if ((uint8_t)c < 0x20)
+    {
+      char esc[8];
+      snprintf(esc, sizeof(esc), "\\u%04x", (uint8_t)c);
+      out += esc;
+    }
+    else
+    {
+      out += c;
+    }
+  }
 }
 
-static bool _bmsWaitPrompt(uint32_t timeout_ms, String *rawOut = nullptr)
+// ================== Caché condicional (ETag / 304) ==================
+// El ETag es la generación del snapshot: si nada se ha adquirido desde la
+// última petición, se responde 304 sin serializar nada. _bootTag evita que
+// una generación de antes de un reinicio coincida con la actual.
+static uint32_t _bootTag = 0;
+
+static bool _notModified(WebServer &server, char kind, uint32_t generation, uint32_t generation2 = 0)
 {
-  unsigned long t0 = millis();
-  String acc;
-  while (millis() - t0 < timeout_ms)
+  char etag[40];
+  snprintf(etag, sizeof(etag), "W/\"%08x-%c%u.%u\"", (unsigned)_bootTag, kind, (unsigned)generation, (unsigned)generation2);
+  server.sendHeader("ETag", etag);
+  server.sendHeader("Cache-Control", "no-cache");
+  if (server.header("If-None-Match") == etag)
   {
-    while (Serial2.available())
-    {
-      char c = (char)Serial2.read();
-      acc += c;
-      if (_isBmsPrompt(acc))
-      {
-        if (rawOut)
-          *rawOut = acc;
-        return true;
-      }
-    }
-    delay(2);
-    yield();
+    server.send(304);
+    return true;
   }
-  if (rawOut)
-    *rawOut = acc;
   return false;
 }
 
-// Cambia a true si tu firmware exige CRLF
-#define USE_CRLF false
+// Negociación de formato: CBOR si el cliente lo pide en Accept, JSON en otro caso.
+// El ETag distingue ambos ('S'/'s', 'H'/'h') y Vary evita que un proxy los mezcle.
+static bool _wantsCbor(WebServer &server)
+{
+  server.sendHeader("Vary", "Accept");
+  return server.header("Accept").indexOf("application/cbor") >= 0;
+}
 
-String _bmsSendCmd(const String &cmd, uint32_t timeout_ms = 3000)
+// ================== Respuestas por trozos (chunked) ==================
+// Acumula en un buffer fijo y lo envía con sendContent() al llenarse, así una
+// respuesta grande no necesita un String del tamaño completo en el heap.
+struct _chunkWriter
 {
-  // “Despierta” y limpia
-  while (Serial2.available())
-    Serial2.read();
-  Serial2.print("\r");
-  _bmsWaitPrompt(700);
-  while (Serial2.available())
-    Serial2.read();
+  WebServer &server;
+  char buf[512];
+  size_t len = 0;
 
-  // Envía
-#if USE_CRLF
-  Serial2.print(cmd);
-  Serial2.print("\r\n");
-#else
-  Serial2.print(cmd);
-  Serial2.print("\r");
-#endif
+  _chunkWriter(WebServer &srv, int code, const char *contentType) : server(srv)
+  {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(code, contentType, "");
+  }
 
-  // Lee hasta prompt / timeout
-  String out;
-  unsigned long t0 = millis();
-  while (millis() - t0 < timeout_ms)
+  void write(const char *s, size_t n)
   {
-    while (Serial2.available())
+    while (n > 0)
     {
-      char c = (char)Serial2.read();
-      out += c;
-      if (_isBmsPrompt(out))
-        return out;
+      size_t room = sizeof(buf) - len;
+      size_t take = n < room ? n : room;
+      memcpy(buf + len, s, take);
+      len += take;
+      s += take;
+      n -= take;
+      if (len == sizeof(buf))
+        flush();
     }
-    delay(2);
-    yield();
   }
-  return out;
-}
-
-// ================== Estado UI ==================
-static String lastCommandOutput;
 
-// -------- helper: extraer 4 enteros en orden (tolerante a espacios) ----
-static bool scan4ints(const String &line, long &a, long &b, long &c, long &d)
-{
-  const char *s = line.c_str();
-  long vals[4];
-  int n = 0;
-  while (*s && n < 4)
+  void flush()
   {
-    while (*s && !((*s == '-') || (*s >= '0' && *s <= '9')))
-      s++; // salta no-num
-    if (!*s)
-      break;
-    char *end;
-    long v = strtol(s, &end, 10);
-    vals[n++] = v;
-    s = end;
+    if (len)
+      server.sendContent(buf, len);
+    len = 0;
   }
-  if (n == 4)
+
+  // Envía lo pendiente y el trozo final vacío
+  void end()
   {
-    a = vals[0];
-    b = vals[1];
-    c = vals[2];
-    d = vals[3];
-    return true;
+    flush();
+    server.sendContent("");
   }
-  return false;
-}
+};
 
 // ================== Interfaz Web ==================
 void setupWebInterface(WebServer &server, batteryStack *batteryData)
 {
 
-  // ---------- UI principal (visual) ----------
-  server.on("/", [&server]()
-            {
-    String html;
-    html.reserve(14*1024);
-    html  = F("<!DOCTYPE html><html lang='es'><head><meta charset='utf-8'>");
-    html += F("<meta name='viewport' content='width=device-width, initial-scale=1'>");
-    html += F("<title>Pylontech Monitoring </title>");
-    html += F("<style>"
-      "body{margin:0;font-family:Inter,system-ui,-apple-system,Segoe UI,Roboto,Ubuntu,Helvetica,Arial,sans-serif;background:#f5f7fb;color:#0f172a}"
-      "nav{background:#0ea5e9;color:#fff;padding:14px 16px;display:flex;justify-content:space-between;align-items:center}"
-      "nav .brand{font-weight:800;letter-spacing:.2px}"
-      "main{max-width:1024px;margin:18px auto;padding:0 16px}"
-      ".grid{display:grid;gap:16px;grid-template-columns:repeat(auto-fit,minmax(260px,1fr))}"
-      ".card{background:#fff;border:1px solid #e2e8f0;border-radius:14px;box-shadow:0 6px 18px rgba(2,6,23,.06);padding:16px}"
-      ".title{font-size:15px;font-weight:700;color:#334155;margin:0 0 8px}"
-      ".big{font-size:28px;font-weight:800;margin:6px 0 2px}"
-      ".muted{color:#64748b;font-size:13px}"
-      ".socwrap{height:16px;background:#e2e8f0;border-radius:10px;overflow:hidden}"
-      ".socbar{height:100%;width:0;background:linear-gradient(90deg,#22c55e,#10b981);transition:width .6s ease}"
-      ".terminal{background:#0b1220;color:#e2e8f0;border-radius:12px;padding:12px;font-family:ui-monospace,Consolas,Monaco,monospace;white-space:pre;min-height:120px;overflow:auto;overflow-x:auto;max-width:100%}"
-      ".terminal .header{color:#60a5fa;font-weight:bold;border-bottom:1px solid #1e293b;padding-bottom:4px;margin-bottom:8px;white-space:pre}"
-      ".terminal .data-row{white-space:pre}"
-      ".terminal .voltage{color:#10b981}"
-      ".terminal .current{color:#f59e0b}"
-      ".terminal .temperature{color:#ef4444}"
-      ".terminal .soc{color:#8b5cf6}"
-      ".terminal .state-normal{color:#10b981}"
-      ".terminal .state-idle{color:#6b7280}"
-      ".terminal .state-absent{color:#6b7280;opacity:0.6}"
-      ".terminal .number{color:#06b6d4}"
-      ".terminal .separator{color:#475569}"
-      ".health-normal{color:#10b981}"
-      ".health-warning{color:#f59e0b}"
-      ".health-critical{color:#ef4444}"
-      "#healthCard.normal{border-left:4px solid #10b981}"
-      "#healthCard.warning{border-left:4px solid #f59e0b}"
-      "#healthCard.critical{border-left:4px solid #ef4444}"
-      ".info-icon{display:inline-block;margin-left:5px;cursor:help;color:#6b7280;font-size:14px;position:relative;user-select:none}"
-      ".info-icon:hover{color:#3b82f6}"
-      ".tooltip{display:none;position:absolute;top:25px;left:50%;transform:translateX(-50%);background:#1f2937;color:#e5e7eb;padding:8px 12px;border-radius:6px;font-size:12px;white-space:nowrap;z-index:1000;box-shadow:0 4px 6px rgba(0,0,0,0.3);max-width:280px;white-space:normal;text-align:left;line-height:1.3;pointer-events:none}"
-      ".tooltip::before{content:'';position:absolute;top:-5px;left:50%;transform:translateX(-50%);width:0;height:0;border-left:5px solid transparent;border-right:5px solid transparent;border-bottom:5px solid #1f2937}"
-      ".info-icon:hover .tooltip{display:block}"
-      "@media (max-width: 768px){"
-        ".terminal{font-size:11px;padding:8px;line-height:1.2}"
-        "main{padding:0 8px;margin:12px auto}"
-        ".card{padding:12px}"
-        ".row{gap:8px}"
-        ".grid{grid-template-columns:1fr}"
-        "button.quick-cmd{padding:4px 8px;font-size:11px;margin:1px}"
-        "input[type=text]{min-width:150px;padding:8px 10px;font-size:14px}"
-        ".tooltip{max-width:250px;left:-50px;transform:none;font-size:11px}"
-        "button{padding:8px 12px;font-size:13px}"
-      "}"
-      ".row{display:flex;gap:12px;flex-wrap:wrap;align-items:center}"
-      "input[type=text]{flex:1;min-width:220px;padding:10px 12px;border:1px solid #cbd5e1;border-radius:10px;font-size:14px}"
-      "button{padding:10px 14px;border:0;border-radius:10px;font-weight:700;cursor:pointer;background:#0ea5e9;color:#fff}"
-      "button.secondary{background:#f1f5f9;color:#0f172a}"
-      "button.danger{background:#ef4444;color:#fff}"
-      "button.danger:hover{background:#dc2626}"
-      "button.quick-cmd{padding:6px 12px;margin:2px;background:#4f46e5;color:#fff;font-size:13px;font-weight:600}"
-      "button.quick-cmd:hover{background:#6366f1}"
-      "button.module{padding:8px 12px;margin:4px;border-radius:8px;font-size:13px;font-weight:600}"
-      "button.module.active{background:#10b981;color:#fff}"
-      "button.module.inactive{background:#e2e8f0;color:#64748b;cursor:not-allowed}"
-      "button.utility-btn{padding:8px 12px;margin:2px;background:#10b981;color:#fff;border:0;border-radius:6px;font-size:12px;font-weight:600;cursor:pointer}"
-      "button.utility-btn:hover{background:#059669}"
-      "button.utility-btn.danger{background:#ef4444}"
-      "button.utility-btn.danger:hover{background:#dc2626}"
-      ".module-selector{margin-bottom:16px;padding:16px;background:#fff;border:1px solid #e2e8f0;border-radius:12px}"
-      ".module-title{font-weight:700;margin-bottom:12px;color:#334155}"
-      "a.link{color:#0ea5e9;text-decoration:none;font-weight:700}"
-      ".foot{margin:22px 0;color:#94a3b8;font-size:12px}"
-      "#hidden{display:none}"
-    "</style></head><body>");
-
-    html += F("<nav><div class='brand'>Pylontech Monitoring</div>"
-              "<div><a class='link' href='/battery-data'>/battery-data</a></div></nav>");
-    
-    html += F("<main>");
-    
-    // Selector de módulos de batería
-    html += F("<div class='module-selector'>"
-              "<div class='module-title'>Seleccionar Batería:</div>"
-              "<div id='moduleButtons'>"
-              "<button class='module active' onclick='selectModule(\"system\")'>Sistema</button>"
-              "<button class='module' onclick='selectModule(1)'>Bat 1</button>"
-              "<button class='module inactive' onclick='selectModule(2)'>Bat 2</button>"
-              "<button class='module inactive' onclick='selectModule(3)'>Bat 3</button>"
-              "<button class='module inactive' onclick='selectModule(4)'>Bat 4</button>"
-              "</div></div>");
-    
-    html += F("<div class='grid'>");
-
-    // Título del módulo actual
-    html += F("<div class='card' style='grid-column:1/-1;text-align:center;background:#f8fafc'>"
-              "<div class='title' id='moduleTitle'>Datos del Sistema General</div></div>");
-
-    html += F("<div class='card'><div class='title'>Estado de carga</div>"
-              "<div class='big'><span id='socv'>--</span>%</div>"
-              "<div class='socwrap'><div id='socbar' class='socbar'></div></div>"
-              "<div class='muted' style='margin-top:8px'>Actualizado cada 3 s</div></div>");
-
-    html += F("<div class='card'><div class='title'>Voltaje</div>"
-              "<div class='big'><span id='volt'>--</span> V</div>"
-              "<div class='muted' id='voltDesc'>Sistema total</div></div>");
-
-    html += F("<div class='card'><div class='title'>Corriente</div>"
-              "<div class='big'><span id='curr'>--</span> A</div>"
-              "<div class='muted' id='currDesc'>Sistema total</div></div>");
-
-    html += F("<div class='card'><div class='title'>Potencia DC</div>"
-              "<div class='big'><span id='powr'>--</span> W</div>"
-              "<div class='muted'>V × I</div></div>");
-
-    html += F("<div class='card'><div class='title'>Temperatura</div>"
-              "<div class='big'><span id='temp'>--</span> °C</div>"
-              "<div class='muted' id='tempDesc'>Promedio sistema</div></div>");
-
-    html += F("<div class='card' id='healthCard'><div class='title'>Salud Celdas "
-              "<span class='info-icon' id='healthInfo'>ⓘ"
-              "<div class='tooltip' id='healthTooltip'>Cargando información...</div>"
-              "</span>"
-              "</div>"
-              "<div class='big'><span id='balanceStatus'>--</span></div>"
-              "<div class='muted' id='balanceDetails'>Analizando...</div>"
-              "<div style='font-size:10px;color:#6b7280;margin-top:8px;line-height:1.2'>"
-              "Normal: ≤40mV | Advertencia: 40-60mV | Crítico: >60mV"
-              "</div></div>");
-
-    html += F("</div>"); // grid
-
-    // Balance History Section
-    html += F("<div class='card' style='margin-top:18px'>"
-              "<div class='title'>Histórico de Balance Diario "
-              "<button class='secondary' style='float:right;padding:4px 8px;font-size:12px' onclick='toggleHistory()'>Mostrar/Ocultar</button>"
-              "</div>"
-              "<div id='historySection' style='display:none'>"
-              "<div class='row' style='margin-bottom:10px;display:flex;align-items:center;gap:10px'>"
-              "<select id='batteryFilter' style='padding:6px'>"
-              "<option value='all'>Todas las baterías</option>"
-              "</select>"
-              "<button onclick='refreshHistory()'>Actualizar</button>"
-              "<button class='secondary' onclick='exportHistory()'>Exportar CSV</button>"
-              "<button class='danger' onclick='clearHistory()'>Vaciar Historial</button>"
-              "</div>"
-              "<div style='max-height:300px;overflow-y:auto'>"
-              "<table id='historyTable' style='width:100%;border-collapse:collapse;font-size:12px'>"
-              "<thead style='background:#f8fafc;position:sticky;top:0'>"
-              "<tr><th style='padding:8px;border:1px solid #e2e8f0'>Hora</th>"
-              "<th style='padding:8px;border:1px solid #e2e8f0'>Batería</th>"
-              "<th style='padding:8px;border:1px solid #e2e8f0'>Balance (mV)</th>"
-              "<th style='padding:8px;border:1px solid #e2e8f0'>SOC (%)</th>"
-              "<th style='padding:8px;border:1px solid #e2e8f0'>Estado</th></tr>"
-              "</thead>"
-              "<tbody id='historyBody'>"
-              "<tr><td colspan='5' style='text-align:center;padding:20px;color:#6b7280'>Cargando histórico...</td></tr>"
-              "</tbody>"
-              "</table>"
-              "</div>"
-              "<div style='margin-top:10px;font-size:11px;color:#6b7280'>"
-              "Registros cada 15 minutos • Máximo 96 entradas (24 horas)"
-              "</div>"
-              "</div></div>");
-
-    // Terminal
-    html += F("<div class='card' style='margin-top:18px'>"
-              "<div class='title'>Terminal BMS <span id='scroll-hint' style='font-size:11px;color:#6b7280;display:none'>← Desliza horizontalmente →</span></div>"
-              "<div class='row' style='margin-bottom:10px'>"
-              "<button class='quick-cmd' onclick='quickCmd(\"pwr\")'>pwr</button>"
-              "<button class='quick-cmd' onclick='quickCmd(\"pwrsys\")'>pwrsys</button>"
-              "<button class='quick-cmd' id='batCmd' onclick='quickCmdBat()'>bat</button>"
-              "<button class='quick-cmd' onclick='quickCmd(\"help\")'>help</button>"
-              "</div>"
-              "<div class='row'>"
-              "<input id='cmd' type='text' placeholder='Ej: help, bat, pwrsys, pwr'>"
-              "<button onclick='sendCmd()'>Enviar</button>"
-              "<button class='secondary' onclick='clearConsole()'>Limpiar</button>"
-              "</div>"
-              "<div id='console' class='terminal'></div></div>");
-
-    // Utilidades y Debugs
-    html += F("<div class='card' style='margin-top:18px'>"
-              "<div class='title'>Utilidades y Debugs "
-              "<button class='secondary' style='float:right;padding:4px 8px;font-size:12px' onclick='toggleUtilities()'>Mostrar/Ocultar</button>"
-              "</div>"
-              "<div id='utilitiesSection' style='display:none'>"
-              "<div style='margin-bottom:15px'>"
-              "<h4 style='margin:0 0 8px 0;font-size:14px;color:#374151'>🔧 Sistema</h4>"
-              "<div style='display:flex;flex-wrap:wrap;gap:8px;margin-bottom:15px'>"
-              "<button class='utility-btn' onclick='openUtility(\"/restart\")'>🔄 Reiniciar ESP</button>"
-              "<button class='utility-btn' onclick='openUtility(\"/time-info\")'>🕒 Info Tiempo</button>"
-              "<button class='utility-btn' onclick='openUtility(\"/version-check\")'>📋 Versión</button>"
-              "</div>"
-              "<h4 style='margin:0 0 8px 0;font-size:14px;color:#374151'>🔍 Debugs</h4>"
-              "<div style='display:flex;flex-wrap:wrap;gap:8px;margin-bottom:15px'>"
-              "<button class='utility-btn' onclick='openUtility(\"/debug-batteries\")'>🔋 Debug Baterías</button>"
-              "<button class='utility-btn' onclick='openUtility(\"/debug-history\")'>📊 Debug Historial</button>"
-              "<button class='utility-btn' onclick='openUtility(\"/battery-data\")'>📈 Datos BMS</button>"
-              "</div>"
-              "<h4 style='margin:0 0 8px 0;font-size:14px;color:#374151'>⚡ Acciones</h4>"
-              "<div style='display:flex;flex-wrap:wrap;gap:8px'>"
-              "<button class='utility-btn' onclick='forceRecord()'>💾 Grabar Ahora</button>"
-              "<button class='utility-btn danger' onclick='confirmClearHistory()'>🗑️ Vaciar Historial</button>"
-              "<button class='utility-btn' onclick='openUtility(\"/balance-history\")'>📋 Ver JSON Historial</button>"
-              "</div>"
-              "</div>"
-              "<div id='utilityResult' style='margin-top:15px;padding:10px;background:#f8fafc;border:1px solid #e2e8f0;border-radius:8px;display:none'>"
-              "<pre id='utilityContent' style='margin:0;font-size:12px;white-space:pre-wrap'></pre>"
-              "</div>"
-              "</div></div>");
-
-    // Bloque oculto con la última respuesta para que el JS la recoja
-    html += F("<div id='hidden'><h3>Respuesta</h3><pre>");
-    html += lastCommandOutput;
-    html += F("</pre></div>");
-
-    html += F("<div class='foot'>DEV BY: https://github.com/h-low-high/pylontech-monitoring</div>");
-
-    // JS
-    html += F("<script>"
-      "let currentModule='system';"
-      "function fmt(n,dec){if(isNaN(n))return'--';return Number(n).toFixed(dec)}"
-      "function selectModule(module){"
-        "currentModule=module;"
-        "document.querySelectorAll('.module').forEach(b=>b.classList.remove('active'));"
-        "event.target.classList.add('active');"
-        "updateBatButton();"
-        "if(module==='system'){"
-          "document.getElementById('moduleTitle').textContent='Datos del Sistema General';"
-          "document.getElementById('voltDesc').textContent='Sistema total';"
-          "document.getElementById('currDesc').textContent='Sistema total';"
-          "document.getElementById('tempDesc').textContent='Promedio sistema';"
-        "}else{"
-          "document.getElementById('moduleTitle').textContent='Datos de Batería '+module;"
-          "document.getElementById('voltDesc').textContent='Batería individual';"
-          "document.getElementById('currDesc').textContent='Batería individual';"
-          "document.getElementById('tempDesc').textContent='Batería individual';"
-        "}"
-        "pull();"
-      "}"
-      "function paint(d){"
-        "document.getElementById('socv').textContent=d.soc;"
-        "document.getElementById('socbar').style.width=d.soc+'%';"
-        "document.getElementById('volt').textContent=fmt(d.voltage,3);"
-        "document.getElementById('curr').textContent=fmt(d.current,3);"
-        "document.getElementById('powr').textContent=fmt(d.power,1);"
-        "document.getElementById('temp').textContent=fmt(d.temperature,1);"
-        "if(d.balanceStatus&&d.balanceStatus!=='N/A'){"
-          "const statusEl=document.getElementById('balanceStatus');"
-          "const detailsEl=document.getElementById('balanceDetails');"
-          "const cardEl=document.getElementById('healthCard');"
-          "const tooltipEl=document.getElementById('healthTooltip');"
-          "statusEl.textContent=d.balanceStatus;"
-          "detailsEl.textContent=d.balanceMessage;"
-          "cardEl.className='card';"
-          "statusEl.className='';"
-          "if(d.balanceStatus==='Normal'){cardEl.classList.add('normal');statusEl.classList.add('health-normal');}"
-          "else if(d.balanceStatus==='Advertencia'){cardEl.classList.add('warning');statusEl.classList.add('health-warning');}"
-          "else if(d.balanceStatus==='Crítico'){cardEl.classList.add('critical');statusEl.classList.add('health-critical');}"
-          "let tooltipText='Balance de '+d.cellCount+' celdas:\\n';"
-          "tooltipText+='• Voltaje máximo: '+fmt(d.maxCellVoltage,3)+'V';"
-          "if(d.maxCellId)tooltipText+=' (celda '+d.maxCellId+')';"
-          "tooltipText+='\\n• Voltaje mínimo: '+fmt(d.minCellVoltage,3)+'V';"
-          "if(d.minCellId)tooltipText+=' (celda '+d.minCellId+')';"
-          "tooltipText+='\\n• Diferencia: '+fmt(d.imbalanceMv,1)+'mV';"
-          "if(d.imbalanceMv<=40)tooltipText+='\\n• Estado: Excelente balance';"
-          "else if(d.imbalanceMv<=60)tooltipText+='\\n• Estado: Revisar pronto';"
-          "else tooltipText+='\\n• Estado: Requiere atención inmediata';"
-          "tooltipEl.innerHTML=tooltipText.replace(/\\n/g,'<br>');"
-        "}"
-        "else{"
-          "document.getElementById('balanceStatus').textContent='N/A';"
-          "document.getElementById('balanceDetails').textContent='Sin datos de balance';"
-          "document.getElementById('healthCard').className='card';"
-          "document.getElementById('healthTooltip').innerHTML='No hay información de balance disponible para esta vista.';"
-        "}"
-      "}"
-      "async function pull(){"
-        "try{"
-          "const endpoint=currentModule==='system'?'/battery-data':'/battery-data?module='+currentModule;"
-          "const r=await fetch(endpoint,{cache:'no-store'});"
-          "if(!r.ok)return;const d=await r.json();paint(d);"
-        "}catch(e){}"
-      "}"
-      "async function updateModuleButtons(){"
-        "try{"
-          "const r=await fetch('/modules',{cache:'no-store'});"
-          "if(!r.ok)return;const modules=await r.json();"
-          "document.querySelectorAll('.module').forEach((btn,idx)=>{"
-            "if(idx===0)return;" // Skip "Sistema" button
-            "const moduleNum=idx;"
-            "if(modules.includes(moduleNum)){"
-              "btn.classList.remove('inactive');"
-              "btn.disabled=false;"
-            "}else{"
-              "btn.classList.add('inactive');"
-              "btn.disabled=true;"
-            "}"
-          "});"
-        "}catch(e){}"
-      "}"
-      "async function sendCmd(){"
-        "const c=document.getElementById('cmd').value||''; if(!c)return;"
-        "try{await fetch('/cmd?q='+encodeURIComponent(c)); setTimeout(loadConsole,250);}catch(e){}"
-      "}"
-      "function clearConsole(){document.getElementById('console').textContent='';}"
-      "function formatTerminalOutput(text){"
-        "if(!text)return '';"
-        "let lines=text.split('\\n');"
-        "let formatted='';"
-        "let inDataSection=false;"
-        "for(let i=0;i<lines.length;i++){"
-          "let line=lines[i];"
-          "if(line.includes('Battery') && line.includes('Volt') && line.includes('Curr')){"
-            "inDataSection=true;"
-            "formatted+='<div class=\"header\">'+line+'</div>';"
-          "}else if(line.includes('Power') && line.includes('Volt') && line.includes('Curr')){"
-            "inDataSection=true;"
-            "formatted+='<div class=\"header\">'+line+'</div>';"
-          "}else if(inDataSection && /^\\d/.test(line)){"
-            "let coloredLine=line;"
-            "coloredLine=coloredLine.replace(/^(\\d+)/,'<span class=\"number\">$1</span>');"
-            "coloredLine=coloredLine.replace(/(\\s)(\\d{4})(\\s)/g,'$1<span class=\"voltage\">$2</span>$3');"
-            "coloredLine=coloredLine.replace(/(\\s)(-?\\d+)(\\s)/g,function(match,p1,p2,p3,offset){"
-              "if(coloredLine.indexOf('<span class=\"voltage\">')>-1 && offset>coloredLine.indexOf('<span class=\"voltage\">')){"
-                "if(p2.length==5) return p1+'<span class=\"temperature\">'+p2+'</span>'+p3;"
-                "if(p2=='0'||p2.startsWith('-')) return p1+'<span class=\"current\">'+p2+'</span>'+p3;"
-              "}"
-              "return match;"
-            "});"
-            "coloredLine=coloredLine.replace(/(\\d+%)/g,'<span class=\"soc\">$1</span>');"
-            "coloredLine=coloredLine.replace(/\\bNormal\\b/g,'<span class=\"state-normal\">Normal</span>');"
-            "coloredLine=coloredLine.replace(/\\bIdle\\b/g,'<span class=\"state-idle\">Idle</span>');"
-            "coloredLine=coloredLine.replace(/\\bAbsent\\b/g,'<span class=\"state-absent\">Absent</span>');"
-            "formatted+='<div class=\"data-row\">'+coloredLine+'</div>';"
-          "}else{"
-            "if(line.trim()=='')inDataSection=false;"
-            "formatted+='<div>'+line+'</div>';"
-          "}"
-        "}"
-        "return formatted;"
-      "}"
-      "async function loadConsole(){"
-        "try{const r=await fetch('/',{cache:'no-store'}); const t=await r.text();"
-            "const m=t.match(/<h3>Respuesta<\\/h3><pre>([\\s\\S]*?)<\\/pre>/);"
-            "const rawText=m?m[1].replace(/&lt;/g,'<').replace(/&gt;/g,'>'):'';"
-            "document.getElementById('console').innerHTML=formatTerminalOutput(rawText);"
-        "}catch(e){}"
-      "}"
-      "function quickCmd(cmd){"
-        "document.getElementById('cmd').value=cmd; sendCmd();"
-      "}"
-      "function quickCmdBat(){"
-        "const cmd = currentModule==='system' ? 'bat' : 'bat '+currentModule;"
-        "document.getElementById('cmd').value=cmd; sendCmd();"
-      "}"
-      "function updateBatButton(){"
-        "const btn=document.getElementById('batCmd');"
-        "btn.textContent = currentModule==='system' ? 'bat' : 'bat '+currentModule;"
-      "}"
-      "function checkMobile(){"
-        "const isMobile = window.innerWidth <= 768;"
-        "const hint = document.getElementById('scroll-hint');"
-        "if(isMobile && hint) hint.style.display = 'inline';"
-      "}"
-      "pull(); loadConsole(); updateModuleButtons(); updateBatButton(); checkMobile(); setInterval(pull,3000); setInterval(updateModuleButtons,10000);"
-      "window.addEventListener('resize', checkMobile);"
-      "document.getElementById('cmd').addEventListener('keydown',e=>{if(e.key==='Enter')sendCmd();});"
-      "let tooltipVisible = false;"
-      "document.getElementById('healthInfo').addEventListener('click', function(e){"
-        "e.preventDefault();"
-        "const tooltip = document.getElementById('healthTooltip');"
-        "tooltipVisible = !tooltipVisible;"
-        "tooltip.style.display = tooltipVisible ? 'block' : 'none';"
-        "if(tooltipVisible) setTimeout(() => {tooltipVisible = false; tooltip.style.display = 'none';}, 3000);"
-      "});"
-      
-      // Balance History Functions
-      "function toggleHistory(){"
-        "const section = document.getElementById('historySection');"
-        "if(section.style.display === 'none'){"
-          "section.style.display = 'block';"
-          "refreshHistory();"
-        "}else{"
-          "section.style.display = 'none';"
-        "}"
-      "}"
-      "async function refreshHistory(){"
-        "try{"
-          "const r = await fetch('/balance-history', {cache: 'no-store'});"
-          "if(!r.ok) return;"
-          "const data = await r.json();"
-          "displayHistory(data);"
-          "populateBatteryFilter(data);"
-        "}catch(e){console.error('Error loading history:', e);}"
-      "}"
-      "function displayHistory(data){"
-        "const tbody = document.getElementById('historyBody');"
-        "const filter = document.getElementById('batteryFilter').value;"
-        "tbody.innerHTML = '';"
-        "if(!data.data || data.data.length === 0){"
-          "tbody.innerHTML = '<tr><td colspan=\"5\" style=\"text-align:center;padding:20px;color:#6b7280\">No hay datos disponibles</td></tr>';"
-          "return;"
-        "}"
-        "const filteredData = filter === 'all' ? data.data : data.data.filter(d => d.batteryId == filter);"
-        "filteredData.slice(-48).reverse().forEach(entry => {"
-          "const date = new Date(entry.timestamp);"
-          "const time = date.toLocaleTimeString('es-ES', {hour: '2-digit', minute: '2-digit'});"
-          "const status = entry.balanceMv <= 40 ? 'Normal' : entry.balanceMv <= 60 ? 'Advertencia' : 'Crítico';"
-          "const statusClass = entry.balanceMv <= 40 ? 'health-normal' : entry.balanceMv <= 60 ? 'health-warning' : 'health-critical';"
-          "tbody.innerHTML += '<tr>' +"
-            "'<td style=\"padding:6px;border:1px solid #e2e8f0\">' + time + '</td>' +"
-            "'<td style=\"padding:6px;border:1px solid #e2e8f0\">' + entry.batteryId + '</td>' +"
-            "'<td style=\"padding:6px;border:1px solid #e2e8f0\">' + entry.balanceMv + '</td>' +"
-            "'<td style=\"padding:6px;border:1px solid #e2e8f0\">' + entry.socPercent + '%</td>' +"
-            "'<td style=\"padding:6px;border:1px solid #e2e8f0\" class=\"' + statusClass + '\">' + status + '</td>' +"
-          "'</tr>';"
-        "});"
-      "}"
-      "function populateBatteryFilter(data){"
-        "const select = document.getElementById('batteryFilter');"
-        "const currentValue = select.value;"
-        "const batteries = [...new Set(data.data.map(d => d.batteryId))].sort((a,b) => a-b);"
-        "select.innerHTML = '<option value=\"all\">Todas las baterías</option>';"
-        "batteries.forEach(id => {"
-          "select.innerHTML += '<option value=\"' + id + '\">Batería ' + id + '</option>';"
-        "});"
-        "select.value = currentValue;"
-        "select.onchange = () => refreshHistory();"
-      "}"
-      "function exportHistory(){"
-        "fetch('/balance-history').then(r => r.json()).then(data => {"
-          "let csv = 'Timestamp,Battery ID,Balance (mV),SOC (%),Status\\n';"
-          "data.data.forEach(entry => {"
-            "const date = new Date(entry.timestamp);"
-            "const status = entry.balanceMv <= 40 ? 'Normal' : entry.balanceMv <= 60 ? 'Warning' : 'Critical';"
-            "csv += date.toISOString() + ',' + entry.batteryId + ',' + entry.balanceMv + ',' + entry.socPercent + ',' + status + '\\n';"
-          "});"
-          "const blob = new Blob([csv], {type: 'text/csv'});"
-          "const url = URL.createObjectURL(blob);"
-          "const a = document.createElement('a');"
-          "a.href = url;"
-          "a.download = 'balance_history_' + new Date().toISOString().split('T')[0] + '.csv';"
-          "a.click();"
-          "URL.revokeObjectURL(url);"
-        "});"
-      "}"
-      "function clearHistory(){"
-        "if(confirm('¿Estás seguro de que quieres vaciar todo el historial?\\n\\nEsta acción NO se puede deshacer.')){"
-          "if(confirm('CONFIRMACIÓN FINAL: Se eliminarán TODOS los datos históricos permanentemente.')){"
-            "fetch('/clear-history', {method: 'POST'})"
-            ".then(response => {"
-              "if(response.ok){"
-                "alert('Historial vaciado correctamente');"
-                "refreshHistory();"
-              "}else{"
-                "alert('Error al vaciar el historial');"
-              "}"
-            "})"
-            ".catch(error => {"
-              "alert('Error de conexión: ' + error);"
-            "});"
-          "}"
-        "}"
-      "}"
-      "function toggleUtilities(){"
-        "const section = document.getElementById('utilitiesSection');"
-        "section.style.display = section.style.display === 'none' ? 'block' : 'none';"
-      "}"
-      "function openUtility(endpoint){"
-        "const resultDiv = document.getElementById('utilityResult');"
-        "const contentPre = document.getElementById('utilityContent');"
-        "resultDiv.style.display = 'block';"
-        "contentPre.textContent = 'Cargando...';"
-        "fetch(endpoint)"
-        ".then(response => response.text())"
-        ".then(data => {"
-          "try {"
-            "const jsonData = JSON.parse(data);"
-            "contentPre.textContent = JSON.stringify(jsonData, null, 2);"
-          "} catch(e) {"
-            "contentPre.textContent = data;"
-          "}"
-        "})"
-        ".catch(error => {"
-          "contentPre.textContent = 'Error: ' + error;"
-        "});"
-      "}"
-      "function forceRecord(){"
-        "fetch('/record-now', {method: 'POST'})"
-        ".then(response => response.text())"
-        ".then(data => {"
-          "alert('Grabación forzada: ' + data);"
-          "refreshHistory();"
-        "})"
-        ".catch(error => {"
-          "alert('Error: ' + error);"
-        "});"
-      "}"
-      "function confirmClearHistory(){"
-        "if(confirm('¿Estás seguro de que quieres vaciar todo el historial?\\n\\nEsta acción NO se puede deshacer.')){"
-          "if(confirm('CONFIRMACIÓN FINAL: Se eliminarán TODOS los datos históricos permanentemente.')){"
-            "fetch('/clear-history', {method: 'POST'})"
-            ".then(response => {"
-              "if(response.ok){"
-                "alert('Historial vaciado correctamente');"
-                "refreshHistory();"
-              "}else{"
-                "alert('Error al vaciar el historial');"
-              "}"
-            "})"
-            ".catch(error => {"
-              "alert('Error de conexión: ' + error);"
-            "});"
-          "}"
-        "}"
-      "}"
-    "</script>");
+#ifdef ESP8266
+  _bootTag = ESP.random();
+#else
+  _bootTag = esp_random();
+#endif
 
-    html += F("</main></body></html>");
-    server.send(200, "text/html", html); });
+  // Cabeceras de petición que los handlers necesitan leer
+  static const char *requestHeaders[] = {"If-None-Match", "Accept"};
+  server.collectHeaders(requestHeaders, sizeof(requestHeaders) / sizeof(requestHeaders[0]));
 
-  // ---------- /battery-data: PARSEAR 'bat' + completar I con 'pwrsys' ----------
-  server.on("/battery-data", [&server, batteryData]()
+  // ---------- UI principal: página estática precomprimida (dashboardPage.h) ----------
+  // Todo el estado dinámico llega después por los endpoints JSON. "/" no
+  // lleva versión: no-cache obliga a revalidar con el ETag en cada carga
+  // (un 304 barato), así tras un OTA nadie se queda con una página vieja.
+  server.on("/", [&server]()
             {
-    String moduleParam = server.arg("module");
-    bool isSystemView = (moduleParam.length() == 0);
-    int targetModule = isSystemView ? 0 : moduleParam.toInt();
-
-    if (isSystemView)
+    server.sendHeader("ETag", DASHBOARD_ETAG);
+    server.sendHeader("Cache-Control", "no-cache");
+    if (server.header("If-None-Match") == DASHBOARD_ETAG)
     {
-      // Vista del sistema completo (como antes)
-      String raw = _bmsSendCmd("bat", 4000);
-
-      int cells = 0;
-      long sum_mV = 0;
-      long sum_mA = 0;
-      long sum_mC = 0;
-      long sum_soc = 0;
-
-      auto scan4ints = [](const String &line, long &a, long &b, long &c, long &d) -> bool
-      {
-        const char *s = line.c_str();
-        long vals[4];
-        int n = 0;
-        while (*s && n < 4)
-        {
-          while (*s && !((*s == '-') || (*s >= '0' && *s <= '9')))
-            s++;
-          if (!*s)
-            break;
-          char *end;
-          long v = strtol(s, &end, 10);
-          vals[n++] = v;
-          s = end;
-        }
-        if (n == 4)
-        {
-          a = vals[0];
-          b = vals[1];
-          c = vals[2];
-          d = vals[3];
-          return true;
-        }
-        return false;
-      };
-
-      int start = 0;
-      while (start < (int)raw.length())
-      {
-        int end = raw.indexOf('\n', start);
-        String line = (end < 0) ? raw.substring(start) : raw.substring(start, end);
-        start = (end < 0) ? raw.length() : end + 1;
-        line.trim();
-        if (line.length() == 0)
-          continue;
-        if (!isDigit(line[0]))
-          continue;
-
-        long idx, mv, ma, mC;
-        if (!scan4ints(line, idx, mv, ma, mC))
-          continue;
-
-        // SOC: número justo antes de '%'
-        int pcent = line.indexOf('%');
-        int pnum = -1, soc = 0;
-        if (pcent > 0)
-        {
-          pnum = pcent - 1;
-          while (pnum >= 0 && isDigit(line[pnum]))
-            pnum--;
-          pnum++;
-          soc = line.substring(pnum, pcent).toInt();
-        }
-
-        (void)idx;
-        cells++;
-        sum_mV += mv;
-        sum_mA += ma;
-        sum_mC += mC;
-        sum_soc += soc;
-      }
-
-      float packV = (cells > 0) ? (sum_mV / 1000.0f) : 0.0f;                  // V
-      float currA = (cells > 0) ? ((sum_mA / (float)cells) / 1000.0f) : 0.0f; // A (media celda)
-      float tempC = (cells > 0) ? ((sum_mC / (float)cells) / 1000.0f) : 0.0f; // °C (media)
-      int socPc = (cells > 0) ? (int)(sum_soc / cells) : 0;
-
-      // --- Si la corriente sigue a 0, intenta obtenerla de 'pwrsys' ---
-      if (fabs(currA) < 0.0005f)
-      {
-        String sys = _bmsSendCmd("pwrsys", 3000);
-
-        // Busca específicamente "System Curr" en la respuesta de pwrsys
-        int p = sys.indexOf("System Curr");
-        if (p >= 0)
-        {
-          // Busca el ":" después de "System Curr"
-          int colon = sys.indexOf(":", p);
-          if (colon >= 0)
-          {
-            // Extrae el número después del ":"
-            int i = colon + 1;
-            // Salta espacios
-            while (i < (int)sys.length() && (sys[i] == ' ' || sys[i] == '\t'))
-              i++;
+      server.send(304);
+      return;
+    }
+    server.sendHeader("Content-Encoding", "gzip");
+    server.send_P(200, "text/html", (PGM_P)DASHBOARD_HTML_GZ, DASHBOARD_HTML_GZ_LEN); });
 
-            String numStr = "";
-            // Captura el número (puede ser negativo)
-            if (i < (int)sys.length() && sys[i] == '-')
-            {
-              numStr += sys[i++];
-            }
-            while (i < (int)sys.length() && ((sys[i] >= '0' && sys[i] <= '9') || sys[i] == '.'))
+  // ---------- /console: última salida de /cmd, su estado y puerto del WebSocket ----------
+  server.on("/console", [&server]()
             {
-              numStr += sys[i++];
-            }
+    String json;
+    json.reserve(lastCommandOutput.length() + 96);
+    json = F("{\"wsPort\":");
+    json += String(WEBSOCKET_PORT);
+    json += F(",\"id\":");
+    json += String(lastCommandId);
+    json += lastCommandDone ? F(",\"done\":true") : F(",\"done\":false");
+    json += lastCommandOk ? F(",\"ok\":true") : F(",\"ok\":false");
+    json += F(",\"output\":\"");
+    _jsonEscapeAppend(json, lastCommandOutput.c_str());
+    json += F("\"}");
+    server.send(200, "application/json", json); });
 
-            if (numStr.length() > 0)
+  // ---------- /battery-data: vista sistema o ?module=N desde el snapshot ----------
+  server.on("/battery-data", [&server, batteryData]()
             {
-              float found = numStr.toFloat();
-              // Convertir de mA a A
-              currA = found / 1000.0f;
-            }
-          }
-        }
-      }
-
-      float power = packV * currA;
-
-      // Refleja también en el struct (si otros módulos lo usan)
-      batteryData->avgVoltage = (int)(packV * 1000.0f);
-      batteryData->currentDC = (int)(currA * 1000.0f);
-      batteryData->temp = (int)tempC;
-      batteryData->soc = socPc;
-
-      // Análisis de balance de celdas para alertas
-      String balanceStatus = "normal";
-      String balanceMessage = "";
-      int maxVoltage = 0, minVoltage = 99999;
-      int imbalanceMv = 0;
-      
-      // Re-analizar para obtener voltajes individuales de celdas
-      int cellCount = 0;
-      start = 0;
-      while (start < (int)raw.length())
-      {
-        int end = raw.indexOf('\n', start);
-        String line = (end < 0) ? raw.substring(start) : raw.substring(start, end);
-        start = (end < 0) ? raw.length() : end + 1;
-        line.trim();
-        
-        if (line.length() == 0 || !isDigit(line[0])) continue;
-        
-        long idx, mv, ma, mC;
-        if (scan4ints(line, idx, mv, ma, mC))
-        {
-          cellCount++;
-          if (mv > maxVoltage) maxVoltage = mv;
-          if (mv < minVoltage) minVoltage = mv;
-        }
-      }
-      
-      if (cellCount > 0)
-      {
-        imbalanceMv = maxVoltage - minVoltage;
-        
-        if (imbalanceMv <= 40)
-        {
-          balanceStatus = "normal";
-          balanceMessage = "✅ Balance normal: " + String(imbalanceMv) + " mV";
-        }
-        else if (imbalanceMv <= 60)
-        {
-          balanceStatus = "warning";
-          balanceMessage = "⚠️ Vigilar balance: " + String(imbalanceMv) + " mV";
-        }
-        else
-        {
-          balanceStatus = "critical";
-          balanceMessage = "❗ Accionar: " + String(imbalanceMv) + " mV - Revisar balanceador";
-        }
-      }
+    if (_notModified(server, 'g', batteryData->generation))
+      return;
 
-      String json = "{";
-      json += "\"soc\":" + String(socPc) + ",";
-      json += "\"voltage\":" + String(packV, 3) + ",";
-      json += "\"current\":" + String(currA, 3) + ",";
-      json += "\"power\":" + String(power, 1) + ",";
-      json += "\"temperature\":" + String(tempC, 1) + ",";
-      json += "\"balanceStatus\":\"" + balanceStatus + "\",";
-      json += "\"balanceMessage\":\"" + balanceMessage + "\",";
-      json += "\"imbalanceMv\":" + String(imbalanceMv) + ",";
-      json += "\"cellCount\":" + String(cellCount) + ",";
-      json += "\"maxCellVoltage\":" + String(maxVoltage) + ",";
-      json += "\"minCellVoltage\":" + String(minVoltage);
-      json += "}";
-      server.send(200, "application/json", json);
-    }
+    String moduleParam = server.arg("module");
+    int targetModule = moduleParam.length() ? moduleParam.toInt() : 0;
+    if (moduleParam.length() && targetModule == 0)
+      targetModule = -1; // ?module=abc: no es la vista de sistema
+
+    _chunkWriter out(server, 200, "application/json");
+    writeBatteryDataJson(out, *batteryData, targetModule, millis());
+    out.end(); });
+
+  // ---------- /snapshot: pila, módulos, extremos de celda y cola del histórico en una respuesta ----------
+  // ?history=N  últimos N puntos del histórico (por defecto 48, 0 = ninguno)
+  // Accept: application/cbor  mismo esquema en CBOR con enteros en milésimas (telemetryCodec.h)
+  server.on("/snapshot", [&server, batteryData]()
+            {
+    const batteryStack &st = *batteryData;
+    bool cbor = _wantsCbor(server);
+    if (_notModified(server, cbor ? 'S' : 's', st.generation, st.history.generation))
+      return;
+
+    int historyTail = server.hasArg("history") ? server.arg("history").toInt() : 48;
+    _chunkWriter out(server, 200, cbor ? "application/cbor" : "application/json");
+    if (cbor)
+      writeSnapshotCbor(out, st, historyTail, millis());
     else
-    {
-      // Vista de módulo individual - usar los datos de pwr pero calcular temperatura como promedio
-      String pwrResponse = _bmsSendCmd("pwr", 4000);
+      writeSnapshotJson(out, st, historyTail, millis());
+    out.end(); });
 
-      float packV = 0.0f;
-      float currA = 0.0f;
-      float tempC = 0.0f;
-      int socPc = 0;
-      bool found = false;
-
-      int start = 0;
-      while (start < (int)pwrResponse.length())
-      {
-        int end = pwrResponse.indexOf('\n', start);
-        String line = (end < 0) ? pwrResponse.substring(start) : pwrResponse.substring(start, end);
-        start = (end < 0) ? pwrResponse.length() : end + 1;
-        line.trim();
-
-        if (line.length() == 0)
-          continue;
-        if (!isDigit(line[0]))
-          continue;
-        if (line.indexOf("Absent") >= 0)
-          continue;
-
-        // Extraer el número del módulo (primer número de la línea)
-        int spacePos = line.indexOf(' ');
-        if (spacePos > 0)
-        {
-          int moduleNum = line.substring(0, spacePos).toInt();
-          if (moduleNum == targetModule)
-          {
-            found = true;
-            
-            // Dividir la línea en tokens
-            String tokens[25];
-            int tokenCount = 0;
-            int pos = 0;
-            
-            while (pos < (int)line.length() && tokenCount < 25)
+  // ---------- /metrics: Prometheus (texto 0.0.4) desde el snapshot y firmwareHealth ----------
+  server.on("/metrics", [&server, batteryData]()
             {
-              while (pos < (int)line.length() && (line[pos] == ' ' || line[pos] == '\t'))
-                pos++;
-              
-              if (pos >= (int)line.length()) break;
-              
-              int start = pos;
-              while (pos < (int)line.length() && line[pos] != ' ' && line[pos] != '\t')
-                pos++;
-              
-              tokens[tokenCount++] = line.substring(start, pos);
-            }
-            
-            if (tokenCount >= 17)
+    unsigned long t0 = micros();
+    health.heap.sample(millis());
+    _chunkWriter out(server, 200, "text/plain; version=0.0.4; charset=utf-8");
+    writePrometheusMetrics(out, *batteryData, health, millis());
+    out.end();
+    health.scrapeUs = micros() - t0; });
+
+#ifndef DISABLE_PERF
+  // ---------- /perf: latencia por etapa de loop() y por ruta (?reset=1 pone a cero) ----------
+  server.on("/perf", [&server]()
             {
-              packV = tokens[1].toFloat() / 1000.0f;    // Volt: mV -> V
-              currA = tokens[2].toFloat() / 1000.0f;    // Curr: mA -> A
-              
-              // Para consistencia con el sistema, obtener temperatura del comando bat
-              // y calcular promedio de las celdas de esta batería
-              String batCmd = "bat " + String(targetModule);
-              String batResponse = _bmsSendCmd(batCmd, 3000);
-              
-              // Calcular promedio de temperatura de las celdas de esta batería
-              int cells = 0;
-              long sum_mC = 0;
-              
-              auto scan4ints = [](const String &line, long &a, long &b, long &c, long &d) -> bool
-              {
-                const char *s = line.c_str();
-                long vals[4];
-                int n = 0;
-                while (*s && n < 4)
-                {
-                  while (*s && !((*s == '-') || (*s >= '0' && *s <= '9')))
-                    s++;
-                  if (!*s) break;
-                  char *end;
-                  long v = strtol(s, &end, 10);
-                  vals[n++] = v;
-                  s = end;
-                }
-                if (n == 4)
-                {
-                  a = vals[0]; b = vals[1]; c = vals[2]; d = vals[3];
-                  return true;
-                }
-                return false;
-              };
-              
-              int batStart = 0;
-              while (batStart < (int)batResponse.length())
-              {
-                int batEnd = batResponse.indexOf('\n', batStart);
-                String batLine = (batEnd < 0) ? batResponse.substring(batStart) : batResponse.substring(batStart, batEnd);
-                batStart = (batEnd < 0) ? batResponse.length() : batEnd + 1;
-                batLine.trim();
-                
-                if (batLine.length() == 0 || !isDigit(batLine[0])) continue;
-                
-                long id, mv, ma, mC;
-                if (scan4ints(batLine, id, mv, ma, mC))
-                {
-                  cells++;
-                  sum_mC += mC;
-                }
-              }
-              
-              // Usar promedio de temperatura si hay datos de bat, sino usar fallback
-              if (cells > 0)
-              {
-                tempC = ((sum_mC / (float)cells) / 1000.0f); // Promedio como en sistema
-              }
-              else
-              {
-                // Fallback: usar temperatura de pwr como antes
-                if (tokens[3] != "-" && tokens[3].length() > 0) {
-                  tempC = tokens[3].toFloat() / 1000.0f;
-                } else if (tokens[16] != "-" && tokens[16].length() > 0) {
-                  tempC = tokens[16].toFloat() / 1000.0f;
-                }
-              }
-              
-              // SOC de pwr
-              String coulombStr = tokens[12];
-              int percentPos = coulombStr.indexOf('%');
-              if (percentPos > 0)
-              {
-                socPc = coulombStr.substring(0, percentPos).toInt();
-              }
-            }
-            break;
-          }
-        }
-      }
-
-      // Análisis de balance para módulo individual
-      String balanceStatus = "N/A";
-      String balanceMessage = "Sin datos";
-      float imbalanceMv = 0;
-      int cellCount = 0;
-      float maxVoltage = 0;
-      float minVoltage = 0;
-      int maxCellId = 0;
-      int minCellId = 0;
+    _chunkWriter out(server, 200, "application/json");
+    writePerfJson(out, perf, httpRoutes, millis());
+    out.end();
+    if (server.hasArg("reset"))
+      perf.reset(millis()); });
 
-      if (found) {
-        String batCmd = "bat " + String(targetModule);
-        String batResponse = _bmsSendCmd(batCmd, 3000);
-        
-        float minV = 999999;
-        float maxV = 0;
-        
-        auto scan4ints = [](const String &line, long &a, long &b, long &c, long &d) -> bool
-        {
-          const char *s = line.c_str();
-          long vals[4];
-          int n = 0;
-          while (*s && n < 4)
-          {
-            while (*s && !((*s == '-') || (*s >= '0' && *s <= '9')))
-              s++;
-            if (!*s) break;
-            char *end;
-            long v = strtol(s, &end, 10);
-            vals[n++] = v;
-            s = end;
-          }
-          if (n == 4)
-          {
-            a = vals[0]; b = vals[1]; c = vals[2]; d = vals[3];
-            return true;
-          }
-          return false;
-        };
-        
-        int start = 0;
-        while (start < (int)batResponse.length())
-        {
-          int end = batResponse.indexOf('\n', start);
-          String line = (end < 0) ? batResponse.substring(start) : batResponse.substring(start, end);
-          start = (end < 0) ? batResponse.length() : end + 1;
-          line.trim();
-          
-          if (line.length() == 0 || !isDigit(line[0])) continue;
-          
-          long id, mv, ma, mC;
-          if (scan4ints(line, id, mv, ma, mC))
-          {
-            float cellV = mv / 1000.0f;
-            if (cellV > maxV) {
-              maxV = cellV;
-              maxCellId = id;
-            }
-            if (cellV < minV) {
-              minV = cellV;
-              minCellId = id;
-            }
-            cellCount++;
-          }
-        }
-        
-        if (cellCount > 0) {
-          imbalanceMv = (maxV - minV) * 1000;
-          maxVoltage = maxV;
-          minVoltage = minV;
-          
-          // Categorizar estado (umbrales LiFePO4)
-          if (imbalanceMv <= 40) {
-            balanceStatus = "Normal";
-            balanceMessage = "Balance óptimo (" + String(imbalanceMv, 1) + "mV)";
-          } else if (imbalanceMv <= 60) {
-            balanceStatus = "Advertencia";
-            balanceMessage = "Desequilibrio moderado (" + String(imbalanceMv, 1) + "mV)";
-          } else {
-            balanceStatus = "Crítico";
-            balanceMessage = "Desequilibrio alto (" + String(imbalanceMv, 1) + "mV)";
-          }
-        }
-      }
-
-      if (!found)
-      {
-        // Módulo no encontrado o sin datos
-        String json = "{";
-        json += "\"soc\":0,";
-        json += "\"voltage\":0.0,";
-        json += "\"current\":0.0,";
-        json += "\"power\":0.0,";
-        json += "\"temperature\":0.0,";
-        json += "\"error\":\"Batería no disponible\"";
-        json += "}";
-        server.send(200, "application/json", json);
-        return;
-      }
-
-      float power = packV * currA;
-
-      String json = "{";
-      json += "\"soc\":" + String(socPc) + ",";
-      json += "\"voltage\":" + String(packV, 3) + ",";
-      json += "\"current\":" + String(currA, 3) + ",";
-      json += "\"power\":" + String(power, 1) + ",";
-      json += "\"temperature\":" + String(tempC, 1) + ",";
-      json += "\"balanceStatus\":\"" + balanceStatus + "\",";
-      json += "\"balanceMessage\":\"" + balanceMessage + "\",";
-      json += "\"imbalanceMv\":" + String(imbalanceMv, 1) + ",";
-      json += "\"cellCount\":" + String(cellCount) + ",";
-      json += "\"maxCellVoltage\":" + String(maxVoltage, 3) + ",";
-      json += "\"minCellVoltage\":" + String(minVoltage, 3) + ",";
-      json += "\"maxCellId\":" + String(maxCellId) + ",";
-      json += "\"minCellId\":" + String(minCellId);
-      json += "}";
-      server.send(200, "application/json", json);
-    } });
-
-  // ---------- /modules: detectar qué baterías están presentes ----------
-  server.on("/modules", [&server]()
+#endif
+  // ---------- /heap: heap libre, fragmentación, marcas desde el arranque y coste por ruta (?reset=1 pone a cero las rutas) ----------
+  server.on("/heap", [&server]()
             {
-    String pwr = _bmsSendCmd("pwr", 4000);
-    
+    health.heap.sample(millis());
+    _chunkWriter out(server, 200, "application/json");
+    writeHeapJson(out, health.heap, httpRoutes, millis());
+    out.end();
+    if (server.hasArg("reset"))
+      health.heap.resetRoutes(millis()); });
+
+  // ---------- /log: registros del anillo en RAM, uno por línea (?since=N desde la secuencia N, ?level=1..4) ----------
+  // X-Log-First / X-Log-Next: secuencias del más antiguo y del siguiente; since < First = registros perdidos
+  server.on("/log", [&server]()
+            {
+    uint32_t since = server.hasArg("since") ? strtoul(server.arg("since").c_str(), nullptr, 10) : 0;
+    uint8_t level = server.hasArg("level") ? server.arg("level").toInt() : LOG_LEVEL_DEBUG;
+    server.sendHeader("X-Log-First", String(logBuffer.firstSeq));
+    server.sendHeader("X-Log-Next", String(logBuffer.nextSeq));
+    _chunkWriter out(server, 200, "text/plain; charset=utf-8");
+    writeLogText(out, logBuffer, since, level);
+    out.end(); });
+
+  // ---------- /bms-queue: comando en curso, colas de la consola y esperas por clase (?reset=1 pone a cero) ----------
+  server.on("/bms-queue", [&server]()
+            {
+    _chunkWriter out(server, 200, "application/json");
+    writeBmsQueueJson(out, bmsQueue, millis());
+    out.end();
+    if (server.hasArg("reset"))
+      bmsQueue.resetStats(millis()); });
+
+  // ---------- /modules: baterías presentes según el último 'pwr' ----------
+  server.on("/modules", [&server, batteryData]()
+            {
+    if (_notModified(server, 'g', batteryData->generation))
+      return;
+
     String json = "[";
     bool first = true;
-    
-    // Parsear la salida del comando pwr para encontrar módulos presentes
-    int start = 0;
-    while (start < (int)pwr.length()) {
-      int end = pwr.indexOf('\n', start);
-      String line = (end < 0) ? pwr.substring(start) : pwr.substring(start, end);
-      start = (end < 0) ? pwr.length() : end + 1;
-      line.trim();
-      
-      if (line.length() == 0) continue;
-      if (!isDigit(line[0])) continue;
-      
-      // Buscar líneas que NO contienen "Absent"
-      if (line.indexOf("Absent") < 0) {
-        // Extraer el número del módulo (primer número de la línea)
-        int spacePos = line.indexOf(' ');
-        if (spacePos > 0) {
-          int moduleNum = line.substring(0, spacePos).toInt();
-          if (moduleNum > 0) {
-            if (!first) json += ",";
-            json += String(moduleNum);
-            first = false;
-          }
-        }
-      }
+    for (int i = 0; i < MAX_PYLON_BATTERIES_SUPPORTED; i++) {
+      if (!batteryData->batts[i].isPresent) continue;
+      if (!first) json += ",";
+      json += String(i + 1);
+      first = false;
     }
-    
     json += "]";
     server.send(200, "application/json", json); });
 
-  // ---------- /cmd: enviar comandos (redirige a / como el repo) ----------
+  // ---------- /cmd: encola un comando (202 + id); la salida se recoge en /console ----------
   server.on("/cmd", [&server](void)
             {
     const String cmd = server.arg("q");   // escribe: help, bat, pwrsys, pwr...
-    lastCommandOutput.clear();
-    if (cmd.length()) {
-      lastCommandOutput = _bmsSendCmd(cmd, 5000);
-#if DBG_BMS
-      Serial2.println("[BMS] RX:\n" + lastCommandOutput);
-#endif
+    if (!cmd.length()) {
+      server.send(400, "application/json", "{\"error\":\"missing command (q)\"}");
+      return;
     }
-    // Redirige para que la home embeba la última respuesta y el JS la pinte en la terminal
-    server.sendHeader("Location", "/");
-    server.send(303); });
+    uint32_t seq = _lastCommandSeq + 1;
+    uint32_t id = bmsQueue.submit(BMS_INTERACTIVE, cmd.c_str(), 5000, [seq](const char *line)
+                                  {
+      if (seq != _lastCommandSeq)
+        return;
+      lastCommandOutput += line;
+      lastCommandOutput += '\n'; }, [seq](bool ok)
+                                  {
+      if (seq != _lastCommandSeq)
+        return;
+      lastCommandDone = true;
+      lastCommandOk = ok;
+      LOG_D(BMS, "RX: %s", lastCommandOutput.c_str()); });
+    if (!id) {
+      if (bmsQueue.lastReject == BMS_CMD_TOO_LONG) {
+        server.send(400, "application/json", "{\"error\":\"command too long\",\"max\":" + String(BMS_CMD_MAX - 1) + "}");
+      } else {
+        server.sendHeader("Retry-After", "1");
+        server.send(503, "application/json", "{\"error\":\"BMS console queue full\"}");
+      }
+      return;
+    }
+    _lastCommandSeq = seq;
+    lastCommandId = id;
+    lastCommandDone = false;
+    lastCommandOk = false;
+    lastCommandOutput.clear();
+    server.send(202, "application/json", "{\"id\":" + String(id) + "}"); });
 
-  // ---------- /balance-history: serve historical balance data ----------
+  // ---------- /balance-history: serve historical balance data (JSON or CBOR) ----------
   server.on("/balance-history", [&server, batteryData]()
             {
-    String json = "{\"data\":[";
-    bool first = true;
-    
-    // Get all valid entries from the history
-    for (uint8_t i = 0; i < batteryData->history.entryCount; i++) {
-      balanceHistoryEntry* entry = batteryData->history.getEntry(i);
-      if (entry && entry->isValid) {
-        if (!first) json += ",";
-        json += "{";
-        json += "\"timestamp\":" + String(entry->timestamp) + ",";
-        json += "\"batteryId\":" + String(entry->batteryId) + ",";
-        json += "\"balanceMv\":" + String(entry->balanceMv) + ",";
-        json += "\"socPercent\":" + String(entry->socPercent);
-        json += "}";
-        first = false;
-      }
-    }
-    
-    json += "],";
-    json += "\"totalEntries\":" + String(batteryData->history.entryCount) + ",";
-    json += "\"maxEntries\":" + String(MAX_BALANCE_HISTORY_ENTRIES) + ",";
-    json += "\"currentTime\":" + String(millis());
-    json += "}";
-    
-    server.send(200, "application/json", json); });
+    bool cbor = _wantsCbor(server);
+    if (_notModified(server, cbor ? 'H' : 'h', batteryData->history.generation))
+      return;
+
+    _chunkWriter out(server, 200, cbor ? "application/cbor" : "application/json");
+    if (cbor)
+      writeHistoryCbor(out, *batteryData, millis());
+    else
+      writeHistoryJson(out, *batteryData, millis());
+    out.end(); });
 
   // ---------- /debug-history: debug endpoint for history status ----------
   server.on("/debug-history", [&server, batteryData]()
             {
+    extern timeService timeSvc;
+    extern unsigned long getCurrentTimestamp();
+    uint32_t uptime = timeSvc.uptimeSeconds();
+    int unsynced = 0;
+    for (int i = 0; i < batteryData->history.entryCount; i++)
+    {
+      const balanceHistoryEntry *e = batteryData->history.getEntry(i);
+      if (e && (e->flags & HISTORY_UNSYNCED))
+        unsynced++;
+    }
+
+    // Todos los tiempos en la misma escala: hora Unix local (o uptime si clockSynced=false)
     String json = "{";
-    json += "\"currentTime\":" + String(millis()) + ",";
+    json += "\"currentTime\":" + String(getCurrentTimestamp()) + ",";
+    json += "\"clockSynced\":" + String(timeSvc.isSynced() ? "true" : "false") + ",";
+    json += "\"uptime\":" + String(uptime) + ",";
     json += "\"lastSaveTime\":" + String(batteryData->history.lastSaveTime) + ",";
-    json += "\"timeSinceLastSave\":" + String(millis() - batteryData->history.lastSaveTime) + ",";
-    json += "\"shouldRecord\":" + String(batteryData->shouldRecordHistory(millis()) ? "true" : "false") + ",";
+    json += "\"timeSinceLastRecord\":" + String(batteryData->history.recordedThisBoot ? (long)(uptime - batteryData->history.lastRecordUptime) : -1L) + ",";
+    json += "\"shouldRecord\":" + String(batteryData->shouldRecordHistory(uptime) ? "true" : "false") + ",";
+    json += "\"unsyncedEntries\":" + String(unsynced) + ",";
     json += "\"currentIndex\":" + String(batteryData->history.currentIndex) + ",";
     json += "\"entryCount\":" + String(batteryData->history.entryCount) + ",";
     json += "\"maxEntries\":" + String(MAX_BALANCE_HISTORY_ENTRIES);
@@ -1204,19 +358,20 @@ void setupWebInterface(WebServer &server, batteryStack *batteryData)
   server.on("/record-now", [&server, batteryData]()
             {
     extern unsigned long getCurrentTimestamp();
+    extern timeService timeSvc;
     unsigned long currentTime = getCurrentTimestamp();
     
-    Serial.println("[FORCE RECORD] Manually forcing balance history recording...");
+    LOG_I(HISTORY, "Manually forcing balance history recording");
     
     // Call the real recording function with real timestamp
-    batteryData->recordBalanceHistory(currentTime);
-    batteryData->updateLastSaveTime(currentTime);
+    batteryData->recordBalanceHistory(currentTime, timeSvc.isSynced());
+    batteryData->updateLastSaveTime(currentTime, timeSvc.uptimeSeconds());
     
     // Save to flash
     if (batteryData->saveBalanceHistory()) {
-      Serial.println("[FORCE RECORD] History saved to flash successfully");
+      LOG_I(HISTORY, "History saved to flash");
     } else {
-      Serial.println("[FORCE RECORD] Failed to save history to flash");
+      LOG_E(HISTORY, "Failed to save history to flash");
     }
     
     // Response with real timestamp
@@ -1224,17 +379,18 @@ void setupWebInterface(WebServer &server, batteryStack *batteryData)
     
     server.send(200, "application/json", response); });
 
-  // ---------- /force-update: force battery data update ----------
-  server.on("/force-update", [&server]()
+  // ---------- /force-update: start an acquisition now (202); the new generation shows up in /snapshot ----------
+  server.on("/force-update", [&server, batteryData]()
             {
-    extern void updateBatteryData();
+    extern bool updateBatteryData();
     
-    Serial.println("[FORCE UPDATE] Manually forcing battery data update...");
-    updateBatteryData();
+    LOG_I(BATTERY, "Manually forcing battery data update");
+    bool started = updateBatteryData();
     
-    String response = "{\"status\":\"OK\",\"action\":\"FORCE_UPDATE_COMPLETED\",\"timestamp\":" + String(millis()) + "}";
+    String response = "{\"status\":\"OK\",\"action\":\"" + String(started ? "FORCE_UPDATE_STARTED" : "UPDATE_IN_PROGRESS") + "\"";
+    response += ",\"generation\":" + String(batteryData->generation) + ",\"timestamp\":" + String(millis()) + "}";
     
-    server.send(200, "application/json", response); });
+    server.send(202, "application/json", response); });
 
   // ---------- /clear-history: clear all balance history ----------
   server.on("/clear-history", [&server, batteryData]()
@@ -1318,17 +474,26 @@ void setupWebInterface(WebServer &server, batteryStack *batteryData)
   // ---------- /time-info: show current time and NTP status ----------
   server.on("/time-info", [&server]()
             {
-    extern NTPClient timeClient;
-    extern unsigned long lastNtpSync;
+    extern timeService timeSvc;
     extern bool wifiConnected;
     extern unsigned long getCurrentTimestamp();
+    char formatted[12];
+    timeSvc.formatTime(formatted, sizeof(formatted));
     
     String response = "{";
     response += "\"wifiConnected\":" + String(wifiConnected ? "true" : "false") + ",";
-    response += "\"ntpInitialized\":" + String(timeClient.isTimeSet() ? "true" : "false") + ",";
+    response += "\"ntpInitialized\":" + String(timeSvc.isSynced() ? "true" : "false") + ",";
     response += "\"currentTimestamp\":" + String(getCurrentTimestamp()) + ",";
-    response += "\"formattedTime\":\"" + timeClient.getFormattedTime() + "\",";
-    response += "\"lastNtpSync\":" + String(lastNtpSync) + ",";
+    response += "\"utc\":" + String(timeSvc.utc()) + ",";
+    response += "\"formattedTime\":\"" + String(formatted) + "\",";
+    response += "\"lastNtpSync\":" + String((unsigned long)(timeSvc.lastSyncMono / 1000)) + ",";
+    response += "\"ntpSyncs\":" + String(timeSvc.syncs) + ",";
+    response += "\"ntpFailures\":" + String(timeSvc.failures) + ",";
+    response += "\"ntpRttMs\":" + String(timeSvc.lastRttMs) + ",";
+    response += "\"lastCorrectionMs\":" + String(timeSvc.lastCorrectionMs) + ",";
+    response += "\"slewPendingMs\":" + String(timeSvc.slewPendingMs()) + ",";
+    response += "\"driftPpm\":" + String(timeSvc.driftPpb / 1000.0, 3) + ",";
+    response += "\"uptime\":" + String(timeSvc.uptimeSeconds()) + ",";
     response += "\"millis\":" + String(millis());
     response += "}";
     
@@ -6,33 +6,47 @@ bool WiFiConfigManager::loadConfig()
 {
     if (!LittleFS.begin())
     {
-        Serial.println("[WiFiConfig] Failed to mount LittleFS");
+        LOG_E(WIFICFG, "Failed to mount LittleFS");
         return false;
     }
 
     if (!LittleFS.exists("/wifi_config.dat"))
     {
-        Serial.println("[WiFiConfig] No config file found");
+        LOG_I(WIFICFG, "No config file found");
         return false;
     }
 
     File file = LittleFS.open("/wifi_config.dat", "r");
     if (!file)
     {
-        Serial.println("[WiFiConfig] Failed to open config file");
+        LOG_E(WIFICFG, "Failed to open config file");
         return false;
     }
 
     size_t bytesRead = file.read((uint8_t *)&config, sizeof(WiFiConfig));
     file.close();
 
-    if (bytesRead != sizeof(WiFiConfig) || !config.isValid)
+    // Ficheros anteriores a WiFiFastPath: credenciales válidas, sin caché
+    // ('fast' va al final y alineado, así que el formato viejo mide la diferencia)
+    if (bytesRead == sizeof(WiFiConfig) - sizeof(WiFiFastPath))
     {
-        Serial.println("[WiFiConfig] Invalid config file");
+        config.fast = WiFiFastPath();
+    }
+    else if (bytesRead != sizeof(WiFiConfig))
+    {
+        LOG_W(WIFICFG, "Invalid config file");
+        config = WiFiConfig();
         return false;
     }
 
-    Serial.println("[WiFiConfig] Configuration loaded successfully");
+    // The file may hold only the fast path of the hardcoded network
+    if (!config.isValid)
+    {
+        LOG_I(WIFICFG, "No saved credentials");
+        return false;
+    }
+
+    LOG_I(WIFICFG, "Configuration loaded successfully");
     return true;
 }
 
@@ -40,16 +54,14 @@ bool WiFiConfigManager::saveConfig()
 {
     if (!LittleFS.begin())
     {
-        Serial.println("[WiFiConfig] Failed to mount LittleFS");
+        LOG_E(WIFICFG, "Failed to mount LittleFS");
         return false;
     }
 
-    config.isValid = true;
-
     File file = LittleFS.open("/wifi_config.dat", "w");
     if (!file)
     {
-        Serial.println("[WiFiConfig] Failed to create config file");
+        LOG_E(WIFICFG, "Failed to create config file");
         return false;
     }
 
@@ -58,24 +70,23 @@ bool WiFiConfigManager::saveConfig()
 
     if (bytesWritten != sizeof(WiFiConfig))
     {
-        Serial.println("[WiFiConfig] Failed to write complete config");
+        LOG_E(WIFICFG, "Failed to write complete config");
         return false;
     }
 
-    Serial.println("[WiFiConfig] Configuration saved successfully");
+    LOG_I(WIFICFG, "Configuration saved successfully");
     return true;
 }
 
-bool WiFiConfigManager::connectToWiFi()
+bool WiFiConfigManager::beginConnect()
 {
     if (!config.isValid || strlen(config.ssid) == 0)
     {
-        Serial.println("[WiFiConfig] No valid WiFi configuration");
+        LOG_W(WIFICFG, "No valid WiFi configuration");
         return false;
     }
 
-    Serial.print("[WiFiConfig] Connecting to: ");
-    Serial.println(config.ssid);
+    LOG_I(WIFICFG, "Connecting to: %s", config.ssid);
 
     WiFi.mode(WIFI_STA);
 
@@ -83,37 +94,70 @@ bool WiFiConfigManager::connectToWiFi()
     {
         if (!WiFi.config(config.staticIP, config.gateway, config.subnet, config.dns))
         {
-            Serial.println("[WiFiConfig] Failed to configure static IP");
+            LOG_E(WIFICFG, "Failed to configure static IP");
         }
     }
 
+    // No esperamos aquí: el llamante consulta WiFi.status() desde loop()
     WiFi.begin(config.ssid, config.password);
+    return true;
+}
 
-    unsigned long startTime = millis();
-    while (WiFi.status() != WL_CONNECTED && millis() - startTime < 30000)
-    {
-        delay(500);
-        Serial.print(".");
-    }
-    Serial.println();
+// Reconexión rápida: BSSID y canal conocidos, sin escaneo. La IP es la de
+// siempre: la fija de la configuración guardada o DHCP (para la red de
+// respaldo, la que haya puesto el llamante). Solo si la caché es de la red
+// que toca: la guardada si hay credenciales, si no la de respaldo.
+bool WiFiConfigManager::beginFastConnect(const char *fallbackSsid, const char *fallbackPass)
+{
+    const char *ssid = config.isValid ? config.ssid : fallbackSsid;
+    const char *pass = config.isValid ? config.password : fallbackPass;
+    fastPathInUse = false;
 
-    if (WiFi.status() == WL_CONNECTED)
-    {
-        Serial.println("[WiFiConfig] ✅ WiFi connected successfully");
-        Serial.print("[WiFiConfig] IP: ");
-        Serial.println(WiFi.localIP());
-        return true;
-    }
-    else
-    {
-        Serial.println("[WiFiConfig] ❌ WiFi connection failed");
+    if (!config.fast.isValid || strncmp(config.fast.ssid, ssid, sizeof(config.fast.ssid)) != 0)
         return false;
-    }
+
+    LOG_I(WIFICFG, "Fast reconnect to %s (channel %u)", ssid, config.fast.channel);
+
+    WiFi.mode(WIFI_STA);
+    if (config.isValid && config.useStaticIP)
+        WiFi.config(config.staticIP, config.gateway, config.subnet, config.dns);
+    WiFi.begin(ssid, pass, config.fast.channel, config.fast.bssid);
+    fastPathInUse = true;
+    return true;
+}
+
+// Llamar al conectar: guarda BSSID y canal si han cambiado (o si la caché
+// aún lleva un lease de un firmware anterior)
+void WiFiConfigManager::rememberLink()
+{
+    WiFiFastPath link;
+    strncpy(link.ssid, WiFi.SSID().c_str(), sizeof(link.ssid) - 1);
+    memcpy(link.bssid, WiFi.BSSID(), sizeof(link.bssid));
+    link.channel = WiFi.channel();
+    link.isValid = 1;
+
+    if (link.sameLink(config.fast) && !config.fast.oldLease[0])
+        return;
+    config.fast = link;
+    saveConfig();
+}
+
+void WiFiConfigManager::forgetFastPath()
+{
+    fastPathInUse = false;
+    if (!config.fast.isValid)
+        return;
+    LOG_W(WIFICFG, "Fast reconnect failed, dropping cached link");
+    config.fast = WiFiFastPath();
+    saveConfig();
+
+    // Volver a DHCP para el intento normal
+    WiFi.config(IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0));
 }
 
 void WiFiConfigManager::startConfigPortal()
 {
-    Serial.println("[WiFiConfig] Starting configuration portal...");
+    LOG_I(WIFICFG, "Starting configuration portal");
 
     WiFi.mode(WIFI_AP_STA);
 
@@ -125,11 +169,6 @@ void WiFiConfigManager::startConfigPortal()
     // Start Access Point
     WiFi.softAP(apName.c_str(), "1234");
 
-    Serial.print("[WiFiConfig] AP IP address: ");
-    Serial.println(WiFi.softAPIP());
-    Serial.print("[WiFiConfig] AP Name: ");
-    Serial.println(apName);
-
     // Start DNS server for captive portal
     dnsServer.start(53, "*", WiFi.softAPIP());
 
@@ -139,10 +178,10 @@ void WiFiConfigManager::startConfigPortal()
 
     apMode = true;
     apStartTime = millis();
+    startScan(); // la lista ya estará lista cuando se abra la página
 
-    Serial.println("[WiFiConfig] ✅ Configuration portal started");
-    Serial.println("[WiFiConfig] Connect to 'ESP_XXXXXX' with password '1234'");
-    Serial.println("[WiFiConfig] Then navigate to http://192.168.4.1");
+    LOG_I(WIFICFG, "Configuration portal started: join '%s' (password '1234') and open http://%s",
+          apName.c_str(), WiFi.softAPIP().toString().c_str());
 }
 
 void WiFiConfigManager::handleConfigPortal()
@@ -152,12 +191,14 @@ void WiFiConfigManager::handleConfigPortal()
 
     dnsServer.processNextRequest();
     configServer.handleClient();
+    pollScan();
 
-    // Auto-close AP after timeout
+    // Auto-close AP after timeout; wifiLoop() starts the sequence again
+    // (no reboot: RAM history, energy counters and uptime survive)
     if (millis() - apStartTime > AP_TIMEOUT)
     {
-        Serial.println("[WiFiConfig] ⏰ AP timeout, restarting...");
-        ESP.restart();
+        LOG_W(WIFICFG, "AP timeout, closing portal");
+        stop();
     }
 }
 
@@ -169,7 +210,7 @@ void WiFiConfigManager::stop()
         dnsServer.stop();
         WiFi.softAPdisconnect(true);
         apMode = false;
-        Serial.println("[WiFiConfig] Configuration portal stopped");
+        LOG_I(WIFICFG, "Configuration portal stopped");
     }
 }
 
@@ -194,24 +235,118 @@ void WiFiConfigManager::handleRoot()
     configServer.send(200, "text/html", generateConfigPage());
 }
 
-void WiFiConfigManager::handleScan()
+// Copia el SSID escapado para JSON; devuelve los bytes escritos
+static size_t _jsonEscapeSsid(char *out, size_t cap, const char *s)
 {
-    String json = "[";
-    int n = WiFi.scanNetworks();
+    size_t n = 0;
+    for (; *s && n + 7 < cap; s++)
+    {
+        unsigned char c = *s;
+        if (c == '"' || c == '\\')
+        {
+            out[n++] = '\\';
+            out[n++] = c;
+        }
+        else if (c < 0x20)
+            n += snprintf(out + n, cap - n, "\\u%04x", c);
+        else
+            out[n++] = c;
+    }
+    out[n] = 0;
+    return n;
+}
+
+// Pide un escaneo asíncrono si no hay uno en marcha
+void WiFiConfigManager::startScan()
+{
+    if (scanRunning)
+        return;
+    WiFi.scanDelete();
+    WiFi.scanNetworks(true);
+    scanRunning = true;
+    LOG_D(WIFICFG, "Network scan started");
+}
+
+// Vuelca el resultado del escaneo terminado a la caché: sin SSID repetidos
+// (se queda el de mejor señal), ordenada por RSSI, máximo SCAN_MAX_NETWORKS
+void WiFiConfigManager::pollScan()
+{
+    if (!scanRunning)
+        return;
+    int n = WiFi.scanComplete();
+    if (n == WIFI_SCAN_RUNNING)
+        return;
+    scanRunning = false;
+    scanCount = 0;
 
     for (int i = 0; i < n; i++)
     {
-        if (i > 0)
-            json += ",";
-        json += "{";
-        json += "\"ssid\":\"" + WiFi.SSID(i) + "\",";
-        json += "\"rssi\":" + String(WiFi.RSSI(i)) + ",";
-        json += "\"encryption\":" + String(WiFi.encryptionType(i));
-        json += "}";
+        String ssid = WiFi.SSID(i);
+        if (ssid.length() == 0)
+            continue;
+        int8_t rssi = WiFi.RSSI(i);
+
+        int slot = -1;
+        for (int k = 0; k < scanCount; k++)
+            if (strncmp(scanCache[k].ssid, ssid.c_str(), sizeof(scanCache[k].ssid)) == 0)
+                slot = k;
+        if (slot >= 0 && scanCache[slot].rssi >= rssi)
+            continue;
+        if (slot < 0)
+        {
+            if (scanCount < SCAN_MAX_NETWORKS)
+                slot = scanCount++;
+            else if (scanCache[scanCount - 1].rssi < rssi)
+                slot = scanCount - 1; // sustituye a la más débil
+            else
+                continue;
+        }
+        scanNetwork &e = scanCache[slot];
+        strncpy(e.ssid, ssid.c_str(), sizeof(e.ssid) - 1);
+        e.ssid[sizeof(e.ssid) - 1] = 0;
+        e.rssi = rssi;
+        e.encryption = WiFi.encryptionType(i);
+
+        // Reordenar hacia arriba la entrada nueva o mejorada
+        for (; slot > 0 && scanCache[slot - 1].rssi < scanCache[slot].rssi; slot--)
+        {
+            scanNetwork t = scanCache[slot];
+            scanCache[slot] = scanCache[slot - 1];
+            scanCache[slot - 1] = t;
+        }
     }
+    WiFi.scanDelete();
+    scanDoneAt = millis();
+    scanValid = true;
+    LOG_D(WIFICFG, "Scan done: %d networks (%u kept)", n < 0 ? 0 : n, scanCount);
+}
 
-    json += "]";
-    configServer.send(200, "application/json", json);
+// Responde siempre al momento con la caché; lanza un escaneo si está
+// caducada o se pide ?refresh=1
+void WiFiConfigManager::handleScan()
+{
+    bool stale = !scanValid || millis() - scanDoneAt > SCAN_TTL;
+    if (stale || configServer.hasArg("refresh"))
+        startScan();
+
+    char buf[128];
+    configServer.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    configServer.send(200, "application/json", "");
+    int n = snprintf(buf, sizeof(buf), "{\"scanning\":%s,\"age\":%ld,\"networks\":[",
+                     scanRunning ? "true" : "false", scanValid ? (long)((millis() - scanDoneAt) / 1000) : -1L);
+    configServer.sendContent(buf, n);
+
+    for (uint8_t i = 0; i < scanCount; i++)
+    {
+        char ssid[sizeof(scanCache[i].ssid) * 6];
+        _jsonEscapeSsid(ssid, sizeof(ssid), scanCache[i].ssid);
+        char item[sizeof(ssid) + 48];
+        n = snprintf(item, sizeof(item), "%s{\"ssid\":\"%s\",\"rssi\":%d,\"encryption\":%u}",
+                     i ? "," : "", ssid, scanCache[i].rssi, scanCache[i].encryption);
+        configServer.sendContent(item, n);
+    }
+    configServer.sendContent("]}");
+    configServer.sendContent("");
 }
 
 void WiFiConfigManager::handleSave()
@@ -230,6 +365,10 @@ void WiFiConfigManager::handleSave()
         config.dns = parseIP(configServer.arg("dns"));
     }
 
+    // New credentials: the cached link belongs to the old network
+    config.isValid = true;
+    config.fast = WiFiFastPath();
+
     if (saveConfig())
     {
         configServer.send(200, "text/html",
@@ -356,42 +495,55 @@ String WiFiConfigManager::generateConfigPage()
             }
         }
 
-        function scanNetworks() {
+        // /scan responde al momento con la última lista; si 'scanning' es
+        // true hay un escaneo en curso y se vuelve a preguntar
+        function scanNetworks(polls = 0) {
             const networksDiv = document.getElementById('networks');
-            networksDiv.innerHTML = '<div style="padding:10px;text-align:center">🔄 Buscando redes...</div>';
-            networksDiv.style.display = 'block';
-            
-            fetch('/scan')
+            if (polls === 0) {
+                networksDiv.innerHTML = '<div style="padding:10px;text-align:center">🔄 Buscando redes...</div>';
+                networksDiv.style.display = 'block';
+            }
+
+            fetch(polls === 0 ? '/scan?refresh=1' : '/scan')
                 .then(response => response.json())
-                .then(networks => {
-                    networksDiv.innerHTML = '';
-                    
-                    if (networks.length === 0) {
-                        networksDiv.innerHTML = '<div style="padding:10px;text-align:center">❌ No se encontraron redes</div>';
-                        return;
-                    }
-                    
-                    networks.forEach(network => {
-                        const item = document.createElement('div');
-                        item.className = 'network-item';
-                        item.onclick = () => selectNetwork(network.ssid);
-                        
-                        const lockIcon = network.encryption === 7 ? '🔓' : '🔒';
-                        const signalBars = getSignalBars(network.rssi);
-                        
-                        item.innerHTML = `
-                            <span>${lockIcon} ${network.ssid}</span>
-                            <span class='signal'>${signalBars} ${network.rssi}dBm</span>
-                        `;
-                        
-                        networksDiv.appendChild(item);
-                    });
+                .then(result => {
+                    if (result.networks.length > 0 || !result.scanning)
+                        showNetworks(result.networks);
+                    if (result.scanning && polls < 20)
+                        setTimeout(() => scanNetworks(polls + 1), 1000);
                 })
                 .catch(error => {
                     networksDiv.innerHTML = '<div style="padding:10px;text-align:center">❌ Error al buscar redes</div>';
                 });
         }
 
+        function showNetworks(networks) {
+            const networksDiv = document.getElementById('networks');
+            networksDiv.innerHTML = '';
+
+            if (networks.length === 0) {
+                networksDiv.innerHTML = '<div style="padding:10px;text-align:center">❌ No se encontraron redes</div>';
+                return;
+            }
+
+            networks.forEach(network => {
+                const item = document.createElement('div');
+                item.className = 'network-item';
+                item.onclick = () => selectNetwork(network.ssid);
+
+                const lockIcon = network.encryption === 7 ? '🔓' : '🔒';
+                const name = document.createElement('span');
+                name.textContent = lockIcon + ' ' + network.ssid;
+                const signal = document.createElement('span');
+                signal.className = 'signal';
+                signal.textContent = getSignalBars(network.rssi) + ' ' + network.rssi + 'dBm';
+
+                item.appendChild(name);
+                item.appendChild(signal);
+                networksDiv.appendChild(item);
+            });
+        }
+
         function selectNetwork(ssid) {
             document.getElementById('ssid').value = ssid;
             document.getElementById('networks').style.display = 'none';
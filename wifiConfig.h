@@ -6,6 +6,30 @@
 #include <DNSServer.h>
 #include <LittleFS.h>
 
+#include "logger.h"
+
+// Datos de la última conexión buena para reconectar sin escaneo.
+// 'ssid' dice a qué red pertenecen: puede ser la guardada o la de respaldo.
+// La IP no se guarda: sin hora al arrancar no se sabe si un lease sigue
+// vigente, y reutilizarlo caducado puede chocar con otro equipo. DHCP siempre.
+struct WiFiFastPath
+{
+    char ssid[32];
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t reserved;      // antes arranques reutilizando el lease
+    uint32_t oldLease[4];  // antes IP, puerta de enlace, máscara y DNS: se ignoran
+    uint32_t isValid;
+
+    WiFiFastPath() { memset(this, 0, sizeof(*this)); }
+
+    bool sameLink(const WiFiFastPath &o) const
+    {
+        return isValid == o.isValid && channel == o.channel &&
+               memcmp(bssid, o.bssid, sizeof(bssid)) == 0 && strncmp(ssid, o.ssid, sizeof(ssid)) == 0;
+    }
+};
+
 // WiFi configuration structure
 struct WiFiConfig
 {
@@ -17,6 +41,7 @@ struct WiFiConfig
     IPAddress subnet;
     IPAddress dns;
     bool isValid;
+    WiFiFastPath fast; // appended: files written before it are shorter
 
     WiFiConfig()
     {
@@ -31,6 +56,14 @@ struct WiFiConfig
     }
 };
 
+// Red vista en el último escaneo del portal
+struct scanNetwork
+{
+    char ssid[33];
+    int8_t rssi;
+    uint8_t encryption;
+};
+
 class WiFiConfigManager
 {
 private:
@@ -39,14 +72,28 @@ private:
     DNSServer dnsServer;
     bool apMode;
     unsigned long apStartTime;
+    bool fastPathInUse;
     static const unsigned long AP_TIMEOUT = 300000; // 5 minutes
 
+    // Escaneo asíncrono con caché: /scan nunca espera a la radio
+    static const uint8_t SCAN_MAX_NETWORKS = 20;
+    static const unsigned long SCAN_TTL = 30000;
+    scanNetwork scanCache[SCAN_MAX_NETWORKS];
+    uint8_t scanCount = 0;
+    bool scanRunning = false;
+    bool scanValid = false;
+    unsigned long scanDoneAt = 0;
+
 public:
-    WiFiConfigManager() : configServer(80), apMode(false), apStartTime(0) {}
+    WiFiConfigManager() : configServer(80), apMode(false), apStartTime(0), fastPathInUse(false) {}
 
     bool loadConfig();
     bool saveConfig();
-    bool connectToWiFi();
+    bool beginConnect(); // non-blocking; poll WiFi.status() afterwards
+    bool beginFastConnect(const char *fallbackSsid, const char *fallbackPass);
+    void rememberLink();
+    void forgetFastPath();
+    bool usingFastPath() { return fastPathInUse; }
     void startConfigPortal();
     void handleConfigPortal();
     bool isInAPMode() { return apMode; }
@@ -57,6 +104,8 @@ private:
     void handleRoot();
     void handleSave();
     void handleScan();
+    void startScan();
+    void pollScan();
     String generateConfigPage();
     IPAddress parseIP(const String &ipStr);
 };